@@ -0,0 +1,222 @@
+#include "Benchmark.h"
+#include "IO/FileStream.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace tyr
+{
+	BenchmarkRegistry& BenchmarkRegistry::Instance()
+	{
+		static BenchmarkRegistry instance;
+		return instance;
+	}
+
+	void BenchmarkRegistry::Register(const char* name, BenchmarkFunc func, uint64 arg)
+	{
+		BenchmarkDesc desc;
+		desc.name = name;
+		desc.func = func;
+		desc.arg = arg;
+		m_Benchmarks.Add(desc);
+	}
+
+	Array<BenchmarkResult> BenchmarkRegistry::Run(const BenchmarkConfig& config) const
+	{
+		Array<BenchmarkResult> results;
+		for (const BenchmarkDesc& desc : m_Benchmarks)
+		{
+			if (!config.filter.empty() && desc.name.find(config.filter) == String::npos)
+			{
+				continue;
+			}
+
+			std::printf("Running %s...\n", desc.name.c_str());
+			std::fflush(stdout);
+			results.Add(RunBenchmark(desc, config));
+		}
+		return results;
+	}
+
+	BenchmarkResult BenchmarkRegistry::RunBenchmark(const BenchmarkDesc& desc, const BenchmarkConfig& config) const
+	{
+		const double minSampleTimeNs = config.minSampleTimeMs * 1000000.0;
+
+		// Scale the iteration count until one sample takes long enough to time reliably. This also warms up caches.
+		uint64 iterations = 1;
+		while (true)
+		{
+			BenchmarkState state(iterations, desc.arg);
+			desc.func(state);
+			const double elapsed = state.GetElapsedNanoseconds();
+			if (elapsed >= minSampleTimeNs || iterations >= (1ull << 40))
+			{
+				break;
+			}
+
+			// Aim slightly above the minimum and grow by at most 10x per step
+			const double scale = elapsed > 0.0 ? std::min(10.0, 1.2 * minSampleTimeNs / elapsed) : 10.0;
+			iterations = std::max(iterations + 1, static_cast<uint64>(static_cast<double>(iterations) * scale));
+		}
+
+		Array<double> samples;
+		samples.Reserve(config.sampleCount);
+		uint64 itemsPerIteration = 0;
+		for (uint i = 0; i < config.sampleCount; ++i)
+		{
+			BenchmarkState state(iterations, desc.arg);
+			desc.func(state);
+			samples.Add(state.GetElapsedNanoseconds() / static_cast<double>(iterations));
+			itemsPerIteration = state.GetItemsPerIteration();
+		}
+		std::sort(samples.begin(), samples.end());
+
+		BenchmarkResult result;
+		result.name = desc.name;
+		result.iterations = iterations;
+		result.sampleCount = samples.Size();
+		result.itemsPerIteration = itemsPerIteration;
+
+		const uint middle = samples.Size() / 2;
+		result.medianNs = samples.Size() % 2 ? samples[middle] : 0.5 * (samples[middle - 1] + samples[middle]);
+		result.minNs = samples[0];
+
+		double sum = 0.0;
+		for (double sample : samples)
+		{
+			sum += sample;
+		}
+		result.meanNs = sum / samples.Size();
+
+		double variance = 0.0;
+		for (double sample : samples)
+		{
+			variance += (sample - result.meanNs) * (sample - result.meanNs);
+		}
+		result.stdDevNs = std::sqrt(variance / samples.Size());
+		return result;
+	}
+
+	BenchmarkRegistrar::BenchmarkRegistrar(const char* name, BenchmarkFunc func, std::initializer_list<uint64> args)
+	{
+		for (uint64 arg : args)
+		{
+			char fullName[256];
+			std::snprintf(fullName, sizeof(fullName), "%s/%llu", name, static_cast<unsigned long long>(arg));
+			BenchmarkRegistry::Instance().Register(fullName, func, arg);
+		}
+	}
+
+	bool BenchmarkReport::WriteJson(const char* filePath, const Array<BenchmarkResult>& results)
+	{
+		String json = "{\n\"benchmarks\": [\n";
+		char line[512];
+		for (uint i = 0; i < results.Size(); ++i)
+		{
+			const BenchmarkResult& result = results[i];
+			std::snprintf(line, sizeof(line),
+				"{\"name\": \"%s\", \"medianNs\": %.4f, \"minNs\": %.4f, \"meanNs\": %.4f, \"stdDevNs\": %.4f, \"iterations\": %llu, \"samples\": %u, \"itemsPerSecond\": %.1f}%s\n",
+				result.name.c_str(), result.medianNs, result.minNs, result.meanNs, result.stdDevNs,
+				static_cast<unsigned long long>(result.iterations), result.sampleCount, GetItemsPerSecond(result), i + 1 < results.Size() ? "," : "");
+			json += line;
+		}
+		json += "]\n}\n";
+
+		FileStream stream(filePath, BinaryStream::Operation::Write);
+		return stream.Write(json.data(), json.size()) == json.size();
+	}
+
+	bool BenchmarkReport::ReadJson(const char* filePath, Array<BenchmarkResult>& results)
+	{
+		FILE* file = std::fopen(filePath, "rb");
+		if (!file)
+		{
+			return false;
+		}
+
+		static constexpr const char* c_NameKey = "\"name\": \"";
+		static constexpr const char* c_MedianKey = "\"medianNs\": ";
+
+		// Files are written by WriteJson() so every benchmark is on its own line
+		char line[512];
+		while (std::fgets(line, sizeof(line), file))
+		{
+			const char* name = std::strstr(line, c_NameKey);
+			const char* median = std::strstr(line, c_MedianKey);
+			if (!name || !median)
+			{
+				continue;
+			}
+
+			name += std::strlen(c_NameKey);
+			const char* nameEnd = std::strchr(name, '"');
+			if (!nameEnd)
+			{
+				continue;
+			}
+
+			BenchmarkResult result = {};
+			result.name = String(name, nameEnd - name);
+			result.medianNs = std::strtod(median + std::strlen(c_MedianKey), nullptr);
+			results.Add(result);
+		}
+
+		std::fclose(file);
+		return true;
+	}
+
+	uint BenchmarkReport::Compare(const Array<BenchmarkResult>& results, const Array<BenchmarkResult>& baseline, double thresholdPercent)
+	{
+		uint regressionCount = 0;
+		std::printf("\n%-48s %14s %14s %10s\n", "Benchmark", "Baseline (ns)", "Current (ns)", "Delta");
+		for (const BenchmarkResult& result : results)
+		{
+			const BenchmarkResult* base = nullptr;
+			for (const BenchmarkResult& candidate : baseline)
+			{
+				if (candidate.name == result.name)
+				{
+					base = &candidate;
+					break;
+				}
+			}
+
+			if (!base || base->medianNs <= 0.0)
+			{
+				std::printf("%-48s %14s %14.2f %10s\n", result.name.c_str(), "-", result.medianNs, "new");
+				continue;
+			}
+
+			const double delta = (result.medianNs - base->medianNs) / base->medianNs * 100.0;
+			const bool regressed = delta > thresholdPercent;
+			if (regressed)
+			{
+				regressionCount++;
+			}
+			std::printf("%-48s %14.2f %14.2f %+9.1f%%%s\n", result.name.c_str(), base->medianNs, result.medianNs, delta, regressed ? "  REGRESSION" : "");
+		}
+		return regressionCount;
+	}
+
+	void BenchmarkReport::Print(const Array<BenchmarkResult>& results)
+	{
+		std::printf("\n%-48s %14s %14s %14s %12s %14s\n", "Benchmark", "Median (ns)", "Min (ns)", "StdDev (ns)", "Iterations", "Rate (M/s)");
+		for (const BenchmarkResult& result : results)
+		{
+			char rate[32] = "-";
+			if (result.itemsPerIteration > 0)
+			{
+				std::snprintf(rate, sizeof(rate), "%.2f", GetItemsPerSecond(result) / 1000000.0);
+			}
+			std::printf("%-48s %14.2f %14.2f %14.2f %12llu %14s\n", result.name.c_str(), result.medianNs, result.minNs, result.stdDevNs,
+				static_cast<unsigned long long>(result.iterations), rate);
+		}
+	}
+
+	double BenchmarkReport::GetItemsPerSecond(const BenchmarkResult& result)
+	{
+		return result.medianNs > 0.0 ? static_cast<double>(result.itemsPerIteration) * 1000000000.0 / result.medianNs : 0.0;
+	}
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Containers/Array.h"
+#include "String/StringTypes.h"
+#include <chrono>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace tyr
+{
+	/// Passed to a benchmark function. The function runs its measured code GetIterations() times.
+	class BenchmarkState final
+	{
+	public:
+		BenchmarkState(uint64 iterations, uint64 arg)
+			: m_Iterations(iterations)
+			, m_Arg(arg)
+			, m_Start(std::chrono::steady_clock::now())
+			, m_ItemsPerIteration(0)
+			, m_Stopped(false)
+		{
+
+		}
+
+		uint64 GetIterations() const { return m_Iterations; }
+
+		/// Argument the benchmark was registered with. Zero if it has none.
+		uint64 GetArg() const { return m_Arg; }
+
+		/// Restarts the timer so that setup done before the call is not measured.
+		void StartTiming()
+		{
+			m_Stopped = false;
+			m_Start = std::chrono::steady_clock::now();
+		}
+
+		/// Stops the timer so that cleanup done after the call is not measured.
+		void StopTiming()
+		{
+			m_End = std::chrono::steady_clock::now();
+			m_Stopped = true;
+		}
+
+		/// Sets how many items, such as rays, one iteration processes so that the report includes a rate.
+		void SetItemsPerIteration(uint64 count) { m_ItemsPerIteration = count; }
+
+		uint64 GetItemsPerIteration() const { return m_ItemsPerIteration; }
+
+		double GetElapsedNanoseconds()
+		{
+			if (!m_Stopped)
+			{
+				StopTiming();
+			}
+			return std::chrono::duration<double, std::nano>(m_End - m_Start).count();
+		}
+
+	private:
+		uint64 m_Iterations;
+		uint64 m_Arg;
+		std::chrono::steady_clock::time_point m_Start;
+		std::chrono::steady_clock::time_point m_End;
+		uint64 m_ItemsPerIteration;
+		bool m_Stopped;
+	};
+
+	using BenchmarkFunc = void(*)(BenchmarkState&);
+
+	struct BenchmarkDesc
+	{
+		String name;
+		BenchmarkFunc func;
+		uint64 arg;
+	};
+
+	struct BenchmarkResult
+	{
+		String name;
+		uint64 iterations;
+		uint sampleCount;
+		// Statistics of the per-iteration time over all samples
+		double medianNs;
+		double minNs;
+		double meanNs;
+		double stdDevNs;
+		// Zero if the benchmark does not report a rate
+		uint64 itemsPerIteration;
+	};
+
+	struct BenchmarkConfig
+	{
+		// Substring a benchmark name must contain to run. Empty runs every benchmark.
+		String filter;
+		// Minimum time of one sample. Iterations are scaled until a sample takes at least this long.
+		double minSampleTimeMs = 10.0;
+		uint sampleCount = 10;
+	};
+
+	/// Registry and runner for the benchmarks.
+	class BenchmarkRegistry final
+	{
+	public:
+		static BenchmarkRegistry& Instance();
+
+		void Register(const char* name, BenchmarkFunc func, uint64 arg = 0);
+
+		Array<BenchmarkResult> Run(const BenchmarkConfig& config) const;
+
+		const Array<BenchmarkDesc>& GetBenchmarks() const { return m_Benchmarks; }
+
+	private:
+		BenchmarkResult RunBenchmark(const BenchmarkDesc& desc, const BenchmarkConfig& config) const;
+
+		Array<BenchmarkDesc> m_Benchmarks;
+	};
+
+	/// Functions for writing results and comparing them with a baseline.
+	class BenchmarkReport final
+	{
+	public:
+		/// Writes the results as JSON with one benchmark per line.
+		static bool WriteJson(const char* filePath, const Array<BenchmarkResult>& results);
+
+		/// Reads results written by WriteJson(). Only the name and median are read.
+		static bool ReadJson(const char* filePath, Array<BenchmarkResult>& results);
+
+		/// Prints the percent change of each benchmark's median from the baseline.
+		/// Returns the number of benchmarks that are slower than the baseline by more than thresholdPercent.
+		static uint Compare(const Array<BenchmarkResult>& results, const Array<BenchmarkResult>& baseline, double thresholdPercent);
+
+		static void Print(const Array<BenchmarkResult>& results);
+
+		/// Items processed per second at the median time. Zero if the benchmark does not report a rate.
+		static double GetItemsPerSecond(const BenchmarkResult& result);
+	};
+
+	struct BenchmarkRegistrar final
+	{
+		BenchmarkRegistrar(const char* name, BenchmarkFunc func)
+		{
+			BenchmarkRegistry::Instance().Register(name, func);
+		}
+
+		/// Registers the benchmark once per argument as name/arg.
+		BenchmarkRegistrar(const char* name, BenchmarkFunc func, std::initializer_list<uint64> args);
+	};
+
+	/// Deterministic xorshift generator so that every run uses the same data.
+	class BenchmarkRandom final
+	{
+	public:
+		BenchmarkRandom(uint64 seed = 0x9E3779B97F4A7C15ull)
+			: m_State(seed ? seed : 1)
+		{
+
+		}
+
+		uint64 Next()
+		{
+			m_State ^= m_State << 13;
+			m_State ^= m_State >> 7;
+			m_State ^= m_State << 17;
+			return m_State;
+		}
+
+		/// Returns a float in [min, max).
+		float NextFloat(float min, float max)
+		{
+			return min + (max - min) * static_cast<float>(Next() >> 40) / static_cast<float>(1ull << 24);
+		}
+
+	private:
+		uint64 m_State;
+	};
+
+	/// Stops the compiler from optimising away a value that is otherwise unused.
+	template<typename T>
+	TYR_FORCEINLINE void DoNotOptimize(const T& value)
+	{
+#if defined(_MSC_VER)
+		const volatile char* ptr = reinterpret_cast<const volatile char*>(&value);
+		(void)*ptr;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	/// Forces pending memory writes to be treated as observable.
+	TYR_FORCEINLINE void ClobberMemory()
+	{
+#if defined(_MSC_VER)
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+}
+
+#define TYR_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define TYR_BENCHMARK_CONCAT(a, b) TYR_BENCHMARK_CONCAT_INNER(a, b)
+
+/// Defines and registers a benchmark function taking a BenchmarkState& named state.
+#define TYR_BENCHMARK(name) \
+	static void name(::tyr::BenchmarkState& state); \
+	static ::tyr::BenchmarkRegistrar TYR_BENCHMARK_CONCAT(s_Registrar, name)(#name, name); \
+	static void name(::tyr::BenchmarkState& state)
+
+/// Like TYR_BENCHMARK but registered once for each argument in the braced list.
+#define TYR_BENCHMARK_ARGS(name, ...) \
+	static void name(::tyr::BenchmarkState& state); \
+	static ::tyr::BenchmarkRegistrar TYR_BENCHMARK_CONCAT(s_Registrar, name)(#name, name, __VA_ARGS__); \
+	static void name(::tyr::BenchmarkState& state)
@@ -0,0 +1,213 @@
+#include "Benchmark.h"
+#include "LinearProbingHashMap.h"
+#include "Containers/Array.h"
+#include "Containers/HashMap.h"
+#include "Containers/LocalArray.h"
+#include "Containers/SPSCRingBuffer.h"
+
+namespace tyr
+{
+	namespace
+	{
+		static constexpr uint c_ElementCount = 4096;
+
+		Array<uint64> CreateKeys(uint count, uint64 seed)
+		{
+			BenchmarkRandom random(seed);
+			Array<uint64> keys;
+			keys.Reserve(count);
+			for (uint i = 0; i < count; ++i)
+			{
+				keys.Add(random.Next());
+			}
+			return keys;
+		}
+
+		template<typename Map>
+		void InsertKeys(BenchmarkState& state)
+		{
+			const uint count = static_cast<uint>(state.GetArg());
+			const Array<uint64> keys = CreateKeys(count, 1);
+			state.StartTiming();
+			for (uint64 i = 0; i < state.GetIterations(); ++i)
+			{
+				Map map;
+				for (uint64 key : keys)
+				{
+					map.Insert(key, key);
+				}
+				DoNotOptimize(map);
+			}
+		}
+
+		template<typename Map>
+		void FindKeys(BenchmarkState& state, bool hit)
+		{
+			const uint count = static_cast<uint>(state.GetArg());
+			const Array<uint64> keys = CreateKeys(count, 1);
+			const Array<uint64> missingKeys = CreateKeys(count, 2);
+			Map map;
+			for (uint64 key : keys)
+			{
+				map.Insert(key, key);
+			}
+
+			const Array<uint64>& lookups = hit ? keys : missingKeys;
+			state.StartTiming();
+			for (uint64 i = 0; i < state.GetIterations(); ++i)
+			{
+				const uint64* value = map.Find(lookups[static_cast<uint>(i % count)]);
+				DoNotOptimize(value);
+			}
+		}
+
+		template<typename Map>
+		void EraseAndInsertKeys(BenchmarkState& state)
+		{
+			// Churn at a steady size, which is where tombstones build up
+			const uint count = static_cast<uint>(state.GetArg());
+			const Array<uint64> keys = CreateKeys(count, 1);
+			const Array<uint64> replacementKeys = CreateKeys(count, 3);
+			Map map;
+			for (uint64 key : keys)
+			{
+				map.Insert(key, key);
+			}
+
+			state.StartTiming();
+			for (uint64 i = 0; i < state.GetIterations(); ++i)
+			{
+				const uint index = static_cast<uint>(i % count);
+				const bool even = (i / count) % 2 == 0;
+				map.Erase(even ? keys[index] : replacementKeys[index]);
+				map.Insert(even ? replacementKeys[index] : keys[index], i);
+			}
+			DoNotOptimize(map);
+		}
+	}
+
+	TYR_BENCHMARK(ArrayAdd)
+	{
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Array<uint> array;
+			for (uint j = 0; j < c_ElementCount; ++j)
+			{
+				array.Add(j);
+			}
+			DoNotOptimize(array.Data());
+		}
+	}
+
+	TYR_BENCHMARK(ArrayAddReserved)
+	{
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Array<uint> array;
+			array.Reserve(c_ElementCount);
+			for (uint j = 0; j < c_ElementCount; ++j)
+			{
+				array.Add(j);
+			}
+			DoNotOptimize(array.Data());
+		}
+	}
+
+	TYR_BENCHMARK(ArrayIterate)
+	{
+		Array<uint> array;
+		for (uint j = 0; j < c_ElementCount; ++j)
+		{
+			array.Add(j);
+		}
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			uint64 sum = 0;
+			for (uint value : array)
+			{
+				sum += value;
+			}
+			DoNotOptimize(sum);
+		}
+	}
+
+	TYR_BENCHMARK(LocalArrayAdd)
+	{
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			LocalArray<uint, c_ElementCount> array;
+			for (uint j = 0; j < c_ElementCount; ++j)
+			{
+				array.Add(j);
+			}
+			DoNotOptimize(array);
+		}
+	}
+
+	TYR_BENCHMARK_ARGS(HashMapInsert, { 1024, 65536 })
+	{
+		InsertKeys<HashMap<uint64, uint64>>(state);
+	}
+
+	TYR_BENCHMARK_ARGS(LinearProbingHashMapInsert, { 1024, 65536 })
+	{
+		InsertKeys<LinearProbingHashMap<uint64, uint64>>(state);
+	}
+
+	TYR_BENCHMARK_ARGS(HashMapFindHit, { 1024, 65536 })
+	{
+		FindKeys<HashMap<uint64, uint64>>(state, true);
+	}
+
+	TYR_BENCHMARK_ARGS(LinearProbingHashMapFindHit, { 1024, 65536 })
+	{
+		FindKeys<LinearProbingHashMap<uint64, uint64>>(state, true);
+	}
+
+	TYR_BENCHMARK_ARGS(HashMapFindMiss, { 1024, 65536 })
+	{
+		FindKeys<HashMap<uint64, uint64>>(state, false);
+	}
+
+	TYR_BENCHMARK_ARGS(LinearProbingHashMapFindMiss, { 1024, 65536 })
+	{
+		FindKeys<LinearProbingHashMap<uint64, uint64>>(state, false);
+	}
+
+	TYR_BENCHMARK_ARGS(HashMapEraseInsert, { 1024, 65536 })
+	{
+		EraseAndInsertKeys<HashMap<uint64, uint64>>(state);
+	}
+
+	TYR_BENCHMARK_ARGS(LinearProbingHashMapEraseInsert, { 1024, 65536 })
+	{
+		EraseAndInsertKeys<LinearProbingHashMap<uint64, uint64>>(state);
+	}
+
+	TYR_BENCHMARK(SPSCRingBufferEnqueueRead)
+	{
+		static constexpr uint c_Capacity = 1024;
+		SPSCRingBuffer<uint64, c_Capacity>* buffer = new SPSCRingBuffer<uint64, c_Capacity>();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			// Fill most of the buffer and drain it so both wrap around
+			for (uint j = 0; j < c_Capacity - 1; ++j)
+			{
+				buffer->Enqueue(j);
+			}
+			uint64 sum = 0;
+			while (Optional<uint64> value = buffer->Read())
+			{
+				sum += *value;
+			}
+			DoNotOptimize(sum);
+		}
+		state.StopTiming();
+
+		delete buffer;
+	}
+}
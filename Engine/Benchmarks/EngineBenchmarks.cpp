@@ -0,0 +1,188 @@
+#include "Benchmark.h"
+#include "Components/TransformHierarchy.h"
+#include "ECS/EntityManager.h"
+#include "World/RenderScene.h"
+#include "Rendering/SceneMirror.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// Every hundredth node is a root with the rest spread over a few levels below it
+		static constexpr uint c_NodesPerRoot = 100;
+		static constexpr uint c_ChildrenPerNode = 4;
+
+		void CreateHierarchy(TransformHierarchy& hierarchy, uint nodeCount, Array<uint>& handles)
+		{
+			handles.Reserve(nodeCount);
+			for (uint i = 0; i < nodeCount; ++i)
+			{
+				Transform local;
+				local.position = Vector3(static_cast<float>(i % 7), static_cast<float>(i % 5), static_cast<float>(i % 3));
+				local.rotation = Quaternion::c_Identity;
+				local.scale = Vector3(1.0f, 1.0f, 1.0f);
+
+				const uint offset = i % c_NodesPerRoot;
+				const uint parent = offset == 0 ? TransformHierarchy::c_InvalidHandle : handles[i - offset + (offset - 1) / c_ChildrenPerNode];
+				handles.Add(hierarchy.AddNode(local, parent));
+			}
+			hierarchy.Update();
+		}
+
+		void BenchmarkTransformUpdate(BenchmarkState& state, uint dirtyInterval)
+		{
+			const uint nodeCount = static_cast<uint>(state.GetArg());
+			TransformHierarchy hierarchy;
+			Array<uint> handles;
+			CreateHierarchy(hierarchy, nodeCount, handles);
+			state.SetItemsPerIteration(nodeCount);
+
+			// Marking nodes dirty is part of the update's cost so it is timed too
+			state.StartTiming();
+			for (uint64 i = 0; i < state.GetIterations(); ++i)
+			{
+				for (uint node = static_cast<uint>(i % dirtyInterval); node < nodeCount; node += dirtyInterval)
+				{
+					hierarchy.SetLocal(handles[node], hierarchy.GetLocal(handles[node]));
+				}
+				hierarchy.Update();
+				DoNotOptimize(hierarchy.GetWorldMatrices());
+			}
+			state.StopTiming();
+		}
+
+		// Sends a frame's changes to a mirror of the scene the way the world manager and renderer do
+		void SendRenderSceneDelta(RenderScene& scene, SceneMirror& mirror, SceneDelta& delta)
+		{
+			FrameAllocator::BeginFrame(FrameAllocator::GetFrameIndex() + 1);
+			delta.Clear();
+			scene.WriteDelta(delta);
+			mirror.Apply(delta);
+			scene.ClearChanges();
+		}
+
+		void BenchmarkRenderSceneDelta(BenchmarkState& state, uint modifyInterval)
+		{
+			const uint instanceCount = static_cast<uint>(state.GetArg());
+			RenderScene scene;
+			SceneMirror mirror;
+			SceneDelta delta;
+			Array<SceneObjectId> ids;
+			ids.Reserve(instanceCount);
+			RigidMeshInstance instance;
+			instance.meshIndex = 0;
+			instance.transform = Matrix4::c_Identity;
+			instance.material = nullptr;
+			for (uint i = 0; i < instanceCount; ++i)
+			{
+				ids.Add(scene.GetRigidMeshInstances().Create(instance));
+			}
+			SendRenderSceneDelta(scene, mirror, delta);
+			state.SetItemsPerIteration(instanceCount);
+
+			state.StartTiming();
+			for (uint64 i = 0; i < state.GetIterations(); ++i)
+			{
+				if (modifyInterval)
+				{
+					for (uint id = static_cast<uint>(i % modifyInterval); id < instanceCount; id += modifyInterval)
+					{
+						scene.GetRigidMeshInstances().Modify(ids[id]).transform[3][0] = static_cast<float>(i);
+					}
+				}
+				SendRenderSceneDelta(scene, mirror, delta);
+			}
+			state.StopTiming();
+			DoNotOptimize(mirror.rigidMeshInstances.GetObjects());
+		}
+
+		struct PositionComponent
+		{
+			Vector3 value;
+		};
+
+		struct VelocityComponent
+		{
+			Vector3 value;
+		};
+
+		struct StaticTag { };
+
+		struct SelectedTag { };
+
+		// Integrates the velocity of every moving entity. Entities are spread over four archetypes, one of which the
+		// query excludes, so the query walks several archetypes' chunks.
+		template<bool Parallel>
+		void BenchmarkEntityQuery(BenchmarkState& state)
+		{
+			const uint entityCount = static_cast<uint>(state.GetArg());
+			EntityManager manager;
+			const ComponentMask mask = GetComponentMask<PositionComponent, VelocityComponent>();
+			uint movingCount = 0;
+			Entity first = c_InvalidEntity;
+			for (uint i = 0; i < entityCount; ++i)
+			{
+				ComponentMask entityMask = mask;
+				entityMask |= (i & 1) ? GetComponentMask<SelectedTag>() : 0;
+				entityMask |= (i & 2) ? GetComponentMask<StaticTag>() : 0;
+				const Entity entity = manager.CreateEntity(entityMask);
+				manager.GetComponent<VelocityComponent>(entity).value = Vector3(static_cast<float>(i % 7), 1.0f, 0.5f);
+				movingCount += (i & 2) ? 0 : 1;
+				first = i == 0 ? entity : first;
+			}
+
+			EntityQuery query(manager, mask, GetComponentMask<StaticTag>());
+			const auto integrate = [](Entity, PositionComponent& position, VelocityComponent& velocity)
+			{
+				position.value += velocity.value * (1.0f / 60.0f);
+			};
+			state.SetItemsPerIteration(movingCount);
+
+			state.StartTiming();
+			for (uint64 i = 0; i < state.GetIterations(); ++i)
+			{
+				if constexpr (Parallel)
+				{
+					query.ParallelForEach<PositionComponent, VelocityComponent>(integrate);
+				}
+				else
+				{
+					query.ForEach<PositionComponent, VelocityComponent>(integrate);
+				}
+			}
+			state.StopTiming();
+			DoNotOptimize(manager.GetComponent<PositionComponent>(first).value);
+		}
+	}
+
+	TYR_BENCHMARK_ARGS(TransformUpdateAllDirty, { 10000, 100000, 1000000 })
+	{
+		BenchmarkTransformUpdate(state, 1);
+	}
+
+	TYR_BENCHMARK_ARGS(TransformUpdateOnePercentDirty, { 10000, 100000, 1000000 })
+	{
+		// A stride that doesn't divide c_NodesPerRoot spreads the dirty nodes over every depth instead of only roots
+		BenchmarkTransformUpdate(state, 101);
+	}
+
+	TYR_BENCHMARK_ARGS(RenderSceneDeltaStatic, { 10000, 100000, 1000000 })
+	{
+		BenchmarkRenderSceneDelta(state, 0);
+	}
+
+	TYR_BENCHMARK_ARGS(RenderSceneDeltaOnePercentModified, { 10000, 100000, 1000000 })
+	{
+		BenchmarkRenderSceneDelta(state, 100);
+	}
+
+	TYR_BENCHMARK_ARGS(EntityQueryForEach, { 100000, 1000000 })
+	{
+		BenchmarkEntityQuery<false>(state);
+	}
+
+	TYR_BENCHMARK_ARGS(EntityQueryParallelForEach, { 100000, 1000000 })
+	{
+		BenchmarkEntityQuery<true>(state);
+	}
+}
@@ -0,0 +1,232 @@
+#include "Benchmark.h"
+#include "Geometry/Frustum.h"
+#include "Geometry/SpatialIndex.h"
+#include "Geometry/TriangleMeshBVH.h"
+#include "Math/Math.h"
+#include "Math/Matrix4.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// 2 million triangles
+		static constexpr uint c_TerrainSize = 1024;
+		// Rays are cast from a camera above the terrain through an image of this size
+		static constexpr uint c_ImageWidth = 128;
+		static constexpr uint c_ImageHeight = 128;
+		static constexpr uint c_RayCount = c_ImageWidth * c_ImageHeight;
+		static constexpr float c_MaxRayDistance = 10000.0f;
+		// Instances are spread over a square of this size on the XZ plane
+		static constexpr uint c_InstanceCount = 100000;
+		static constexpr float c_InstanceAreaSize = 8192.0f;
+
+		struct TerrainMesh
+		{
+			Array<Vector3> vertices;
+			Array<uint> indices;
+		};
+
+		// Height field of quads split into two triangles each
+		TerrainMesh CreateTerrain(uint size)
+		{
+			TerrainMesh mesh;
+			const uint rowLength = size + 1;
+			mesh.vertices.Reserve(rowLength * rowLength);
+			for (uint z = 0; z <= size; ++z)
+			{
+				for (uint x = 0; x <= size; ++x)
+				{
+					const float height = Math::Sin(x * 0.05f) * Math::Cos(z * 0.07f) * 8.0f;
+					mesh.vertices.Add(Vector3(static_cast<float>(x), height, static_cast<float>(z)));
+				}
+			}
+
+			mesh.indices.Reserve(size * size * 6);
+			for (uint z = 0; z < size; ++z)
+			{
+				for (uint x = 0; x < size; ++x)
+				{
+					const uint corner = z * rowLength + x;
+					mesh.indices.Add(corner);
+					mesh.indices.Add(corner + 1);
+					mesh.indices.Add(corner + rowLength);
+					mesh.indices.Add(corner + 1);
+					mesh.indices.Add(corner + rowLength + 1);
+					mesh.indices.Add(corner + rowLength);
+				}
+			}
+			return mesh;
+		}
+
+		struct RayScene
+		{
+			TriangleMeshBVH bvh;
+			Ray rays[c_RayCount];
+			// The rays of 2x4 pixel tiles
+			RayPacket8 packets[c_RayCount / RayPacket8::c_RayCount];
+		};
+
+		// Building the large terrain takes a while so it is shared by every run of the ray benchmarks
+		const RayScene& GetRayScene()
+		{
+			static const RayScene* scene = []()
+			{
+				RayScene* result = new RayScene();
+				const TerrainMesh mesh = CreateTerrain(c_TerrainSize);
+				result->bvh.Build(mesh.vertices.Data(), mesh.indices.Data(), mesh.indices.Size() / 3);
+
+				const Vector3 origin(c_TerrainSize * 0.5f, 300.0f, -200.0f);
+				uint packetIndex = 0;
+				for (uint tileY = 0; tileY < c_ImageHeight; tileY += 2)
+				{
+					for (uint tileX = 0; tileX < c_ImageWidth; tileX += 4)
+					{
+						RayPacket8& packet = result->packets[packetIndex++];
+						for (uint i = 0; i < RayPacket8::c_RayCount; ++i)
+						{
+							const uint x = tileX + i % 4;
+							const uint y = tileY + i / 4;
+							const Vector3 target(c_TerrainSize * (x + 0.5f) / c_ImageWidth, 0.0f, c_TerrainSize * (y + 0.5f) / c_ImageHeight);
+							Vector3 direction = target - origin;
+							direction.Normalize();
+
+							const Ray ray(origin, direction);
+							result->rays[y * c_ImageWidth + x] = ray;
+							packet.SetRay(i, ray, c_MaxRayDistance);
+						}
+					}
+				}
+				return result;
+			}();
+			return *scene;
+		}
+
+		// Fills the index with small boxes on a jittered grid and writes their handles to handles
+		URef<SpatialIndex> CreateInstanceIndex(SpatialIndexType type, Array<uint>& handles)
+		{
+			SpatialIndexDesc desc;
+			desc.type = type;
+			desc.octreeHalfSize = c_InstanceAreaSize * 0.5f;
+			URef<SpatialIndex> index = SpatialIndex::Create(desc);
+
+			const uint rowLength = static_cast<uint>(Math::Sqrt(static_cast<float>(c_InstanceCount)));
+			const float spacing = c_InstanceAreaSize / rowLength;
+			handles.Reserve(c_InstanceCount);
+			for (uint i = 0; i < c_InstanceCount; ++i)
+			{
+				const float x = (i % rowLength + 0.5f + Math::Sin(i * 1.3f) * 0.4f) * spacing - c_InstanceAreaSize * 0.5f;
+				const float z = (i / rowLength + 0.5f + Math::Cos(i * 0.7f) * 0.4f) * spacing - c_InstanceAreaSize * 0.5f;
+				const Vector3 extents(1.0f + (i % 7), 2.0f + (i % 5), 1.0f + (i % 3));
+				handles.Add(index->Insert(AABB::FromCentreExtents(Vector3(x, extents.y, z), extents), i));
+			}
+			return index;
+		}
+	}
+
+	TYR_BENCHMARK_ARGS(BVHBuildTriangles, { 64, 512 })
+	{
+		const TerrainMesh mesh = CreateTerrain(static_cast<uint>(state.GetArg()));
+		const uint triangleCount = mesh.indices.Size() / 3;
+		state.SetItemsPerIteration(triangleCount);
+
+		TriangleMeshBVH bvh;
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			bvh.Build(mesh.vertices.Data(), mesh.indices.Data(), triangleCount);
+			DoNotOptimize(bvh.GetBVH().GetNodes().Data());
+		}
+		state.StopTiming();
+	}
+
+	TYR_BENCHMARK(BVHRaycast)
+	{
+		const RayScene& scene = GetRayScene();
+		state.SetItemsPerIteration(c_RayCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (const Ray& ray : scene.rays)
+			{
+				RayHit hit;
+				const bool found = scene.bvh.Raycast(ray, c_MaxRayDistance, hit);
+				DoNotOptimize(found);
+				DoNotOptimize(hit);
+			}
+		}
+		state.StopTiming();
+	}
+
+	TYR_BENCHMARK(BVHRaycastPacket)
+	{
+		const RayScene& scene = GetRayScene();
+		state.SetItemsPerIteration(c_RayCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (const RayPacket8& packet : scene.packets)
+			{
+				RayHit hits[RayPacket8::c_RayCount];
+				const uint hitMask = scene.bvh.Raycast(packet, hits);
+				DoNotOptimize(hitMask);
+				DoNotOptimize(hits);
+			}
+		}
+		state.StopTiming();
+	}
+
+	TYR_BENCHMARK(BVHRaycastAnyPacket)
+	{
+		const RayScene& scene = GetRayScene();
+		state.SetItemsPerIteration(c_RayCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (const RayPacket8& packet : scene.packets)
+			{
+				const uint hitMask = scene.bvh.RaycastAny(packet);
+				DoNotOptimize(hitMask);
+			}
+		}
+		state.StopTiming();
+	}
+
+	TYR_BENCHMARK_ARGS(SpatialIndexFrustumQuery, { static_cast<uint64>(SpatialIndexType::LooseOctree), static_cast<uint64>(SpatialIndexType::HashGrid) })
+	{
+		Array<uint> handles;
+		const URef<SpatialIndex> index = CreateInstanceIndex(static_cast<SpatialIndexType>(state.GetArg()), handles);
+		const Matrix4 view = Matrix4::CreateView(Vector3(0.0f, 50.0f, 0.0f), Vector3::Normalize(Vector3(0.3f, -0.1f, 1.0f)), Vector3::c_Up);
+		const Frustum frustum(view * Matrix4::CreatePerspective(60.0f, 16.0f / 9.0f, 0.5f, 2000.0f));
+		state.SetItemsPerIteration(c_InstanceCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const std::span<const uint> visible = index->QueryFrustum(frustum);
+			DoNotOptimize(visible.data());
+		}
+		state.StopTiming();
+	}
+
+	TYR_BENCHMARK_ARGS(SpatialIndexMove, { static_cast<uint64>(SpatialIndexType::LooseOctree), static_cast<uint64>(SpatialIndexType::HashGrid) })
+	{
+		Array<uint> handles;
+		const URef<SpatialIndex> index = CreateInstanceIndex(static_cast<SpatialIndexType>(state.GetArg()), handles);
+		state.SetItemsPerIteration(c_InstanceCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const Vector3 offset((i & 1) ? -0.5f : 0.5f, 0.0f, 0.0f);
+			for (uint handle : handles)
+			{
+				const AABB& bounds = index->GetBounds(handle);
+				index->Move(handle, AABB(bounds.GetMin() + offset, bounds.GetMax() + offset));
+			}
+		}
+		state.StopTiming();
+	}
+}
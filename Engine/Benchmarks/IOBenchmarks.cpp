@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+#include "IO/BufferedFileStream.h"
+#include "Platform/Platform.h"
+#include "Reflection/Reflection.h"
+
+namespace tyr
+{
+	struct BenchmarkRecord
+	{
+		uint id;
+		float weight;
+		uint64 timestamp;
+		uint8 flags;
+	};
+
+	namespace
+	{
+		// Internal linkage as the meta class instance is named by line number and could clash with another file's
+		TYR_REFL_CLASS_START(BenchmarkRecord, 0);
+			TYR_REFL_FIELD(&BenchmarkRecord::id, "ID", true, true, true);
+			TYR_REFL_FIELD(&BenchmarkRecord::weight, "Weight", true, true, true);
+			TYR_REFL_FIELD(&BenchmarkRecord::timestamp, "Timestamp", true, true, true);
+			TYR_REFL_FIELD(&BenchmarkRecord::flags, "Flags", true, true, true);
+		TYR_REFL_CLASS_END();
+
+		static constexpr uint c_RecordCount = 4096;
+		static constexpr size_t c_StreamBufferSize = 64 * 1024;
+		static constexpr size_t c_FileSize = 4 * 1024 * 1024;
+
+		String GetTempFilePath(const char* fileName)
+		{
+			return Platform::c_BinaryDirectory + "/" + fileName;
+		}
+	}
+
+	TYR_BENCHMARK(SerializerRoundTrip)
+	{
+		Array<BenchmarkRecord> records;
+		records.Resize(c_RecordCount);
+		BenchmarkRandom random;
+		for (uint i = 0; i < c_RecordCount; ++i)
+		{
+			records[i].id = i;
+			records[i].weight = random.NextFloat(0.0f, 1.0f);
+			records[i].timestamp = random.Next();
+			records[i].flags = static_cast<uint8>(i);
+		}
+
+		const String filePath = GetTempFilePath("SerializerBenchmark.bin");
+		Serializer& serializer = Serializer::Instance();
+		Array<BenchmarkRecord> loadedRecords;
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			serializer.SerializeToFile(filePath.c_str(), records);
+			loadedRecords.Clear();
+			serializer.DeserializeFromFile(filePath.c_str(), loadedRecords);
+			DoNotOptimize(loadedRecords.Data());
+		}
+		state.StopTiming();
+
+		TYR_ASSERT(loadedRecords.Size() == c_RecordCount && loadedRecords.Back().timestamp == records.Back().timestamp);
+	}
+
+	TYR_BENCHMARK_ARGS(BufferedFileStreamWrite, { 16, 4096 })
+	{
+		// The argument is the size of each write
+		const size_t writeSize = static_cast<size_t>(state.GetArg());
+		Array<uint8> data;
+		data.Resize(static_cast<uint>(writeSize));
+		Array<uint8> streamBuffer;
+		streamBuffer.Resize(c_StreamBufferSize);
+		const String filePath = GetTempFilePath("StreamBenchmark.bin");
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			BufferedFileStream stream(streamBuffer.Data(), c_StreamBufferSize, filePath.c_str(), BinaryStream::Operation::Write);
+			for (size_t written = 0; written < c_FileSize; written += writeSize)
+			{
+				stream.Write(data.Data(), writeSize);
+			}
+		}
+	}
+
+	TYR_BENCHMARK_ARGS(BufferedFileStreamRead, { 16, 4096 })
+	{
+		const size_t readSize = static_cast<size_t>(state.GetArg());
+		Array<uint8> data;
+		data.Resize(static_cast<uint>(readSize));
+		Array<uint8> streamBuffer;
+		streamBuffer.Resize(c_StreamBufferSize);
+		const String filePath = GetTempFilePath("StreamBenchmark.bin");
+		{
+			BufferedFileStream stream(streamBuffer.Data(), c_StreamBufferSize, filePath.c_str(), BinaryStream::Operation::Write);
+			for (size_t written = 0; written < c_FileSize; written += readSize)
+			{
+				stream.Write(data.Data(), readSize);
+			}
+		}
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			BufferedFileStream stream(streamBuffer.Data(), c_StreamBufferSize, filePath.c_str(), BinaryStream::Operation::Read);
+			for (size_t read = 0; read < c_FileSize; read += readSize)
+			{
+				stream.Read(data.Data(), readSize);
+			}
+			DoNotOptimize(data.Data());
+		}
+	}
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Math.h"
+
+namespace tyr
+{
+    /// The linear probing hash map that HashMap replaced, kept as the baseline for the HashMap benchmarks.
+    /// Uses linear probing for collisions and keeps the load factor at 50% max.
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class LinearProbingHashMap
+    {
+    private:
+        struct Bucket
+        {
+            Key key;
+            Value value;
+            bool occupied = false;
+            bool deleted = false;
+        };
+
+        Array<Bucket> m_Buckets;
+        uint m_Capacity;
+        uint m_Size;
+
+        uint ProbeIndex(uint hash, uint i) const
+        {
+            return (hash + i) & (m_Capacity - 1);
+        }
+
+        void Rehash(uint newCapacity)
+        {
+            Array<Bucket> newBuckets;
+            newBuckets.Resize(newCapacity);
+            for (uint i = 0; i < newCapacity; ++i)
+            {
+                newBuckets[i].occupied = false;
+                newBuckets[i].deleted = false;
+            }
+
+            for (uint i = 0; i < m_Capacity; ++i)
+            {
+                if (m_Buckets[i].occupied && !m_Buckets[i].deleted)
+                {
+                    const uint hash = static_cast<uint>(Hash{}(m_Buckets[i].key));
+                    for (uint j = 0; j < newCapacity; ++j)
+                    {
+                        const uint index = (hash + j) & (newCapacity - 1);
+                        if (!newBuckets[index].occupied)
+                        {
+                            newBuckets[index].key = m_Buckets[i].key;
+                            newBuckets[index].value = m_Buckets[i].value;
+                            newBuckets[index].occupied = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            m_Buckets = std::move(newBuckets);
+            m_Capacity = newCapacity;
+        }
+
+        void EnsureCapacity(uint requiredSize)
+        {
+            const uint requiredCapacity = requiredSize * 2;
+            if (requiredCapacity > m_Capacity)
+            {
+                Rehash(Math::NextPowerOfTwo(requiredCapacity));
+            }
+        }
+
+    public:
+        LinearProbingHashMap(uint capacity = 8)
+            : m_Capacity(Math::NextPowerOfTwo(capacity))
+            , m_Size(0)
+        {
+            m_Buckets.Resize(m_Capacity);
+            for (uint i = 0; i < m_Capacity; ++i)
+            {
+                m_Buckets[i].occupied = false;
+                m_Buckets[i].deleted = false;
+            }
+        }
+
+        void Insert(const Key& key, const Value& value)
+        {
+            EnsureCapacity(m_Size + 1);
+            const uint hash = static_cast<uint>(Hash{}(key));
+            for (uint i = 0; i < m_Capacity; ++i)
+            {
+                Bucket& bucket = m_Buckets[ProbeIndex(hash, i)];
+                if (bucket.occupied && !bucket.deleted && bucket.key == key)
+                {
+                    bucket.value = value;
+                    return;
+                }
+
+                if (!bucket.occupied || bucket.deleted)
+                {
+                    bucket.key = key;
+                    bucket.value = value;
+                    bucket.occupied = true;
+                    bucket.deleted = false;
+                    ++m_Size;
+                    return;
+                }
+            }
+        }
+
+        const Value* Find(const Key& key) const
+        {
+            const uint hash = static_cast<uint>(Hash{}(key));
+            for (uint i = 0; i < m_Capacity; ++i)
+            {
+                const Bucket& bucket = m_Buckets[ProbeIndex(hash, i)];
+                if (!bucket.occupied && !bucket.deleted)
+                {
+                    return nullptr;
+                }
+
+                if (bucket.occupied && !bucket.deleted && bucket.key == key)
+                {
+                    return &bucket.value;
+                }
+            }
+            return nullptr;
+        }
+
+        void Erase(const Key& key)
+        {
+            const uint hash = static_cast<uint>(Hash{}(key));
+            for (uint i = 0; i < m_Capacity; ++i)
+            {
+                Bucket& bucket = m_Buckets[ProbeIndex(hash, i)];
+                if (!bucket.occupied && !bucket.deleted)
+                {
+                    return;
+                }
+
+                if (bucket.occupied && !bucket.deleted && bucket.key == key)
+                {
+                    bucket.deleted = true;
+                    --m_Size;
+                    return;
+                }
+            }
+        }
+
+        void Reserve(uint n)
+        {
+            EnsureCapacity(n);
+        }
+
+        uint Size() const { return m_Size; }
+    };
+}
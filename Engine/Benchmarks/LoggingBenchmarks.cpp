@@ -0,0 +1,63 @@
+#include "Benchmark.h"
+#include "Logging/Logger.h"
+
+namespace tyr
+{
+	namespace
+	{
+		static constexpr uint c_MessageCount = 256;
+
+		// Keeps the formatting cost on the logging thread without any IO
+		class NullLogSink final : public LogSink
+		{
+		public:
+			void Write(const char* text, size_t size) override
+			{
+				DoNotOptimize(text);
+			}
+		};
+	}
+
+	// Flushes after each batch of messages so that none are dropped
+	TYR_BENCHMARK(LoggerLog)
+	{
+		Logger& logger = Logger::Instance();
+		LoggerConfig config;
+		config.logToConsole = false;
+		logger.AddSink(MakeURef<NullLogSink>());
+		logger.Initialize(config);
+
+		const LogSource source = { __FUNCTION__, __FILE__, __LINE__ };
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (uint j = 0; j < c_MessageCount; ++j)
+			{
+				logger.Log(LogLevel::Info, LogCategory::General, source, "Frame %u took %.3f ms for %s", j, 16.6f, "Benchmark");
+			}
+			logger.Flush();
+		}
+		state.StopTiming();
+
+		logger.Shutdown();
+	}
+
+	TYR_BENCHMARK(LoggerFiltered)
+	{
+		Logger& logger = Logger::Instance();
+		logger.SetLevel(LogCategory::General, LogLevel::Error);
+
+		const LogSource source = { __FUNCTION__, __FILE__, __LINE__ };
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (uint j = 0; j < c_MessageCount; ++j)
+			{
+				logger.Log(LogLevel::Info, LogCategory::General, source, "Frame %u took %.3f ms for %s", j, 16.6f, "Benchmark");
+			}
+		}
+		state.StopTiming();
+
+		logger.SetLevel(LogCategory::General, LogLevel::Info);
+	}
+}
@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+#include "Threading/JobSystem.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace tyr;
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::printf(
+			"Usage: TyrantBenchmarks [options]\n"
+			"  --filter <text>        Only run benchmarks whose name contains text\n"
+			"  --output <file>        Write results as JSON\n"
+			"  --baseline <file>      Compare results with a JSON file written by --output\n"
+			"  --threshold <percent>  Slowdown that counts as a regression (default 10)\n"
+			"  --fail-on-regression   Exit with failure if any benchmark regressed\n"
+			"  --min-time <ms>        Minimum time of one sample (default 10)\n"
+			"  --samples <count>      Samples per benchmark (default 10)\n"
+			"  --list                 List the benchmarks and exit\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkConfig config;
+	const char* outputPath = nullptr;
+	const char* baselinePath = nullptr;
+	double threshold = 10.0;
+	bool failOnRegression = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (std::strcmp(arg, "--filter") == 0 && hasValue)
+		{
+			config.filter = argv[++i];
+		}
+		else if (std::strcmp(arg, "--output") == 0 && hasValue)
+		{
+			outputPath = argv[++i];
+		}
+		else if (std::strcmp(arg, "--baseline") == 0 && hasValue)
+		{
+			baselinePath = argv[++i];
+		}
+		else if (std::strcmp(arg, "--threshold") == 0 && hasValue)
+		{
+			threshold = std::atof(argv[++i]);
+		}
+		else if (std::strcmp(arg, "--min-time") == 0 && hasValue)
+		{
+			config.minSampleTimeMs = std::atof(argv[++i]);
+		}
+		else if (std::strcmp(arg, "--samples") == 0 && hasValue)
+		{
+			config.sampleCount = std::max(1, std::atoi(argv[++i]));
+		}
+		else if (std::strcmp(arg, "--fail-on-regression") == 0)
+		{
+			failOnRegression = true;
+		}
+		else if (std::strcmp(arg, "--list") == 0)
+		{
+			for (const BenchmarkDesc& desc : BenchmarkRegistry::Instance().GetBenchmarks())
+			{
+				std::printf("%s\n", desc.name.c_str());
+			}
+			return EXIT_SUCCESS;
+		}
+		else
+		{
+			PrintUsage();
+			return std::strcmp(arg, "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	// Threading benchmarks use the job system like the engine does
+	JobSystem::Instance().Initialize(JobSystemConfig());
+
+	const Array<BenchmarkResult> results = BenchmarkRegistry::Instance().Run(config);
+
+	JobSystem::Instance().Shutdown();
+
+	BenchmarkReport::Print(results);
+
+	if (outputPath && !BenchmarkReport::WriteJson(outputPath, results))
+	{
+		std::printf("Failed to write results to %s\n", outputPath);
+		return EXIT_FAILURE;
+	}
+
+	if (baselinePath)
+	{
+		Array<BenchmarkResult> baseline;
+		if (!BenchmarkReport::ReadJson(baselinePath, baseline))
+		{
+			std::printf("\nNo baseline found at %s\n", baselinePath);
+			return EXIT_SUCCESS;
+		}
+
+		const uint regressionCount = BenchmarkReport::Compare(results, baseline, threshold);
+		std::printf("\n%u benchmark(s) regressed by more than %.1f%%\n", regressionCount, threshold);
+		if (failOnRegression && regressionCount > 0)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,363 @@
+#include "Benchmark.h"
+#include "Math/Matrix4.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3.h"
+#include "Math/Vector3SoA.h"
+#include "Math/Vector4.h"
+#include "Geometry/Frustum.h"
+#include "Memory/Allocation.h"
+#include "Identifiers/Hashing.h"
+
+namespace tyr
+{
+	namespace
+	{
+		static constexpr uint c_TransformCount = 1024;
+
+		struct Transforms
+		{
+			Vector3 translations[c_TransformCount];
+			Quaternion rotations[c_TransformCount];
+			Vector3 scales[c_TransformCount];
+			Matrix4 matrices[c_TransformCount];
+		};
+
+		Transforms* CreateTransforms()
+		{
+			BenchmarkRandom random;
+			Transforms* transforms = new Transforms();
+			for (uint i = 0; i < c_TransformCount; ++i)
+			{
+				transforms->translations[i] = Vector3(random.NextFloat(-100.0f, 100.0f), random.NextFloat(-100.0f, 100.0f), random.NextFloat(-100.0f, 100.0f));
+				Quaternion rotation(random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f));
+				rotation.Normalize();
+				transforms->rotations[i] = rotation;
+				transforms->scales[i] = Vector3(random.NextFloat(0.5f, 2.0f), random.NextFloat(0.5f, 2.0f), random.NextFloat(0.5f, 2.0f));
+				transforms->matrices[i] = Matrix4::CreateTRS(transforms->translations[i], transforms->rotations[i], transforms->scales[i]);
+			}
+			return transforms;
+		}
+	}
+
+	TYR_BENCHMARK(Matrix4Multiply)
+	{
+		Transforms* transforms = CreateTransforms();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const uint index = static_cast<uint>(i % (c_TransformCount - 1));
+			const Matrix4 result = transforms->matrices[index] * transforms->matrices[index + 1];
+			DoNotOptimize(result);
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Matrix4Inverse)
+	{
+		Transforms* transforms = CreateTransforms();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const Matrix4 result = transforms->matrices[i % c_TransformCount].Inverse();
+			DoNotOptimize(result);
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Matrix4InverseAffine)
+	{
+		Transforms* transforms = CreateTransforms();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const Matrix4 result = transforms->matrices[i % c_TransformCount].InverseAffine();
+			DoNotOptimize(result);
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Matrix4CreateTRS)
+	{
+		Transforms* transforms = CreateTransforms();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const uint index = static_cast<uint>(i % c_TransformCount);
+			const Matrix4 result = Matrix4::CreateTRS(transforms->translations[index], transforms->rotations[index], transforms->scales[index]);
+			DoNotOptimize(result);
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Matrix4MultiplyVector)
+	{
+		Transforms* transforms = CreateTransforms();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const uint index = static_cast<uint>(i % c_TransformCount);
+			const Vector4 point(transforms->translations[index].x, transforms->translations[index].y, transforms->translations[index].z, 1.0f);
+			const Vector4 result = transforms->matrices[index].Multiply(point);
+			DoNotOptimize(result);
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Matrix4MultiplyBatch)
+	{
+		Transforms* transforms = CreateTransforms();
+		Matrix4* output = new Matrix4[c_TransformCount];
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Matrix4::MultiplyBatch(transforms->matrices[i % c_TransformCount], transforms->matrices, output, c_TransformCount);
+			ClobberMemory();
+		}
+		state.StopTiming();
+
+		delete[] output;
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Matrix4CreateTRSBatch)
+	{
+		Transforms* transforms = CreateTransforms();
+		Matrix4* output = new Matrix4[c_TransformCount];
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Matrix4::CreateTRSBatch(transforms->translations, transforms->rotations, transforms->scales, output, c_TransformCount);
+			ClobberMemory();
+		}
+		state.StopTiming();
+
+		delete[] output;
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Matrix4TransformPoints)
+	{
+		Transforms* transforms = CreateTransforms();
+		Vector3* output = new Vector3[c_TransformCount];
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			transforms->matrices[i % c_TransformCount].TransformPoints(transforms->translations, output, c_TransformCount);
+			ClobberMemory();
+		}
+		state.StopTiming();
+
+		delete[] output;
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(QuaternionMultiply)
+	{
+		Transforms* transforms = CreateTransforms();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const uint index = static_cast<uint>(i % (c_TransformCount - 1));
+			const Quaternion result = transforms->rotations[index] * transforms->rotations[index + 1];
+			DoNotOptimize(result);
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(QuaternionRotate)
+	{
+		Transforms* transforms = CreateTransforms();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const uint index = static_cast<uint>(i % c_TransformCount);
+			const Vector3 result = transforms->rotations[index].Rotate(transforms->translations[index]);
+			DoNotOptimize(result);
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(QuaternionRotateBatch)
+	{
+		Transforms* transforms = CreateTransforms();
+		Vector3* output = new Vector3[c_TransformCount];
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Quaternion::RotateBatch(transforms->rotations, transforms->translations, output, c_TransformCount);
+			ClobberMemory();
+		}
+		state.StopTiming();
+
+		delete[] output;
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(QuaternionSlerp)
+	{
+		Transforms* transforms = CreateTransforms();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const uint index = static_cast<uint>(i % (c_TransformCount - 1));
+			const Quaternion result = Quaternion::Slerp(0.3f, transforms->rotations[index], transforms->rotations[index + 1]);
+			DoNotOptimize(result);
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Vector3SoACross)
+	{
+		Transforms* transforms = CreateTransforms();
+		Vector3SoA a;
+		Vector3SoA b;
+		Vector3SoA output;
+		a.FromAoS(transforms->translations, c_TransformCount);
+		b.FromAoS(transforms->scales, c_TransformCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Vector3SoA::Cross(a, b, output);
+			ClobberMemory();
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Vector3SoANormalize)
+	{
+		Transforms* transforms = CreateTransforms();
+		Vector3SoA a;
+		Vector3SoA output;
+		a.FromAoS(transforms->translations, c_TransformCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Vector3SoA::Normalize(a, output);
+			ClobberMemory();
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK(Vector3SoAFromAoS)
+	{
+		Transforms* transforms = CreateTransforms();
+		Vector3SoA output(c_TransformCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			output.FromAoS(transforms->translations, c_TransformCount);
+			ClobberMemory();
+		}
+		state.StopTiming();
+
+		delete transforms;
+	}
+
+	TYR_BENCHMARK_ARGS(FrustumCullSpheres, { 1024, 65536 })
+	{
+		const uint count = static_cast<uint>(state.GetArg());
+		BenchmarkRandom random;
+		Vector3SoA centres(count);
+		float* radii = static_cast<float*>(AllocAligned(centres.PaddedSize() * sizeof(float), Vector3SoA::c_Alignment));
+		for (uint i = 0; i < centres.PaddedSize(); ++i)
+		{
+			if (i < count)
+			{
+				centres.Set(i, Vector3(random.NextFloat(-500.0f, 500.0f), random.NextFloat(-500.0f, 500.0f), random.NextFloat(-500.0f, 500.0f)));
+			}
+			radii[i] = random.NextFloat(0.5f, 10.0f);
+		}
+		uint* visibleIndices = new uint[count];
+
+		const Matrix4 view = Matrix4::CreateView(Vector3::c_Zero, Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 1.0f, 0.0f));
+		const Matrix4 projection = Matrix4::CreatePerspective(90.0f, 16.0f / 9.0f, 1000.0f, 0.1f);
+		const Frustum frustum(view * projection);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const uint visibleCount = frustum.CullSpheres(centres, radii, visibleIndices);
+			DoNotOptimize(visibleCount);
+			ClobberMemory();
+		}
+		state.StopTiming();
+
+		delete[] visibleIndices;
+		FreeAligned(radii);
+	}
+
+	TYR_BENCHMARK_ARGS(FNV1aHash64, { 16, 256 })
+	{
+		const uint length = static_cast<uint>(state.GetArg());
+		Array<char> text;
+		text.Resize(length);
+		BenchmarkRandom random;
+		for (char& c : text)
+		{
+			c = static_cast<char>('a' + random.Next() % 26);
+		}
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			ClobberMemory();
+			const uint64 hash = FNV1aHash<uint64, c_FNVOffsetBasis64, c_FNVPrime64>(text.Data(), length);
+			DoNotOptimize(hash);
+		}
+	}
+
+	TYR_BENCHMARK_ARGS(FNV1aHash32, { 16, 256 })
+	{
+		const uint length = static_cast<uint>(state.GetArg());
+		Array<char> text;
+		text.Resize(length);
+		BenchmarkRandom random;
+		for (char& c : text)
+		{
+			c = static_cast<char>('a' + random.Next() % 26);
+		}
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			ClobberMemory();
+			const uint hash = FNV1aHash<uint, c_FNVOffsetBasis32, c_FNVPrime32>(text.Data(), length);
+			DoNotOptimize(hash);
+		}
+	}
+}
@@ -0,0 +1,140 @@
+#include "Benchmark.h"
+#include "Memory/ScratchAllocator.h"
+#include "Memory/StackAllocation.h"
+#include "Memory/ObjectPool.h"
+#include "Memory/VirtualArena.h"
+
+namespace tyr
+{
+	namespace
+	{
+		static constexpr uint c_AllocationCount = 1024;
+
+		struct PoolObject
+		{
+			uint64 id;
+			float values[6];
+		};
+
+		// Sizes between 16 and 256 bytes
+		uint GetAllocationSize(uint index)
+		{
+			return 16 + (index * 37) % 241;
+		}
+	}
+
+	TYR_BENCHMARK(ScratchAllocatorAlloc)
+	{
+		ScratchAllocator allocator;
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (uint j = 0; j < c_AllocationCount; ++j)
+			{
+				DoNotOptimize(allocator.AllocAligned(GetAllocationSize(j), 16));
+			}
+			allocator.Reset();
+		}
+	}
+
+	TYR_BENCHMARK(ScratchAllocatorArenaAlloc)
+	{
+		VirtualArenaConfig config;
+		config.reserveSize = 64 * 1024 * 1024;
+		ScratchAllocator allocator(config);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (uint j = 0; j < c_AllocationCount; ++j)
+			{
+				DoNotOptimize(allocator.AllocAligned(GetAllocationSize(j), 16));
+			}
+			allocator.Reset();
+		}
+	}
+
+	// Baseline for the allocator benchmarks
+	TYR_BENCHMARK(HeapAllocFree)
+	{
+		uint8* allocations[c_AllocationCount];
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (uint j = 0; j < c_AllocationCount; ++j)
+			{
+				allocations[j] = new uint8[GetAllocationSize(j)];
+				DoNotOptimize(allocations[j]);
+			}
+			for (uint j = 0; j < c_AllocationCount; ++j)
+			{
+				delete[] allocations[j];
+			}
+		}
+	}
+
+	TYR_BENCHMARK(MemoryStackAllocDealloc)
+	{
+		MemoryStack& stack = MemoryStack::Instance();
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (uint j = 0; j < c_AllocationCount; ++j)
+			{
+				DoNotOptimize(stack.Alloc(GetAllocationSize(j)));
+			}
+			for (uint j = 0; j < c_AllocationCount; ++j)
+			{
+				stack.DeallocLast();
+			}
+		}
+	}
+
+	TYR_BENCHMARK(ObjectPoolCreateDelete)
+	{
+		ObjectPool<PoolObject> pool;
+		PoolObject* objects[c_AllocationCount];
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (uint j = 0; j < c_AllocationCount; ++j)
+			{
+				objects[j] = pool.Create();
+				DoNotOptimize(objects[j]);
+			}
+			for (uint j = 0; j < c_AllocationCount; ++j)
+			{
+				pool.Delete(objects[j]);
+			}
+		}
+	}
+
+	TYR_BENCHMARK(HandlePoolLookup)
+	{
+		HandlePool<PoolObject> pool;
+		uint handles[c_AllocationCount];
+		for (uint j = 0; j < c_AllocationCount; ++j)
+		{
+			pool.Create(handles[j])->id = j;
+		}
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			uint64 sum = 0;
+			for (uint j = 0; j < c_AllocationCount; ++j)
+			{
+				sum += pool.GetObjectRef(handles[j]).id;
+			}
+			DoNotOptimize(sum);
+		}
+		state.StopTiming();
+
+		for (uint j = 0; j < c_AllocationCount; ++j)
+		{
+			pool.Delete(handles[j]);
+		}
+	}
+}
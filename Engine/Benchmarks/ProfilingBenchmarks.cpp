@@ -0,0 +1,63 @@
+#include "Benchmark.h"
+#include "Profiling/Profiler.h"
+
+#if TYR_PROFILER
+
+namespace tyr
+{
+	namespace
+	{
+		// Fewer zones than a thread buffer holds so that none are dropped between frames
+		static constexpr uint c_ZoneCount = 4096;
+		static constexpr uint c_ZoneDepth = 8;
+
+		void RecordZones()
+		{
+			for (uint i = 0; i < c_ZoneCount / c_ZoneDepth; ++i)
+			{
+				TYR_PROFILE_SCOPE("Outer");
+				TYR_PROFILE_SCOPE("Depth1");
+				TYR_PROFILE_SCOPE("Depth2");
+				TYR_PROFILE_SCOPE("Depth3");
+				TYR_PROFILE_SCOPE("Depth4");
+				TYR_PROFILE_SCOPE("Depth5");
+				TYR_PROFILE_SCOPE("Depth6");
+				TYR_PROFILE_SCOPE("Depth7");
+				ClobberMemory();
+			}
+		}
+	}
+
+	// Cost of a zone's begin and end records including the per frame collection, which is what the engine pays per
+	// zone when no capture is running
+	TYR_BENCHMARK(ProfilerZone)
+	{
+		state.SetItemsPerIteration(c_ZoneCount);
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			RecordZones();
+			Profiler::EndFrame();
+		}
+		state.StopTiming();
+	}
+
+	TYR_BENCHMARK(ProfilerZoneCapturing)
+	{
+		Profiler::BeginCapture();
+		state.SetItemsPerIteration(c_ZoneCount);
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			RecordZones();
+			Profiler::EndFrame();
+			// Keeps the capture's storage so that only copying the events is measured
+			Profiler::ClearCapture();
+		}
+		state.StopTiming();
+		Profiler::EndCapture();
+		Profiler::ClearCapture();
+	}
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include "Benchmark.h"
+#include "Geometry/Frustum.h"
+#include "Math/Math.h"
+#include "Math/Matrix4.h"
+#include "RenderDataTypes/Vertex.h"
+#include "RenderDataUtility/MeshletBuilder.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// About a million triangles, or 8000 meshlets
+		static constexpr uint c_CullSphereRings = 512;
+		static constexpr float c_SphereRadius = 10.0f;
+
+		struct SphereMesh
+		{
+			Array<Vertex> vertices;
+			Array<uint> indices;
+		};
+
+		// Sphere with rings of twice as many segments, whose triangles face outwards
+		SphereMesh CreateSphere(uint rings)
+		{
+			SphereMesh mesh;
+			const uint segments = rings * 2;
+			const uint rowLength = segments + 1;
+			mesh.vertices.Reserve((rings + 1) * rowLength);
+			for (uint ring = 0; ring <= rings; ++ring)
+			{
+				const float theta = Math::c_Pi * ring / rings;
+				for (uint segment = 0; segment <= segments; ++segment)
+				{
+					const float phi = Math::c_TwoPi * segment / segments;
+					Vertex vertex;
+					vertex.position = Vector3(Math::Sin(theta) * Math::Cos(phi), Math::Cos(theta), Math::Sin(theta) * Math::Sin(phi)) * c_SphereRadius;
+					vertex.normal = Vector3::c_Zero;
+					vertex.texCoord = Vector2(static_cast<float>(segment) / segments, static_cast<float>(ring) / rings);
+					vertex.tangent = Vector3::c_Zero;
+					mesh.vertices.Add(vertex);
+				}
+			}
+
+			mesh.indices.Reserve(rings * segments * 6);
+			for (uint ring = 0; ring < rings; ++ring)
+			{
+				for (uint segment = 0; segment < segments; ++segment)
+				{
+					const uint corner = ring * rowLength + segment;
+					mesh.indices.Add(corner);
+					mesh.indices.Add(corner + rowLength);
+					mesh.indices.Add(corner + 1);
+					mesh.indices.Add(corner + 1);
+					mesh.indices.Add(corner + rowLength);
+					mesh.indices.Add(corner + rowLength + 1);
+				}
+			}
+			return mesh;
+		}
+
+		// Building the large sphere's meshlets takes a while so they are shared by every run of the cull benchmark
+		const MeshletData& GetCullMeshlets()
+		{
+			static const MeshletData* data = []()
+			{
+				MeshletData* result = new MeshletData();
+				const SphereMesh mesh = CreateSphere(c_CullSphereRings);
+				MeshletBuilder::Build(mesh.vertices.Data(), mesh.indices.Data(), mesh.indices.Size(), *result);
+				return result;
+			}();
+			return *data;
+		}
+	}
+
+	TYR_BENCHMARK_ARGS(MeshletBuild, { 64, 256 })
+	{
+		const SphereMesh mesh = CreateSphere(static_cast<uint>(state.GetArg()));
+		state.SetItemsPerIteration(mesh.indices.Size() / 3);
+
+		MeshletData data;
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			MeshletBuilder::Build(mesh.vertices.Data(), mesh.indices.Data(), mesh.indices.Size(), data);
+			DoNotOptimize(data.meshlets.Data());
+		}
+		state.StopTiming();
+	}
+
+	TYR_BENCHMARK(MeshletCull)
+	{
+		const MeshletData& data = GetCullMeshlets();
+		const uint meshletCount = data.meshlets.Size();
+		Array<uint> visible(meshletCount);
+
+		// Close enough that the frustum cuts off the sphere's sides, while the cones cull its far half
+		const Vector3 cameraPosition(0.0f, 0.0f, -1.5f * c_SphereRadius);
+		const Matrix4 view = Matrix4::CreateView(cameraPosition, Vector3(0.0f, 0.0f, 1.0f), Vector3::c_Up);
+		const Frustum frustum(view * Matrix4::CreatePerspective(60.0f, 16.0f / 9.0f, 0.5f, 100.0f));
+		state.SetItemsPerIteration(meshletCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const uint visibleCount = MeshletBuilder::CullMeshlets(data.bounds.Data(), meshletCount, frustum, cameraPosition, visible.Data());
+			DoNotOptimize(visibleCount);
+			DoNotOptimize(visible.Data());
+		}
+		state.StopTiming();
+	}
+}
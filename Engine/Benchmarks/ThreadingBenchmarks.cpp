@@ -0,0 +1,199 @@
+#include "Benchmark.h"
+#include "Containers/MPMCRingBuffer.h"
+#include "Containers/WorkStealingQueue.h"
+#include "Memory/MemoryTypes.h"
+#include "Threading/JobSystem.h"
+#include "Threading/ThreadPool.h"
+#include "Threading/Task.h"
+
+namespace tyr
+{
+	namespace
+	{
+		static constexpr uint c_TaskCount = 256;
+		static constexpr uint c_TaskWork = 256;
+
+		void SmallTask(void* context)
+		{
+			Atomic<uint64>* sum = static_cast<Atomic<uint64>*>(context);
+			uint64 value = 0;
+			for (uint i = 0; i < c_TaskWork; ++i)
+			{
+				value += i * i;
+			}
+			sum->fetch_add(value, std::memory_order_relaxed);
+		}
+
+		Callable MakeSmallTask(Atomic<uint64>& sum)
+		{
+			Callable callable;
+			callable.Execute = &SmallTask;
+			callable.Context = &sum;
+			return callable;
+		}
+	}
+
+	TYR_BENCHMARK(JobSystemSubmitWait)
+	{
+		JobSystem& jobSystem = JobSystem::Instance();
+		Atomic<uint64> sum = 0;
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			JobCounter counter;
+			for (uint j = 0; j < c_TaskCount; ++j)
+			{
+				jobSystem.Submit(MakeSmallTask(sum), &counter);
+			}
+			jobSystem.Wait(counter);
+		}
+		state.StopTiming();
+		DoNotOptimize(sum.load());
+	}
+
+	// Baseline for JobSystemSubmitWait using the thread pool the job system replaced
+	TYR_BENCHMARK(ThreadPoolDispatch)
+	{
+		ThreadPoolConfig config;
+		ThreadPool pool(config);
+		Atomic<uint64> sum = 0;
+		// Tasks are neither copyable nor movable so they cannot live in an Array
+		URef<Task[]> tasks = std::make_unique<Task[]>(c_TaskCount);
+		Array<PooledThread*> usedThreads;
+		usedThreads.Reserve(c_TaskCount);
+
+		state.StartTiming();
+		for (uint64 i = 0; i < state.GetIterations(); ++i)
+		{
+			usedThreads.Clear();
+			for (uint j = 0; j < c_TaskCount; ++j)
+			{
+				tasks[j].SetCallable(MakeSmallTask(sum));
+				PooledThread* thread = pool.GetAvailableThread();
+				while (thread == nullptr)
+				{
+					TYR_THREAD_YIELD
+					thread = pool.GetAvailableThread();
+				}
+				thread->Start(&tasks[j]);
+				usedThreads.Add(thread);
+			}
+			for (PooledThread* thread : usedThreads)
+			{
+				thread->Wait();
+			}
+		}
+		state.StopTiming();
+		DoNotOptimize(sum.load());
+	}
+
+	// Each thread enqueues and dequeues in pairs so the buffer never fills. The argument is the thread count.
+	TYR_BENCHMARK_ARGS(MPMCRingBufferContention, { 1, 2, 4, 8, 16, 32, 64 })
+	{
+		static constexpr uint c_OpsPerIteration = 1024;
+		using RingBuffer = MPMCRingBuffer<uint64, 1024>;
+
+		const uint threadCount = static_cast<uint>(state.GetArg());
+		URef<RingBuffer> buffer = std::make_unique<RingBuffer>();
+		const uint64 totalOps = state.GetIterations() * c_OpsPerIteration;
+		const uint64 opsPerThread = (totalOps + threadCount - 1) / threadCount;
+
+		Atomic<bool> go = false;
+		Array<Thread> threads;
+		threads.Reserve(threadCount);
+		for (uint t = 0; t < threadCount; ++t)
+		{
+			threads.Add(Thread([&buffer, &go, opsPerThread, t]()
+			{
+				while (!go.load(std::memory_order_acquire))
+				{
+					TYR_THREAD_YIELD
+				}
+
+				uint64 checksum = 0;
+				for (uint64 i = 0; i < opsPerThread; ++i)
+				{
+					while (!buffer->TryEnqueue(i + t))
+					{
+						TYR_THREAD_YIELD
+					}
+					Optional<uint64> value = buffer->TryDequeue();
+					while (!value)
+					{
+						value = buffer->TryDequeue();
+					}
+					checksum += *value;
+				}
+				DoNotOptimize(checksum);
+			}));
+		}
+
+		state.StartTiming();
+		go.store(true, std::memory_order_release);
+		for (Thread& thread : threads)
+		{
+			thread.join();
+		}
+		state.StopTiming();
+	}
+
+	// One owner pushes to its deque while idle threads steal everything from it, as job system workers do when a
+	// single worker submits all the jobs. The argument is the thief count.
+	TYR_BENCHMARK_ARGS(WorkStealingQueueSteal, { 1, 2, 4, 8, 16 })
+	{
+		static constexpr uint c_ItemsPerIteration = 1024;
+		using Queue = WorkStealingQueue<uint64, 1024>;
+
+		const uint thiefCount = static_cast<uint>(state.GetArg());
+		URef<Queue> queue = std::make_unique<Queue>();
+		const uint64 totalItems = state.GetIterations() * c_ItemsPerIteration;
+		state.SetItemsPerIteration(c_ItemsPerIteration);
+
+		Atomic<bool> go = false;
+		Atomic<uint64> stolenCount = 0;
+		Array<Thread> thieves;
+		thieves.Reserve(thiefCount);
+		for (uint t = 0; t < thiefCount; ++t)
+		{
+			thieves.Add(Thread([&queue, &go, &stolenCount, totalItems]()
+			{
+				while (!go.load(std::memory_order_acquire))
+				{
+					TYR_THREAD_YIELD
+				}
+
+				uint64 checksum = 0;
+				while (stolenCount.load(std::memory_order_relaxed) < totalItems)
+				{
+					if (Optional<uint64> item = queue->Steal())
+					{
+						checksum += *item;
+						stolenCount.fetch_add(1, std::memory_order_relaxed);
+					}
+					else
+					{
+						// Workers yield the same way when they find nothing to steal
+						TYR_THREAD_YIELD
+					}
+				}
+				DoNotOptimize(checksum);
+			}));
+		}
+
+		state.StartTiming();
+		go.store(true, std::memory_order_release);
+		for (uint64 i = 0; i < totalItems; ++i)
+		{
+			while (!queue->Push(i))
+			{
+				TYR_THREAD_YIELD
+			}
+		}
+		for (Thread& thief : thieves)
+		{
+			thief.join();
+		}
+		state.StopTiming();
+	}
+}
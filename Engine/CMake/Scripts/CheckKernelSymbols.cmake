@@ -0,0 +1,37 @@
+# Fails if an object compiled with a wider instruction set defines a weak symbol outside the per instruction set
+# namespaces of SIMD.h. The linker may pick any copy of a weak symbol, so such a copy could replace the baseline one
+# and crash on CPUs without that instruction set.
+#
+# Usage: cmake -DNM=<nm> -DOBJECTS=<object>|<object>... -P CheckKernelSymbols.cmake
+
+string(REPLACE "|" ";" objects "${OBJECTS}")
+if(NOT objects)
+	message(FATAL_ERROR "No kernel variant objects to check.")
+endif()
+
+set(failed FALSE)
+foreach(object IN LISTS objects)
+	execute_process(
+		COMMAND ${NM} -C --defined-only ${object}
+		OUTPUT_VARIABLE symbols
+		RESULT_VARIABLE result)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "${NM} failed on ${object}.")
+	endif()
+
+	string(REPLACE "\n" ";" lines "${symbols}")
+	foreach(line IN LISTS lines)
+		if(line MATCHES "^[0-9a-fA-F]* [WwVvu] (.*)$")
+			set(symbol "${CMAKE_MATCH_1}")
+			if(NOT symbol MATCHES "::SIMDAVX2::|::SIMDAVX512::")
+				message(SEND_ERROR "${object} defines the weak symbol ${symbol}")
+				set(failed TRUE)
+			endif()
+		endif()
+	endforeach()
+endforeach()
+
+if(failed)
+	message(FATAL_ERROR "Kernel variants must only use SIMD.h, see MathKernels.h.")
+endif()
+message(STATUS "Checked the symbols of ${objects}")
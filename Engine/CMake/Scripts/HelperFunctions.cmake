@@ -143,7 +143,12 @@ function(add_common_properties target)
 	elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang" OR CMAKE_CXX_COMPILER_ID MATCHES "AppleClang" OR "${CMAKE_CXX_COMPILER_ID}" STREQUAL "GNU")
 		# Note: Optionally add -ffunction-sections, -fdata-sections, but with linker option --gc-sections
 		# TODO: Use link-time optimization -flto. Might require non-default linker.
-		set_property(TARGET ${target} APPEND PROPERTY COMPILE_OPTIONS -Wall -Wextra -Wno-unused-parameter -fpiC -fno-strict-aliasing -msse4.1)
+		set_property(TARGET ${target} APPEND PROPERTY COMPILE_OPTIONS -Wall -Wextra -Wno-unused-parameter -fPIC -fno-strict-aliasing)
+
+		# SSE4.2 is the x86 baseline. Wider instruction sets are only enabled for code that is picked at runtime.
+		if(TYR_ARCHITECTURE STREQUAL "x64" OR TYR_ARCHITECTURE STREQUAL "Win32")
+			set_property(TARGET ${target} APPEND PROPERTY COMPILE_OPTIONS -msse4.2)
+		endif()
 
 		if(CMAKE_CXX_COMPILER_ID MATCHES "Clang" OR CMAKE_CXX_COMPILER_ID MATCHES "AppleClang")
 			set_property(TARGET ${target} APPEND PROPERTY COMPILE_OPTIONS -fno-ms-compatibility)
@@ -192,6 +192,24 @@ namespace tyr
             return *this;
         }
 
+        Array& operator=(Array&& other) noexcept
+        {
+            if (this != &other)
+            {
+                DestructElements(0, m_Size);
+                Free<A>(m_Data);
+
+                m_Data = other.m_Data;
+                m_Capacity = other.m_Capacity;
+                m_Size = other.m_Size;
+
+                other.m_Data = nullptr;
+                other.m_Capacity = 0;
+                other.m_Size = 0;
+            }
+            return *this;
+        }
+
         void Reserve(uint capacity)
         {
             EnsureCapacity(capacity);
@@ -349,7 +367,7 @@ namespace tyr
         void PopBack()
         {
             TYR_ASSERT(m_Size > 0);
-            DestructElement[--m_Size];
+            DestructElement(--m_Size);
         }
 
         void Clear()
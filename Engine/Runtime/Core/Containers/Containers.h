@@ -14,7 +14,8 @@
 #include "LocalArray.h"
 #include "HashMap.h"
 #include "SPSCRingBuffer.h"
-#include "MPSCRingBuffer.h"
+#include "MPMCRingBuffer.h"
+#include "WorkStealingQueue.h"
 
 namespace tyr
 {
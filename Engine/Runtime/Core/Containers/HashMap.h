@@ -2,219 +2,381 @@
 
 #include "Array.h"
 #include "Math/Math.h"
+#include "Math/SIMD.h"
+#include <bit>
+#include <cstring>
 
 namespace tyr
 {
-    // Hash map thast uses linear probing for collisions and keeps the load factor at 50% max
+    /// Open addressing hash map in the style of SwissTable.
+    ///
+    /// - A separate control byte array stores one byte per slot: empty, deleted, or the low 7 bits of the
+    ///   hash (H2) for a full slot. The rest of the hash (H1) picks the starting position.
+    /// - Lookups compare H2 against a whole group of control bytes with one SIMD compare and only touch the slots
+    ///   whose control byte matches, so most misses never read a key.
+    /// - Groups are probed with triangular steps, which visits every slot when the capacity is a power of two.
+    /// - The load factor is kept at 87.5% max. Entries are moved rather than copied when the table grows.
     template <typename Key, typename Value, typename Hash = std::hash<Key>, typename A = HeapAllocator>
     class HashMap
     {
     private:
-        struct Bucket
+        struct Slot
         {
-            Key Key;
-            Value Value;
-            bool occupied = false;
-            bool deleted = false;
+            Key key;
+            Value value;
         };
 
-        Array<Bucket, A> m_Buckets;
+        static constexpr uint c_GroupWidth = 16;
+        static constexpr uint c_MinCapacity = c_GroupWidth;
+
+        static constexpr int8 c_Empty = static_cast<int8>(0x80);
+        static constexpr int8 c_Deleted = static_cast<int8>(0xFE);
+
+        // Control bytes. The first group is mirrored after the last slot so that a group can be loaded from any
+        // position without wrapping.
+        int8* m_Ctrl;
+        Slot* m_Slots;
         uint m_Capacity;
         uint m_Size;
+        // Number of empty slots that can still be filled before the table needs to grow
+        uint m_GrowthLeft;
 
-        uint ProbeIndex(uint hash, uint i) const
+        static uint64 ComputeHash(const Key& key)
         {
-            return (hash + i) & (m_Capacity - 1); 
+            // Mix so that weak hashes, such as the identity hash for integers, still spread over H1 and H2
+            const uint64 hash = static_cast<uint64>(Hash{}(key)) * 0x9E3779B97F4A7C15ull;
+            return hash ^ (hash >> 32);
         }
 
-        void Rehash(uint newCapacity)
+        static uint H1(uint64 hash) { return static_cast<uint>(hash >> 7); }
+        static int8 H2(uint64 hash) { return static_cast<int8>(hash & 0x7F); }
+
+        static uint ComputeMaxLoad(uint capacity)
         {
-            Array<Bucket, A> newBuckets;
-            newBuckets.Resize(newCapacity);
-            for (uint i = 0; i < newCapacity; ++i)
+            return capacity - capacity / 8;
+        }
+
+        uint MatchH2(uint pos, int8 h2) const
+        {
+            const RegB group = SIMD::LoadBytes(reinterpret_cast<const uint8*>(m_Ctrl + pos));
+            return SIMD::MoveMaskBytes(SIMD::CmpEqBytes(group, SIMD::SetBytes(h2)));
+        }
+
+        uint MatchEmpty(uint pos) const
+        {
+            const RegB group = SIMD::LoadBytes(reinterpret_cast<const uint8*>(m_Ctrl + pos));
+            return SIMD::MoveMaskBytes(SIMD::CmpEqBytes(group, SIMD::SetBytes(c_Empty)));
+        }
+
+        // Empty and deleted both have the top bit set while full slots don't
+        uint MatchEmptyOrDeleted(uint pos) const
+        {
+            return SIMD::MoveMaskBytes(SIMD::LoadBytes(reinterpret_cast<const uint8*>(m_Ctrl + pos)));
+        }
+
+        bool IsFull(uint index) const
+        {
+            return m_Ctrl[index] >= 0;
+        }
+
+        void SetCtrl(uint index, int8 value)
+        {
+            m_Ctrl[index] = value;
+            if (index < c_GroupWidth)
             {
-                newBuckets[i].occupied = false;
-                newBuckets[i].deleted = false;
+                m_Ctrl[m_Capacity + index] = value;
             }
+        }
 
-            for (uint i = 0; i < m_Capacity; ++i)
+        void Allocate(uint capacity)
+        {
+            m_Capacity = capacity;
+            m_Ctrl = AllocN<int8, A>(capacity + c_GroupWidth);
+            m_Slots = AllocN<Slot, A>(capacity);
+            std::memset(m_Ctrl, static_cast<uint8>(c_Empty), capacity + c_GroupWidth);
+            m_GrowthLeft = ComputeMaxLoad(capacity);
+        }
+
+        void DestroySlots()
+        {
+            if constexpr (!std::is_trivially_destructible_v<Slot>)
             {
-                if (m_Buckets[i].occupied && !m_Buckets[i].deleted)
+                for (uint i = 0; i < m_Capacity; ++i)
                 {
-                    const Key& key = m_Buckets[i].Key;
-                    const Value& value = m_Buckets[i].Value;
-                    uint hash = Hash{}(key);
-
-                    for (uint j = 0; j < newCapacity; ++j)
+                    if (IsFull(i))
                     {
-                        uint index = (hash + j) & (newCapacity - 1);
-                        if (!newBuckets[index].occupied)
-                        {
-                            newBuckets[index].Key = key;
-                            newBuckets[index].Value = value;
-                            newBuckets[index].occupied = true;
-                            break;
-                        }
+                        m_Slots[i].~Slot();
                     }
                 }
             }
+        }
 
-            m_Buckets = std::move(newBuckets);
-            m_Capacity = newCapacity;
+        void Deallocate()
+        {
+            Free<A>(m_Ctrl);
+            Free<A>(m_Slots);
+            m_Ctrl = nullptr;
+            m_Slots = nullptr;
         }
 
-        void EnsureCapacity(uint requiredSize)
+        // Returns the index of the first empty or deleted slot in the probe sequence
+        uint FindInsertIndex(uint64 hash) const
         {
-            // Make sure a max load factor of 0.5 is kept
-            uint requiredCapacity = requiredSize * 2;
-            if (requiredCapacity > m_Capacity)
+            const uint mask = m_Capacity - 1;
+            uint pos = H1(hash) & mask;
+            uint step = 0;
+            while (true)
             {
-                Rehash(Math::NextPowerOfTwo(requiredCapacity));
+                const uint match = MatchEmptyOrDeleted(pos);
+                if (match)
+                {
+                    return (pos + std::countr_zero(match)) & mask;
+                }
+                step += c_GroupWidth;
+                pos = (pos + step) & mask;
             }
         }
 
-        const Value* FindInternal(const Key& key) const
+        uint FindIndex(const Key& key, uint64 hash) const
         {
-            const uint hash = Hash{}(key);
-            for (uint i = 0; i < m_Capacity; ++i)
+            const uint mask = m_Capacity - 1;
+            const int8 h2 = H2(hash);
+            uint pos = H1(hash) & mask;
+            uint step = 0;
+            while (true)
             {
-                const uint index = ProbeIndex(hash, i);
-                const Bucket& bucket = m_Buckets[index];
+                uint match = MatchH2(pos, h2);
+                while (match)
+                {
+                    const uint index = (pos + std::countr_zero(match)) & mask;
+                    if (m_Slots[index].key == key)
+                    {
+                        return index;
+                    }
+                    match &= match - 1;
+                }
 
-                if (!bucket.occupied && !bucket.deleted)
+                // An empty slot ends the probe sequence as the key would have been inserted there
+                if (MatchEmpty(pos))
                 {
-                    return nullptr;
+                    return c_NotFound;
                 }
 
-                if (bucket.occupied && !bucket.deleted && bucket.Key == key)
+                step += c_GroupWidth;
+                if (step > m_Capacity)
                 {
-                    return &bucket.Value;
+                    return c_NotFound;
                 }
+                pos = (pos + step) & mask;
             }
-            return nullptr;
         }
 
+        void Rehash(uint newCapacity)
+        {
+            int8* oldCtrl = m_Ctrl;
+            Slot* oldSlots = m_Slots;
+            const uint oldCapacity = m_Capacity;
 
-    public:
-        HashMap(uint capacity = 8)
-            : m_Capacity(Math::NextPowerOfTwo(capacity))
-            , m_Size(0)
+            Allocate(newCapacity);
+
+            for (uint i = 0; i < oldCapacity; ++i)
+            {
+                if (oldCtrl[i] >= 0)
+                {
+                    Slot& oldSlot = oldSlots[i];
+                    const uint64 hash = ComputeHash(oldSlot.key);
+                    const uint index = FindInsertIndex(hash);
+                    SetCtrl(index, H2(hash));
+                    new (&m_Slots[index]) Slot{ std::move(oldSlot.key), std::move(oldSlot.value) };
+                    oldSlot.~Slot();
+                }
+            }
+            m_GrowthLeft -= m_Size;
+
+            Free<A>(oldCtrl);
+            Free<A>(oldSlots);
+        }
+
+        void EnsureCapacity(uint requiredSize)
         {
-            m_Buckets.Resize(m_Capacity);
-            for (uint i = 0; i < m_Capacity; ++i)
+            if (requiredSize > ComputeMaxLoad(m_Capacity))
             {
-                m_Buckets[i].occupied = false;
-                m_Buckets[i].deleted = false;
+                uint newCapacity = m_Capacity;
+                while (requiredSize > ComputeMaxLoad(newCapacity))
+                {
+                    newCapacity *= 2;
+                }
+                Rehash(newCapacity);
             }
         }
 
-        ~HashMap() = default;
+        // Returns the slot index for key, inserting a default constructed value if it isn't in the map
+        template<typename... Args>
+        uint FindOrInsert(const Key& key, bool& inserted, Args&&... args)
+        {
+            uint64 hash = ComputeHash(key);
+            uint index = FindIndex(key, hash);
+            if (index != c_NotFound)
+            {
+                inserted = false;
+                return index;
+            }
 
-        Value& operator[](const Key& key)
+            index = FindInsertIndex(hash);
+            if (m_GrowthLeft == 0 && m_Ctrl[index] == c_Empty)
+            {
+                // Grow if the table is genuinely full, otherwise rehash at the same size to clear out deleted slots
+                const uint newCapacity = m_Size + 1 > ComputeMaxLoad(m_Capacity) / 2 ? m_Capacity * 2 : m_Capacity;
+                Rehash(newCapacity);
+                index = FindInsertIndex(hash);
+            }
+
+            if (m_Ctrl[index] == c_Empty)
+            {
+                --m_GrowthLeft;
+            }
+            SetCtrl(index, H2(hash));
+            new (&m_Slots[index]) Slot{ key, Value(std::forward<Args>(args)...) };
+            ++m_Size;
+            inserted = true;
+            return index;
+        }
+
+        void CopyFrom(const HashMap& other)
         {
-            uint hash = Hash{}(key);
+            Allocate(other.m_Capacity);
+            std::memcpy(m_Ctrl, other.m_Ctrl, m_Capacity + c_GroupWidth);
             for (uint i = 0; i < m_Capacity; ++i)
             {
-                uint index = ProbeIndex(hash, i);
-                Bucket& bucket = m_Buckets[index];
-
-                if (bucket.occupied && !bucket.deleted && bucket.Key == key)
+                if (IsFull(i))
                 {
-                    return bucket.Value;
+                    new (&m_Slots[i]) Slot{ other.m_Slots[i].key, other.m_Slots[i].value };
                 }
+            }
+            m_Size = other.m_Size;
+            m_GrowthLeft = other.m_GrowthLeft;
+        }
 
-                if (!bucket.occupied || bucket.deleted)
-                {
-                    EnsureCapacity(m_Size + 1); // Ensure BEFORE insert!
-                    hash = Hash{}(key); // In case rehash changed capacity
+    public:
+        static constexpr uint c_NotFound = ~0u;
 
-                    for (uint j = 0; j < m_Capacity; ++j)
-                    {
-                        uint insertIndex = ProbeIndex(hash, j);
-                        Bucket& insertBucket = m_Buckets[insertIndex];
-                        if (!insertBucket.occupied || insertBucket.deleted)
-                        {
-                            insertBucket.Key = key;
-                            insertBucket.Value = Value();
-                            insertBucket.occupied = true;
-                            insertBucket.deleted = false;
-                            ++m_Size;
-                            return insertBucket.Value;
-                        }
-                    }
-                }
+        HashMap(uint capacity = 8)
+            : m_Size(0)
+        {
+            // Size the table so that capacity entries fit without growing
+            uint tableCapacity = Math::NextPowerOfTwo(std::max(capacity, c_MinCapacity));
+            while (capacity > ComputeMaxLoad(tableCapacity))
+            {
+                tableCapacity *= 2;
             }
+            Allocate(tableCapacity);
+        }
 
-            TYR_ASSERT(false);
-            static Value dummy = {};
-            return dummy;
+        HashMap(const HashMap& other)
+            : m_Size(0)
+        {
+            CopyFrom(other);
         }
 
-        void Insert(const Key& key, const Value& value)
+        HashMap(HashMap&& other) noexcept
+            : m_Ctrl(other.m_Ctrl)
+            , m_Slots(other.m_Slots)
+            , m_Capacity(other.m_Capacity)
+            , m_Size(other.m_Size)
+            , m_GrowthLeft(other.m_GrowthLeft)
         {
-            EnsureCapacity(m_Size + 1);
-            uint hash = Hash{}(key);
+            // The moved from map is left as a valid empty table so that it can still be used
+            other.Allocate(c_MinCapacity);
+            other.m_Size = 0;
+        }
 
-            for (uint i = 0; i < m_Capacity; ++i)
+        ~HashMap()
+        {
+            if (m_Ctrl)
             {
-                uint index = ProbeIndex(hash, i);
-                Bucket& bucket = m_Buckets[index];
+                DestroySlots();
+                Deallocate();
+            }
+        }
 
-                if (bucket.occupied && !bucket.deleted && bucket.Key == key)
-                {
-                    bucket.Value = value;
-                    return;
-                }
+        HashMap& operator=(const HashMap& other)
+        {
+            if (this != &other)
+            {
+                this->~HashMap();
+                CopyFrom(other);
+            }
+            return *this;
+        }
 
-                if (!bucket.occupied || bucket.deleted)
-                {
-                    bucket.Key = key;
-                    bucket.Value = value;
-                    bucket.occupied = true;
-                    bucket.deleted = false;
-                    ++m_Size;
-                    return;
-                }
+        HashMap& operator=(HashMap&& other) noexcept
+        {
+            if (this != &other)
+            {
+                this->~HashMap();
+                new (this) HashMap(std::move(other));
             }
+            return *this;
+        }
 
-            TYR_ASSERT(false);
+        Value& operator[](const Key& key)
+        {
+            bool inserted;
+            // Find first as inserting can reallocate the slots
+            const uint index = FindOrInsert(key, inserted);
+            return m_Slots[index].value;
+        }
+
+        void Insert(const Key& key, const Value& value)
+        {
+            bool inserted;
+            const uint index = FindOrInsert(key, inserted, value);
+            if (!inserted)
+            {
+                m_Slots[index].value = value;
+            }
         }
 
         Value* Find(const Key& key)
         {
-            return const_cast<Value*>(static_cast<const HashMap*>(this)->FindInternal(key));
+            const uint index = FindIndex(key, ComputeHash(key));
+            return index != c_NotFound ? &m_Slots[index].value : nullptr;
         }
 
         const Value* Find(const Key& key) const
         {
-            return FindInternal(key);
+            const uint index = FindIndex(key, ComputeHash(key));
+            return index != c_NotFound ? &m_Slots[index].value : nullptr;
         }
 
         bool Contains(const Key& key) const
         {
-            return FindInternal(key) != nullptr;
+            return FindIndex(key, ComputeHash(key)) != c_NotFound;
         }
-        
+
         void Erase(const Key& key)
         {
-            uint hash = Hash{}(key);
-            for (uint i = 0; i < m_Capacity; ++i)
+            const uint index = FindIndex(key, ComputeHash(key));
+            if (index == c_NotFound)
             {
-                uint index = ProbeIndex(hash, i);
-                Bucket& bucket = m_Buckets[index];
-
-                if (!bucket.occupied && !bucket.deleted)
-                {
-                    return;
-                }
+                return;
+            }
 
-                if (bucket.occupied && !bucket.deleted && bucket.Key == key)
-                {
-                    bucket.deleted = true;
-                    --m_Size;
-                    return;
-                }
+            // The slot can go back to empty if no probe sequence could have passed over it, which is when no
+            // group sized window around it was ever completely full.
+            const uint mask = m_Capacity - 1;
+            const uint emptyBefore = MatchEmpty((index - c_GroupWidth) & mask);
+            const uint emptyAfter = MatchEmpty(index);
+            const bool wasNeverFull = emptyBefore && emptyAfter &&
+                static_cast<uint>(std::countr_zero(emptyAfter) + std::countl_zero(static_cast<uint16>(emptyBefore))) < c_GroupWidth;
+
+            m_Slots[index].~Slot();
+            SetCtrl(index, wasNeverFull ? c_Empty : c_Deleted);
+            if (wasNeverFull)
+            {
+                ++m_GrowthLeft;
             }
+            --m_Size;
         }
 
         void Reserve(uint n)
@@ -224,8 +386,14 @@ namespace tyr
 
         void Clear()
         {
-            m_Buckets.Clear();
+            if (!m_Ctrl)
+            {
+                return;
+            }
+            DestroySlots();
+            std::memset(m_Ctrl, static_cast<uint8>(c_Empty), m_Capacity + c_GroupWidth);
             m_Size = 0;
+            m_GrowthLeft = ComputeMaxLoad(m_Capacity);
         }
 
         uint Size() const { return m_Size; }
@@ -235,38 +403,40 @@ namespace tyr
         class Iterator
         {
         public:
-            Iterator(Bucket* ptr, Bucket* end)
-                : m_Ptr(ptr), m_End(end)
+            Iterator(const int8* ctrl, Slot* slots, uint index, uint capacity)
+                : m_Ctrl(ctrl), m_Slots(slots), m_Index(index), m_Capacity(capacity)
             {
                 AdvanceToValid();
             }
 
             Iterator& operator++()
             {
-                ++m_Ptr;
+                ++m_Index;
                 AdvanceToValid();
                 return *this;
             }
 
             std::pair<const Key&, Value&> operator*() const
             {
-                return { m_Ptr->Key, m_Ptr->Value };
+                return { m_Slots[m_Index].key, m_Slots[m_Index].value };
             }
 
             bool operator!=(const Iterator& other) const
             {
-                return m_Ptr != other.m_Ptr;
+                return m_Index != other.m_Index;
             }
 
         private:
-            Bucket* m_Ptr;
-            Bucket* m_End;
+            const int8* m_Ctrl;
+            Slot* m_Slots;
+            uint m_Index;
+            uint m_Capacity;
 
             void AdvanceToValid()
             {
-                while (m_Ptr < m_End && (!m_Ptr->occupied || m_Ptr->deleted))
+                while (m_Index < m_Capacity && m_Ctrl[m_Index] < 0)
                 {
-                    ++m_Ptr;
+                    ++m_Index;
                 }
             }
         };
@@ -274,51 +444,52 @@ namespace tyr
         class ConstIterator
         {
         public:
-            ConstIterator(const Bucket* ptr, const Bucket* end)
-                : m_Ptr(ptr), m_End(end)
+            ConstIterator(const int8* ctrl, const Slot* slots, uint index, uint capacity)
+                : m_Ctrl(ctrl), m_Slots(slots), m_Index(index), m_Capacity(capacity)
             {
                 AdvanceToValid();
             }
 
             ConstIterator& operator++()
             {
-                ++m_Ptr;
+                ++m_Index;
                 AdvanceToValid();
                 return *this;
             }
 
             std::pair<const Key&, const Value&> operator*() const
             {
-                return { m_Ptr->Key, m_Ptr->Value };
+                return { m_Slots[m_Index].key, m_Slots[m_Index].value };
             }
 
             bool operator!=(const ConstIterator& other) const
             {
-                return m_Ptr != other.m_Ptr;
+                return m_Index != other.m_Index;
             }
 
         private:
-            const Bucket* m_Ptr;
-            const Bucket* m_End;
+            const int8* m_Ctrl;
+            const Slot* m_Slots;
+            uint m_Index;
+            uint m_Capacity;
 
             void AdvanceToValid()
             {
-                while (m_Ptr < m_End && (!m_Ptr->occupied || m_Ptr->deleted))
+                while (m_Index < m_Capacity && m_Ctrl[m_Index] < 0)
                 {
-                    ++m_Ptr;
+                    ++m_Index;
                 }
             }
         };
 
-        Iterator begin() { return Iterator(m_Buckets.Data(), m_Buckets.Data() + m_Capacity); }
-        Iterator end() { return Iterator(m_Buckets.Data() + m_Capacity, m_Buckets.Data() + m_Capacity); }
+        Iterator begin() { return Iterator(m_Ctrl, m_Slots, 0, m_Capacity); }
+        Iterator end() { return Iterator(m_Ctrl, m_Slots, m_Capacity, m_Capacity); }
 
-        ConstIterator begin() const { return ConstIterator(m_Buckets.Data(), m_Buckets.Data() + m_Capacity); }
-        ConstIterator end() const { return ConstIterator(m_Buckets.Data() + m_Capacity, m_Buckets.Data() + m_Capacity); }
+        ConstIterator begin() const { return ConstIterator(m_Ctrl, m_Slots, 0, m_Capacity); }
+        ConstIterator end() const { return ConstIterator(m_Ctrl, m_Slots, m_Capacity, m_Capacity); }
 
         ConstIterator cbegin() const { return begin(); }
         ConstIterator cend() const { return end(); }
     };
-	
-}
 
+}
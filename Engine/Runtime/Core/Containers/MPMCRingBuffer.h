@@ -0,0 +1,235 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Memory/Allocation.h"
+#include "Threading/Threading.h"
+
+namespace tyr
+{
+    /// Bounded lock-free multi-producer, multi-consumer (MPMC) ring buffer
+    ///
+    /// Based on Dmitry Vyukov's bounded MPMC queue:
+    /// - Every slot has a sequence number that tells producers and consumers whose turn it is.
+    /// - A producer claims a position with a CAS on the enqueue position, writes the value and then publishes it
+    ///   by bumping the slot's sequence. Consumers do the same with the dequeue position.
+    /// - Producers and consumers only touch shared state on their own position and the slots they claim.
+    ///
+    /// The batch functions claim several positions with a single CAS. A claimed slot can still be in use by a thread
+    /// that claimed it on the previous lap, in which case the batch call waits for that thread to finish with it.
+    template<typename T, uint Capacity>
+    class MPMCRingBuffer final
+    {
+    public:
+        MPMCRingBuffer()
+            : m_EnqueuePos(0)
+            , m_DequeuePos(0)
+        {
+            TYR_STATIC_ASSERT(((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of 2");
+            TYR_STATIC_ASSERT(Capacity >= 2, "Capacity must be at least 2");
+
+            for (uint i = 0; i < Capacity; ++i)
+            {
+                m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // Producer-side. Returns false if the buffer is full.
+        bool TryEnqueue(const T& item)
+        {
+            T copy = item;
+            return TryEnqueue(std::move(copy));
+        }
+
+        // Producer-side. Returns false if the buffer is full.
+        bool TryEnqueue(T&& item)
+        {
+            uint64 pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            Slot* slot;
+            while (true)
+            {
+                slot = &m_Slots[pos & c_Mask];
+                const uint64 sequence = slot->sequence.load(std::memory_order_acquire);
+                const int64 diff = static_cast<int64>(sequence) - static_cast<int64>(pos);
+                if (diff == 0)
+                {
+                    if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // Full
+                    return false;
+                }
+                else
+                {
+                    // Another producer claimed the position
+                    pos = m_EnqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->value = std::move(item);
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer-side. Returns nothing if the buffer is empty.
+        Optional<T> TryDequeue()
+        {
+            uint64 pos = m_DequeuePos.load(std::memory_order_relaxed);
+            Slot* slot;
+            while (true)
+            {
+                slot = &m_Slots[pos & c_Mask];
+                const uint64 sequence = slot->sequence.load(std::memory_order_acquire);
+                const int64 diff = static_cast<int64>(sequence) - static_cast<int64>(pos + 1);
+                if (diff == 0)
+                {
+                    if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // Empty
+                    return std::nullopt;
+                }
+                else
+                {
+                    // Another consumer claimed the position
+                    pos = m_DequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            Optional<T> item = std::move(slot->value);
+            slot->sequence.store(pos + Capacity, std::memory_order_release);
+            return item;
+        }
+
+        // Producer-side. Enqueues up to count items in order and returns how many were enqueued.
+        uint TryEnqueueBatch(const T* items, uint count)
+        {
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            uint64 pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            uint claimed;
+            while (true)
+            {
+                const uint64 dequeuePos = m_DequeuePos.load(std::memory_order_acquire);
+                const uint64 used = pos - dequeuePos;
+                if (used >= Capacity)
+                {
+                    // Full, or pos is stale if another producer raced ahead of dequeuePos. Reload and recheck.
+                    const uint64 current = m_EnqueuePos.load(std::memory_order_relaxed);
+                    if (current == pos)
+                    {
+                        return 0;
+                    }
+                    pos = current;
+                    continue;
+                }
+
+                claimed = static_cast<uint>(std::min<uint64>(count, Capacity - used));
+                if (m_EnqueuePos.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+
+            for (uint i = 0; i < claimed; ++i)
+            {
+                Slot& slot = m_Slots[(pos + i) & c_Mask];
+                // Wait for the consumer from the previous lap to finish reading the slot
+                while (slot.sequence.load(std::memory_order_acquire) != pos + i)
+                {
+                    TYR_THREAD_YIELD
+                }
+                slot.value = items[i];
+                slot.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            return claimed;
+        }
+
+        // Consumer-side. Dequeues up to maxCount items in order into items and returns how many were dequeued.
+        uint TryDequeueBatch(T* items, uint maxCount)
+        {
+            if (maxCount == 0)
+            {
+                return 0;
+            }
+
+            uint64 pos = m_DequeuePos.load(std::memory_order_relaxed);
+            uint claimed;
+            while (true)
+            {
+                const uint64 enqueuePos = m_EnqueuePos.load(std::memory_order_acquire);
+                if (enqueuePos <= pos)
+                {
+                    const uint64 current = m_DequeuePos.load(std::memory_order_relaxed);
+                    if (current == pos)
+                    {
+                        return 0;
+                    }
+                    pos = current;
+                    continue;
+                }
+
+                claimed = static_cast<uint>(std::min<uint64>(maxCount, enqueuePos - pos));
+                if (m_DequeuePos.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+
+            for (uint i = 0; i < claimed; ++i)
+            {
+                Slot& slot = m_Slots[(pos + i) & c_Mask];
+                // Wait for the producer that claimed the slot to finish writing it
+                while (slot.sequence.load(std::memory_order_acquire) != pos + i + 1)
+                {
+                    TYR_THREAD_YIELD
+                }
+                items[i] = std::move(slot.value);
+                slot.sequence.store(pos + i + Capacity, std::memory_order_release);
+            }
+            return claimed;
+        }
+
+        // Approximate when other threads are enqueuing or dequeuing
+        uint Size() const
+        {
+            const uint64 dequeuePos = m_DequeuePos.load(std::memory_order_relaxed);
+            const uint64 enqueuePos = m_EnqueuePos.load(std::memory_order_relaxed);
+            return enqueuePos > dequeuePos ? static_cast<uint>(enqueuePos - dequeuePos) : 0u;
+        }
+
+        bool IsEmpty() const
+        {
+            return Size() == 0;
+        }
+
+        static constexpr uint GetCapacity()
+        {
+            return Capacity;
+        }
+
+    private:
+        static constexpr uint64 c_Mask = Capacity - 1;
+
+        struct Slot
+        {
+            Atomic<uint64> sequence;
+            T value;
+        };
+
+        // Positions are on separate cache lines as producers write one and consumers the other
+        alignas(c_CacheLineSize) Atomic<uint64> m_EnqueuePos;
+        alignas(c_CacheLineSize) Atomic<uint64> m_DequeuePos;
+        alignas(c_CacheLineSize) Slot m_Slots[Capacity];
+    };
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Threading/Threading.h"
+
+namespace tyr
+{
+    /// Bounded lock-free work-stealing deque (Chase-Lev).
+    ///
+    /// - Only the owner thread may call Push() and Pop(), which work on the bottom of the deque (LIFO).
+    /// - Any thread may call Steal(), which takes from the top of the deque (FIFO).
+    /// - The owner only contends with thieves when a single item is left.
+    ///
+    /// T must be trivially copyable as slots are read speculatively by thieves. In practice it holds pointers.
+    /// Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al. 2013), without the
+    /// growable array so that slots are never reallocated underneath a thief.
+    template<typename T, uint Capacity>
+    class WorkStealingQueue final
+    {
+    public:
+        WorkStealingQueue()
+            : m_Top(0)
+            , m_Bottom(0)
+        {
+            TYR_STATIC_ASSERT(((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of 2");
+            TYR_STATIC_ASSERT(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+        }
+
+        // Owner-side. Returns false if the deque is full.
+        bool Push(T item)
+        {
+            const int64 bottom = m_Bottom.load(std::memory_order_relaxed);
+            const int64 top = m_Top.load(std::memory_order_acquire);
+            if (bottom - top >= static_cast<int64>(Capacity))
+            {
+                return false;
+            }
+
+            m_Slots[bottom & c_Mask].store(item, std::memory_order_relaxed);
+            // Make the slot visible before the new bottom
+            std::atomic_thread_fence(std::memory_order_release);
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Owner-side. Takes the most recently pushed item.
+        Optional<T> Pop()
+        {
+            const int64 bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+            // The bottom store must be visible to thieves before top is read
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64 top = m_Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                // Empty
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T item = m_Slots[bottom & c_Mask].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // Last item so race any thieves for it
+                const bool won = m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                if (!won)
+                {
+                    return std::nullopt;
+                }
+            }
+            return item;
+        }
+
+        // Thief-side. Can be called from any thread. Returns nothing if the deque is empty or another thread won the item.
+        Optional<T> Steal()
+        {
+            int64 top = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64 bottom = m_Bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+            {
+                return std::nullopt;
+            }
+
+            T item = m_Slots[top & c_Mask].load(std::memory_order_relaxed);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return std::nullopt;
+            }
+            return item;
+        }
+
+        // Approximate when called from a thread other than the owner
+        uint Size() const
+        {
+            const int64 bottom = m_Bottom.load(std::memory_order_relaxed);
+            const int64 top = m_Top.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<uint>(bottom - top) : 0u;
+        }
+
+        bool IsEmpty() const
+        {
+            return Size() == 0;
+        }
+
+    private:
+        static constexpr int64 c_Mask = static_cast<int64>(Capacity) - 1;
+
+        // Top and bottom are on separate cache lines as thieves write top and the owner writes bottom
+        alignas(c_CacheLineSize) Atomic<int64> m_Top;
+        alignas(c_CacheLineSize) Atomic<int64> m_Bottom;
+        alignas(c_CacheLineSize) Atomic<T> m_Slots[Capacity];
+    };
+}
@@ -16,3 +16,6 @@
 #include "Reflection/Reflection.h"
 #include "Reflection/Serializer.h"
 #include "Threading/Task.h"
+#include "Threading/JobSystem.h"
+#include "Threading/Parallel.h"
+#include "Profiling/Profiler.h"
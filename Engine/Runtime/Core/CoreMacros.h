@@ -14,6 +14,7 @@
 
 #define TYR_ARCHITECTURE_x86_32 1
 #define TYR_ARCHITECTURE_x86_64 2
+#define TYR_ARCHITECTURE_ARM64 3
 
 #define TYR_ENDIAN_LITTLE 1
 #define TYR_ENDIAN_BIG 2
@@ -68,6 +69,8 @@
 // Find the architecture type
 #if defined(__x86_64__) || defined(_M_X64)
 #	define TYR_ARCH_TYPE TYR_ARCHITECTURE_x86_64
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#	define TYR_ARCH_TYPE TYR_ARCHITECTURE_ARM64
 #else
 #	define TYR_ARCH_TYPE TYR_ARCHITECTURE_x86_32
 #endif
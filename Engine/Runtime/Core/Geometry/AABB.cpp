@@ -0,0 +1,74 @@
+#include "AABB.h"
+#include "BoundingSphere.h"
+#include "Math/Matrix4.h"
+
+namespace tyr
+{
+	AABB AABB::FromCentreExtents(const Vector3& centre, const Vector3& extents)
+	{
+		return AABB(centre - extents, centre + extents);
+	}
+
+	AABB AABB::CreateEmpty()
+	{
+		const float inf = std::numeric_limits<float>::infinity();
+		return AABB(Vector3(inf, inf, inf), Vector3(-inf, -inf, -inf));
+	}
+
+	bool AABB::Intersects(const AABB& box) const
+	{
+		return m_Min.x <= box.m_Max.x && m_Max.x >= box.m_Min.x &&
+			m_Min.y <= box.m_Max.y && m_Max.y >= box.m_Min.y &&
+			m_Min.z <= box.m_Max.z && m_Max.z >= box.m_Min.z;
+	}
+
+	bool AABB::Intersects(const BoundingSphere& sphere) const
+	{
+		// Distance from the centre to the closest point in the box
+		const Vector3& centre = sphere.GetCentre();
+		float sqrDistance = 0.0f;
+		for (uint i = 0; i < 3; ++i)
+		{
+			if (centre[i] < m_Min[i])
+			{
+				sqrDistance += Math::Sqr(m_Min[i] - centre[i]);
+			}
+			else if (centre[i] > m_Max[i])
+			{
+				sqrDistance += Math::Sqr(centre[i] - m_Max[i]);
+			}
+		}
+		return sqrDistance <= Math::Sqr(sphere.GetRadius());
+	}
+
+	bool AABB::Contains(const Vector3& point) const
+	{
+		return point.x >= m_Min.x && point.x <= m_Max.x &&
+			point.y >= m_Min.y && point.y <= m_Max.y &&
+			point.z >= m_Min.z && point.z <= m_Max.z;
+	}
+
+	bool AABB::Contains(const AABB& box) const
+	{
+		return box.m_Min.x >= m_Min.x && box.m_Max.x <= m_Max.x &&
+			box.m_Min.y >= m_Min.y && box.m_Max.y <= m_Max.y &&
+			box.m_Min.z >= m_Min.z && box.m_Max.z <= m_Max.z;
+	}
+
+	AABB AABB::TransformAffine(const Matrix4& mat) const
+	{
+		const Vector3 centre = GetCentre();
+		const Vector3 extents = GetExtents();
+
+		// Each output extent is the sum of the input extents projected onto that axis
+		Vector3 newCentre;
+		Vector3 newExtents;
+		for (uint i = 0; i < 3; ++i)
+		{
+			newCentre[i] = centre.x * mat[0][i] + centre.y * mat[1][i] + centre.z * mat[2][i] + mat[3][i];
+			newExtents[i] = extents.x * Math::Abs(mat[0][i]) + extents.y * Math::Abs(mat[1][i]) + extents.z * Math::Abs(mat[2][i]);
+		}
+
+		return FromCentreExtents(newCentre, newExtents);
+	}
+}
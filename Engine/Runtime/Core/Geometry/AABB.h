@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Math/Vector3.h"
+#include <algorithm>
+
+namespace tyr
+{
+	class BoundingSphere;
+	class Matrix4;
+
+	/// An axis aligned bounding box represented by its minimum and maximum corners
+	class TYR_CORE_EXPORT AABB
+	{
+	public:
+		AABB() = default;
+
+		AABB(const AABB& copy) = default;
+
+		AABB(const Vector3& min, const Vector3& max)
+			: m_Min(min), m_Max(max)
+		{ }
+
+		/// Creates a box from its centre and half of its size along each axis
+		static AABB FromCentreExtents(const Vector3& centre, const Vector3& extents);
+
+		/// Creates an inverted box that becomes the bounds of whatever is merged into it
+		static AABB CreateEmpty();
+
+		bool Intersects(const AABB& box) const;
+
+		bool Intersects(const BoundingSphere& sphere) const;
+
+		bool Contains(const Vector3& point) const;
+
+		bool Contains(const AABB& box) const;
+
+		/// Grows the box so that it contains the point.
+		void Merge(const Vector3& point)
+		{
+			m_Min = Vector3(std::min(m_Min.x, point.x), std::min(m_Min.y, point.y), std::min(m_Min.z, point.z));
+			m_Max = Vector3(std::max(m_Max.x, point.x), std::max(m_Max.y, point.y), std::max(m_Max.z, point.z));
+		}
+
+		/// Grows the box so that it contains the other box.
+		void Merge(const AABB& box)
+		{
+			m_Min = Vector3(std::min(m_Min.x, box.m_Min.x), std::min(m_Min.y, box.m_Min.y), std::min(m_Min.z, box.m_Min.z));
+			m_Max = Vector3(std::max(m_Max.x, box.m_Max.x), std::max(m_Max.y, box.m_Max.y), std::max(m_Max.z, box.m_Max.z));
+		}
+
+		float GetSurfaceArea() const
+		{
+			const Vector3 size = m_Max - m_Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		/// Returns the smallest box containing this box transformed by an affine 4x4 matrix.
+		AABB TransformAffine(const Matrix4& mat) const;
+
+		bool operator==(const AABB& rhs) const
+		{
+			return (rhs.m_Min == m_Min && rhs.m_Max == m_Max);
+		}
+
+		bool operator!=(const AABB& rhs) const
+		{
+			return (rhs.m_Min != m_Min || rhs.m_Max != m_Max);
+		}
+
+		Vector3 GetCentre() const { return (m_Min + m_Max) * 0.5f; }
+
+		/// Returns half of the size of the box along each axis
+		Vector3 GetExtents() const { return (m_Max - m_Min) * 0.5f; }
+
+		void SetMin(const Vector3& min) { m_Min = min; }
+
+		const Vector3& GetMin() const { return m_Min; }
+
+		void SetMax(const Vector3& max) { m_Max = max; }
+
+		const Vector3& GetMax() const { return m_Max; }
+
+	private:
+		Vector3 m_Min;
+		Vector3 m_Max;
+	};
+
+}
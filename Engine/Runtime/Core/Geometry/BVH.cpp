@@ -0,0 +1,349 @@
+#include "BVH.h"
+#include "Threading/Parallel.h"
+#include "Threading/Threading.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// Relative costs of visiting a node and of testing a primitive
+		constexpr float c_TraversalCost = 1.0f;
+		constexpr float c_IntersectionCost = 1.0f;
+
+		// Primitives are partitioned by value rather than through their indices so that every pass over a node's
+		// range reads contiguous memory
+		struct PrimitiveRef
+		{
+			AABB bounds;
+			Vector3 centroid;
+			uint index;
+		};
+
+		struct BuildContext
+		{
+			PrimitiveRef* primitives;
+			BVH::Node* nodes;
+			Atomic<uint> nodeCount;
+		};
+
+		struct RangeBounds
+		{
+			AABB bounds;
+			AABB centroidBounds;
+		};
+
+		struct Bin
+		{
+			AABB bounds;
+			uint count;
+		};
+
+		struct BinSet
+		{
+			Bin bins[3][BVH::c_BinCount];
+		};
+
+		struct Split
+		{
+			uint axis;
+			uint bin;
+			float cost;
+		};
+
+		RangeBounds MergeRangeBounds(const RangeBounds& a, const RangeBounds& b)
+		{
+			RangeBounds result = a;
+			result.bounds.Merge(b.bounds);
+			result.centroidBounds.Merge(b.centroidBounds);
+			return result;
+		}
+
+		RangeBounds ComputeRangeBounds(const BuildContext& context, uint first, uint count)
+		{
+			const RangeBounds empty = { AABB::CreateEmpty(), AABB::CreateEmpty() };
+			auto map = [&](uint i)
+			{
+				const PrimitiveRef& primitive = context.primitives[first + i];
+				return RangeBounds { primitive.bounds, AABB(primitive.centroid, primitive.centroid) };
+			};
+
+			if (count >= BVH::c_ParallelBuildThreshold)
+			{
+				return ParallelReduce(count, empty, map, &MergeRangeBounds);
+			}
+
+			RangeBounds result = empty;
+			for (uint i = 0; i < count; ++i)
+			{
+				result = MergeRangeBounds(result, map(i));
+			}
+			return result;
+		}
+
+		TYR_FORCEINLINE uint GetBinIndex(float centroid, float min, float scale)
+		{
+			const uint bin = static_cast<uint>((centroid - min) * scale);
+			return std::min(bin, BVH::c_BinCount - 1);
+		}
+
+		BinSet CreateEmptyBinSet()
+		{
+			BinSet binSet;
+			for (uint axis = 0; axis < 3; ++axis)
+			{
+				for (Bin& bin : binSet.bins[axis])
+				{
+					bin.bounds = AABB::CreateEmpty();
+					bin.count = 0;
+				}
+			}
+			return binSet;
+		}
+
+		BinSet MergeBinSets(const BinSet& a, const BinSet& b)
+		{
+			BinSet result = a;
+			for (uint axis = 0; axis < 3; ++axis)
+			{
+				for (uint i = 0; i < BVH::c_BinCount; ++i)
+				{
+					result.bins[axis][i].bounds.Merge(b.bins[axis][i].bounds);
+					result.bins[axis][i].count += b.bins[axis][i].count;
+				}
+			}
+			return result;
+		}
+
+		void AddToBins(const PrimitiveRef& primitive, const Vector3& min, const Vector3& scale, BinSet& binSet)
+		{
+			for (uint axis = 0; axis < 3; ++axis)
+			{
+				Bin& bin = binSet.bins[axis][GetBinIndex(primitive.centroid[axis], min[axis], scale[axis])];
+				bin.bounds.Merge(primitive.bounds);
+				bin.count++;
+			}
+		}
+
+		// Returns the split with the lowest surface area heuristic cost. The split puts bins below the bin index on the left.
+		Split FindSplit(const BuildContext& context, uint first, uint count, const AABB& centroidBounds, float parentArea)
+		{
+			const Vector3& min = centroidBounds.GetMin();
+			const Vector3 extent = centroidBounds.GetMax() - min;
+			Vector3 scale;
+			for (uint axis = 0; axis < 3; ++axis)
+			{
+				scale[axis] = extent[axis] > 0.0f ? BVH::c_BinCount / extent[axis] : 0.0f;
+			}
+
+			BinSet binSet;
+			if (count >= BVH::c_ParallelBuildThreshold)
+			{
+				const uint chunkCount = Parallel::ComputeChunkCount(count);
+				binSet = ParallelReduce(chunkCount, CreateEmptyBinSet(), [&](uint chunk)
+				{
+					BinSet chunkBins = CreateEmptyBinSet();
+					const uint end = first + Parallel::GetChunkBegin(chunk + 1, chunkCount, count);
+					for (uint i = first + Parallel::GetChunkBegin(chunk, chunkCount, count); i < end; ++i)
+					{
+						AddToBins(context.primitives[i], min, scale, chunkBins);
+					}
+					return chunkBins;
+				}, &MergeBinSets, 1);
+			}
+			else
+			{
+				binSet = CreateEmptyBinSet();
+				for (uint i = first; i < first + count; ++i)
+				{
+					AddToBins(context.primitives[i], min, scale, binSet);
+				}
+			}
+
+			Split best = { 0, 0, std::numeric_limits<float>::max() };
+			for (uint axis = 0; axis < 3; ++axis)
+			{
+				if (extent[axis] <= 0.0f)
+				{
+					continue;
+				}
+
+				// Sweep from the right to get the area and count to the right of every split
+				const Bin* bins = binSet.bins[axis];
+				float rightCost[BVH::c_BinCount];
+				AABB rightBounds = AABB::CreateEmpty();
+				uint rightCount = 0;
+				for (uint i = BVH::c_BinCount - 1; i > 0; --i)
+				{
+					rightBounds.Merge(bins[i].bounds);
+					rightCount += bins[i].count;
+					rightCost[i] = rightCount > 0 ? rightBounds.GetSurfaceArea() * rightCount : 0.0f;
+				}
+
+				AABB leftBounds = AABB::CreateEmpty();
+				uint leftCount = 0;
+				for (uint i = 1; i < BVH::c_BinCount; ++i)
+				{
+					leftBounds.Merge(bins[i - 1].bounds);
+					leftCount += bins[i - 1].count;
+					if (leftCount == 0 || leftCount == count)
+					{
+						continue;
+					}
+
+					const float cost = c_TraversalCost + c_IntersectionCost * (leftBounds.GetSurfaceArea() * leftCount + rightCost[i]) / parentArea;
+					if (cost < best.cost)
+					{
+						best = { axis, i, cost };
+					}
+				}
+			}
+			return best;
+		}
+
+		void MakeLeaf(BVH::Node& node, uint first, uint count)
+		{
+			node.leftOrFirst = first;
+			node.primitiveCount = count;
+		}
+
+		void BuildNode(BuildContext& context, uint nodeIndex, uint first, uint count, uint depth)
+		{
+			BVH::Node& node = context.nodes[nodeIndex];
+			const RangeBounds rangeBounds = ComputeRangeBounds(context, first, count);
+			node.boundsMin = rangeBounds.bounds.GetMin();
+			node.boundsMax = rangeBounds.bounds.GetMax();
+
+			if (count == 1 || depth + 1 >= BVH::c_MaxDepth)
+			{
+				MakeLeaf(node, first, count);
+				return;
+			}
+
+			PrimitiveRef* begin = context.primitives + first;
+			PrimitiveRef* end = begin + count;
+			PrimitiveRef* middle = nullptr;
+			const float parentArea = rangeBounds.bounds.GetSurfaceArea();
+			const Split split = parentArea > 0.0f
+				? FindSplit(context, first, count, rangeBounds.centroidBounds, parentArea)
+				: Split { 0, 0, std::numeric_limits<float>::max() };
+
+			if (split.cost < c_IntersectionCost * count || (count > BVH::c_MaxLeafSize && split.bin > 0))
+			{
+				const float min = rangeBounds.centroidBounds.GetMin()[split.axis];
+				const float extent = rangeBounds.centroidBounds.GetMax()[split.axis] - min;
+				const float scale = BVH::c_BinCount / extent;
+				middle = std::partition(begin, end, [&](const PrimitiveRef& primitive)
+				{
+					return GetBinIndex(primitive.centroid[split.axis], min, scale) < split.bin;
+				});
+			}
+			else if (count > BVH::c_MaxLeafSize)
+			{
+				// The centroids can't be separated by the bins so split at the median of the widest axis
+				const Vector3 extent = rangeBounds.centroidBounds.GetMax() - rangeBounds.centroidBounds.GetMin();
+				const uint axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+				middle = begin + count / 2;
+				std::nth_element(begin, middle, end, [&](const PrimitiveRef& a, const PrimitiveRef& b)
+				{
+					return a.centroid[axis] < b.centroid[axis];
+				});
+			}
+			else
+			{
+				MakeLeaf(node, first, count);
+				return;
+			}
+
+			const uint leftCount = static_cast<uint>(middle - begin);
+			TYR_ASSERT(leftCount > 0 && leftCount < count);
+
+			const uint leftIndex = context.nodeCount.fetch_add(2, std::memory_order_relaxed);
+			node.leftOrFirst = leftIndex;
+			node.primitiveCount = 0;
+
+			if (count >= BVH::c_ParallelBuildThreshold)
+			{
+				ParallelFor(2, [&](uint child)
+				{
+					if (child == 0)
+					{
+						BuildNode(context, leftIndex, first, leftCount, depth + 1);
+					}
+					else
+					{
+						BuildNode(context, leftIndex + 1, first + leftCount, count - leftCount, depth + 1);
+					}
+				}, 1);
+			}
+			else
+			{
+				BuildNode(context, leftIndex, first, leftCount, depth + 1);
+				BuildNode(context, leftIndex + 1, first + leftCount, count - leftCount, depth + 1);
+			}
+		}
+	}
+
+	void BVH::Build(const AABB* bounds, uint count)
+	{
+		m_Nodes.Clear();
+		m_PrimitiveIndices.Resize(count);
+		if (count == 0)
+		{
+			return;
+		}
+
+		Array<PrimitiveRef> primitives;
+		primitives.Resize(count);
+		ParallelForRange(count, [&](uint begin, uint end)
+		{
+			for (uint i = begin; i < end; ++i)
+			{
+				primitives[i] = { bounds[i], bounds[i].GetCentre(), i };
+			}
+		});
+
+		BuildContext context;
+		context.primitives = primitives.Data();
+
+		// A binary tree with count leaves has at most 2 * count - 1 nodes
+		m_Nodes.Resize(2 * count - 1);
+		context.nodes = m_Nodes.Data();
+		context.nodeCount.store(1, std::memory_order_relaxed);
+		BuildNode(context, 0, 0, count, 0);
+		m_Nodes.Resize(context.nodeCount.load(std::memory_order_relaxed));
+
+		ParallelForRange(count, [&](uint begin, uint end)
+		{
+			for (uint i = begin; i < end; ++i)
+			{
+				m_PrimitiveIndices[i] = primitives[i].index;
+			}
+		});
+	}
+
+	void BVH::Refit(const AABB* bounds)
+	{
+		// Children always come after their parent so a reverse pass updates them first
+		for (uint i = m_Nodes.Size(); i-- > 0;)
+		{
+			Node& node = m_Nodes[i];
+			AABB nodeBounds = AABB::CreateEmpty();
+			if (node.IsLeaf())
+			{
+				for (uint j = node.leftOrFirst; j < node.leftOrFirst + node.primitiveCount; ++j)
+				{
+					nodeBounds.Merge(bounds[m_PrimitiveIndices[j]]);
+				}
+			}
+			else
+			{
+				const Node& left = m_Nodes[node.leftOrFirst];
+				const Node& right = m_Nodes[node.leftOrFirst + 1];
+				nodeBounds = AABB(left.boundsMin, left.boundsMax);
+				nodeBounds.Merge(AABB(right.boundsMin, right.boundsMax));
+			}
+			node.boundsMin = nodeBounds.GetMin();
+			node.boundsMax = nodeBounds.GetMax();
+		}
+	}
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Containers/Array.h"
+#include "AABB.h"
+#include "Ray.h"
+#include <algorithm>
+#include <limits>
+
+namespace tyr
+{
+	/// Closest hit found by a ray query
+	struct RayHit
+	{
+		float distance;
+		// Index of the primitive as passed to the build
+		uint primitive;
+		// Barycentric coordinates of the hit point on a triangle
+		float u;
+		float v;
+	};
+
+	/// 8 rays stored as arrays of components so that they can be tested together. Rays with a max distance of zero
+	/// never hit anything, which can be used for packets that are not full.
+	struct alignas(32) RayPacket8
+	{
+		static constexpr uint c_RayCount = 8;
+
+		float originX[c_RayCount];
+		float originY[c_RayCount];
+		float originZ[c_RayCount];
+		float directionX[c_RayCount];
+		float directionY[c_RayCount];
+		float directionZ[c_RayCount];
+		float maxDistance[c_RayCount];
+
+		void SetRay(uint index, const Ray& ray, float distance)
+		{
+			TYR_ASSERT(index < c_RayCount);
+			originX[index] = ray.GetOrigin().x;
+			originY[index] = ray.GetOrigin().y;
+			originZ[index] = ray.GetOrigin().z;
+			directionX[index] = ray.GetDirection().x;
+			directionY[index] = ray.GetDirection().y;
+			directionZ[index] = ray.GetDirection().z;
+			maxDistance[index] = distance;
+		}
+	};
+
+	/// Bounding volume hierarchy over boxes, such as the bounds of scene instances or of triangles.
+	///
+	/// Splits are chosen with the surface area heuristic evaluated on c_BinCount bins per axis. Large nodes are binned
+	/// and their subtrees built in parallel on the job system. The nodes are stored in one array with the children of
+	/// a node next to each other and after their parent.
+	class TYR_CORE_EXPORT BVH
+	{
+	public:
+		/// 32 byte node. Interior nodes have a primitive count of zero.
+		struct Node
+		{
+			Vector3 boundsMin;
+			// Index of the first child for interior nodes and of the first primitive for leaves. The second child
+			// follows the first.
+			uint leftOrFirst;
+			Vector3 boundsMax;
+			uint primitiveCount;
+
+			bool IsLeaf() const { return primitiveCount > 0; }
+		};
+
+		static constexpr uint c_BinCount = 16;
+		// Nodes with more primitives than this are always split
+		static constexpr uint c_MaxLeafSize = 8;
+		// Nodes with at least this many primitives are binned and split in parallel
+		static constexpr uint c_ParallelBuildThreshold = 8192;
+		// Deepest a leaf can be, which is also the traversal stack size
+		static constexpr uint c_MaxDepth = 64;
+		static constexpr float c_NoHit = std::numeric_limits<float>::infinity();
+
+		/// Builds the hierarchy over count boxes. Previous contents are discarded.
+		void Build(const AABB* bounds, uint count);
+
+		/// Updates the node bounds after the boxes have changed without rebuilding. bounds must hold the same number of
+		/// boxes as the build. The tree gets less efficient the further the boxes move from where they were built.
+		void Refit(const AABB* bounds);
+
+		/// Finds the closest primitive hit by the ray. intersect(primitive, distance) tests the ray against the primitive
+		/// and returns true with the distance to it if it is hit.
+		template<typename IntersectFunc>
+		bool Raycast(const Ray& ray, float maxDistance, RayHit& hit, IntersectFunc&& intersect) const
+		{
+			bool found = false;
+			TraverseRay(ray.GetOrigin(), ray.GetDirection(), maxDistance, [&](uint first, uint count)
+			{
+				for (uint i = first; i < first + count; ++i)
+				{
+					const uint primitive = m_PrimitiveIndices[i];
+					float distance;
+					if (intersect(primitive, distance) && distance < maxDistance)
+					{
+						maxDistance = distance;
+						hit.distance = distance;
+						hit.primitive = primitive;
+						hit.u = 0.0f;
+						hit.v = 0.0f;
+						found = true;
+					}
+				}
+				return false;
+			});
+			return found;
+		}
+
+		/// Returns true as soon as any primitive is hit closer than maxDistance. Same callback as Raycast().
+		template<typename IntersectFunc>
+		bool RaycastAny(const Ray& ray, float maxDistance, IntersectFunc&& intersect) const
+		{
+			bool found = false;
+			TraverseRay(ray.GetOrigin(), ray.GetDirection(), maxDistance, [&](uint first, uint count)
+			{
+				for (uint i = first; i < first + count; ++i)
+				{
+					float distance;
+					if (intersect(m_PrimitiveIndices[i], distance) && distance < maxDistance)
+					{
+						found = true;
+						return true;
+					}
+				}
+				return false;
+			});
+			return found;
+		}
+
+		/// Visits the leaves hit by the ray, nearest first where possible. leaf(first, count) gets a range of
+		/// GetPrimitiveIndices() and returns true to stop. It may lower maxDistance to skip nodes further away.
+		template<typename LeafFunc>
+		void TraverseRay(const Vector3& origin, const Vector3& direction, float& maxDistance, LeafFunc&& leaf) const
+		{
+			if (m_Nodes.Size() == 0)
+			{
+				return;
+			}
+
+			const Vector3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+			struct StackEntry
+			{
+				uint node;
+				float distance;
+			};
+			StackEntry stack[c_MaxDepth];
+			uint stackSize = 0;
+
+			uint nodeIndex = 0;
+			if (IntersectNode(m_Nodes[0], origin, invDirection, maxDistance) == c_NoHit)
+			{
+				return;
+			}
+
+			while (true)
+			{
+				const Node& node = m_Nodes[nodeIndex];
+				if (node.IsLeaf())
+				{
+					if (leaf(node.leftOrFirst, node.primitiveCount))
+					{
+						return;
+					}
+				}
+				else
+				{
+					uint nearIndex = node.leftOrFirst;
+					uint farIndex = nearIndex + 1;
+					float nearDistance = IntersectNode(m_Nodes[nearIndex], origin, invDirection, maxDistance);
+					float farDistance = IntersectNode(m_Nodes[farIndex], origin, invDirection, maxDistance);
+					if (farDistance < nearDistance)
+					{
+						std::swap(nearIndex, farIndex);
+						std::swap(nearDistance, farDistance);
+					}
+
+					if (nearDistance != c_NoHit)
+					{
+						if (farDistance != c_NoHit)
+						{
+							stack[stackSize++] = { farIndex, farDistance };
+						}
+						nodeIndex = nearIndex;
+						continue;
+					}
+				}
+
+				// Skip nodes that are further than a hit found since they were pushed
+				do
+				{
+					if (stackSize == 0)
+					{
+						return;
+					}
+					--stackSize;
+				} while (stack[stackSize].distance >= maxDistance);
+				nodeIndex = stack[stackSize].node;
+			}
+		}
+
+		/// Returns the distance along the ray to where it enters the node or c_NoHit if it misses or only enters
+		/// beyond maxDistance.
+		static TYR_FORCEINLINE float IntersectNode(const Node& node, const Vector3& origin, const Vector3& invDirection, float maxDistance)
+		{
+			const float tx1 = (node.boundsMin.x - origin.x) * invDirection.x;
+			const float tx2 = (node.boundsMax.x - origin.x) * invDirection.x;
+			const float ty1 = (node.boundsMin.y - origin.y) * invDirection.y;
+			const float ty2 = (node.boundsMax.y - origin.y) * invDirection.y;
+			const float tz1 = (node.boundsMin.z - origin.z) * invDirection.z;
+			const float tz2 = (node.boundsMax.z - origin.z) * invDirection.z;
+
+			const float entry = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+			const float exit = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), maxDistance));
+			return entry <= exit && entry < maxDistance ? entry : c_NoHit;
+		}
+
+		const Array<Node>& GetNodes() const { return m_Nodes; }
+
+		/// Primitive indices in leaf order. Leaves refer to ranges of this array.
+		const Array<uint>& GetPrimitiveIndices() const { return m_PrimitiveIndices; }
+
+		uint GetPrimitiveCount() const { return m_PrimitiveIndices.Size(); }
+
+	private:
+		Array<Node> m_Nodes;
+		Array<uint> m_PrimitiveIndices;
+	};
+}
@@ -0,0 +1,222 @@
+#include "Frustum.h"
+#include "AABB.h"
+#include "BoundingSphere.h"
+#include "Math/Matrix4.h"
+#include "Math/MathKernels.h"
+#include "Math/Vector3SoA.h"
+#include "Threading/Parallel.h"
+#include <cmath>
+#include <cstring>
+
+namespace tyr
+{
+	namespace
+	{
+		// Creates a plane from the coefficients of ax + by + cz + d >= 0 with a normalized normal
+		Plane CreateNormalizedPlane(float a, float b, float c, float d)
+		{
+			const float invLength = 1.0f / Vector3(a, b, c).Length();
+			return Plane(a * invLength, b * invLength, c * invLength, -d * invLength);
+		}
+
+		// Finds the point where three planes meet. Returns false if they don't meet in a single finite point.
+		bool IntersectPlanes(const Plane& p0, const Plane& p1, const Plane& p2, Vector3& point)
+		{
+			const Vector3 cross12 = p1.GetNormal().Cross(p2.GetNormal());
+			const float det = p0.GetNormal().Dot(cross12);
+			if (Math::Abs(det) < 1e-6f)
+			{
+				return false;
+			}
+			const Vector3 cross20 = p2.GetNormal().Cross(p0.GetNormal());
+			const Vector3 cross01 = p0.GetNormal().Cross(p1.GetNormal());
+			point = (cross12 * p0.GetDistance() + cross20 * p1.GetDistance() + cross01 * p2.GetDistance()) / det;
+			return std::isfinite(point.x) && std::isfinite(point.y) && std::isfinite(point.z);
+		}
+
+#if TYR_USE_SIMD
+		// Stores the planes as normal x, y, z and distance for the culling kernels
+		void StorePlanes(const Plane* planes, float* output)
+		{
+			for (uint i = 0; i < Frustum::c_PlaneCount; ++i, output += 4)
+			{
+				const Vector3& normal = planes[i].GetNormal();
+				output[0] = normal.x;
+				output[1] = normal.y;
+				output[2] = normal.z;
+				output[3] = planes[i].GetDistance();
+			}
+		}
+#endif
+
+		// Calls cull(begin, end, visibleIndices) on chunks of the volumes and packs the results together.
+		template<typename CullFunc>
+		uint CullChunks(uint count, uint* visibleIndices, CullFunc&& cull)
+		{
+			// Chunks start on a multiple of 8 so that the kernels can use aligned loads
+			constexpr uint c_GroupSize = 8;
+			const uint groupCount = (count + c_GroupSize - 1) / c_GroupSize;
+			const uint chunkCount = Parallel::ComputeChunkCount(groupCount, Frustum::c_CullGrainSize / c_GroupSize);
+			if (chunkCount <= 1)
+			{
+				return cull(0, count, visibleIndices);
+			}
+
+			// Each chunk writes its indices to the start of its own range, which can't overlap the other chunks
+			Array<uint> visibleCounts(chunkCount);
+			ParallelFor(chunkCount, [&](uint chunk)
+			{
+				const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, groupCount) * c_GroupSize;
+				const uint end = std::min(Parallel::GetChunkBegin(chunk + 1, chunkCount, groupCount) * c_GroupSize, count);
+				visibleCounts[chunk] = cull(begin, end, visibleIndices + begin);
+			}, 1);
+
+			uint visibleCount = visibleCounts[0];
+			for (uint chunk = 1; chunk < chunkCount; ++chunk)
+			{
+				const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, groupCount) * c_GroupSize;
+				std::memmove(visibleIndices + visibleCount, visibleIndices + begin, visibleCounts[chunk] * sizeof(uint));
+				visibleCount += visibleCounts[chunk];
+			}
+			return visibleCount;
+		}
+	}
+
+	Frustum::Frustum(const Matrix4& viewProj)
+	{
+		// Points are row vectors so each clip space component is a dot product with a column of the matrix
+		const Matrix4& m = viewProj;
+		m_Planes[c_LeftPlane] = CreateNormalizedPlane(m[0][3] + m[0][0], m[1][3] + m[1][0], m[2][3] + m[2][0], m[3][3] + m[3][0]);
+		m_Planes[c_RightPlane] = CreateNormalizedPlane(m[0][3] - m[0][0], m[1][3] - m[1][0], m[2][3] - m[2][0], m[3][3] - m[3][0]);
+		m_Planes[c_BottomPlane] = CreateNormalizedPlane(m[0][3] + m[0][1], m[1][3] + m[1][1], m[2][3] + m[2][1], m[3][3] + m[3][1]);
+		m_Planes[c_TopPlane] = CreateNormalizedPlane(m[0][3] - m[0][1], m[1][3] - m[1][1], m[2][3] - m[2][1], m[3][3] - m[3][1]);
+		m_Planes[c_NearPlane] = CreateNormalizedPlane(m[0][2], m[1][2], m[2][2], m[3][2]);
+		m_Planes[c_FarPlane] = CreateNormalizedPlane(m[0][3] - m[0][2], m[1][3] - m[1][2], m[2][3] - m[2][2], m[3][3] - m[3][2]);
+	}
+
+	bool Frustum::Intersects(const BoundingSphere& sphere) const
+	{
+		for (const Plane& plane : m_Planes)
+		{
+			if (plane.GetDistanceFromPoint(sphere.GetCentre()) < -sphere.GetRadius())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Frustum::Intersects(const AABB& box) const
+	{
+		return IntersectsBox(box.GetCentre(), box.GetExtents());
+	}
+
+	bool Frustum::Contains(const AABB& box) const
+	{
+		const Vector3 centre = box.GetCentre();
+		const Vector3 extents = box.GetExtents();
+		for (const Plane& plane : m_Planes)
+		{
+			// The corner furthest against the normal must be inside too
+			const Vector3& normal = plane.GetNormal();
+			const float radius = Math::Abs(normal.x) * extents.x + Math::Abs(normal.y) * extents.y + Math::Abs(normal.z) * extents.z;
+			if (plane.GetDistanceFromPoint(centre) < radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Frustum::GetBounds(AABB& bounds) const
+	{
+		bounds = AABB::CreateEmpty();
+		const uint sidePlanes[2][2] = { { c_LeftPlane, c_RightPlane }, { c_BottomPlane, c_TopPlane } };
+		for (uint depthPlane : { c_NearPlane, c_FarPlane })
+		{
+			for (uint x = 0; x < 2; ++x)
+			{
+				for (uint y = 0; y < 2; ++y)
+				{
+					Vector3 corner;
+					if (!IntersectPlanes(m_Planes[sidePlanes[0][x]], m_Planes[sidePlanes[1][y]], m_Planes[depthPlane], corner))
+					{
+						return false;
+					}
+					bounds.Merge(corner);
+				}
+			}
+		}
+		return true;
+	}
+
+	bool Frustum::IntersectsBox(const Vector3& centre, const Vector3& extents) const
+	{
+		for (const Plane& plane : m_Planes)
+		{
+			// Distance from the centre to the corner furthest along the normal
+			const Vector3& normal = plane.GetNormal();
+			const float radius = Math::Abs(normal.x) * extents.x + Math::Abs(normal.y) * extents.y + Math::Abs(normal.z) * extents.z;
+			if (plane.GetDistanceFromPoint(centre) < -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	uint Frustum::CullSpheres(const Vector3SoA& centres, const float* radii, uint* visibleIndices) const
+	{
+#if TYR_USE_SIMD
+		float planes[c_PlaneCount * 4];
+		StorePlanes(m_Planes, planes);
+
+		const MathKernels& kernels = GetMathKernels();
+		return CullChunks(centres.Size(), visibleIndices, [&](uint begin, uint end, uint* visible)
+		{
+			return kernels.cullSpheres(planes, centres.X(), radii, centres.PaddedSize(), begin, end, visible);
+		});
+#else
+		return CullChunks(centres.Size(), visibleIndices, [&](uint begin, uint end, uint* visible)
+		{
+			uint visibleCount = 0;
+			for (uint i = begin; i < end; ++i)
+			{
+				if (Intersects(BoundingSphere(centres.Get(i), radii[i])))
+				{
+					visible[visibleCount++] = i;
+				}
+			}
+			return visibleCount;
+		});
+#endif
+	}
+
+	uint Frustum::CullBoxes(const Vector3SoA& centres, const Vector3SoA& extents, uint* visibleIndices) const
+	{
+		TYR_ASSERT(centres.Size() == extents.Size());
+#if TYR_USE_SIMD
+		float planes[c_PlaneCount * 4];
+		StorePlanes(m_Planes, planes);
+
+		const MathKernels& kernels = GetMathKernels();
+		return CullChunks(centres.Size(), visibleIndices, [&](uint begin, uint end, uint* visible)
+		{
+			return kernels.cullBoxes(planes, centres.X(), extents.X(), centres.PaddedSize(), begin, end, visible);
+		});
+#else
+		return CullChunks(centres.Size(), visibleIndices, [&](uint begin, uint end, uint* visible)
+		{
+			uint visibleCount = 0;
+			for (uint i = begin; i < end; ++i)
+			{
+				if (IntersectsBox(centres.Get(i), extents.Get(i)))
+				{
+					visible[visibleCount++] = i;
+				}
+			}
+			return visibleCount;
+		});
+#endif
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Plane.h"
+
+namespace tyr
+{
+	class Matrix4;
+	class BoundingSphere;
+	class AABB;
+	class Vector3SoA;
+
+	/// A view frustum represented by 6 planes whose normals point inwards
+	class TYR_CORE_EXPORT Frustum
+	{
+	public:
+		enum PlaneIndex : uint
+		{
+			c_LeftPlane = 0,
+			c_RightPlane,
+			c_BottomPlane,
+			c_TopPlane,
+			c_NearPlane,
+			c_FarPlane,
+			c_PlaneCount
+		};
+
+		// Culling splits the volumes into chunks of at least this many for the job system
+		static constexpr uint c_CullGrainSize = 4096;
+
+		Frustum() = default;
+
+		Frustum(const Frustum& frustum) = default;
+
+		/// Extracts the planes from a view projection matrix that maps depth to [0, 1]. With reverse-z the near and far
+		/// planes are swapped.
+		explicit Frustum(const Matrix4& viewProj);
+
+		bool Intersects(const BoundingSphere& sphere) const;
+
+		bool Intersects(const AABB& box) const;
+
+		/// Returns true if the box is entirely inside the frustum.
+		bool Contains(const AABB& box) const;
+
+		/// Computes the box around the corners of the frustum. Returns false if the frustum has no finite corners, which is
+		/// the case with an infinite far plane.
+		bool GetBounds(AABB& bounds) const;
+
+		/// Writes the indices of the spheres that intersect the frustum to visibleIndices in increasing order and returns
+		/// the number written. radii must be 32 byte aligned and hold centres.PaddedSize() floats. visibleIndices must
+		/// hold centres.Size() indices.
+		uint CullSpheres(const Vector3SoA& centres, const float* radii, uint* visibleIndices) const;
+
+		/// Same as CullSpheres() for boxes given by their centres and half sizes. Both streams must have the same size.
+		uint CullBoxes(const Vector3SoA& centres, const Vector3SoA& extents, uint* visibleIndices) const;
+
+		const Plane& GetPlane(uint index) const { return m_Planes[index]; }
+
+	private:
+		bool IntersectsBox(const Vector3& centre, const Vector3& extents) const;
+
+		Plane m_Planes[c_PlaneCount];
+	};
+
+}
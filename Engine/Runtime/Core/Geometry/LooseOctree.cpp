@@ -0,0 +1,193 @@
+#include "LooseOctree.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// Index of the child whose cell contains the point
+		uint GetChildIndex(const Vector3& centre, const Vector3& point)
+		{
+			return (point.x >= centre.x ? 1 : 0) | (point.y >= centre.y ? 2 : 0) | (point.z >= centre.z ? 4 : 0);
+		}
+	}
+
+	LooseOctree::LooseOctree(const Vector3& centre, float halfSize, uint maxDepth)
+		: m_MaxDepth(maxDepth)
+	{
+		CreateNode(centre, halfSize, 0, c_NoNode);
+	}
+
+	LooseOctree::~LooseOctree()
+	{
+		Clear();
+	}
+
+	void LooseOctree::Clear()
+	{
+		for (const Node& node : m_Nodes)
+		{
+			for (uint handle : node.objects)
+			{
+				DeleteObject(handle);
+			}
+		}
+
+		const Vector3 centre = m_Nodes[0].centre;
+		const float halfSize = m_Nodes[0].halfSize;
+		m_Nodes.Clear();
+		CreateNode(centre, halfSize, 0, c_NoNode);
+	}
+
+	uint LooseOctree::CreateNode(const Vector3& centre, float halfSize, uint depth, uint parent)
+	{
+		const uint index = m_Nodes.Size();
+		m_Nodes.Add(Node());
+		Node& node = m_Nodes.Back();
+		node.centre = centre;
+		node.halfSize = halfSize;
+		node.depth = depth;
+		node.parent = parent;
+		for (uint& child : node.children)
+		{
+			child = c_NoNode;
+		}
+		node.subtreeObjectCount = 0;
+		return index;
+	}
+
+	uint LooseOctree::GetTargetDepth(const AABB& bounds) const
+	{
+		const Node& root = m_Nodes[0];
+		if (!IsInCell(root, bounds.GetCentre()))
+		{
+			return 0;
+		}
+
+		// Objects fit in the loose bounds of any node whose half size is at least their largest extent
+		const Vector3 extents = bounds.GetExtents();
+		const float size = std::max(std::max(extents.x, extents.y), extents.z);
+		uint depth = 0;
+		float halfSize = root.halfSize * 0.5f;
+		while (depth < m_MaxDepth && size <= halfSize)
+		{
+			++depth;
+			halfSize *= 0.5f;
+		}
+		return depth;
+	}
+
+	bool LooseOctree::IsInCell(const Node& node, const Vector3& point) const
+	{
+		return Math::Abs(point.x - node.centre.x) <= node.halfSize
+			&& Math::Abs(point.y - node.centre.y) <= node.halfSize
+			&& Math::Abs(point.z - node.centre.z) <= node.halfSize;
+	}
+
+	void LooseOctree::Link(uint handle, Object& object)
+	{
+		const Vector3 centre = object.bounds.GetCentre();
+		const uint depth = GetTargetDepth(object.bounds);
+		uint nodeIndex = 0;
+		while (m_Nodes[nodeIndex].depth < depth)
+		{
+			m_Nodes[nodeIndex].subtreeObjectCount++;
+
+			const Node& node = m_Nodes[nodeIndex];
+			const uint childIndex = GetChildIndex(node.centre, centre);
+			uint child = node.children[childIndex];
+			if (child == c_NoNode)
+			{
+				const float childHalfSize = node.halfSize * 0.5f;
+				const Vector3 childCentre(
+					node.centre.x + (childIndex & 1 ? childHalfSize : -childHalfSize),
+					node.centre.y + (childIndex & 2 ? childHalfSize : -childHalfSize),
+					node.centre.z + (childIndex & 4 ? childHalfSize : -childHalfSize));
+				// Creating the node can reallocate the nodes so the parent is looked up again
+				child = CreateNode(childCentre, childHalfSize, node.depth + 1, nodeIndex);
+				m_Nodes[nodeIndex].children[childIndex] = child;
+			}
+			nodeIndex = child;
+		}
+
+		Node& node = m_Nodes[nodeIndex];
+		node.subtreeObjectCount++;
+		object.location = nodeIndex;
+		object.locationIndex = node.objects.Size();
+		node.objects.Add(handle);
+	}
+
+	void LooseOctree::Unlink(uint handle, Object& object)
+	{
+		Node& node = m_Nodes[object.location];
+		TYR_ASSERT(node.objects[object.locationIndex] == handle);
+
+		// Move the last object into the removed object's place
+		const uint lastHandle = node.objects.Back();
+		node.objects[object.locationIndex] = lastHandle;
+		GetObject(lastHandle).locationIndex = object.locationIndex;
+		node.objects.PopBack();
+
+		for (uint nodeIndex = object.location; nodeIndex != c_NoNode; nodeIndex = m_Nodes[nodeIndex].parent)
+		{
+			m_Nodes[nodeIndex].subtreeObjectCount--;
+		}
+	}
+
+	bool LooseOctree::CanStay(const Object& object) const
+	{
+		const Node& node = m_Nodes[object.location];
+		return GetTargetDepth(object.bounds) == node.depth && (node.depth == 0 || IsInCell(node, object.bounds.GetCentre()));
+	}
+
+	void LooseOctree::Gather(const SpatialQuery& query, SpatialQueryResult& result) const
+	{
+		// The root also holds the objects outside of its bounds so it is always visited
+		GatherNode(m_Nodes[0], query, result);
+	}
+
+	void LooseOctree::GatherNode(const Node& node, const SpatialQuery& query, SpatialQueryResult& result) const
+	{
+		GatherObjects(node.objects, query, result);
+
+		for (uint childIndex : node.children)
+		{
+			if (childIndex == c_NoNode)
+			{
+				continue;
+			}
+
+			const Node& child = m_Nodes[childIndex];
+			if (child.subtreeObjectCount == 0)
+			{
+				continue;
+			}
+
+			const float looseHalfSize = child.halfSize * 2.0f;
+			const AABB looseBounds = AABB::FromCentreExtents(child.centre, Vector3(looseHalfSize, looseHalfSize, looseHalfSize));
+			if (query.Contains(looseBounds))
+			{
+				GatherSubtree(child, result);
+			}
+			else if (query.Intersects(looseBounds))
+			{
+				GatherNode(child, query, result);
+			}
+		}
+	}
+
+	void LooseOctree::GatherSubtree(const Node& node, SpatialQueryResult& result) const
+	{
+		for (uint handle : node.objects)
+		{
+			result.Add(GetObject(handle).userValue);
+		}
+
+		for (uint childIndex : node.children)
+		{
+			if (childIndex != c_NoNode && m_Nodes[childIndex].subtreeObjectCount > 0)
+			{
+				GatherSubtree(m_Nodes[childIndex], result);
+			}
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "SpatialIndex.h"
+
+namespace tyr
+{
+	/// Loose octree where every node's bounds are twice the size of its cell.
+	///
+	/// The looseness means an object only has to be placed by its centre and size: it goes to the deepest node whose
+	/// cell is at least as large as the object, in the cell containing its centre, so it is never stored more than once
+	/// and moving it only relinks it when it changes cell or size class. Nodes are created as objects are inserted and
+	/// kept once empty. Each node counts the objects in its subtree so that queries skip empty branches.
+	class TYR_CORE_EXPORT LooseOctree final : public SpatialIndex
+	{
+	public:
+		LooseOctree(const Vector3& centre, float halfSize, uint maxDepth);
+		~LooseOctree();
+
+		void Clear() override;
+
+		uint GetNodeCount() const { return m_Nodes.Size(); }
+
+	protected:
+		void Link(uint handle, Object& object) override;
+
+		void Unlink(uint handle, Object& object) override;
+
+		bool CanStay(const Object& object) const override;
+
+		void Gather(const SpatialQuery& query, SpatialQueryResult& result) const override;
+
+	private:
+		static constexpr uint c_NoNode = ~0u;
+
+		struct Node
+		{
+			Vector3 centre;
+			// Half the size of the node's cell. The loose bounds extend twice as far.
+			float halfSize;
+			uint depth;
+			uint parent;
+			uint children[8];
+			uint subtreeObjectCount;
+			Array<uint> objects;
+		};
+
+		uint CreateNode(const Vector3& centre, float halfSize, uint depth, uint parent);
+
+		/// Returns the depth an object with the bounds is stored at.
+		uint GetTargetDepth(const AABB& bounds) const;
+
+		bool IsInCell(const Node& node, const Vector3& point) const;
+
+		void GatherNode(const Node& node, const SpatialQuery& query, SpatialQueryResult& result) const;
+
+		/// Adds every object in the subtree without testing it, for subtrees inside the query volume.
+		void GatherSubtree(const Node& node, SpatialQueryResult& result) const;
+
+		Array<Node> m_Nodes;
+		uint m_MaxDepth;
+	};
+}
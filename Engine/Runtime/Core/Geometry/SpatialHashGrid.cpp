@@ -0,0 +1,212 @@
+#include "SpatialHashGrid.h"
+#include <cmath>
+
+namespace tyr
+{
+	namespace
+	{
+		// Bits of each coordinate in a cell key, which covers a million cells in each direction from the origin
+		constexpr uint c_CoordBits = 21;
+		constexpr uint64 c_CoordMask = (1ull << c_CoordBits) - 1;
+
+		// Removes the handle at index from the list by moving the last handle into its place. Returns the handle that
+		// was moved or SpatialIndex::c_InvalidHandle if none was.
+		uint RemoveHandle(Array<uint>& handles, uint index)
+		{
+			const uint lastHandle = handles.Back();
+			handles.PopBack();
+			if (index == handles.Size())
+			{
+				return SpatialIndex::c_InvalidHandle;
+			}
+			handles[index] = lastHandle;
+			return lastHandle;
+		}
+	}
+
+	SpatialHashGrid::SpatialHashGrid(float cellSize)
+		: m_CellSize(cellSize)
+		, m_InvCellSize(1.0f / cellSize)
+	{
+		TYR_ASSERT(cellSize > 0.0f);
+	}
+
+	SpatialHashGrid::~SpatialHashGrid()
+	{
+		Clear();
+	}
+
+	void SpatialHashGrid::Clear()
+	{
+		for (Cell& cell : m_Cells)
+		{
+			for (uint handle : cell.objects)
+			{
+				DeleteObject(handle);
+			}
+		}
+		for (uint handle : m_OversizedObjects)
+		{
+			DeleteObject(handle);
+		}
+
+		m_CellMap.Clear();
+		m_Cells.Clear();
+		m_FreeCells.Clear();
+		m_OversizedObjects.Clear();
+	}
+
+	uint64 SpatialHashGrid::GetCellKey(const CellCoords& coords)
+	{
+		return ((static_cast<uint64>(coords.x) & c_CoordMask) << (c_CoordBits * 2))
+			| ((static_cast<uint64>(coords.y) & c_CoordMask) << c_CoordBits)
+			| (static_cast<uint64>(coords.z) & c_CoordMask);
+	}
+
+	SpatialHashGrid::CellCoords SpatialHashGrid::GetCellCoords(const Vector3& point) const
+	{
+		return CellCoords {
+			static_cast<int>(std::floor(point.x * m_InvCellSize)),
+			static_cast<int>(std::floor(point.y * m_InvCellSize)),
+			static_cast<int>(std::floor(point.z * m_InvCellSize)) };
+	}
+
+	bool SpatialHashGrid::IsOversized(const AABB& bounds) const
+	{
+		// Objects fit in the loose cell bounds if they extend no more than half a cell from their centre
+		const Vector3 extents = bounds.GetExtents();
+		const float halfCellSize = m_CellSize * 0.5f;
+		return extents.x > halfCellSize || extents.y > halfCellSize || extents.z > halfCellSize;
+	}
+
+	void SpatialHashGrid::Link(uint handle, Object& object)
+	{
+		Array<uint>* handles;
+		if (IsOversized(object.bounds))
+		{
+			object.location = c_OversizedLocation;
+			handles = &m_OversizedObjects;
+		}
+		else
+		{
+			const CellCoords coords = GetCellCoords(object.bounds.GetCentre());
+			const uint64 key = GetCellKey(coords);
+			const uint* cellIndex = m_CellMap.Find(key);
+			if (cellIndex)
+			{
+				object.location = *cellIndex;
+			}
+			else
+			{
+				if (m_FreeCells.IsEmpty())
+				{
+					object.location = m_Cells.Size();
+					m_Cells.Add(Cell());
+				}
+				else
+				{
+					object.location = m_FreeCells.Back();
+					m_FreeCells.PopBack();
+				}
+				m_Cells[object.location].coords = coords;
+				m_CellMap.Insert(key, object.location);
+			}
+			handles = &m_Cells[object.location].objects;
+		}
+
+		object.locationIndex = handles->Size();
+		handles->Add(handle);
+	}
+
+	void SpatialHashGrid::Unlink(uint handle, Object& object)
+	{
+		Array<uint>& handles = object.location == c_OversizedLocation ? m_OversizedObjects : m_Cells[object.location].objects;
+		TYR_ASSERT(handles[object.locationIndex] == handle);
+
+		const uint movedHandle = RemoveHandle(handles, object.locationIndex);
+		if (movedHandle != c_InvalidHandle)
+		{
+			GetObject(movedHandle).locationIndex = object.locationIndex;
+		}
+
+		if (object.location != c_OversizedLocation && handles.IsEmpty())
+		{
+			m_CellMap.Erase(GetCellKey(m_Cells[object.location].coords));
+			m_FreeCells.Add(object.location);
+		}
+	}
+
+	bool SpatialHashGrid::CanStay(const Object& object) const
+	{
+		if (IsOversized(object.bounds))
+		{
+			return object.location == c_OversizedLocation;
+		}
+		return object.location != c_OversizedLocation && m_Cells[object.location].coords == GetCellCoords(object.bounds.GetCentre());
+	}
+
+	void SpatialHashGrid::GatherCell(const Cell& cell, const SpatialQuery& query, SpatialQueryResult& result) const
+	{
+		const Vector3 min(
+			(cell.coords.x - 0.5f) * m_CellSize,
+			(cell.coords.y - 0.5f) * m_CellSize,
+			(cell.coords.z - 0.5f) * m_CellSize);
+		const float looseSize = m_CellSize * 2.0f;
+		const AABB looseBounds(min, min + Vector3(looseSize, looseSize, looseSize));
+		if (query.Contains(looseBounds))
+		{
+			for (uint handle : cell.objects)
+			{
+				result.Add(GetObject(handle).userValue);
+			}
+		}
+		else if (query.Intersects(looseBounds))
+		{
+			GatherObjects(cell.objects, query, result);
+		}
+	}
+
+	void SpatialHashGrid::Gather(const SpatialQuery& query, SpatialQueryResult& result) const
+	{
+		GatherObjects(m_OversizedObjects, query, result);
+
+		AABB bounds;
+		if (query.GetBounds(bounds))
+		{
+			// Objects in cells up to half a cell away can reach into the bounds
+			const float halfCellSize = m_CellSize * 0.5f;
+			const Vector3 margin(halfCellSize, halfCellSize, halfCellSize);
+			const CellCoords first = GetCellCoords(bounds.GetMin() - margin);
+			const CellCoords last = GetCellCoords(bounds.GetMax() + margin);
+			const uint64 rangeCellCount = static_cast<uint64>(last.x - first.x + 1) * static_cast<uint64>(last.y - first.y + 1)
+				* static_cast<uint64>(last.z - first.z + 1);
+
+			if (rangeCellCount <= m_CellMap.Size())
+			{
+				for (int z = first.z; z <= last.z; ++z)
+				{
+					for (int y = first.y; y <= last.y; ++y)
+					{
+						for (int x = first.x; x <= last.x; ++x)
+						{
+							const uint* cellIndex = m_CellMap.Find(GetCellKey(CellCoords { x, y, z }));
+							if (cellIndex)
+							{
+								GatherCell(m_Cells[*cellIndex], query, result);
+							}
+						}
+					}
+				}
+				return;
+			}
+		}
+
+		for (const Cell& cell : m_Cells)
+		{
+			if (!cell.objects.IsEmpty())
+			{
+				GatherCell(cell, query, result);
+			}
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "SpatialIndex.h"
+#include "Containers/HashMap.h"
+
+namespace tyr
+{
+	/// Loose uniform grid whose occupied cells are found through a hash map, so the grid has no bounds.
+	///
+	/// Objects are stored once, in the cell containing their centre. Each cell's bounds are extended by half a cell on
+	/// every side so that any object up to a cell in size fits in them. Larger objects are kept in a separate list that
+	/// every query tests. Queries with bounds visit the cells they overlap, or every occupied cell if that is fewer.
+	class TYR_CORE_EXPORT SpatialHashGrid final : public SpatialIndex
+	{
+	public:
+		explicit SpatialHashGrid(float cellSize);
+		~SpatialHashGrid();
+
+		void Clear() override;
+
+		uint GetOccupiedCellCount() const { return m_CellMap.Size(); }
+
+	protected:
+		void Link(uint handle, Object& object) override;
+
+		void Unlink(uint handle, Object& object) override;
+
+		bool CanStay(const Object& object) const override;
+
+		void Gather(const SpatialQuery& query, SpatialQueryResult& result) const override;
+
+	private:
+		// Location of objects too large for a cell
+		static constexpr uint c_OversizedLocation = ~0u;
+
+		struct CellCoords
+		{
+			int x;
+			int y;
+			int z;
+
+			bool operator==(const CellCoords& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
+		};
+
+		struct Cell
+		{
+			CellCoords coords;
+			Array<uint> objects;
+		};
+
+		static uint64 GetCellKey(const CellCoords& coords);
+
+		CellCoords GetCellCoords(const Vector3& point) const;
+
+		bool IsOversized(const AABB& bounds) const;
+
+		void GatherCell(const Cell& cell, const SpatialQuery& query, SpatialQueryResult& result) const;
+
+		float m_CellSize;
+		float m_InvCellSize;
+		// Index in m_Cells of every occupied cell
+		HashMap<uint64, uint> m_CellMap;
+		// Cells are reused once empty so that their object arrays keep their memory
+		Array<Cell> m_Cells;
+		Array<uint> m_FreeCells;
+		Array<uint> m_OversizedObjects;
+	};
+}
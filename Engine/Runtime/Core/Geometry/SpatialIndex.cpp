@@ -0,0 +1,163 @@
+#include "SpatialIndex.h"
+#include "Frustum.h"
+#include "LooseOctree.h"
+#include "SpatialHashGrid.h"
+#include "Memory/FrameAllocation.h"
+#include <cstring>
+
+namespace tyr
+{
+	namespace
+	{
+		// Capacity of the first buffer of a query result
+		constexpr uint c_InitialResultCapacity = 256;
+	}
+
+	SpatialQuery::SpatialQuery(const AABB& box)
+		: m_Type(Type::Box)
+		, m_Bounds(box)
+		, m_Frustum(nullptr)
+		, m_HasBounds(true)
+	{ }
+
+	SpatialQuery::SpatialQuery(const BoundingSphere& sphere)
+		: m_Type(Type::Sphere)
+		, m_Sphere(sphere)
+		, m_Frustum(nullptr)
+		, m_HasBounds(true)
+	{
+		const float radius = sphere.GetRadius();
+		m_Bounds = AABB::FromCentreExtents(sphere.GetCentre(), Vector3(radius, radius, radius));
+	}
+
+	SpatialQuery::SpatialQuery(const Frustum& frustum)
+		: m_Type(Type::Frustum)
+		, m_Frustum(&frustum)
+	{
+		m_HasBounds = frustum.GetBounds(m_Bounds);
+	}
+
+	bool SpatialQuery::Intersects(const AABB& box) const
+	{
+		switch (m_Type)
+		{
+		case Type::Box:
+			return m_Bounds.Intersects(box);
+		case Type::Sphere:
+			return box.Intersects(m_Sphere);
+		default:
+			return m_Frustum->Intersects(box);
+		}
+	}
+
+	bool SpatialQuery::Contains(const AABB& box) const
+	{
+		switch (m_Type)
+		{
+		case Type::Box:
+			return m_Bounds.Contains(box);
+		case Type::Sphere:
+		{
+			// The corner furthest from the centre must be inside the sphere
+			const Vector3 offset = box.GetCentre() - m_Sphere.GetCentre();
+			const Vector3 extents = box.GetExtents();
+			const Vector3 farthest(Math::Abs(offset.x) + extents.x, Math::Abs(offset.y) + extents.y, Math::Abs(offset.z) + extents.z);
+			return farthest.SqrLength() <= Math::Sqr(m_Sphere.GetRadius());
+		}
+		default:
+			return m_Frustum->Contains(box);
+		}
+	}
+
+	bool SpatialQuery::GetBounds(AABB& bounds) const
+	{
+		bounds = m_Bounds;
+		return m_HasBounds;
+	}
+
+	SpatialQueryResult::SpatialQueryResult()
+		: m_Data(nullptr)
+		, m_Size(0)
+		, m_Capacity(0)
+	{ }
+
+	void SpatialQueryResult::Grow()
+	{
+		// The old buffer is left in frame memory, which at most doubles the memory used by the result
+		const uint capacity = m_Capacity ? m_Capacity * 2 : c_InitialResultCapacity;
+		uint* data = FrameAlloc<uint>(capacity);
+		if (m_Size)
+		{
+			std::memcpy(data, m_Data, m_Size * sizeof(uint));
+		}
+		m_Data = data;
+		m_Capacity = capacity;
+	}
+
+	SpatialIndex::~SpatialIndex()
+	{
+
+	}
+
+	URef<SpatialIndex> SpatialIndex::Create(const SpatialIndexDesc& desc)
+	{
+		switch (desc.type)
+		{
+		case SpatialIndexType::HashGrid:
+			return MakeURef<SpatialHashGrid>(desc.gridCellSize);
+		default:
+			return MakeURef<LooseOctree>(desc.octreeCentre, desc.octreeHalfSize, desc.octreeMaxDepth);
+		}
+	}
+
+	uint SpatialIndex::Insert(const AABB& bounds, uint userValue)
+	{
+		uint handle;
+		Object* object = m_Objects.Create(handle);
+		object->bounds = bounds;
+		object->userValue = userValue;
+		Link(handle, *object);
+		return handle;
+	}
+
+	void SpatialIndex::Move(uint handle, const AABB& bounds)
+	{
+		Object& object = GetObject(handle);
+		object.bounds = bounds;
+		if (!CanStay(object))
+		{
+			Unlink(handle, object);
+			Link(handle, object);
+		}
+	}
+
+	void SpatialIndex::Remove(uint handle)
+	{
+		Unlink(handle, GetObject(handle));
+		m_Objects.Delete(handle);
+	}
+
+	void SpatialIndex::SetUserValue(uint handle, uint userValue)
+	{
+		GetObject(handle).userValue = userValue;
+	}
+
+	std::span<const uint> SpatialIndex::Query(const SpatialQuery& query) const
+	{
+		SpatialQueryResult result;
+		Gather(query, result);
+		return result.GetSpan();
+	}
+
+	void SpatialIndex::GatherObjects(const Array<uint>& handles, const SpatialQuery& query, SpatialQueryResult& result) const
+	{
+		for (uint handle : handles)
+		{
+			const Object& object = GetObject(handle);
+			if (query.Intersects(object.bounds))
+			{
+				result.Add(object.userValue);
+			}
+		}
+	}
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Containers/Array.h"
+#include "AABB.h"
+#include "BoundingSphere.h"
+#include "Memory/HandlePool.h"
+#include "Memory/MemoryTypes.h"
+#include <span>
+
+namespace tyr
+{
+	class Frustum;
+
+	enum class SpatialIndexType : uint8
+	{
+		// Loose octree over fixed bounds. Handles objects of very different sizes well.
+		LooseOctree,
+		// Loose uniform grid that only stores occupied cells in a hash map. Has no bounds so it suits large open worlds
+		// with objects of similar sizes.
+		HashGrid
+	};
+
+	struct SpatialIndexDesc
+	{
+		SpatialIndexType type = SpatialIndexType::LooseOctree;
+		// Bounds of the octree root. Objects outside of them are kept in the root.
+		Vector3 octreeCentre = Vector3(0.0f, 0.0f, 0.0f);
+		float octreeHalfSize = 4096.0f;
+		uint octreeMaxDepth = 10;
+		// Size of a grid cell. Objects larger than a cell are kept in a list that every query tests.
+		float gridCellSize = 64.0f;
+	};
+
+	/// Volume tested by a spatial index query
+	class TYR_CORE_EXPORT SpatialQuery
+	{
+	public:
+		explicit SpatialQuery(const AABB& box);
+
+		explicit SpatialQuery(const BoundingSphere& sphere);
+
+		explicit SpatialQuery(const Frustum& frustum);
+
+		bool Intersects(const AABB& box) const;
+
+		/// Returns true if the box is entirely inside the volume, in which case everything in it intersects the volume.
+		bool Contains(const AABB& box) const;
+
+		/// Gets a box containing the volume. Returns false if the volume is unbounded, such as a frustum with an infinite
+		/// far plane.
+		bool GetBounds(AABB& bounds) const;
+
+	private:
+		enum class Type : uint8
+		{
+			Box,
+			Sphere,
+			Frustum
+		};
+
+		Type m_Type;
+		// The box itself or the bounds of the sphere or frustum
+		AABB m_Bounds;
+		BoundingSphere m_Sphere;
+		const Frustum* m_Frustum;
+		bool m_HasBounds;
+	};
+
+	/// Builds the result of a query in frame memory. The buffer is reallocated in frame memory when it fills up.
+	class TYR_CORE_EXPORT SpatialQueryResult
+	{
+	public:
+		SpatialQueryResult();
+
+		TYR_FORCEINLINE void Add(uint value)
+		{
+			if (m_Size == m_Capacity)
+			{
+				Grow();
+			}
+			m_Data[m_Size++] = value;
+		}
+
+		std::span<const uint> GetSpan() const { return std::span<const uint>(m_Data, m_Size); }
+
+	private:
+		void Grow();
+
+		uint* m_Data;
+		uint m_Size;
+		uint m_Capacity;
+	};
+
+	/// Spatial index over the bounds of objects such as world instances, for culling, light assignment and proximity
+	/// queries.
+	///
+	/// Objects are referred to by generational handles and carry a user value, such as an instance index, that queries
+	/// return. Insert(), Move() and Remove() are incremental and must not be called during queries. Queries are const
+	/// and can run on several threads at once. Their results are frame allocated on the calling thread, so they stay
+	/// valid for FrameAllocator::c_FrameGenerationCount frames.
+	class TYR_CORE_EXPORT SpatialIndex
+	{
+	public:
+		static constexpr uint c_InvalidHandle = HandlePool<uint>::c_InvalidHandle;
+
+		virtual ~SpatialIndex();
+
+		/// Creates the index type selected by the description.
+		static URef<SpatialIndex> Create(const SpatialIndexDesc& desc);
+
+		/// Adds an object and returns its handle.
+		uint Insert(const AABB& bounds, uint userValue);
+
+		/// Updates the bounds of an object after its transform has changed.
+		void Move(uint handle, const AABB& bounds);
+
+		void Remove(uint handle);
+
+		/// Changes the value returned for an object, for example when instances are reordered.
+		void SetUserValue(uint handle, uint userValue);
+
+		/// Removes every object.
+		virtual void Clear() = 0;
+
+		const AABB& GetBounds(uint handle) const { return m_Objects.GetObjectRef(handle).bounds; }
+
+		uint GetUserValue(uint handle) const { return m_Objects.GetObjectRef(handle).userValue; }
+
+		uint GetObjectCount() const { return m_Objects.GetObjectCount(); }
+
+		/// Returns the user values of the objects whose bounds intersect the volume, in no particular order.
+		std::span<const uint> Query(const SpatialQuery& query) const;
+
+		std::span<const uint> QueryBox(const AABB& box) const { return Query(SpatialQuery(box)); }
+
+		std::span<const uint> QuerySphere(const BoundingSphere& sphere) const { return Query(SpatialQuery(sphere)); }
+
+		std::span<const uint> QueryFrustum(const Frustum& frustum) const { return Query(SpatialQuery(frustum)); }
+
+	protected:
+		struct Object
+		{
+			AABB bounds;
+			uint userValue;
+			// Node or cell holding the object and the object's index in its list of handles
+			uint location;
+			uint locationIndex;
+		};
+
+		const Object& GetObject(uint handle) const { return m_Objects.GetObjectRef(handle); }
+
+		Object& GetObject(uint handle) { return m_Objects.GetObjectRef(handle); }
+
+		/// Frees the handle of an object that has already been unlinked. Used by Clear().
+		void DeleteObject(uint handle) { m_Objects.Delete(handle); }
+
+		/// Adds the user values of the objects in the list that intersect the query.
+		void GatherObjects(const Array<uint>& handles, const SpatialQuery& query, SpatialQueryResult& result) const;
+
+		/// Adds the object to the structure and sets its location.
+		virtual void Link(uint handle, Object& object) = 0;
+
+		/// Removes the object from the structure.
+		virtual void Unlink(uint handle, Object& object) = 0;
+
+		/// Returns true if the object can stay at its location with its new bounds.
+		virtual bool CanStay(const Object& object) const = 0;
+
+		virtual void Gather(const SpatialQuery& query, SpatialQueryResult& result) const = 0;
+
+	private:
+		HandlePool<Object> m_Objects;
+	};
+}
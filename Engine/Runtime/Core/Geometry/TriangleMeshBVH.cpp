@@ -0,0 +1,416 @@
+#include "TriangleMeshBVH.h"
+#include "Math/SIMD.h"
+#include "Threading/Parallel.h"
+#include <bit>
+
+namespace tyr
+{
+	namespace
+	{
+		// Determinants closer to zero than this mean the ray is parallel to the triangle
+		constexpr float c_ParallelEpsilon = 1e-8f;
+
+		AABB GetTriangleBounds(const Vector3* vertices, const uint* indices, uint triangle)
+		{
+			AABB bounds = AABB::CreateEmpty();
+			bounds.Merge(vertices[indices[triangle * 3]]);
+			bounds.Merge(vertices[indices[triangle * 3 + 1]]);
+			bounds.Merge(vertices[indices[triangle * 3 + 2]]);
+			return bounds;
+		}
+
+		void GetTriangleBounds(const Vector3* vertices, const uint* indices, uint triangleCount, Array<AABB>& bounds)
+		{
+			bounds.Resize(triangleCount);
+			ParallelForRange(triangleCount, [&](uint begin, uint end)
+			{
+				for (uint i = begin; i < end; ++i)
+				{
+					bounds[i] = GetTriangleBounds(vertices, indices, i);
+				}
+			});
+		}
+
+		// Moller-Trumbore intersection. Returns true if the ray hits the front or back of the triangle in front of its origin.
+		bool IntersectTriangle(const Vector3& vertex, const Vector3& edge1, const Vector3& edge2, const Vector3& origin,
+			const Vector3& direction, float& t, float& u, float& v)
+		{
+			const Vector3 pvec = direction.Cross(edge2);
+			const float det = edge1.Dot(pvec);
+			if (!(det > c_ParallelEpsilon || det < -c_ParallelEpsilon))
+			{
+				return false;
+			}
+
+			const float invDet = 1.0f / det;
+			const Vector3 tvec = origin - vertex;
+			u = tvec.Dot(pvec) * invDet;
+			if (u < 0.0f || u > 1.0f)
+			{
+				return false;
+			}
+
+			const Vector3 qvec = tvec.Cross(edge1);
+			v = direction.Dot(qvec) * invDet;
+			if (v < 0.0f || u + v > 1.0f)
+			{
+				return false;
+			}
+
+			t = edge2.Dot(qvec) * invDet;
+			return t > 0.0f;
+		}
+	}
+
+	void TriangleMeshBVH::Build(const Vector3* vertices, const uint* indices, uint triangleCount)
+	{
+		Array<AABB> bounds;
+		GetTriangleBounds(vertices, indices, triangleCount, bounds);
+		m_BVH.Build(bounds.Data(), triangleCount);
+		m_Triangles.Resize(triangleCount);
+		UpdateTriangles(vertices, indices);
+	}
+
+	void TriangleMeshBVH::Refit(const Vector3* vertices, const uint* indices)
+	{
+		Array<AABB> bounds;
+		GetTriangleBounds(vertices, indices, m_Triangles.Size(), bounds);
+		m_BVH.Refit(bounds.Data());
+		UpdateTriangles(vertices, indices);
+	}
+
+	void TriangleMeshBVH::UpdateTriangles(const Vector3* vertices, const uint* indices)
+	{
+		const Array<uint>& order = m_BVH.GetPrimitiveIndices();
+		ParallelForRange(m_Triangles.Size(), [&](uint begin, uint end)
+		{
+			for (uint i = begin; i < end; ++i)
+			{
+				const uint* triangleIndices = indices + order[i] * 3;
+				const Vector3& vertex = vertices[triangleIndices[0]];
+				Triangle& triangle = m_Triangles[i];
+				triangle.vertex = vertex;
+				triangle.edge1 = vertices[triangleIndices[1]] - vertex;
+				triangle.edge2 = vertices[triangleIndices[2]] - vertex;
+			}
+		});
+	}
+
+	bool TriangleMeshBVH::Raycast(const Ray& ray, float maxDistance, RayHit& hit) const
+	{
+		const Vector3& origin = ray.GetOrigin();
+		const Vector3& direction = ray.GetDirection();
+		const Array<uint>& order = m_BVH.GetPrimitiveIndices();
+		bool found = false;
+		m_BVH.TraverseRay(origin, direction, maxDistance, [&](uint first, uint count)
+		{
+			for (uint i = first; i < first + count; ++i)
+			{
+				const Triangle& triangle = m_Triangles[i];
+				float t, u, v;
+				if (IntersectTriangle(triangle.vertex, triangle.edge1, triangle.edge2, origin, direction, t, u, v) && t < maxDistance)
+				{
+					maxDistance = t;
+					hit = { t, order[i], u, v };
+					found = true;
+				}
+			}
+			return false;
+		});
+		return found;
+	}
+
+	bool TriangleMeshBVH::RaycastAny(const Ray& ray, float maxDistance) const
+	{
+		const Vector3& origin = ray.GetOrigin();
+		const Vector3& direction = ray.GetDirection();
+		bool found = false;
+		m_BVH.TraverseRay(origin, direction, maxDistance, [&](uint first, uint count)
+		{
+			for (uint i = first; i < first + count; ++i)
+			{
+				const Triangle& triangle = m_Triangles[i];
+				float t, u, v;
+				if (IntersectTriangle(triangle.vertex, triangle.edge1, triangle.edge2, origin, direction, t, u, v) && t < maxDistance)
+				{
+					found = true;
+					return true;
+				}
+			}
+			return false;
+		});
+		return found;
+	}
+
+	uint TriangleMeshBVH::Raycast(const RayPacket8& packet, RayHit* hits) const
+	{
+		return RaycastPacket<false>(packet, hits);
+	}
+
+	uint TriangleMeshBVH::RaycastAny(const RayPacket8& packet) const
+	{
+		return RaycastPacket<true>(packet, nullptr);
+	}
+
+#if TYR_USE_SIMD
+	template<bool AnyHit>
+	uint TriangleMeshBVH::RaycastPacket(const RayPacket8& packet, RayHit* hits) const
+	{
+		const Array<BVH::Node>& nodes = m_BVH.GetNodes();
+		if (nodes.Size() == 0)
+		{
+			return 0;
+		}
+
+		// The packet is processed as two halves of 4 rays with the same steps as the single ray functions
+		struct RayGroup
+		{
+			Reg4 originX, originY, originZ;
+			Reg4 directionX, directionY, directionZ;
+			Reg4 invDirectionX, invDirectionY, invDirectionZ;
+		};
+
+		const Reg4 zero = SIMD::Set4(0.0f);
+		const Reg4 one = SIMD::Set4(1.0f);
+		RayGroup groups[2];
+		alignas(16) float maxDistance[RayPacket8::c_RayCount];
+		uint activeMask = 0;
+		for (uint i = 0; i < 2; ++i)
+		{
+			RayGroup& group = groups[i];
+			group.originX = SIMD::Load4(packet.originX + i * 4);
+			group.originY = SIMD::Load4(packet.originY + i * 4);
+			group.originZ = SIMD::Load4(packet.originZ + i * 4);
+			group.directionX = SIMD::Load4(packet.directionX + i * 4);
+			group.directionY = SIMD::Load4(packet.directionY + i * 4);
+			group.directionZ = SIMD::Load4(packet.directionZ + i * 4);
+			group.invDirectionX = SIMD::Div4(one, group.directionX);
+			group.invDirectionY = SIMD::Div4(one, group.directionY);
+			group.invDirectionZ = SIMD::Div4(one, group.directionZ);
+
+			const Reg4 distance = SIMD::Load4(packet.maxDistance + i * 4);
+			SIMD::Store4(maxDistance + i * 4, distance);
+			activeMask |= SIMD::MoveMask4(SIMD::CmpGt4(distance, zero)) << (i * 4);
+		}
+
+		// Returns the mask of active rays that hit the node and the nearest distance at which one of them enters it
+		auto intersectNode = [&](const BVH::Node& node, float& entry)
+		{
+			const Reg4 minX = SIMD::Set4(node.boundsMin.x);
+			const Reg4 minY = SIMD::Set4(node.boundsMin.y);
+			const Reg4 minZ = SIMD::Set4(node.boundsMin.z);
+			const Reg4 maxX = SIMD::Set4(node.boundsMax.x);
+			const Reg4 maxY = SIMD::Set4(node.boundsMax.y);
+			const Reg4 maxZ = SIMD::Set4(node.boundsMax.z);
+
+			uint mask = 0;
+			entry = BVH::c_NoHit;
+			for (uint i = 0; i < 2; ++i)
+			{
+				const RayGroup& group = groups[i];
+				const Reg4 tx1 = SIMD::Mul4(SIMD::Sub4(minX, group.originX), group.invDirectionX);
+				const Reg4 tx2 = SIMD::Mul4(SIMD::Sub4(maxX, group.originX), group.invDirectionX);
+				const Reg4 ty1 = SIMD::Mul4(SIMD::Sub4(minY, group.originY), group.invDirectionY);
+				const Reg4 ty2 = SIMD::Mul4(SIMD::Sub4(maxY, group.originY), group.invDirectionY);
+				const Reg4 tz1 = SIMD::Mul4(SIMD::Sub4(minZ, group.originZ), group.invDirectionZ);
+				const Reg4 tz2 = SIMD::Mul4(SIMD::Sub4(maxZ, group.originZ), group.invDirectionZ);
+
+				const Reg4 distance = SIMD::Load4(maxDistance + i * 4);
+				const Reg4 rayEntry = SIMD::Max4(SIMD::Max4(SIMD::Min4(tx1, tx2), SIMD::Min4(ty1, ty2)), SIMD::Max4(SIMD::Min4(tz1, tz2), zero));
+				const Reg4 rayExit = SIMD::Min4(SIMD::Min4(SIMD::Max4(tx1, tx2), SIMD::Max4(ty1, ty2)), SIMD::Min4(SIMD::Max4(tz1, tz2), distance));
+				const uint groupMask = (~SIMD::MoveMask4(SIMD::CmpGt4(rayEntry, rayExit)) & SIMD::MoveMask4(SIMD::CmpGt4(distance, rayEntry)))
+					& (activeMask >> (i * 4)) & 0xF;
+				if (groupMask)
+				{
+					mask |= groupMask << (i * 4);
+					alignas(16) float laneEntry[4];
+					SIMD::Store4(laneEntry, rayEntry);
+					for (uint lanes = groupMask; lanes; lanes &= lanes - 1)
+					{
+						entry = std::min(entry, laneEntry[std::countr_zero(lanes)]);
+					}
+				}
+			}
+			return mask;
+		};
+
+		uint hitMask = 0;
+		auto intersectTriangles = [&](uint first, uint count)
+		{
+			for (uint index = first; index < first + count; ++index)
+			{
+				const Triangle& triangle = m_Triangles[index];
+				const Reg4 vertexX = SIMD::Set4(triangle.vertex.x);
+				const Reg4 vertexY = SIMD::Set4(triangle.vertex.y);
+				const Reg4 vertexZ = SIMD::Set4(triangle.vertex.z);
+				const Reg4 edge1X = SIMD::Set4(triangle.edge1.x);
+				const Reg4 edge1Y = SIMD::Set4(triangle.edge1.y);
+				const Reg4 edge1Z = SIMD::Set4(triangle.edge1.z);
+				const Reg4 edge2X = SIMD::Set4(triangle.edge2.x);
+				const Reg4 edge2Y = SIMD::Set4(triangle.edge2.y);
+				const Reg4 edge2Z = SIMD::Set4(triangle.edge2.z);
+				const Reg4 epsilon = SIMD::Set4(c_ParallelEpsilon);
+				const Reg4 negEpsilon = SIMD::Set4(-c_ParallelEpsilon);
+
+				for (uint i = 0; i < 2; ++i)
+				{
+					const uint groupActive = (activeMask >> (i * 4)) & 0xF;
+					if (!groupActive)
+					{
+						continue;
+					}
+
+					const RayGroup& group = groups[i];
+					const Reg4 px = SIMD::Sub4(SIMD::Mul4(group.directionY, edge2Z), SIMD::Mul4(group.directionZ, edge2Y));
+					const Reg4 py = SIMD::Sub4(SIMD::Mul4(group.directionZ, edge2X), SIMD::Mul4(group.directionX, edge2Z));
+					const Reg4 pz = SIMD::Sub4(SIMD::Mul4(group.directionX, edge2Y), SIMD::Mul4(group.directionY, edge2X));
+					const Reg4 det = SIMD::Add4(SIMD::Add4(SIMD::Mul4(edge1X, px), SIMD::Mul4(edge1Y, py)), SIMD::Mul4(edge1Z, pz));
+					const Reg4 invDet = SIMD::Div4(one, det);
+
+					const Reg4 tx = SIMD::Sub4(group.originX, vertexX);
+					const Reg4 ty = SIMD::Sub4(group.originY, vertexY);
+					const Reg4 tz = SIMD::Sub4(group.originZ, vertexZ);
+					const Reg4 u = SIMD::Mul4(SIMD::Add4(SIMD::Add4(SIMD::Mul4(tx, px), SIMD::Mul4(ty, py)), SIMD::Mul4(tz, pz)), invDet);
+
+					const Reg4 qx = SIMD::Sub4(SIMD::Mul4(ty, edge1Z), SIMD::Mul4(tz, edge1Y));
+					const Reg4 qy = SIMD::Sub4(SIMD::Mul4(tz, edge1X), SIMD::Mul4(tx, edge1Z));
+					const Reg4 qz = SIMD::Sub4(SIMD::Mul4(tx, edge1Y), SIMD::Mul4(ty, edge1X));
+					const Reg4 v = SIMD::Mul4(SIMD::Add4(SIMD::Add4(SIMD::Mul4(group.directionX, qx), SIMD::Mul4(group.directionY, qy)),
+						SIMD::Mul4(group.directionZ, qz)), invDet);
+					const Reg4 t = SIMD::Mul4(SIMD::Add4(SIMD::Add4(SIMD::Mul4(edge2X, qx), SIMD::Mul4(edge2Y, qy)), SIMD::Mul4(edge2Z, qz)), invDet);
+
+					const Reg4 accept = SIMD::And4(SIMD::Or4(SIMD::CmpGt4(det, epsilon), SIMD::CmpGt4(negEpsilon, det)),
+						SIMD::And4(SIMD::CmpGt4(t, zero), SIMD::CmpGt4(SIMD::Load4(maxDistance + i * 4), t)));
+					const Reg4 reject = SIMD::Or4(SIMD::Or4(SIMD::CmpGt4(zero, u), SIMD::CmpGt4(u, one)),
+						SIMD::Or4(SIMD::CmpGt4(zero, v), SIMD::CmpGt4(SIMD::Add4(u, v), one)));
+					uint groupHits = SIMD::MoveMask4(accept) & ~SIMD::MoveMask4(reject) & groupActive;
+					if (!groupHits)
+					{
+						continue;
+					}
+
+					hitMask |= groupHits << (i * 4);
+					if constexpr (AnyHit)
+					{
+						activeMask &= ~(groupHits << (i * 4));
+						continue;
+					}
+
+					alignas(16) float hitT[4];
+					alignas(16) float hitU[4];
+					alignas(16) float hitV[4];
+					SIMD::Store4(hitT, t);
+					SIMD::Store4(hitU, u);
+					SIMD::Store4(hitV, v);
+					const uint primitive = m_BVH.GetPrimitiveIndices()[index];
+					while (groupHits)
+					{
+						const uint lane = std::countr_zero(groupHits);
+						groupHits &= groupHits - 1;
+						maxDistance[i * 4 + lane] = hitT[lane];
+						hits[i * 4 + lane] = { hitT[lane], primitive, hitU[lane], hitV[lane] };
+					}
+				}
+			}
+		};
+
+		// Furthest distance any active ray can still find a hit at
+		auto getMaxDistance = [&]()
+		{
+			float distance = 0.0f;
+			for (uint mask = activeMask; mask; mask &= mask - 1)
+			{
+				distance = std::max(distance, maxDistance[std::countr_zero(mask)]);
+			}
+			return distance;
+		};
+
+		struct StackEntry
+		{
+			uint node;
+			float distance;
+		};
+		StackEntry stack[BVH::c_MaxDepth];
+		uint stackSize = 0;
+
+		float entry;
+		if (!intersectNode(nodes[0], entry))
+		{
+			return 0;
+		}
+
+		uint nodeIndex = 0;
+		while (true)
+		{
+			const BVH::Node& node = nodes[nodeIndex];
+			if (node.IsLeaf())
+			{
+				intersectTriangles(node.leftOrFirst, node.primitiveCount);
+				if (AnyHit && activeMask == 0)
+				{
+					return hitMask;
+				}
+			}
+			else
+			{
+				uint nearIndex = node.leftOrFirst;
+				uint farIndex = nearIndex + 1;
+				float nearDistance;
+				float farDistance;
+				uint nearMask = intersectNode(nodes[nearIndex], nearDistance);
+				uint farMask = intersectNode(nodes[farIndex], farDistance);
+				if (farDistance < nearDistance)
+				{
+					std::swap(nearIndex, farIndex);
+					std::swap(nearDistance, farDistance);
+					std::swap(nearMask, farMask);
+				}
+
+				if (nearMask)
+				{
+					if (farMask)
+					{
+						stack[stackSize++] = { farIndex, farDistance };
+					}
+					nodeIndex = nearIndex;
+					continue;
+				}
+			}
+
+			// Skip nodes that are further than every active ray's closest hit
+			const float distance = getMaxDistance();
+			do
+			{
+				if (stackSize == 0)
+				{
+					return hitMask;
+				}
+				--stackSize;
+			} while (stack[stackSize].distance >= distance);
+			nodeIndex = stack[stackSize].node;
+		}
+	}
+#else
+	template<bool AnyHit>
+	uint TriangleMeshBVH::RaycastPacket(const RayPacket8& packet, RayHit* hits) const
+	{
+		uint hitMask = 0;
+		for (uint i = 0; i < RayPacket8::c_RayCount; ++i)
+		{
+			if (packet.maxDistance[i] <= 0.0f)
+			{
+				continue;
+			}
+
+			const Ray ray(Vector3(packet.originX[i], packet.originY[i], packet.originZ[i]),
+				Vector3(packet.directionX[i], packet.directionY[i], packet.directionZ[i]));
+			const bool hit = AnyHit ? RaycastAny(ray, packet.maxDistance[i]) : Raycast(ray, packet.maxDistance[i], hits[i]);
+			if (hit)
+			{
+				hitMask |= 1u << i;
+			}
+		}
+		return hitMask;
+	}
+#endif
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "BVH.h"
+
+namespace tyr
+{
+	/// BVH over the triangles of a mesh for ray queries such as picking.
+	///
+	/// The triangles are copied in leaf order with precomputed edges so that leaves are read from contiguous memory.
+	/// Hits report the triangle index passed to the build and the barycentric coordinates of the hit point.
+	class TYR_CORE_EXPORT TriangleMeshBVH
+	{
+	public:
+		/// Builds over triangleCount triangles given by 3 vertex indices each.
+		void Build(const Vector3* vertices, const uint* indices, uint triangleCount);
+
+		/// Updates the triangles and node bounds after the vertices have moved. The indices must be the ones the
+		/// hierarchy was built with.
+		void Refit(const Vector3* vertices, const uint* indices);
+
+		bool Raycast(const Ray& ray, float maxDistance, RayHit& hit) const;
+
+		bool RaycastAny(const Ray& ray, float maxDistance) const;
+
+		/// Finds the closest hit of each ray in the packet. Returns a mask with bit i set if ray i hit a triangle, in
+		/// which case hits[i] is written.
+		uint Raycast(const RayPacket8& packet, RayHit* hits) const;
+
+		/// Returns a mask with bit i set if ray i hits any triangle.
+		uint RaycastAny(const RayPacket8& packet) const;
+
+		const BVH& GetBVH() const { return m_BVH; }
+
+		uint GetTriangleCount() const { return m_Triangles.Size(); }
+
+	private:
+		struct Triangle
+		{
+			Vector3 vertex;
+			Vector3 edge1;
+			Vector3 edge2;
+		};
+
+		void UpdateTriangles(const Vector3* vertices, const uint* indices);
+
+		template<bool AnyHit>
+		uint RaycastPacket(const RayPacket8& packet, RayHit* hits) const;
+
+		BVH m_BVH;
+		// Triangles in the order of the BVH's primitive indices
+		Array<Triangle> m_Triangles;
+	};
+}
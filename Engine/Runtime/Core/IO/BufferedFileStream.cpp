@@ -63,7 +63,7 @@ namespace tyr
 		const size_t memoryRemaining = m_MemoryRead - m_BufferOffset;
 		if (count >= memoryRemaining)
 		{
-			memcpy(buffer, &m_Buffer[0], memoryRemaining);	
+			memcpy(buffer, &m_Buffer[m_BufferOffset], memoryRemaining);	
 			const size_t remaining = count - memoryRemaining;
 			uint8* remainingData = &((uint8*)buffer)[memoryRemaining];
 			// This if condition shouldn't occur because the buffer size should be big enough
@@ -84,7 +84,7 @@ namespace tyr
 		}
 		else
 		{
-			memcpy(buffer, &m_Buffer[0], count);
+			memcpy(buffer, &m_Buffer[m_BufferOffset], count);
 			m_BufferOffset += count;
 		}
 		return count;
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "String/StringTypes.h"
+#include <cstring>
+#include <type_traits>
+
+namespace tyr
+{
+	enum class LogArgumentType : uint8
+	{
+		Int,
+		UInt,
+		Double,
+		Pointer,
+		String
+	};
+
+	/// Encodes log arguments into a binary record so that they can be formatted later on the logging thread.
+	///
+	/// Numbers and pointers are stored as a type byte followed by 8 bytes. Strings are copied as a type byte, a length
+	/// and the characters with a null terminator, so they do not need to outlive the call.
+	class LogArguments final
+	{
+	public:
+		/// Strings longer than this are truncated.
+		static constexpr uint c_MaxStringLength = 2048;
+
+		template<typename T>
+		static size_t GetEncodedSize(const T& arg)
+		{
+			if constexpr (IsString<T>())
+			{
+				return 1 + sizeof(uint) + GetStringLength(arg) + 1;
+			}
+			else
+			{
+				return 1 + sizeof(uint64);
+			}
+		}
+
+		template<typename T>
+		static uint8* Encode(uint8* dst, const T& arg)
+		{
+			using Type = std::decay_t<T>;
+			if constexpr (IsString<T>())
+			{
+				const char* str = GetStringData(arg);
+				const uint length = GetStringLength(arg);
+				*dst++ = static_cast<uint8>(LogArgumentType::String);
+				memcpy(dst, &length, sizeof(uint));
+				dst += sizeof(uint);
+				memcpy(dst, str, length);
+				dst[length] = '\0';
+				return dst + length + 1;
+			}
+			else if constexpr (std::is_enum_v<Type>)
+			{
+				return Encode(dst, static_cast<std::underlying_type_t<Type>>(arg));
+			}
+			else if constexpr (std::is_floating_point_v<Type>)
+			{
+				return EncodeValue(dst, LogArgumentType::Double, static_cast<double>(arg));
+			}
+			else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+			{
+				return EncodeValue(dst, LogArgumentType::Int, static_cast<int64>(arg));
+			}
+			else if constexpr (std::is_integral_v<Type>)
+			{
+				return EncodeValue(dst, LogArgumentType::UInt, static_cast<uint64>(arg));
+			}
+			else if constexpr (std::is_pointer_v<Type> || std::is_null_pointer_v<Type>)
+			{
+				return EncodeValue(dst, LogArgumentType::Pointer, reinterpret_cast<uint64>(static_cast<const void*>(arg)));
+			}
+			else
+			{
+				TYR_STATIC_ASSERT(sizeof(T) == 0, "Unsupported log argument type");
+				return dst;
+			}
+		}
+
+	private:
+		template<typename T>
+		static constexpr bool IsString()
+		{
+			using Type = std::decay_t<T>;
+			return std::is_same_v<Type, const char*> || std::is_same_v<Type, char*> || std::is_same_v<Type, String>
+				|| std::is_same_v<Type, StringView> || IsLocalString<Type>::value;
+		}
+
+		template<typename T>
+		struct IsLocalString : std::false_type {};
+
+		template<uint N>
+		struct IsLocalString<LocalString<N>> : std::true_type {};
+
+		template<typename T>
+		static const char* GetStringData(const T& arg)
+		{
+			using Type = std::decay_t<T>;
+			if constexpr (std::is_same_v<Type, String> || std::is_same_v<Type, StringView>)
+			{
+				return arg.data();
+			}
+			else if constexpr (IsLocalString<Type>::value)
+			{
+				return arg.CStr();
+			}
+			else if constexpr (std::is_pointer_v<T>)
+			{
+				return arg ? static_cast<const char*>(arg) : "(null)";
+			}
+			else
+			{
+				// Character arrays can't be null
+				return arg;
+			}
+		}
+
+		template<typename T>
+		static uint GetStringLength(const T& arg)
+		{
+			using Type = std::decay_t<T>;
+			size_t length;
+			if constexpr (std::is_same_v<Type, String> || std::is_same_v<Type, StringView>)
+			{
+				length = arg.size();
+			}
+			else if constexpr (IsLocalString<Type>::value)
+			{
+				length = arg.Size();
+			}
+			else
+			{
+				length = strlen(GetStringData(arg));
+			}
+			return static_cast<uint>(std::min<size_t>(length, c_MaxStringLength));
+		}
+
+		template<typename T>
+		static uint8* EncodeValue(uint8* dst, LogArgumentType type, T value)
+		{
+			TYR_STATIC_ASSERT(sizeof(T) == sizeof(uint64), "Encoded values must be 8 bytes");
+			*dst++ = static_cast<uint8>(type);
+			memcpy(dst, &value, sizeof(T));
+			return dst + sizeof(T);
+		}
+	};
+}
@@ -0,0 +1,106 @@
+#include "LogSinks.h"
+#include "IO/FileStream.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if TYR_PLATFORM == TYR_PLATFORM_WINDOWS && TYR_COMPILER == TYR_COMPILER_MSVC
+#include <windows.h>
+#endif
+
+namespace tyr
+{
+	void ConsoleLogSink::Write(const char* text, size_t size)
+	{
+#if TYR_PLATFORM == TYR_PLATFORM_WINDOWS && TYR_COMPILER == TYR_COMPILER_MSVC
+		OutputDebugStringA(text);
+#endif
+		// Default output if running without debugger.
+		std::fwrite(text, 1, size, stdout);
+	}
+
+	void ConsoleLogSink::Flush()
+	{
+		std::fflush(stdout);
+	}
+
+	RotatingFileLogSink::RotatingFileLogSink(const char* filePath, size_t maxFileSize, uint maxBackupCount)
+		: m_FilePath(filePath)
+		, m_MaxFileSize(maxFileSize)
+		, m_MaxBackupCount(maxBackupCount)
+		, m_FileSize(0)
+	{
+		// Keep the log of the previous run as a backup
+		Rotate();
+	}
+
+	RotatingFileLogSink::~RotatingFileLogSink()
+	{
+
+	}
+
+	void RotatingFileLogSink::Write(const char* text, size_t size)
+	{
+		while (m_FileSize + size > m_MaxFileSize)
+		{
+			// Fill the file up to the last line that fits
+			size_t count = 0;
+			const size_t available = m_MaxFileSize > m_FileSize ? m_MaxFileSize - m_FileSize : 0;
+			for (size_t i = std::min(available, size); i > 0; --i)
+			{
+				if (text[i - 1] == '\n')
+				{
+					count = i;
+					break;
+				}
+			}
+
+			// A line longer than the limit gets a file of its own
+			if (count == 0 && m_FileSize == 0)
+			{
+				const char* lineEnd = static_cast<const char*>(memchr(text, '\n', size));
+				count = lineEnd ? static_cast<size_t>(lineEnd - text) + 1 : size;
+			}
+
+			m_FileSize += m_Stream->Write(text, count);
+			text += count;
+			size -= count;
+			if (size == 0)
+			{
+				return;
+			}
+			Rotate();
+		}
+
+		m_FileSize += m_Stream->Write(text, size);
+	}
+
+	void RotatingFileLogSink::Rotate()
+	{
+		m_Stream.reset();
+
+		// Renaming and removing fail harmlessly for files that do not exist
+		if (m_MaxBackupCount > 0)
+		{
+			std::remove(GetBackupPath(m_MaxBackupCount).c_str());
+			for (uint i = m_MaxBackupCount - 1; i > 0; --i)
+			{
+				std::rename(GetBackupPath(i).c_str(), GetBackupPath(i + 1).c_str());
+			}
+			std::rename(m_FilePath.c_str(), GetBackupPath(1).c_str());
+		}
+
+		m_Stream = MakeURef<FileStream>(m_FilePath.c_str(), BinaryStream::Operation::Write);
+		m_FileSize = 0;
+	}
+
+	String RotatingFileLogSink::GetBackupPath(uint index) const
+	{
+		// Insert the index before the extension
+		const size_t separator = m_FilePath.find_last_of("/\\");
+		const size_t dot = m_FilePath.find_last_of('.');
+		const bool hasExtension = dot != String::npos && (separator == String::npos || dot > separator);
+		const size_t insertPos = hasExtension ? dot : m_FilePath.size();
+		return m_FilePath.substr(0, insertPos) + "." + std::to_string(index) + m_FilePath.substr(insertPos);
+	}
+}
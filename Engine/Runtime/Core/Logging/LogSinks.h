@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "String/StringTypes.h"
+#include "Memory/MemoryTypes.h"
+
+namespace tyr
+{
+	class FileStream;
+
+	/// Destination for formatted log text. Sinks are only called from the logging thread, or from the calling thread
+	/// under a lock when the logger is not running, so they do not need to be thread safe.
+	class TYR_CORE_EXPORT LogSink
+	{
+	public:
+		virtual ~LogSink() = default;
+
+		/// Writes a batch of formatted lines. The text is null terminated.
+		virtual void Write(const char* text, size_t size) = 0;
+
+		virtual void Flush() {}
+	};
+
+	/// Writes to stdout, and to the debugger output on Windows.
+	class TYR_CORE_EXPORT ConsoleLogSink final : public LogSink
+	{
+	public:
+		void Write(const char* text, size_t size) override;
+
+		void Flush() override;
+	};
+
+	/// Writes to a file that is rotated once it reaches a maximum size.
+	///
+	/// The current log is always written to filePath. On rotation it becomes the first backup (Log.1.txt for Log.txt),
+	/// the other backups move up one and the oldest is deleted. A log left by a previous run is rotated on creation.
+	class TYR_CORE_EXPORT RotatingFileLogSink final : public LogSink
+	{
+	public:
+		RotatingFileLogSink(const char* filePath, size_t maxFileSize, uint maxBackupCount);
+		~RotatingFileLogSink();
+
+		void Write(const char* text, size_t size) override;
+
+	private:
+		void Rotate();
+		String GetBackupPath(uint index) const;
+
+		String m_FilePath;
+		size_t m_MaxFileSize;
+		uint m_MaxBackupCount;
+		size_t m_FileSize;
+		URef<FileStream> m_Stream;
+	};
+}
@@ -1,94 +1,696 @@
 #include "Logger.h"
-#include "String/StringUtil.h"
-#include "Threading/Threading.h"
-#include <iostream>
+#include "Memory/Allocation.h"
+#include "Profiling/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 
 namespace tyr
 {
+	struct LogRecordHeader
+	{
+		// Size of the record including the arguments. Always a multiple of 8.
+		uint size;
+		// Fills the end of the buffer when a record does not fit before it wraps
+		bool isPadding;
+		LogLevel level;
+		LogCategory category;
+		uint8 argCount;
+		uint line;
+		uint64 timestamp;
+		const char* format;
+		const char* function;
+		const char* file;
+	};
+
+	struct LogThreadBuffer
+	{
+		// Written by the owning thread and read by the consumer
+		alignas(c_CacheLineSize) Atomic<uint64> head = 0;
+		// Written by the consumer and read by the owning thread
+		alignas(c_CacheLineSize) Atomic<uint64> tail = 0;
+
+		// Only accessed by the owning thread. End of the record being written.
+		alignas(c_CacheLineSize) uint64 reservedHead = 0;
+		uint64 capacity = 0;
+		uint8* data = nullptr;
+	};
+
+	namespace
+	{
+		struct PendingRecord
+		{
+			uint64 timestamp;
+			const LogRecordHeader* header;
+		};
+
+		uint64 GetTimestamp()
+		{
+			return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		const char* GetLevelName(LogLevel level)
+		{
+			switch (level)
+			{
+			case LogLevel::Fatal:
+				return "FATAL";
+			case LogLevel::Error:
+				return "ERROR";
+			case LogLevel::Warning:
+				return "WARNING";
+			default:
+				return "INFO";
+			}
+		}
+
+		const char* GetCategoryName(LogCategory category)
+		{
+			switch (category)
+			{
+			case LogCategory::General:
+				return "General";
+			case LogCategory::FileSystem:
+				return "FileSystem";
+			default:
+				return nullptr;
+			}
+		}
+
+		template<typename... Args>
+		void AppendFormatted(String& out, const char* format, Args... args)
+		{
+			char buffer[128];
+			const int length = std::snprintf(buffer, sizeof(buffer), format, args...);
+			if (length <= 0)
+			{
+				return;
+			}
+			if (static_cast<size_t>(length) < sizeof(buffer))
+			{
+				out.append(buffer, static_cast<size_t>(length));
+			}
+			else
+			{
+				const size_t offset = out.size();
+				out.resize(offset + length + 1);
+				std::snprintf(&out[offset], length + 1, format, args...);
+				out.resize(offset + length);
+			}
+		}
+
+		/// Reads the arguments encoded by LogArguments.
+		class LogArgumentReader final
+		{
+		public:
+			LogArgumentReader(const uint8* data, uint count)
+				: m_Data(data)
+				, m_Remaining(count)
+			{
+
+			}
+
+			bool HasNext() const
+			{
+				return m_Remaining > 0;
+			}
+
+			LogArgumentType Next(uint64& value, const char*& str)
+			{
+				TYR_ASSERT(HasNext());
+				m_Remaining--;
+				const LogArgumentType type = static_cast<LogArgumentType>(*m_Data++);
+				if (type == LogArgumentType::String)
+				{
+					uint length;
+					memcpy(&length, m_Data, sizeof(uint));
+					str = reinterpret_cast<const char*>(m_Data + sizeof(uint));
+					value = length;
+					m_Data += sizeof(uint) + length + 1;
+				}
+				else
+				{
+					memcpy(&value, m_Data, sizeof(uint64));
+					m_Data += sizeof(uint64);
+				}
+				return type;
+			}
+
+		private:
+			const uint8* m_Data;
+			uint m_Remaining;
+		};
+
+		void AppendArgument(String& out, LogArgumentType type, uint64 value, const char* str)
+		{
+			switch (type)
+			{
+			case LogArgumentType::Int:
+				AppendFormatted(out, "%lld", static_cast<long long>(static_cast<int64>(value)));
+				break;
+			case LogArgumentType::UInt:
+				AppendFormatted(out, "%llu", static_cast<unsigned long long>(value));
+				break;
+			case LogArgumentType::Double:
+			{
+				double d;
+				memcpy(&d, &value, sizeof(double));
+				AppendFormatted(out, "%g", d);
+				break;
+			}
+			case LogArgumentType::Pointer:
+				AppendFormatted(out, "%p", reinterpret_cast<void*>(value));
+				break;
+			case LogArgumentType::String:
+				out.append(str, static_cast<size_t>(value));
+				break;
+			}
+		}
+
+		/// Formats a printf style message from encoded arguments.
+		/// Length modifiers are ignored as integers are always stored as 64 bits, so a %d given an int64 prints
+		/// correctly. Conversions without a matching argument are written out unchanged.
+		void FormatMessage(String& out, const char* format, const uint8* args, uint argCount)
+		{
+			LogArgumentReader reader(args, argCount);
+			const char* c = format;
+			while (*c != '\0')
+			{
+				if (*c != '%')
+				{
+					const char* start = c;
+					while (*c != '\0' && *c != '%')
+					{
+						++c;
+					}
+					out.append(start, c - start);
+					continue;
+				}
+
+				if (c[1] == '%')
+				{
+					out += '%';
+					c += 2;
+					continue;
+				}
+
+				// Rebuild the conversion without its length modifier
+				const char* specStart = c++;
+				char spec[32];
+				uint specLength = 0;
+				spec[specLength++] = '%';
+				while (*c != '\0' && strchr("-+ #0123456789.*", *c) && specLength < sizeof(spec) - 4)
+				{
+					spec[specLength++] = *c++;
+				}
+				while (*c != '\0' && strchr("hljztL", *c))
+				{
+					++c;
+				}
+				const char conversion = *c;
+				if (conversion == '\0')
+				{
+					out.append(specStart);
+					break;
+				}
+				++c;
+
+				const bool hasArgument = reader.HasNext() && memchr(spec, '*', specLength) == nullptr;
+				if (!hasArgument)
+				{
+					out.append(specStart, c - specStart);
+					continue;
+				}
+
+				uint64 value;
+				const char* str = nullptr;
+				const LogArgumentType type = reader.Next(value, str);
+				const bool isInteger = type == LogArgumentType::Int || type == LogArgumentType::UInt;
+				const bool plain = specLength == 1;
+				switch (conversion)
+				{
+				case 'd':
+				case 'i':
+					if (!isInteger)
+					{
+						AppendArgument(out, type, value, str);
+						break;
+					}
+					memcpy(&spec[specLength], "lld", 4);
+					AppendFormatted(out, spec, static_cast<long long>(static_cast<int64>(value)));
+					break;
+				case 'u':
+				case 'x':
+				case 'X':
+				case 'o':
+					if (!isInteger)
+					{
+						AppendArgument(out, type, value, str);
+						break;
+					}
+					spec[specLength] = 'l';
+					spec[specLength + 1] = 'l';
+					spec[specLength + 2] = conversion;
+					spec[specLength + 3] = '\0';
+					AppendFormatted(out, spec, static_cast<unsigned long long>(value));
+					break;
+				case 'c':
+					if (!isInteger)
+					{
+						AppendArgument(out, type, value, str);
+						break;
+					}
+					memcpy(&spec[specLength], "c", 2);
+					AppendFormatted(out, spec, static_cast<int>(value));
+					break;
+				case 'f':
+				case 'F':
+				case 'e':
+				case 'E':
+				case 'g':
+				case 'G':
+				case 'a':
+				case 'A':
+				{
+					double d;
+					if (type == LogArgumentType::Double)
+					{
+						memcpy(&d, &value, sizeof(double));
+					}
+					else if (type == LogArgumentType::Int)
+					{
+						d = static_cast<double>(static_cast<int64>(value));
+					}
+					else if (type == LogArgumentType::UInt)
+					{
+						d = static_cast<double>(value);
+					}
+					else
+					{
+						AppendArgument(out, type, value, str);
+						break;
+					}
+					spec[specLength] = conversion;
+					spec[specLength + 1] = '\0';
+					AppendFormatted(out, spec, d);
+					break;
+				}
+				case 's':
+					if (type != LogArgumentType::String)
+					{
+						AppendArgument(out, type, value, str);
+					}
+					else if (plain)
+					{
+						out.append(str, static_cast<size_t>(value));
+					}
+					else
+					{
+						memcpy(&spec[specLength], "s", 2);
+						AppendFormatted(out, spec, str);
+					}
+					break;
+				default:
+					// Pointers and anything unknown
+					AppendArgument(out, type, value, str);
+					break;
+				}
+			}
+		}
+
+		ConsoleLogSink& GetFallbackSink()
+		{
+			static ConsoleLogSink sink;
+			return sink;
+		}
+	}
+
+	TYR_THREADLOCAL LogThreadBuffer* Logger::s_ThreadBuffer = nullptr;
+
+	Logger::Logger()
+		: m_Running(false)
+		, m_DroppedCount(0)
+		, m_ReportedDroppedCount(0)
+		, m_StartTime(GetTimestamp())
+		, m_FlushRequests(0)
+		, m_FlushesDone(0)
+		, m_StopRequested(false)
+	{
+		for (Atomic<LogLevel>& level : m_Levels)
+		{
+			level.store(LogLevel::Info, std::memory_order_relaxed);
+		}
+	}
+
+	Logger::~Logger()
+	{
+		if (m_Running.load(std::memory_order_acquire))
+		{
+			Shutdown();
+		}
+
+		for (LogThreadBuffer* buffer : m_ThreadBuffers)
+		{
+			FreeAligned(buffer->data);
+			delete buffer;
+		}
+	}
+
+	void Logger::Initialize(const LoggerConfig& config)
+	{
+		TYR_ASSERT(!m_Running.load(std::memory_order_relaxed));
+		TYR_ASSERT((config.threadBufferSize & (config.threadBufferSize - 1)) == 0);
+
+		m_Config = config;
+		{
+			LockGuard guard(m_SinkMutex);
+			if (config.logToConsole)
+			{
+				m_Sinks.Add(MakeURef<ConsoleLogSink>());
+			}
+			if (!config.filePath.empty())
+			{
+				m_Sinks.Add(MakeURef<RotatingFileLogSink>(config.filePath.c_str(), config.maxFileSize, config.maxFileBackupCount));
+			}
+		}
+
+		m_StopRequested = false;
+		m_Thread = Thread(&Logger::LoggingThreadMain, this);
+		m_Running.store(true, std::memory_order_release);
+	}
+
+	void Logger::Shutdown()
+	{
+		TYR_ASSERT(m_Running.load(std::memory_order_relaxed));
+
+		{
+			LockGuard guard(m_WakeMutex);
+			m_StopRequested = true;
+		}
+		m_WakeCV.notify_one();
+		m_Thread.join();
+		m_Running.store(false, std::memory_order_release);
+
+		LockGuard guard(m_SinkMutex);
+		// Records logged while the thread was stopping
+		ProcessRecords();
+		for (URef<LogSink>& sink : m_Sinks)
+		{
+			sink->Flush();
+		}
+		m_Sinks.Clear();
+	}
+
+	void Logger::AddSink(URef<LogSink> sink)
+	{
+		TYR_ASSERT(!m_Running.load(std::memory_order_relaxed));
+		LockGuard guard(m_SinkMutex);
+		m_Sinks.Add(std::move(sink));
+	}
+
+	void Logger::SetLevel(LogCategory category, LogLevel level)
+	{
+		m_Levels[static_cast<uint>(category)].store(level, std::memory_order_relaxed);
+	}
+
 	void Logger::LogMessage(const String& msg, LogLevel level, LogCategory category)
 	{
-		// TODO: Log out to a file here
-		switch (level)
+		Log(level, category, LogSource{ nullptr, nullptr, 0 }, "%s", msg);
+	}
+
+	LogThreadBuffer* Logger::GetThreadBuffer()
+	{
+		if (s_ThreadBuffer == nullptr)
+		{
+			LogThreadBuffer* buffer = new LogThreadBuffer();
+			buffer->capacity = m_Config.threadBufferSize;
+			buffer->data = static_cast<uint8*>(AllocAligned(buffer->capacity, alignof(LogRecordHeader)));
+
+			LockGuard guard(m_RegistryMutex);
+			m_ThreadBuffers.Add(buffer);
+			s_ThreadBuffer = buffer;
+		}
+		return s_ThreadBuffer;
+	}
+
+	uint8* Logger::BeginRecord(LogLevel level, LogCategory category, const LogSource& source, const char* format, uint argCount, size_t argsSize)
+	{
+		TYR_ASSERT(argCount <= UINT8_MAX);
+		const uint64 timestamp = GetTimestamp();
+		LogThreadBuffer* buffer = GetThreadBuffer();
+
+		const uint64 size = (sizeof(LogRecordHeader) + argsSize + 7) & ~7ull;
+		if (size > buffer->capacity / 2)
+		{
+			TYR_ASSERT(level != LogLevel::Fatal);
+			m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		uint64 head = buffer->head.load(std::memory_order_relaxed);
+		const uint64 offset = head & (buffer->capacity - 1);
+		const uint64 contiguous = buffer->capacity - offset;
+		const uint64 padding = size > contiguous ? contiguous : 0;
+
+		uint64 used = head - buffer->tail.load(std::memory_order_acquire);
+		while (used + padding + size > buffer->capacity)
+		{
+			if (level != LogLevel::Fatal)
+			{
+				m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			// Fatal records are never dropped
+			if (m_Running.load(std::memory_order_acquire))
+			{
+				m_WakeCV.notify_one();
+				TYR_THREAD_YIELD
+			}
+			else
+			{
+				LockGuard guard(m_SinkMutex);
+				ProcessRecords();
+			}
+			used = head - buffer->tail.load(std::memory_order_acquire);
+		}
+
+		// Wake the logging thread early once the buffer is half full
+		const uint64 halfCapacity = buffer->capacity / 2;
+		if (used < halfCapacity && used + padding + size >= halfCapacity && m_Running.load(std::memory_order_relaxed))
 		{
-		case LogLevel::Fatal:
-			LogToConsole(msg.c_str(), "FATAL");
-			break;
-		case LogLevel::Error:
-			LogToConsole(msg.c_str(), "ERROR");
-			break;
-		case LogLevel::Warning:
-			LogToConsole(msg.c_str(), "WARNING");
-			break;
-		case LogLevel::Info:
-			LogToConsole(msg.c_str(), "INFO");
-			break;
-		}	
+			m_WakeCV.notify_one();
+		}
+
+		if (padding > 0)
+		{
+			LogRecordHeader* paddingHeader = reinterpret_cast<LogRecordHeader*>(&buffer->data[offset]);
+			paddingHeader->size = static_cast<uint>(padding);
+			paddingHeader->isPadding = true;
+			head += padding;
+		}
+
+		LogRecordHeader* header = reinterpret_cast<LogRecordHeader*>(&buffer->data[head & (buffer->capacity - 1)]);
+		header->size = static_cast<uint>(size);
+		header->isPadding = false;
+		header->level = level;
+		header->category = category;
+		header->argCount = static_cast<uint8>(argCount);
+		header->line = source.line;
+		header->timestamp = timestamp;
+		header->format = format;
+		header->function = source.function;
+		header->file = source.file;
+
+		buffer->reservedHead = head + size;
+		return reinterpret_cast<uint8*>(header + 1);
 	}
 
-	void Logger::LogErrorAndTrace(const String& msg, const String& stackTrace, LogLevel logLevel)
+	void Logger::EndRecord(LogLevel level)
 	{
-		StringStream errorMsg;
-		if (logLevel == LogLevel::Fatal)
+		LogThreadBuffer* buffer = s_ThreadBuffer;
+		buffer->head.store(buffer->reservedHead, std::memory_order_release);
+
+		if (!m_Running.load(std::memory_order_acquire))
 		{
-			errorMsg << "A fatal error occurred and the application must be terminated!" << std::endl;
+			LockGuard guard(m_SinkMutex);
+			ProcessRecords();
 		}
-		errorMsg << msg;
 
-		if (stackTrace != "")
+		if (level == LogLevel::Fatal)
 		{
-			errorMsg << "\n\nStack trace: \n";
-			errorMsg << stackTrace;
+			Flush();
 		}
+	}
 
-		LogMessage(errorMsg.str(), logLevel);
+	void Logger::Flush()
+	{
+		if (m_Running.load(std::memory_order_acquire))
+		{
+			Lock lock(m_WakeMutex);
+			const uint64 request = ++m_FlushRequests;
+			m_WakeCV.notify_one();
+			m_FlushCV.wait(lock, [this, request]() { return m_FlushesDone >= request || m_StopRequested; });
+		}
+		else
+		{
+			LockGuard guard(m_SinkMutex);
+			ProcessRecords();
+			for (URef<LogSink>& sink : m_Sinks)
+			{
+				sink->Flush();
+			}
+			GetFallbackSink().Flush();
+		}
 	}
 
-	void Logger::LogError(LogLevel logLevel, const String& function, const String& file, uint line, const char* desc, ...)
+	void Logger::LoggingThreadMain()
 	{
-		va_list args;
-		char buffer[4096];
+		TYR_PROFILE_THREAD_NAME("Logger");
 
-		va_start(args, desc);
-		vsprintf_s(buffer, desc, args);
-		va_end(args);
+		while (true)
+		{
+			uint64 flushRequests;
+			bool stop;
+			{
+				Lock lock(m_WakeMutex);
+				m_WakeCV.wait_for(lock, std::chrono::milliseconds(m_Config.flushIntervalMs),
+					[this]() { return m_StopRequested || m_FlushRequests != m_FlushesDone; });
+				flushRequests = m_FlushRequests;
+				stop = m_StopRequested;
+			}
 
-		String descStr = buffer;
+			{
+				LockGuard guard(m_SinkMutex);
+				// Sinks are flushed with each batch so a crash loses at most one flush interval of messages
+				if (ProcessRecords() || flushRequests != m_FlushesDone)
+				{
+					for (URef<LogSink>& sink : m_Sinks)
+					{
+						sink->Flush();
+					}
+				}
+			}
 
-		StringStream msg;
-		msg << "  - Description: " << descStr << std::endl;
-		msg << "  - Function: " << function << std::endl;
-		msg << "  - File: "     << file << ":" << line;
+			{
+				LockGuard guard(m_WakeMutex);
+				m_FlushesDone = flushRequests;
+			}
+			m_FlushCV.notify_all();
 
-		// TODO:: Get stack trace from Platform
-		LogErrorAndTrace(msg.str(), "", logLevel);
+			if (stop)
+			{
+				break;
+			}
+		}
 	}
 
-#if TYR_PLATFORM == TYR_PLATFORM_WINDOWS && TYR_COMPILER == TYR_COMPILER_MSVC
-#include <windows.h>
-	void Logger::LogToConsole(const String& msg, const char* catergory)
+	bool Logger::ProcessRecords()
 	{
-		static Mutex mutex;
+		TYR_PROFILE_SCOPE("Logger::ProcessRecords");
 
-		Lock lock(mutex);
-		OutputDebugString("[");
-		OutputDebugString(catergory);
-		OutputDebugString("] ");
-		OutputDebugString(msg.c_str());
-		OutputDebugString("\n");
+		// Gather the published records of every thread
+		Array<PendingRecord> records;
+		Array<LogThreadBuffer*> buffers;
+		Array<uint64> heads;
+		{
+			LockGuard guard(m_RegistryMutex);
+			buffers = m_ThreadBuffers;
+		}
+		heads.Resize(buffers.Size());
+
+		for (uint i = 0; i < buffers.Size(); ++i)
+		{
+			LogThreadBuffer* buffer = buffers[i];
+			const uint64 head = buffer->head.load(std::memory_order_acquire);
+			heads[i] = head;
+			for (uint64 pos = buffer->tail.load(std::memory_order_relaxed); pos < head;)
+			{
+				const LogRecordHeader* header = reinterpret_cast<const LogRecordHeader*>(&buffer->data[pos & (buffer->capacity - 1)]);
+				if (!header->isPadding)
+				{
+					records.Add({ header->timestamp, header });
+				}
+				pos += header->size;
+			}
+		}
+
+		const uint64 droppedCount = m_DroppedCount.load(std::memory_order_relaxed);
+		if (records.Size() == 0 && droppedCount == m_ReportedDroppedCount)
+		{
+			return false;
+		}
+
+		// Each thread's records are already in order
+		std::stable_sort(records.begin(), records.end(),
+			[](const PendingRecord& a, const PendingRecord& b) { return a.timestamp < b.timestamp; });
+
+		m_FormatBuffer.clear();
+		if (droppedCount != m_ReportedDroppedCount)
+		{
+			AppendFormatted(m_FormatBuffer, "[WARNING] %llu log messages were dropped as a thread's log buffer was full\n",
+				static_cast<unsigned long long>(droppedCount - m_ReportedDroppedCount));
+			m_ReportedDroppedCount = droppedCount;
+		}
+
+		for (const PendingRecord& record : records)
+		{
+			const double seconds = static_cast<double>(static_cast<int64>(record.timestamp - m_StartTime)) * 1e-9;
+			FormatRecord(m_FormatBuffer, *record.header, seconds);
+		}
+
+		// The records are no longer needed once formatted
+		for (uint i = 0; i < buffers.Size(); ++i)
+		{
+			buffers[i]->tail.store(heads[i], std::memory_order_release);
+		}
 
-		// Default output if running without debugger.
-		std::cout << "[" << catergory << "] " << msg << std::endl;
+		WriteToSinks(m_FormatBuffer);
+		return true;
 	}
-#else
-	void Logger::LogToConsole(const String& msg, const char* catergory)
+
+	void Logger::WriteToSinks(const String& text)
+	{
+		if (m_Sinks.Size() == 0)
+		{
+			GetFallbackSink().Write(text.c_str(), text.size());
+			return;
+		}
+
+		for (URef<LogSink>& sink : m_Sinks)
+		{
+			sink->Write(text.c_str(), text.size());
+		}
+	}
+
+	void Logger::FormatRecord(String& out, const LogRecordHeader& header, double seconds)
 	{
-		std::cout << "[" << catergory << "] " << msg << std::endl;
+		AppendFormatted(out, "[%.6f] [%s] ", seconds, GetLevelName(header.level));
+		if (const char* category = GetCategoryName(header.category))
+		{
+			out += '[';
+			out += category;
+			out += "] ";
+		}
+
+		if (header.level == LogLevel::Fatal)
+		{
+			out += "A fatal error occurred and the application must be terminated!\n  - Description: ";
+		}
+
+		FormatMessage(out, header.format, reinterpret_cast<const uint8*>(&header + 1), header.argCount);
+
+		if (header.level <= LogLevel::Error && header.file)
+		{
+			AppendFormatted(out, "\n  - Function: %s\n  - File: %s:%u", header.function, header.file, header.line);
+		}
+		out += '\n';
 	}
-#endif
 
 	Logger& Logger::Instance()
 	{
 		static Logger logger;
 		return logger;
 	}
-}
\ No newline at end of file
+}
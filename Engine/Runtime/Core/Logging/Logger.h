@@ -1,42 +1,159 @@
 #pragma once
 
-#include "Base/base.h"
+#include "Base/Base.h"
+#include "Base/INonCopyable.h"
 #include "String/StringTypes.h"
+#include "Containers/Array.h"
+#include "Threading/Threading.h"
+#include "Memory/MemoryTypes.h"
+#include "LogArguments.h"
+#include "LogSinks.h"
 
 namespace tyr
 {
-	enum class LogLevel
+	enum class LogLevel : uint8
 	{
 		Fatal,
 		Error,
 		Warning,
-		Info	
+		Info
 	};
 
-	enum class LogCategory : uint
+	enum class LogCategory : uint8
 	{
 		Unspecified,
 		General,
-		FileSystem
+		FileSystem,
+		Count
 	};
 
-	class TYR_CORE_EXPORT Logger 
+	/// Where a message was logged from. The strings must be literals.
+	struct LogSource
+	{
+		const char* function;
+		const char* file;
+		uint line;
+	};
+
+	struct LoggerConfig
+	{
+		// Size in bytes of the ring buffer each logging thread writes records to. Must be a power of 2.
+		uint threadBufferSize = 64 * 1024;
+		// How often the logging thread writes out records
+		uint flushIntervalMs = 10;
+		bool logToConsole = true;
+		// No file is written if empty
+		String filePath;
+		size_t maxFileSize = 8 * 1024 * 1024;
+		uint maxFileBackupCount = 3;
+	};
+
+	struct LogThreadBuffer;
+	struct LogRecordHeader;
+
+	/// Asynchronous logger.
+	///
+	/// - Logging threads write a compact binary record (format pointer, timestamp, level, category, source and the
+	///   arguments) into a lock-free ring buffer owned by the thread. Nothing is formatted or allocated on the caller.
+	/// - A background thread drains the buffers, orders the records by timestamp, formats them and writes each batch
+	///   to the sinks.
+	/// - Levels are filtered per category before any work is done.
+	/// - A record that does not fit in a full buffer is dropped and counted. Fatal records wait for space and flush
+	///   the logger before returning.
+	/// - Before Initialize() and after Shutdown() messages are formatted and written to the console on the caller.
+	class TYR_CORE_EXPORT Logger final : public INonCopyable
 	{
 	public:
-		Logger& operator=(const Logger&) = delete;
-		Logger(const Logger&) = delete;
+		void Initialize(const LoggerConfig& config = LoggerConfig());
+
+		/// Writes out all pending records and stops the logging thread. Other threads must have stopped logging.
+		void Shutdown();
+
+		/// Adds a sink. Must be called before Initialize().
+		void AddSink(URef<LogSink> sink);
+
+		/// Messages less severe than level are discarded for the category.
+		void SetLevel(LogCategory category, LogLevel level);
+
+		bool IsEnabled(LogLevel level, LogCategory category) const
+		{
+			return level <= m_Levels[static_cast<uint>(category)].load(std::memory_order_relaxed);
+		}
 
-		void LogMessage(const String& msg, LogLevel logLevel, LogCategory logCatergory = LogCategory::Unspecified);
+		/// Logs a printf style message. The format string must be a literal as it is formatted later.
+		/// Arguments are copied, strings included.
+		template<typename... Args>
+		void Log(LogLevel level, LogCategory category, const LogSource& source, const char* format, const Args&... args)
+		{
+			if (!IsEnabled(level, category))
+			{
+				return;
+			}
 
-		void LogErrorAndTrace(const String& msg, const String& stackTrace, LogLevel logLevel);
+			const size_t argsSize = (static_cast<size_t>(0) + ... + LogArguments::GetEncodedSize(args));
+			uint8* data = BeginRecord(level, category, source, format, static_cast<uint>(sizeof...(Args)), argsSize);
+			if (data)
+			{
+				((data = LogArguments::Encode(data, args)), ...);
+				EndRecord(level);
+			}
+		}
 
-		void LogError(LogLevel logLevel, const String& function, const String& file, uint line, const char* desc, ...);
+		/// Logs a message that is not a format string.
+		void LogMessage(const String& msg, LogLevel level, LogCategory category = LogCategory::Unspecified);
+
+		/// Blocks until every record logged before the call has been written to the sinks.
+		void Flush();
+
+		/// Number of records dropped because a thread's buffer was full.
+		uint64 GetDroppedCount() const
+		{
+			return m_DroppedCount.load(std::memory_order_relaxed);
+		}
 
 		static Logger& Instance();
 
 	private:
-		Logger() = default;
-		void LogToConsole(const String& msg, const char* catergory);
+		Logger();
+		~Logger();
+
+		/// Reserves space for a record and returns where to write the arguments, or null if the record was dropped.
+		uint8* BeginRecord(LogLevel level, LogCategory category, const LogSource& source, const char* format, uint argCount, size_t argsSize);
+		void EndRecord(LogLevel level);
+		LogThreadBuffer* GetThreadBuffer();
+
+		void LoggingThreadMain();
+		/// Formats and writes out all records in the thread buffers. Returns false if there were none.
+		bool ProcessRecords();
+		void WriteToSinks(const String& text);
+
+		static void FormatRecord(String& out, const LogRecordHeader& header, double seconds);
+
+		static TYR_THREADLOCAL LogThreadBuffer* s_ThreadBuffer;
+
+		Atomic<LogLevel> m_Levels[static_cast<uint>(LogCategory::Count)];
+		Atomic<bool> m_Running;
+		Atomic<uint64> m_DroppedCount;
+		uint64 m_ReportedDroppedCount;
+		uint64 m_StartTime;
+		LoggerConfig m_Config;
+
+		Mutex m_RegistryMutex;
+		Array<LogThreadBuffer*> m_ThreadBuffers;
+
+		// Held while processing records so that only one thread consumes the buffers and writes to the sinks
+		Mutex m_SinkMutex;
+		Array<URef<LogSink>> m_Sinks;
+
+		Thread m_Thread;
+		Mutex m_WakeMutex;
+		ConditionVariable m_WakeCV;
+		ConditionVariable m_FlushCV;
+		uint64 m_FlushRequests;
+		uint64 m_FlushesDone;
+		bool m_StopRequested;
+
+		// Guarded by m_SinkMutex
+		String m_FormatBuffer;
 	};
-	
-}
\ No newline at end of file
+}
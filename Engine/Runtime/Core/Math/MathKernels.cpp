@@ -0,0 +1,495 @@
+#include "MathKernels.h"
+#include "SIMD.h"
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if TYR_USE_SIMD
+namespace tyr
+{
+	namespace
+	{
+		// Returns the row of lhs multiplied by the matrix with rows r0 to r3
+		TYR_FORCEINLINE Reg4 MultiplyRow(Reg4 lhsRow, Reg4 r0, Reg4 r1, Reg4 r2, Reg4 r3)
+		{
+			Reg4 row = SIMD::Mul4(SIMD::Splat4<0>(lhsRow), r0);
+			row = SIMD::MulAdd4(SIMD::Splat4<1>(lhsRow), r1, row);
+			row = SIMD::MulAdd4(SIMD::Splat4<2>(lhsRow), r2, row);
+			return SIMD::MulAdd4(SIMD::Splat4<3>(lhsRow), r3, row);
+		}
+
+		void MultiplyMatrices(const float* lhs, const float* rhs, float* output, uint count)
+		{
+			for (uint i = 0; i < count; ++i, lhs += 16, rhs += 16, output += 16)
+			{
+				const Reg4 r0 = SIMD::Load4(rhs);
+				const Reg4 r1 = SIMD::Load4(rhs + 4);
+				const Reg4 r2 = SIMD::Load4(rhs + 8);
+				const Reg4 r3 = SIMD::Load4(rhs + 12);
+
+				const Reg4 p0 = MultiplyRow(SIMD::Load4(lhs), r0, r1, r2, r3);
+				const Reg4 p1 = MultiplyRow(SIMD::Load4(lhs + 4), r0, r1, r2, r3);
+				const Reg4 p2 = MultiplyRow(SIMD::Load4(lhs + 8), r0, r1, r2, r3);
+				const Reg4 p3 = MultiplyRow(SIMD::Load4(lhs + 12), r0, r1, r2, r3);
+
+				SIMD::Store4(output, p0);
+				SIMD::Store4(output + 4, p1);
+				SIMD::Store4(output + 8, p2);
+				SIMD::Store4(output + 12, p3);
+			}
+		}
+
+		void MultiplyMatrixByMatrices(const float* lhs, const float* rhs, float* output, uint count)
+		{
+			const Reg4 l0 = SIMD::Load4(lhs);
+			const Reg4 l1 = SIMD::Load4(lhs + 4);
+			const Reg4 l2 = SIMD::Load4(lhs + 8);
+			const Reg4 l3 = SIMD::Load4(lhs + 12);
+
+			for (uint i = 0; i < count; ++i, rhs += 16, output += 16)
+			{
+				const Reg4 r0 = SIMD::Load4(rhs);
+				const Reg4 r1 = SIMD::Load4(rhs + 4);
+				const Reg4 r2 = SIMD::Load4(rhs + 8);
+				const Reg4 r3 = SIMD::Load4(rhs + 12);
+
+				const Reg4 p0 = MultiplyRow(l0, r0, r1, r2, r3);
+				const Reg4 p1 = MultiplyRow(l1, r0, r1, r2, r3);
+				const Reg4 p2 = MultiplyRow(l2, r0, r1, r2, r3);
+				const Reg4 p3 = MultiplyRow(l3, r0, r1, r2, r3);
+
+				SIMD::Store4(output, p0);
+				SIMD::Store4(output + 4, p1);
+				SIMD::Store4(output + 8, p2);
+				SIMD::Store4(output + 12, p3);
+			}
+		}
+
+		void TransformPoints(const float* matrix, const float* points, float* output, uint count)
+		{
+			const Reg4 r0 = SIMD::Load4(matrix);
+			const Reg4 r1 = SIMD::Load4(matrix + 4);
+			const Reg4 r2 = SIMD::Load4(matrix + 8);
+			const Reg4 r3 = SIMD::Load4(matrix + 12);
+
+			for (uint i = 0; i < count; ++i, points += 3, output += 3)
+			{
+				Reg4 result = SIMD::MulAdd4(r0, SIMD::Set4(points[0]), r3);
+				result = SIMD::MulAdd4(r1, SIMD::Set4(points[1]), result);
+				result = SIMD::MulAdd4(r2, SIMD::Set4(points[2]), result);
+				SIMD::Store3(output, result);
+			}
+		}
+
+		void TransformVectors(const float* matrix, const float* vectors, float* output, uint count)
+		{
+			const Reg4 r0 = SIMD::Load4(matrix);
+			const Reg4 r1 = SIMD::Load4(matrix + 4);
+			const Reg4 r2 = SIMD::Load4(matrix + 8);
+			const Reg4 r3 = SIMD::Load4(matrix + 12);
+
+			for (uint i = 0; i < count; ++i, vectors += 4, output += 4)
+			{
+				SIMD::StoreU4(output, MultiplyRow(SIMD::LoadU4(vectors), r0, r1, r2, r3));
+			}
+		}
+
+		// Loads 4 xyz triples as x, y and z registers, see AoSToSoA()
+		TYR_FORCEINLINE void LoadTriples4(const float* aos, Reg4& x, Reg4& y, Reg4& z)
+		{
+			const Reg4 a = SIMD::LoadU4(aos);
+			const Reg4 b = SIMD::LoadU4(aos + 4);
+			const Reg4 c = SIMD::LoadU4(aos + 8);
+
+			x = SIMD::Shuffle4<0, 3, 0, 2>(a, SIMD::Shuffle4<2, 2, 1, 1>(b, c));
+			y = SIMD::Shuffle4<0, 2, 0, 2>(SIMD::Shuffle4<1, 1, 0, 0>(a, b), SIMD::Shuffle4<3, 3, 2, 2>(b, c));
+			z = SIMD::Shuffle4<0, 2, 0, 2>(SIMD::Shuffle4<2, 2, 1, 1>(a, b), SIMD::Shuffle4<0, 0, 3, 3>(c, c));
+		}
+
+		// Transposes the elements of 4 matrices back to their rows and stores them at output, 16 floats apart
+		TYR_FORCEINLINE void StoreRows4(Reg4 c0, Reg4 c1, Reg4 c2, Reg4 c3, float* output)
+		{
+			SIMD::Transpose4(c0, c1, c2, c3);
+			SIMD::Store4(output, c0);
+			SIMD::Store4(output + 16, c1);
+			SIMD::Store4(output + 32, c2);
+			SIMD::Store4(output + 48, c3);
+		}
+
+		// Builds 4 matrices at once with every element in its own register, instead of a row at a time as SetTRS()
+		// does, so that no register lanes are wasted on the 4th column
+		void CreateTRS4(const float* translations, const float* rotations, const float* scales, float* output)
+		{
+			Reg4 x = SIMD::Load4(rotations);
+			Reg4 y = SIMD::Load4(rotations + 4);
+			Reg4 z = SIMD::Load4(rotations + 8);
+			Reg4 w = SIMD::Load4(rotations + 12);
+			SIMD::Transpose4(x, y, z, w);
+
+			Reg4 tx, ty, tz, sx, sy, sz;
+			LoadTriples4(translations, tx, ty, tz);
+			LoadTriples4(scales, sx, sy, sz);
+
+			const Reg4 x2 = SIMD::Add4(x, x);
+			const Reg4 y2 = SIMD::Add4(y, y);
+			const Reg4 z2 = SIMD::Add4(z, z);
+			const Reg4 zero = SIMD::Set4(0.0f);
+			const Reg4 one = SIMD::Set4(1.0f);
+
+			// Same terms as Quaternion::ToRotationMatrix(), with row i scaled by scale i
+			StoreRows4(
+				SIMD::Mul4(SIMD::Sub4(one, SIMD::MulAdd4(y2, y, SIMD::Mul4(z2, z))), sx),
+				SIMD::Mul4(SIMD::MulAdd4(y2, x, SIMD::Mul4(z2, w)), sx),
+				SIMD::Mul4(SIMD::Sub4(SIMD::Mul4(z2, x), SIMD::Mul4(y2, w)), sx),
+				zero, output);
+			StoreRows4(
+				SIMD::Mul4(SIMD::Sub4(SIMD::Mul4(x2, y), SIMD::Mul4(z2, w)), sy),
+				SIMD::Mul4(SIMD::Sub4(one, SIMD::MulAdd4(x2, x, SIMD::Mul4(z2, z))), sy),
+				SIMD::Mul4(SIMD::MulAdd4(y2, z, SIMD::Mul4(x2, w)), sy),
+				zero, output + 4);
+			StoreRows4(
+				SIMD::Mul4(SIMD::MulAdd4(x2, z, SIMD::Mul4(y2, w)), sz),
+				SIMD::Mul4(SIMD::Sub4(SIMD::Mul4(y2, z), SIMD::Mul4(x2, w)), sz),
+				SIMD::Mul4(SIMD::Sub4(one, SIMD::MulAdd4(x2, x, SIMD::Mul4(y2, y))), sz),
+				zero, output + 8);
+			StoreRows4(tx, ty, tz, one, output + 12);
+		}
+
+		void CreateTRS(const float* translations, const float* rotations, const float* scales, float* output, uint count)
+		{
+			uint i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				CreateTRS4(translations + i * 3, rotations + i * 4, scales + i * 3, output + i * 16);
+			}
+
+			if (i < count)
+			{
+				// The rest are built from copies padded to 4
+				alignas(16) float paddedTranslations[12] = {};
+				alignas(16) float paddedRotations[16] = {};
+				alignas(16) float paddedScales[12] = {};
+				alignas(16) float paddedOutput[64];
+				const uint rest = count - i;
+				std::memcpy(paddedTranslations, translations + i * 3, rest * 3 * sizeof(float));
+				std::memcpy(paddedRotations, rotations + i * 4, rest * 4 * sizeof(float));
+				std::memcpy(paddedScales, scales + i * 3, rest * 3 * sizeof(float));
+				CreateTRS4(paddedTranslations, paddedRotations, paddedScales, paddedOutput);
+				std::memcpy(output + i * 16, paddedOutput, rest * 16 * sizeof(float));
+			}
+		}
+
+		void AddStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 4)
+			{
+				SIMD::Store4(output + i, SIMD::Add4(SIMD::Load4(a + i), SIMD::Load4(b + i)));
+			}
+		}
+
+		void SubStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 4)
+			{
+				SIMD::Store4(output + i, SIMD::Sub4(SIMD::Load4(a + i), SIMD::Load4(b + i)));
+			}
+		}
+
+		void MulStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 4)
+			{
+				SIMD::Store4(output + i, SIMD::Mul4(SIMD::Load4(a + i), SIMD::Load4(b + i)));
+			}
+		}
+
+		void MulAddStreams(const float* a, const float* b, const float* c, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 4)
+			{
+				SIMD::Store4(output + i, SIMD::MulAdd4(SIMD::Load4(a + i), SIMD::Load4(b + i), SIMD::Load4(c + i)));
+			}
+		}
+
+		TYR_FORCEINLINE Reg4 Dot3(Reg4 ax, Reg4 ay, Reg4 az, Reg4 bx, Reg4 by, Reg4 bz)
+		{
+			return SIMD::MulAdd4(az, bz, SIMD::MulAdd4(ay, by, SIMD::Mul4(ax, bx)));
+		}
+
+		void DotStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 4)
+			{
+				const Reg4 dot = Dot3(SIMD::Load4(a + i), SIMD::Load4(a + count + i), SIMD::Load4(a + 2 * count + i),
+					SIMD::Load4(b + i), SIMD::Load4(b + count + i), SIMD::Load4(b + 2 * count + i));
+				SIMD::Store4(output + i, dot);
+			}
+		}
+
+		void CrossStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 4)
+			{
+				const Reg4 ax = SIMD::Load4(a + i);
+				const Reg4 ay = SIMD::Load4(a + count + i);
+				const Reg4 az = SIMD::Load4(a + 2 * count + i);
+				const Reg4 bx = SIMD::Load4(b + i);
+				const Reg4 by = SIMD::Load4(b + count + i);
+				const Reg4 bz = SIMD::Load4(b + 2 * count + i);
+
+				SIMD::Store4(output + i, SIMD::Sub4(SIMD::Mul4(ay, bz), SIMD::Mul4(az, by)));
+				SIMD::Store4(output + count + i, SIMD::Sub4(SIMD::Mul4(az, bx), SIMD::Mul4(ax, bz)));
+				SIMD::Store4(output + 2 * count + i, SIMD::Sub4(SIMD::Mul4(ax, by), SIMD::Mul4(ay, bx)));
+			}
+		}
+
+		void LengthStreams(const float* a, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 4)
+			{
+				const Reg4 x = SIMD::Load4(a + i);
+				const Reg4 y = SIMD::Load4(a + count + i);
+				const Reg4 z = SIMD::Load4(a + 2 * count + i);
+				SIMD::Store4(output + i, SIMD::Sqrt4(Dot3(x, y, z, x, y, z)));
+			}
+		}
+
+		void NormalizeStreams(const float* a, float* output, uint count)
+		{
+			const Reg4 zero = SIMD::Set4(0.0f);
+			const Reg4 one = SIMD::Set4(1.0f);
+			for (uint i = 0; i < count; i += 4)
+			{
+				const Reg4 x = SIMD::Load4(a + i);
+				const Reg4 y = SIMD::Load4(a + count + i);
+				const Reg4 z = SIMD::Load4(a + 2 * count + i);
+
+				// Same as Vector3::Normalize() but zero length vectors are skipped
+				const Reg4 length = SIMD::Sqrt4(Dot3(x, y, z, x, y, z));
+				const Reg4 nonZero = SIMD::CmpGt4(length, zero);
+				const Reg4 invLength = SIMD::Div4(one, length);
+
+				SIMD::Store4(output + i, SIMD::Select4(nonZero, SIMD::Mul4(x, invLength), x));
+				SIMD::Store4(output + count + i, SIMD::Select4(nonZero, SIMD::Mul4(y, invLength), y));
+				SIMD::Store4(output + 2 * count + i, SIMD::Select4(nonZero, SIMD::Mul4(z, invLength), z));
+			}
+		}
+
+		void MinMaxStream(const float* values, uint count, float* min, float* max)
+		{
+			uint i = 0;
+			float minValue = values[0];
+			float maxValue = values[0];
+			if (count >= 4)
+			{
+				Reg4 minReg = SIMD::LoadU4(values);
+				Reg4 maxReg = minReg;
+				for (i = 4; i + 4 <= count; i += 4)
+				{
+					const Reg4 v = SIMD::LoadU4(values + i);
+					minReg = SIMD::Min4(minReg, v);
+					maxReg = SIMD::Max4(maxReg, v);
+				}
+				minValue = SIMD::HorizontalMin4(minReg);
+				maxValue = SIMD::HorizontalMax4(maxReg);
+			}
+
+			for (; i < count; ++i)
+			{
+				minValue = values[i] < minValue ? values[i] : minValue;
+				maxValue = values[i] > maxValue ? values[i] : maxValue;
+			}
+
+			*min = minValue;
+			*max = maxValue;
+		}
+
+		// Four xyz triples are 3 registers (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3), which are shuffled into the
+		// x, y and z registers and back.
+
+		void AoSToSoA(const float* aos, float* soa, uint stride, uint count)
+		{
+			uint i = 0;
+			for (; i + 4 <= count; i += 4, aos += 12)
+			{
+				const Reg4 a = SIMD::LoadU4(aos);
+				const Reg4 b = SIMD::LoadU4(aos + 4);
+				const Reg4 c = SIMD::LoadU4(aos + 8);
+
+				const Reg4 x = SIMD::Shuffle4<0, 3, 0, 2>(a, SIMD::Shuffle4<2, 2, 1, 1>(b, c));
+				const Reg4 y = SIMD::Shuffle4<0, 2, 0, 2>(SIMD::Shuffle4<1, 1, 0, 0>(a, b), SIMD::Shuffle4<3, 3, 2, 2>(b, c));
+				const Reg4 z = SIMD::Shuffle4<0, 2, 0, 2>(SIMD::Shuffle4<2, 2, 1, 1>(a, b), SIMD::Shuffle4<0, 0, 3, 3>(c, c));
+
+				SIMD::StoreU4(soa + i, x);
+				SIMD::StoreU4(soa + stride + i, y);
+				SIMD::StoreU4(soa + 2 * stride + i, z);
+			}
+
+			for (; i < count; ++i, aos += 3)
+			{
+				soa[i] = aos[0];
+				soa[stride + i] = aos[1];
+				soa[2 * stride + i] = aos[2];
+			}
+		}
+
+		void SoAToAoS(const float* soa, uint stride, float* aos, uint count)
+		{
+			uint i = 0;
+			for (; i + 4 <= count; i += 4, aos += 12)
+			{
+				const Reg4 x = SIMD::LoadU4(soa + i);
+				const Reg4 y = SIMD::LoadU4(soa + stride + i);
+				const Reg4 z = SIMD::LoadU4(soa + 2 * stride + i);
+
+				SIMD::StoreU4(aos, SIMD::Shuffle4<0, 2, 0, 2>(SIMD::Shuffle4<0, 1, 0, 1>(x, y), SIMD::Shuffle4<0, 0, 1, 1>(z, x)));
+				SIMD::StoreU4(aos + 4, SIMD::Shuffle4<0, 2, 0, 2>(SIMD::Shuffle4<1, 1, 1, 1>(y, z), SIMD::Shuffle4<2, 2, 2, 2>(x, y)));
+				SIMD::StoreU4(aos + 8, SIMD::Shuffle4<0, 2, 0, 2>(SIMD::Shuffle4<2, 2, 3, 3>(z, x), SIMD::Shuffle4<3, 3, 3, 3>(y, z)));
+			}
+
+			for (; i < count; ++i, aos += 3)
+			{
+				aos[0] = soa[i];
+				aos[1] = soa[stride + i];
+				aos[2] = soa[2 * stride + i];
+			}
+		}
+
+		// Writes the indices in [i, i + 4) whose bit is clear in culledMask, skipping those at or past end
+		TYR_FORCEINLINE uint WriteVisible4(uint culledMask, uint i, uint end, uint* visible)
+		{
+			uint mask = ~culledMask & 0xF;
+			if (end - i < 4)
+			{
+				mask &= (1u << (end - i)) - 1;
+			}
+
+			uint count = 0;
+			while (mask)
+			{
+				visible[count++] = i + std::countr_zero(mask);
+				mask &= mask - 1;
+			}
+			return count;
+		}
+
+		uint CullSpheres(const float* planes, const float* centres, const float* radii, uint stride, uint begin, uint end, uint* visible)
+		{
+			Reg4 nx[6], ny[6], nz[6], d[6];
+			for (uint p = 0; p < 6; ++p)
+			{
+				nx[p] = SIMD::Set4(planes[p * 4]);
+				ny[p] = SIMD::Set4(planes[p * 4 + 1]);
+				nz[p] = SIMD::Set4(planes[p * 4 + 2]);
+				d[p] = SIMD::Set4(planes[p * 4 + 3]);
+			}
+
+			const Reg4 zero = SIMD::Set4(0.0f);
+			uint visibleCount = 0;
+			for (uint i = begin; i < end; i += 4)
+			{
+				const Reg4 x = SIMD::Load4(centres + i);
+				const Reg4 y = SIMD::Load4(centres + stride + i);
+				const Reg4 z = SIMD::Load4(centres + 2 * stride + i);
+				const Reg4 negRadius = SIMD::Sub4(zero, SIMD::Load4(radii + i));
+
+				// Culled if fully behind any plane
+				Reg4 culled = zero;
+				for (uint p = 0; p < 6; ++p)
+				{
+					const Reg4 distance = SIMD::Sub4(Dot3(nx[p], ny[p], nz[p], x, y, z), d[p]);
+					culled = SIMD::Or4(culled, SIMD::CmpGt4(negRadius, distance));
+				}
+
+				visibleCount += WriteVisible4(SIMD::MoveMask4(culled), i, end, visible + visibleCount);
+			}
+			return visibleCount;
+		}
+
+		uint CullBoxes(const float* planes, const float* centres, const float* extents, uint stride, uint begin, uint end, uint* visible)
+		{
+			Reg4 nx[6], ny[6], nz[6], d[6], absX[6], absY[6], absZ[6];
+			for (uint p = 0; p < 6; ++p)
+			{
+				nx[p] = SIMD::Set4(planes[p * 4]);
+				ny[p] = SIMD::Set4(planes[p * 4 + 1]);
+				nz[p] = SIMD::Set4(planes[p * 4 + 2]);
+				d[p] = SIMD::Set4(planes[p * 4 + 3]);
+				absX[p] = SIMD::Set4(std::fabs(planes[p * 4]));
+				absY[p] = SIMD::Set4(std::fabs(planes[p * 4 + 1]));
+				absZ[p] = SIMD::Set4(std::fabs(planes[p * 4 + 2]));
+			}
+
+			const Reg4 zero = SIMD::Set4(0.0f);
+			uint visibleCount = 0;
+			for (uint i = begin; i < end; i += 4)
+			{
+				const Reg4 x = SIMD::Load4(centres + i);
+				const Reg4 y = SIMD::Load4(centres + stride + i);
+				const Reg4 z = SIMD::Load4(centres + 2 * stride + i);
+				const Reg4 ex = SIMD::Load4(extents + i);
+				const Reg4 ey = SIMD::Load4(extents + stride + i);
+				const Reg4 ez = SIMD::Load4(extents + 2 * stride + i);
+
+				// Culled if the corner furthest along the normal of any plane is behind it
+				Reg4 culled = zero;
+				for (uint p = 0; p < 6; ++p)
+				{
+					const Reg4 distance = SIMD::Sub4(Dot3(nx[p], ny[p], nz[p], x, y, z), d[p]);
+					const Reg4 negRadius = SIMD::Sub4(zero, Dot3(absX[p], absY[p], absZ[p], ex, ey, ez));
+					culled = SIMD::Or4(culled, SIMD::CmpGt4(negRadius, distance));
+				}
+
+				visibleCount += WriteVisible4(SIMD::MoveMask4(culled), i, end, visible + visibleCount);
+			}
+			return visibleCount;
+		}
+	}
+
+	MathKernels CreateMathKernels(SIMDLevel maxLevel)
+	{
+		MathKernels kernels;
+		kernels.multiplyMatrices = &MultiplyMatrices;
+		kernels.multiplyMatrixByMatrices = &MultiplyMatrixByMatrices;
+		kernels.transformPoints = &TransformPoints;
+		kernels.transformVectors = &TransformVectors;
+		kernels.createTRS = &CreateTRS;
+		kernels.addStreams = &AddStreams;
+		kernels.subStreams = &SubStreams;
+		kernels.mulStreams = &MulStreams;
+		kernels.mulAddStreams = &MulAddStreams;
+		kernels.dotStreams = &DotStreams;
+		kernels.crossStreams = &CrossStreams;
+		kernels.lengthStreams = &LengthStreams;
+		kernels.normalizeStreams = &NormalizeStreams;
+		kernels.minMaxStream = &MinMaxStream;
+		kernels.aosToSoA = &AoSToSoA;
+		kernels.soaToAoS = &SoAToAoS;
+		kernels.cullSpheres = &CullSpheres;
+		kernels.cullBoxes = &CullBoxes;
+
+		const SIMDLevel cpuLevel = CPUInfo::GetSIMDLevel();
+		kernels.level = cpuLevel == SIMDLevel::NEON ? SIMDLevel::NEON : SIMDLevel::SSE42;
+
+#ifdef TYR_AVX_INTRINSICS
+		const bool hasAVX2 = cpuLevel == SIMDLevel::AVX2 || cpuLevel == SIMDLevel::AVX512;
+		if (hasAVX2 && (maxLevel == SIMDLevel::AVX2 || maxLevel == SIMDLevel::AVX512))
+		{
+			SetMathKernelsAVX2(kernels);
+		}
+		if (cpuLevel == SIMDLevel::AVX512 && maxLevel == SIMDLevel::AVX512)
+		{
+			SetMathKernelsAVX512(kernels);
+		}
+#endif
+
+		return kernels;
+	}
+
+	const MathKernels& GetMathKernels()
+	{
+		static const MathKernels kernels = CreateMathKernels(SIMDLevel::AVX512);
+		return kernels;
+	}
+}
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Platform/CPUInfo.h"
+
+namespace tyr
+{
+	/// Batch math kernels with variants for wider instruction sets. The variants are compiled in their own translation
+	/// units with AVX2 or AVX-512 enabled and the widest one the CPU supports is picked on first use.
+	///
+	/// Matrices are 16 floats laid out as in Matrix4 and are 16 byte aligned. Points are 3 floats and vectors are 4.
+	/// Kernels only use SIMD.h and raw data. An inline function from another header that is compiled in a variant
+	/// translation unit could replace the baseline copy at link time.
+	struct MathKernels
+	{
+		/// Multiplies each matrix in lhs by the matrix at the same index in rhs. output may alias either input.
+		void (*multiplyMatrices)(const float* lhs, const float* rhs, float* output, uint count);
+
+		/// Multiplies lhs by each matrix in rhs. output may alias rhs.
+		void (*multiplyMatrixByMatrices)(const float* lhs, const float* rhs, float* output, uint count);
+
+		/// Transforms points by an affine matrix, treating them as having w = 1. output may alias points.
+		void (*transformPoints)(const float* matrix, const float* points, float* output, uint count);
+
+		/// Transforms vectors by a matrix. output may alias vectors.
+		void (*transformVectors)(const float* matrix, const float* vectors, float* output, uint count);
+
+		/// Creates matrices from translation, rotation and scale as Matrix4::SetTRS() does. Translations and scales are
+		/// 3 floats and rotations are quaternions stored as (x, y, z, w), which are 16 byte aligned.
+		void (*createTRS)(const float* translations, const float* rotations, const float* scales, float* output, uint count);
+
+		// Stream kernels work on the arrays of Vector3SoA. count is a multiple of 8 unless noted otherwise. The y and
+		// z arrays of a stream follow x at offsets of count and 2 * count floats. output may alias any input.
+
+		/// Element wise operations on flat arrays
+		void (*addStreams)(const float* a, const float* b, float* output, uint count);
+		void (*subStreams)(const float* a, const float* b, float* output, uint count);
+		void (*mulStreams)(const float* a, const float* b, float* output, uint count);
+		void (*mulAddStreams)(const float* a, const float* b, const float* c, float* output, uint count);
+
+		/// Writes count dot products to output.
+		void (*dotStreams)(const float* a, const float* b, float* output, uint count);
+		void (*crossStreams)(const float* a, const float* b, float* output, uint count);
+		/// Writes count lengths to output.
+		void (*lengthStreams)(const float* a, float* output, uint count);
+		/// Vectors with zero length are left unchanged.
+		void (*normalizeStreams)(const float* a, float* output, uint count);
+
+		/// Finds the minimum and maximum of a flat array. count can be any value above 0.
+		void (*minMaxStream)(const float* values, uint count, float* min, float* max);
+
+		/// Converts count xyz triples to the arrays of a stream whose arrays are stride floats apart. count can be any
+		/// value.
+		void (*aosToSoA)(const float* aos, float* soa, uint stride, uint count);
+		void (*soaToAoS)(const float* soa, uint stride, float* aos, uint count);
+
+		/// Tests bounding volumes in [begin, end) against 6 planes, stored as normal x, y, z and distance each, and writes
+		/// the indices of those that are not fully behind a plane to visible. Returns the number written. begin is a
+		/// multiple of 8 and the arrays are padded to a multiple of 8. Centres and extents are streams with arrays stride
+		/// floats apart.
+		uint (*cullSpheres)(const float* planes, const float* centres, const float* radii, uint stride, uint begin, uint end, uint* visible);
+		uint (*cullBoxes)(const float* planes, const float* centres, const float* extents, uint stride, uint begin, uint end, uint* visible);
+
+		/// Widest instruction set used by the kernels
+		SIMDLevel level;
+	};
+
+	/// Returns the kernels for the widest instruction set that is supported by the CPU and compiled in.
+	const MathKernels& GetMathKernels();
+
+	/// Creates the kernels for the widest instruction set up to maxLevel that is supported by the CPU and compiled in,
+	/// so that tests can compare every variant the CPU can run.
+	TYR_CORE_EXPORT MathKernels CreateMathKernels(SIMDLevel maxLevel);
+
+	/// Replaces the kernels that have an AVX2 variant. Must only be called if the CPU supports AVX2.
+	void SetMathKernelsAVX2(MathKernels& kernels);
+
+	/// Replaces the kernels that have an AVX-512 variant. Must only be called if the CPU supports AVX-512F.
+	void SetMathKernelsAVX512(MathKernels& kernels);
+}
@@ -0,0 +1,512 @@
+#include "MathKernels.h"
+#include "SIMD.h"
+#include <cstring>
+
+// Only has code when compiled with AVX2 enabled, see TYR_USE_AVX_INTRINSICS
+#if TYR_USE_SIMD && defined(TYR_SIMD_AVX2)
+namespace tyr
+{
+	namespace
+	{
+		// Each 128-bit lane holds a row of lhs. Returns those rows multiplied by the matrix whose rows are copied to
+		// both lanes of r0 to r3.
+		TYR_FORCEINLINE Reg MultiplyRows(Reg lhsRows, Reg r0, Reg r1, Reg r2, Reg r3)
+		{
+			Reg rows = SIMD::Mul(SIMD::SplatLanes<0>(lhsRows), r0);
+			rows = SIMD::Add(rows, SIMD::Mul(SIMD::SplatLanes<1>(lhsRows), r1));
+			rows = SIMD::Add(rows, SIMD::Mul(SIMD::SplatLanes<2>(lhsRows), r2));
+			return SIMD::Add(rows, SIMD::Mul(SIMD::SplatLanes<3>(lhsRows), r3));
+		}
+
+		void MultiplyMatrices(const float* lhs, const float* rhs, float* output, uint count)
+		{
+			for (uint i = 0; i < count; ++i, lhs += 16, rhs += 16, output += 16)
+			{
+				const Reg r0 = SIMD::Broadcast4(rhs);
+				const Reg r1 = SIMD::Broadcast4(rhs + 4);
+				const Reg r2 = SIMD::Broadcast4(rhs + 8);
+				const Reg r3 = SIMD::Broadcast4(rhs + 12);
+
+				const Reg p01 = MultiplyRows(SIMD::Load(lhs), r0, r1, r2, r3);
+				const Reg p23 = MultiplyRows(SIMD::Load(lhs + 8), r0, r1, r2, r3);
+
+				SIMD::Store(output, p01);
+				SIMD::Store(output + 8, p23);
+			}
+		}
+
+		void MultiplyMatrixByMatrices(const float* lhs, const float* rhs, float* output, uint count)
+		{
+			const Reg l01 = SIMD::Load(lhs);
+			const Reg l23 = SIMD::Load(lhs + 8);
+
+			for (uint i = 0; i < count; ++i, rhs += 16, output += 16)
+			{
+				const Reg r0 = SIMD::Broadcast4(rhs);
+				const Reg r1 = SIMD::Broadcast4(rhs + 4);
+				const Reg r2 = SIMD::Broadcast4(rhs + 8);
+				const Reg r3 = SIMD::Broadcast4(rhs + 12);
+
+				const Reg p01 = MultiplyRows(l01, r0, r1, r2, r3);
+				const Reg p23 = MultiplyRows(l23, r0, r1, r2, r3);
+
+				SIMD::Store(output, p01);
+				SIMD::Store(output + 8, p23);
+			}
+		}
+
+		// Two points or vectors are transformed at once, one per 128-bit lane
+
+		void TransformPoints(const float* matrix, const float* points, float* output, uint count)
+		{
+			const Reg r0 = SIMD::Broadcast4(matrix);
+			const Reg r1 = SIMD::Broadcast4(matrix + 4);
+			const Reg r2 = SIMD::Broadcast4(matrix + 8);
+			const Reg r3 = SIMD::Broadcast4(matrix + 12);
+
+			uint i = 0;
+			for (; i + 2 <= count; i += 2, points += 6, output += 6)
+			{
+				const Reg p = SIMD::Combine(SIMD::Load3(points), SIMD::Load3(points + 3));
+				Reg result = SIMD::Add(SIMD::Mul(r0, SIMD::SplatLanes<0>(p)), r3);
+				result = SIMD::Add(SIMD::Mul(r1, SIMD::SplatLanes<1>(p)), result);
+				result = SIMD::Add(SIMD::Mul(r2, SIMD::SplatLanes<2>(p)), result);
+				SIMD::Store3(output, SIMD::GetLow(result));
+				SIMD::Store3(output + 3, SIMD::GetHigh(result));
+			}
+
+			if (i < count)
+			{
+				const Reg p = SIMD::Combine(SIMD::Load3(points), SIMD::Load3(points));
+				Reg result = SIMD::Add(SIMD::Mul(r0, SIMD::SplatLanes<0>(p)), r3);
+				result = SIMD::Add(SIMD::Mul(r1, SIMD::SplatLanes<1>(p)), result);
+				result = SIMD::Add(SIMD::Mul(r2, SIMD::SplatLanes<2>(p)), result);
+				SIMD::Store3(output, SIMD::GetLow(result));
+			}
+		}
+
+		void TransformVectors(const float* matrix, const float* vectors, float* output, uint count)
+		{
+			const Reg r0 = SIMD::Broadcast4(matrix);
+			const Reg r1 = SIMD::Broadcast4(matrix + 4);
+			const Reg r2 = SIMD::Broadcast4(matrix + 8);
+			const Reg r3 = SIMD::Broadcast4(matrix + 12);
+
+			uint i = 0;
+			for (; i + 2 <= count; i += 2, vectors += 8, output += 8)
+			{
+				SIMD::Store(output, MultiplyRows(SIMD::Load(vectors), r0, r1, r2, r3));
+			}
+
+			if (i < count)
+			{
+				const Reg4 v = SIMD::LoadU4(vectors);
+				SIMD::StoreU4(output, SIMD::GetLow(MultiplyRows(SIMD::Combine(v, v), r0, r1, r2, r3)));
+			}
+		}
+
+		// Transposes the 4x4 block in each 128-bit lane
+		TYR_FORCEINLINE void TransposeLanes(Reg& r0, Reg& r1, Reg& r2, Reg& r3)
+		{
+			const Reg t0 = SIMD::Shuffle<0, 1, 0, 1>(r0, r1);
+			const Reg t1 = SIMD::Shuffle<2, 3, 2, 3>(r0, r1);
+			const Reg t2 = SIMD::Shuffle<0, 1, 0, 1>(r2, r3);
+			const Reg t3 = SIMD::Shuffle<2, 3, 2, 3>(r2, r3);
+			r0 = SIMD::Shuffle<0, 2, 0, 2>(t0, t2);
+			r1 = SIMD::Shuffle<1, 3, 1, 3>(t0, t2);
+			r2 = SIMD::Shuffle<0, 2, 0, 2>(t1, t3);
+			r3 = SIMD::Shuffle<1, 3, 1, 3>(t1, t3);
+		}
+
+		// Loads 8 xyz triples as x, y and z registers, see AoSToSoA()
+		TYR_FORCEINLINE void LoadTriples(const float* aos, Reg& x, Reg& y, Reg& z)
+		{
+			const Reg r0 = SIMD::Load(aos);
+			const Reg r1 = SIMD::Load(aos + 8);
+			const Reg r2 = SIMD::Load(aos + 16);
+
+			const Reg a = SIMD::PermuteLanes<0, 3>(r0, r1);
+			const Reg b = SIMD::PermuteLanes<1, 2>(r0, r2);
+			const Reg c = SIMD::PermuteLanes<0, 3>(r1, r2);
+
+			x = SIMD::Shuffle<0, 3, 0, 2>(a, SIMD::Shuffle<2, 2, 1, 1>(b, c));
+			y = SIMD::Shuffle<0, 2, 0, 2>(SIMD::Shuffle<1, 1, 0, 0>(a, b), SIMD::Shuffle<3, 3, 2, 2>(b, c));
+			z = SIMD::Shuffle<0, 2, 0, 2>(SIMD::Shuffle<2, 2, 1, 1>(a, b), SIMD::Shuffle<0, 0, 3, 3>(c, c));
+		}
+
+		// Transposes the elements of 8 matrices back to two of their rows each and stores them at output, 16 floats
+		// apart. Lane 0 holds matrices 0 to 3 and lane 1 holds matrices 4 to 7.
+		TYR_FORCEINLINE void StoreRowPairs(Reg a0, Reg a1, Reg a2, Reg a3, Reg b0, Reg b1, Reg b2, Reg b3, float* output)
+		{
+			TransposeLanes(a0, a1, a2, a3);
+			TransposeLanes(b0, b1, b2, b3);
+			SIMD::Store(output, SIMD::PermuteLanes<0, 2>(a0, b0));
+			SIMD::Store(output + 16, SIMD::PermuteLanes<0, 2>(a1, b1));
+			SIMD::Store(output + 32, SIMD::PermuteLanes<0, 2>(a2, b2));
+			SIMD::Store(output + 48, SIMD::PermuteLanes<0, 2>(a3, b3));
+			SIMD::Store(output + 64, SIMD::PermuteLanes<1, 3>(a0, b0));
+			SIMD::Store(output + 80, SIMD::PermuteLanes<1, 3>(a1, b1));
+			SIMD::Store(output + 96, SIMD::PermuteLanes<1, 3>(a2, b2));
+			SIMD::Store(output + 112, SIMD::PermuteLanes<1, 3>(a3, b3));
+		}
+
+		// Builds 8 matrices at once the same way as the 4 wide version
+		void CreateTRS8(const float* translations, const float* rotations, const float* scales, float* output)
+		{
+			const Reg q01 = SIMD::Load(rotations);
+			const Reg q23 = SIMD::Load(rotations + 8);
+			const Reg q45 = SIMD::Load(rotations + 16);
+			const Reg q67 = SIMD::Load(rotations + 24);
+			Reg x = SIMD::PermuteLanes<0, 2>(q01, q45);
+			Reg y = SIMD::PermuteLanes<1, 3>(q01, q45);
+			Reg z = SIMD::PermuteLanes<0, 2>(q23, q67);
+			Reg w = SIMD::PermuteLanes<1, 3>(q23, q67);
+			TransposeLanes(x, y, z, w);
+
+			Reg tx, ty, tz, sx, sy, sz;
+			LoadTriples(translations, tx, ty, tz);
+			LoadTriples(scales, sx, sy, sz);
+
+			const Reg x2 = SIMD::Add(x, x);
+			const Reg y2 = SIMD::Add(y, y);
+			const Reg z2 = SIMD::Add(z, z);
+			const Reg zero = SIMD::Set(0.0f);
+			const Reg one = SIMD::Set(1.0f);
+
+			StoreRowPairs(
+				SIMD::Mul(SIMD::Sub(one, SIMD::Add(SIMD::Mul(y2, y), SIMD::Mul(z2, z))), sx),
+				SIMD::Mul(SIMD::Add(SIMD::Mul(y2, x), SIMD::Mul(z2, w)), sx),
+				SIMD::Mul(SIMD::Sub(SIMD::Mul(z2, x), SIMD::Mul(y2, w)), sx),
+				zero,
+				SIMD::Mul(SIMD::Sub(SIMD::Mul(x2, y), SIMD::Mul(z2, w)), sy),
+				SIMD::Mul(SIMD::Sub(one, SIMD::Add(SIMD::Mul(x2, x), SIMD::Mul(z2, z))), sy),
+				SIMD::Mul(SIMD::Add(SIMD::Mul(y2, z), SIMD::Mul(x2, w)), sy),
+				zero, output);
+			StoreRowPairs(
+				SIMD::Mul(SIMD::Add(SIMD::Mul(x2, z), SIMD::Mul(y2, w)), sz),
+				SIMD::Mul(SIMD::Sub(SIMD::Mul(y2, z), SIMD::Mul(x2, w)), sz),
+				SIMD::Mul(SIMD::Sub(one, SIMD::Add(SIMD::Mul(x2, x), SIMD::Mul(y2, y))), sz),
+				zero,
+				tx, ty, tz, one, output + 8);
+		}
+
+		void CreateTRS(const float* translations, const float* rotations, const float* scales, float* output, uint count)
+		{
+			uint i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				CreateTRS8(translations + i * 3, rotations + i * 4, scales + i * 3, output + i * 16);
+			}
+
+			if (i < count)
+			{
+				// The rest are built from copies padded to 8
+				alignas(32) float paddedTranslations[24] = {};
+				alignas(32) float paddedRotations[32] = {};
+				alignas(32) float paddedScales[24] = {};
+				alignas(32) float paddedOutput[128];
+				const uint rest = count - i;
+				std::memcpy(paddedTranslations, translations + i * 3, rest * 3 * sizeof(float));
+				std::memcpy(paddedRotations, rotations + i * 4, rest * 4 * sizeof(float));
+				std::memcpy(paddedScales, scales + i * 3, rest * 3 * sizeof(float));
+				CreateTRS8(paddedTranslations, paddedRotations, paddedScales, paddedOutput);
+				std::memcpy(output + i * 16, paddedOutput, rest * 16 * sizeof(float));
+			}
+		}
+
+		void AddStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 8)
+			{
+				SIMD::Store(output + i, SIMD::Add(SIMD::Load(a + i), SIMD::Load(b + i)));
+			}
+		}
+
+		void SubStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 8)
+			{
+				SIMD::Store(output + i, SIMD::Sub(SIMD::Load(a + i), SIMD::Load(b + i)));
+			}
+		}
+
+		void MulStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 8)
+			{
+				SIMD::Store(output + i, SIMD::Mul(SIMD::Load(a + i), SIMD::Load(b + i)));
+			}
+		}
+
+		void MulAddStreams(const float* a, const float* b, const float* c, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 8)
+			{
+				SIMD::Store(output + i, SIMD::Add(SIMD::Mul(SIMD::Load(a + i), SIMD::Load(b + i)), SIMD::Load(c + i)));
+			}
+		}
+
+		TYR_FORCEINLINE Reg Dot3(Reg ax, Reg ay, Reg az, Reg bx, Reg by, Reg bz)
+		{
+			return SIMD::Add(SIMD::Add(SIMD::Mul(ax, bx), SIMD::Mul(ay, by)), SIMD::Mul(az, bz));
+		}
+
+		void DotStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 8)
+			{
+				const Reg dot = Dot3(SIMD::Load(a + i), SIMD::Load(a + count + i), SIMD::Load(a + 2 * count + i),
+					SIMD::Load(b + i), SIMD::Load(b + count + i), SIMD::Load(b + 2 * count + i));
+				SIMD::Store(output + i, dot);
+			}
+		}
+
+		void CrossStreams(const float* a, const float* b, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 8)
+			{
+				const Reg ax = SIMD::Load(a + i);
+				const Reg ay = SIMD::Load(a + count + i);
+				const Reg az = SIMD::Load(a + 2 * count + i);
+				const Reg bx = SIMD::Load(b + i);
+				const Reg by = SIMD::Load(b + count + i);
+				const Reg bz = SIMD::Load(b + 2 * count + i);
+
+				SIMD::Store(output + i, SIMD::Sub(SIMD::Mul(ay, bz), SIMD::Mul(az, by)));
+				SIMD::Store(output + count + i, SIMD::Sub(SIMD::Mul(az, bx), SIMD::Mul(ax, bz)));
+				SIMD::Store(output + 2 * count + i, SIMD::Sub(SIMD::Mul(ax, by), SIMD::Mul(ay, bx)));
+			}
+		}
+
+		void LengthStreams(const float* a, float* output, uint count)
+		{
+			for (uint i = 0; i < count; i += 8)
+			{
+				const Reg x = SIMD::Load(a + i);
+				const Reg y = SIMD::Load(a + count + i);
+				const Reg z = SIMD::Load(a + 2 * count + i);
+				SIMD::Store(output + i, SIMD::Sqrt(Dot3(x, y, z, x, y, z)));
+			}
+		}
+
+		void NormalizeStreams(const float* a, float* output, uint count)
+		{
+			const Reg zero = SIMD::Set(0.0f);
+			const Reg one = SIMD::Set(1.0f);
+			for (uint i = 0; i < count; i += 8)
+			{
+				const Reg x = SIMD::Load(a + i);
+				const Reg y = SIMD::Load(a + count + i);
+				const Reg z = SIMD::Load(a + 2 * count + i);
+
+				const Reg length = SIMD::Sqrt(Dot3(x, y, z, x, y, z));
+				const Reg nonZero = SIMD::CmpGt(length, zero);
+				const Reg invLength = SIMD::Div(one, length);
+
+				SIMD::Store(output + i, SIMD::Select(nonZero, SIMD::Mul(x, invLength), x));
+				SIMD::Store(output + count + i, SIMD::Select(nonZero, SIMD::Mul(y, invLength), y));
+				SIMD::Store(output + 2 * count + i, SIMD::Select(nonZero, SIMD::Mul(z, invLength), z));
+			}
+		}
+
+		void MinMaxStream(const float* values, uint count, float* min, float* max)
+		{
+			uint i = 0;
+			float minValue = values[0];
+			float maxValue = values[0];
+			if (count >= 8)
+			{
+				Reg minReg = SIMD::Load(values);
+				Reg maxReg = minReg;
+				for (i = 8; i + 8 <= count; i += 8)
+				{
+					const Reg v = SIMD::Load(values + i);
+					minReg = SIMD::Min(minReg, v);
+					maxReg = SIMD::Max(maxReg, v);
+				}
+				minValue = SIMD::HorizontalMin4(SIMD::Min4(SIMD::GetLow(minReg), SIMD::GetHigh(minReg)));
+				maxValue = SIMD::HorizontalMax4(SIMD::Max4(SIMD::GetLow(maxReg), SIMD::GetHigh(maxReg)));
+			}
+
+			for (; i < count; ++i)
+			{
+				minValue = values[i] < minValue ? values[i] : minValue;
+				maxValue = values[i] > maxValue ? values[i] : maxValue;
+			}
+
+			*min = minValue;
+			*max = maxValue;
+		}
+
+		// Eight xyz triples are 3 registers. Their 128-bit lanes are regrouped so that each lane holds 4 triples
+		// (x y z x) (y z x y) (z x y z), which are then shuffled the same way as in the 4 wide version.
+
+		void AoSToSoA(const float* aos, float* soa, uint stride, uint count)
+		{
+			uint i = 0;
+			for (; i + 8 <= count; i += 8, aos += 24)
+			{
+				const Reg r0 = SIMD::Load(aos);
+				const Reg r1 = SIMD::Load(aos + 8);
+				const Reg r2 = SIMD::Load(aos + 16);
+
+				const Reg a = SIMD::PermuteLanes<0, 3>(r0, r1);
+				const Reg b = SIMD::PermuteLanes<1, 2>(r0, r2);
+				const Reg c = SIMD::PermuteLanes<0, 3>(r1, r2);
+
+				const Reg x = SIMD::Shuffle<0, 3, 0, 2>(a, SIMD::Shuffle<2, 2, 1, 1>(b, c));
+				const Reg y = SIMD::Shuffle<0, 2, 0, 2>(SIMD::Shuffle<1, 1, 0, 0>(a, b), SIMD::Shuffle<3, 3, 2, 2>(b, c));
+				const Reg z = SIMD::Shuffle<0, 2, 0, 2>(SIMD::Shuffle<2, 2, 1, 1>(a, b), SIMD::Shuffle<0, 0, 3, 3>(c, c));
+
+				SIMD::Store(soa + i, x);
+				SIMD::Store(soa + stride + i, y);
+				SIMD::Store(soa + 2 * stride + i, z);
+			}
+
+			for (; i < count; ++i, aos += 3)
+			{
+				soa[i] = aos[0];
+				soa[stride + i] = aos[1];
+				soa[2 * stride + i] = aos[2];
+			}
+		}
+
+		void SoAToAoS(const float* soa, uint stride, float* aos, uint count)
+		{
+			uint i = 0;
+			for (; i + 8 <= count; i += 8, aos += 24)
+			{
+				const Reg x = SIMD::Load(soa + i);
+				const Reg y = SIMD::Load(soa + stride + i);
+				const Reg z = SIMD::Load(soa + 2 * stride + i);
+
+				const Reg a = SIMD::Shuffle<0, 2, 0, 2>(SIMD::Shuffle<0, 1, 0, 1>(x, y), SIMD::Shuffle<0, 0, 1, 1>(z, x));
+				const Reg b = SIMD::Shuffle<0, 2, 0, 2>(SIMD::Shuffle<1, 1, 1, 1>(y, z), SIMD::Shuffle<2, 2, 2, 2>(x, y));
+				const Reg c = SIMD::Shuffle<0, 2, 0, 2>(SIMD::Shuffle<2, 2, 3, 3>(z, x), SIMD::Shuffle<3, 3, 3, 3>(y, z));
+
+				SIMD::Store(aos, SIMD::PermuteLanes<0, 2>(a, b));
+				SIMD::Store(aos + 8, SIMD::PermuteLanes<0, 3>(c, a));
+				SIMD::Store(aos + 16, SIMD::PermuteLanes<1, 3>(b, c));
+			}
+
+			for (; i < count; ++i, aos += 3)
+			{
+				aos[0] = soa[i];
+				aos[1] = soa[stride + i];
+				aos[2] = soa[2 * stride + i];
+			}
+		}
+
+		// Writes the indices in [i, i + 8) whose bit is clear in culledMask, skipping those at or past end
+		TYR_FORCEINLINE uint WriteVisible(uint culledMask, uint i, uint end, uint* visible)
+		{
+			uint mask = ~culledMask & 0xFF;
+			if (end - i < 8)
+			{
+				mask &= (1u << (end - i)) - 1;
+			}
+
+			uint count = 0;
+			while (mask)
+			{
+				visible[count++] = i + SIMD::CountTrailingZeros(mask);
+				mask &= mask - 1;
+			}
+			return count;
+		}
+
+		uint CullSpheres(const float* planes, const float* centres, const float* radii, uint stride, uint begin, uint end, uint* visible)
+		{
+			Reg nx[6], ny[6], nz[6], d[6];
+			for (uint p = 0; p < 6; ++p)
+			{
+				nx[p] = SIMD::Set(planes[p * 4]);
+				ny[p] = SIMD::Set(planes[p * 4 + 1]);
+				nz[p] = SIMD::Set(planes[p * 4 + 2]);
+				d[p] = SIMD::Set(planes[p * 4 + 3]);
+			}
+
+			const Reg zero = SIMD::Set(0.0f);
+			uint visibleCount = 0;
+			for (uint i = begin; i < end; i += 8)
+			{
+				const Reg x = SIMD::Load(centres + i);
+				const Reg y = SIMD::Load(centres + stride + i);
+				const Reg z = SIMD::Load(centres + 2 * stride + i);
+				const Reg negRadius = SIMD::Sub(zero, SIMD::Load(radii + i));
+
+				Reg culled = zero;
+				for (uint p = 0; p < 6; ++p)
+				{
+					const Reg distance = SIMD::Sub(Dot3(nx[p], ny[p], nz[p], x, y, z), d[p]);
+					culled = SIMD::Or(culled, SIMD::CmpGt(negRadius, distance));
+				}
+
+				visibleCount += WriteVisible(SIMD::MoveMask(culled), i, end, visible + visibleCount);
+			}
+			return visibleCount;
+		}
+
+		uint CullBoxes(const float* planes, const float* centres, const float* extents, uint stride, uint begin, uint end, uint* visible)
+		{
+			Reg nx[6], ny[6], nz[6], d[6], absX[6], absY[6], absZ[6];
+			for (uint p = 0; p < 6; ++p)
+			{
+				nx[p] = SIMD::Set(planes[p * 4]);
+				ny[p] = SIMD::Set(planes[p * 4 + 1]);
+				nz[p] = SIMD::Set(planes[p * 4 + 2]);
+				d[p] = SIMD::Set(planes[p * 4 + 3]);
+				absX[p] = SIMD::Abs(nx[p]);
+				absY[p] = SIMD::Abs(ny[p]);
+				absZ[p] = SIMD::Abs(nz[p]);
+			}
+
+			const Reg zero = SIMD::Set(0.0f);
+			uint visibleCount = 0;
+			for (uint i = begin; i < end; i += 8)
+			{
+				const Reg x = SIMD::Load(centres + i);
+				const Reg y = SIMD::Load(centres + stride + i);
+				const Reg z = SIMD::Load(centres + 2 * stride + i);
+				const Reg ex = SIMD::Load(extents + i);
+				const Reg ey = SIMD::Load(extents + stride + i);
+				const Reg ez = SIMD::Load(extents + 2 * stride + i);
+
+				Reg culled = zero;
+				for (uint p = 0; p < 6; ++p)
+				{
+					const Reg distance = SIMD::Sub(Dot3(nx[p], ny[p], nz[p], x, y, z), d[p]);
+					const Reg negRadius = SIMD::Sub(zero, Dot3(absX[p], absY[p], absZ[p], ex, ey, ez));
+					culled = SIMD::Or(culled, SIMD::CmpGt(negRadius, distance));
+				}
+
+				visibleCount += WriteVisible(SIMD::MoveMask(culled), i, end, visible + visibleCount);
+			}
+			return visibleCount;
+		}
+	}
+
+	void SetMathKernelsAVX2(MathKernels& kernels)
+	{
+		kernels.multiplyMatrices = &MultiplyMatrices;
+		kernels.multiplyMatrixByMatrices = &MultiplyMatrixByMatrices;
+		kernels.transformPoints = &TransformPoints;
+		kernels.transformVectors = &TransformVectors;
+		kernels.createTRS = &CreateTRS;
+		kernels.addStreams = &AddStreams;
+		kernels.subStreams = &SubStreams;
+		kernels.mulStreams = &MulStreams;
+		kernels.mulAddStreams = &MulAddStreams;
+		kernels.dotStreams = &DotStreams;
+		kernels.crossStreams = &CrossStreams;
+		kernels.lengthStreams = &LengthStreams;
+		kernels.normalizeStreams = &NormalizeStreams;
+		kernels.minMaxStream = &MinMaxStream;
+		kernels.aosToSoA = &AoSToSoA;
+		kernels.soaToAoS = &SoAToAoS;
+		kernels.cullSpheres = &CullSpheres;
+		kernels.cullBoxes = &CullBoxes;
+		kernels.level = SIMDLevel::AVX2;
+	}
+}
+#endif
@@ -0,0 +1,59 @@
+#include "MathKernels.h"
+#include "SIMD.h"
+
+// Only has code when compiled with AVX-512 enabled, see TYR_USE_AVX_INTRINSICS
+#if TYR_USE_SIMD && defined(TYR_SIMD_AVX512)
+namespace tyr
+{
+	namespace
+	{
+		// A whole matrix fits in a register, one row per 128-bit lane. Returns the rows of lhs multiplied by the matrix
+		// whose rows are copied to every lane of r0 to r3.
+		TYR_FORCEINLINE Reg16 MultiplyMatrix(Reg16 lhs, Reg16 r0, Reg16 r1, Reg16 r2, Reg16 r3)
+		{
+			Reg16 rows = SIMD::Mul16(SIMD::SplatLanes16<0>(lhs), r0);
+			rows = SIMD::Add16(rows, SIMD::Mul16(SIMD::SplatLanes16<1>(lhs), r1));
+			rows = SIMD::Add16(rows, SIMD::Mul16(SIMD::SplatLanes16<2>(lhs), r2));
+			return SIMD::Add16(rows, SIMD::Mul16(SIMD::SplatLanes16<3>(lhs), r3));
+		}
+
+		void MultiplyMatrices(const float* lhs, const float* rhs, float* output, uint count)
+		{
+			for (uint i = 0; i < count; ++i, lhs += 16, rhs += 16, output += 16)
+			{
+				const Reg16 r0 = SIMD::Broadcast4To16(rhs);
+				const Reg16 r1 = SIMD::Broadcast4To16(rhs + 4);
+				const Reg16 r2 = SIMD::Broadcast4To16(rhs + 8);
+				const Reg16 r3 = SIMD::Broadcast4To16(rhs + 12);
+
+				SIMD::Store16(output, MultiplyMatrix(SIMD::Load16(lhs), r0, r1, r2, r3));
+			}
+		}
+
+		void MultiplyMatrixByMatrices(const float* lhs, const float* rhs, float* output, uint count)
+		{
+			const Reg16 l = SIMD::Load16(lhs);
+			const Reg16 l0 = SIMD::SplatLanes16<0>(l);
+			const Reg16 l1 = SIMD::SplatLanes16<1>(l);
+			const Reg16 l2 = SIMD::SplatLanes16<2>(l);
+			const Reg16 l3 = SIMD::SplatLanes16<3>(l);
+
+			for (uint i = 0; i < count; ++i, rhs += 16, output += 16)
+			{
+				Reg16 rows = SIMD::Mul16(l0, SIMD::Broadcast4To16(rhs));
+				rows = SIMD::Add16(rows, SIMD::Mul16(l1, SIMD::Broadcast4To16(rhs + 4)));
+				rows = SIMD::Add16(rows, SIMD::Mul16(l2, SIMD::Broadcast4To16(rhs + 8)));
+				rows = SIMD::Add16(rows, SIMD::Mul16(l3, SIMD::Broadcast4To16(rhs + 12)));
+				SIMD::Store16(output, rows);
+			}
+		}
+	}
+
+	void SetMathKernelsAVX512(MathKernels& kernels)
+	{
+		kernels.multiplyMatrices = &MultiplyMatrices;
+		kernels.multiplyMatrixByMatrices = &MultiplyMatrixByMatrices;
+		kernels.level = SIMDLevel::AVX512;
+	}
+}
+#endif
@@ -2,6 +2,7 @@
 
 #include "Math/Matrix4.h"
 #include "Math/Quaternion.h"
+#include "Math/MathKernels.h"
 
 namespace tyr
 {
@@ -59,8 +60,84 @@ namespace tyr
 		return det;
 	}
 
+#if TYR_USE_SIMD
+	namespace
+	{
+		// 2x2 matrix helpers for the block-wise inverse. A 2x2 matrix is stored in a register as (m00, m01, m10, m11).
+
+		// Returns a * b
+		TYR_FORCEINLINE Reg4 Matrix2Multiply(Reg4 a, Reg4 b)
+		{
+			return SIMD::Add4(SIMD::Mul4(a, SIMD::Swizzle4<0, 3, 0, 3>(b)),
+				SIMD::Mul4(SIMD::Swizzle4<1, 0, 3, 2>(a), SIMD::Swizzle4<2, 1, 2, 1>(b)));
+		}
+
+		// Returns adjugate(a) * b
+		TYR_FORCEINLINE Reg4 Matrix2AdjugateMultiply(Reg4 a, Reg4 b)
+		{
+			return SIMD::Sub4(SIMD::Mul4(SIMD::Swizzle4<3, 3, 0, 0>(a), b),
+				SIMD::Mul4(SIMD::Swizzle4<1, 1, 2, 2>(a), SIMD::Swizzle4<2, 3, 0, 1>(b)));
+		}
+
+		// Returns a * adjugate(b)
+		TYR_FORCEINLINE Reg4 Matrix2MultiplyAdjugate(Reg4 a, Reg4 b)
+		{
+			return SIMD::Sub4(SIMD::Mul4(a, SIMD::Swizzle4<3, 0, 3, 0>(b)),
+				SIMD::Mul4(SIMD::Swizzle4<1, 0, 3, 2>(a), SIMD::Swizzle4<2, 1, 2, 1>(b)));
+		}
+	}
+#endif
+
 	Matrix4 Matrix4::Inverse() const
 	{
+#if TYR_USE_SIMD
+		// Inverts the matrix as 2x2 blocks | A B |
+		//                                  | C D |
+		const Reg4 r0 = SIMD::Load4(m[0]);
+		const Reg4 r1 = SIMD::Load4(m[1]);
+		const Reg4 r2 = SIMD::Load4(m[2]);
+		const Reg4 r3 = SIMD::Load4(m[3]);
+
+		const Reg4 a = SIMD::MoveLH4(r0, r1);
+		const Reg4 b = SIMD::MoveHL4(r0, r1);
+		const Reg4 c = SIMD::MoveLH4(r2, r3);
+		const Reg4 d = SIMD::MoveHL4(r2, r3);
+
+		// Determinants of A, B, C and D
+		const Reg4 blockDets = SIMD::Sub4(
+			SIMD::Mul4(SIMD::Shuffle4<0, 2, 0, 2>(r0, r2), SIMD::Shuffle4<1, 3, 1, 3>(r1, r3)),
+			SIMD::Mul4(SIMD::Shuffle4<1, 3, 1, 3>(r0, r2), SIMD::Shuffle4<0, 2, 0, 2>(r1, r3)));
+		const Reg4 detA = SIMD::Splat4<0>(blockDets);
+		const Reg4 detB = SIMD::Splat4<1>(blockDets);
+		const Reg4 detC = SIMD::Splat4<2>(blockDets);
+		const Reg4 detD = SIMD::Splat4<3>(blockDets);
+
+		const Reg4 dc = Matrix2AdjugateMultiply(d, c);
+		const Reg4 ab = Matrix2AdjugateMultiply(a, b);
+
+		Reg4 x = SIMD::Sub4(SIMD::Mul4(detD, a), Matrix2Multiply(b, dc));
+		Reg4 w = SIMD::Sub4(SIMD::Mul4(detA, d), Matrix2Multiply(c, ab));
+		Reg4 y = SIMD::Sub4(SIMD::Mul4(detB, c), Matrix2MultiplyAdjugate(d, ab));
+		Reg4 z = SIMD::Sub4(SIMD::Mul4(detC, b), Matrix2MultiplyAdjugate(a, dc));
+
+		Reg4 det = SIMD::Add4(SIMD::Mul4(detA, detD), SIMD::Mul4(detB, detC));
+		det = SIMD::Sub4(det, SIMD::HorizontalSum4(SIMD::Mul4(ab, SIMD::Swizzle4<0, 2, 1, 3>(dc))));
+
+		// The adjugate's signs are folded into the reciprocal
+		const Reg4 invDet = SIMD::Div4(SIMD::Set4(1.0f, -1.0f, -1.0f, 1.0f), det);
+		x = SIMD::Mul4(x, invDet);
+		y = SIMD::Mul4(y, invDet);
+		z = SIMD::Mul4(z, invDet);
+		w = SIMD::Mul4(w, invDet);
+
+		Matrix4 output;
+		SIMD::Store4(output.m[0], SIMD::Shuffle4<3, 1, 3, 1>(x, y));
+		SIMD::Store4(output.m[1], SIMD::Shuffle4<2, 0, 2, 0>(x, y));
+		SIMD::Store4(output.m[2], SIMD::Shuffle4<3, 1, 3, 1>(z, w));
+		SIMD::Store4(output.m[3], SIMD::Shuffle4<2, 0, 2, 0>(z, w));
+
+		return output;
+#else
 		float m00 = m[0][0], m01 = m[0][1], m02 = m[0][2], m03 = m[0][3];
 		float m10 = m[1][0], m11 = m[1][1], m12 = m[1][2], m13 = m[1][3];
 		float m20 = m[2][0], m21 = m[2][1], m22 = m[2][2], m23 = m[2][3];
@@ -119,10 +196,45 @@ namespace tyr
 			d10, d11, d12, d13,
 			d20, d21, d22, d23,
 			d30, d31, d32, d33);
+#endif
 	}
 
 	Matrix4 Matrix4::InverseAffine() const
 	{
+#if TYR_USE_SIMD
+		const Reg4 r0 = SIMD::Load4(m[0]);
+		const Reg4 r1 = SIMD::Load4(m[1]);
+		const Reg4 r2 = SIMD::Load4(m[2]);
+
+		// The columns of the inverse of the 3x3 part are the cross products of its rows divided by the determinant
+		const Reg4 a = SIMD::ClearW4(r0);
+		const Reg4 b = SIMD::ClearW4(r1);
+		const Reg4 c = SIMD::ClearW4(r2);
+		Reg4 col0 = SIMD::Cross3(b, c);
+		Reg4 col1 = SIMD::Cross3(c, a);
+		Reg4 col2 = SIMD::Cross3(a, b);
+
+		const Reg4 invDet = SIMD::Div4(SIMD::Set4(1.0f), SIMD::HorizontalSum4(SIMD::Mul4(a, col0)));
+		col0 = SIMD::Mul4(col0, invDet);
+		col1 = SIMD::Mul4(col1, invDet);
+		col2 = SIMD::Mul4(col2, invDet);
+
+		// The translation column is -inverse(3x3) * translation
+		Reg4 translation = SIMD::Mul4(col0, SIMD::Splat4<3>(r0));
+		translation = SIMD::MulAdd4(col1, SIMD::Splat4<3>(r1), translation);
+		translation = SIMD::MulAdd4(col2, SIMD::Splat4<3>(r2), translation);
+		translation = SIMD::Sub4(SIMD::Set4(0.0f), translation);
+
+		SIMD::Transpose4(col0, col1, col2, translation);
+
+		Matrix4 output;
+		SIMD::Store4(output.m[0], col0);
+		SIMD::Store4(output.m[1], col1);
+		SIMD::Store4(output.m[2], col2);
+		SIMD::Store4(output.m[3], SIMD::Set4(0.0f, 0.0f, 0.0f, 1.0f));
+
+		return output;
+#else
 		float m10 = m[1][0], m11 = m[1][1], m12 = m[1][2];
 		float m20 = m[2][0], m21 = m[2][1], m22 = m[2][2];
 
@@ -161,10 +273,42 @@ namespace tyr
 			r10, r11, r12, r13,
 			r20, r21, r22, r23,
 			  0,   0,   0,   1);
+#endif
 	}
 
 	void Matrix4::SetTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
 	{
+#if TYR_USE_SIMD
+		// Builds the rows of the rotation matrix (see Quaternion::ToRotationMatrix) from the quaternion (x, y, z, w)
+		// and twice its value, flipping signs with xor
+		const Reg4 q = SIMD::Load4(&rotation.x);
+		const Reg4 q2 = SIMD::Add4(q, q);
+		const Reg4 negX = SIMD::Set4(-0.0f, 0.0f, 0.0f, 0.0f);
+		const Reg4 negY = SIMD::Set4(0.0f, -0.0f, 0.0f, 0.0f);
+		const Reg4 negZ = SIMD::Set4(0.0f, 0.0f, -0.0f, 0.0f);
+		const Reg4 negXZ = SIMD::Set4(-0.0f, 0.0f, -0.0f, 0.0f);
+		const Reg4 negXY = SIMD::Set4(-0.0f, -0.0f, 0.0f, 0.0f);
+		const Reg4 negYZ = SIMD::Set4(0.0f, -0.0f, -0.0f, 0.0f);
+
+		// Row 0: (1, 0, 0) + 2y * (-y, x, -w) + 2z * (-z, w, x)
+		Reg4 row0 = SIMD::Mul4(SIMD::Splat4<1>(q2), SIMD::Xor4(SIMD::Swizzle4<1, 0, 3, 3>(q), negXZ));
+		row0 = SIMD::MulAdd4(SIMD::Splat4<2>(q2), SIMD::Xor4(SIMD::Swizzle4<2, 3, 0, 3>(q), negX), row0);
+		// Row 1: (0, 1, 0) + 2x * (y, -x, w) + 2z * (-w, -z, y)
+		Reg4 row1 = SIMD::Mul4(SIMD::Splat4<0>(q2), SIMD::Xor4(SIMD::Swizzle4<1, 0, 3, 3>(q), negY));
+		row1 = SIMD::MulAdd4(SIMD::Splat4<2>(q2), SIMD::Xor4(SIMD::Swizzle4<3, 2, 1, 3>(q), negXY), row1);
+		// Row 2: (0, 0, 1) + 2x * (z, -w, -x) + 2y * (w, z, -y)
+		Reg4 row2 = SIMD::Mul4(SIMD::Splat4<0>(q2), SIMD::Xor4(SIMD::Swizzle4<2, 3, 0, 3>(q), negYZ));
+		row2 = SIMD::MulAdd4(SIMD::Splat4<1>(q2), SIMD::Xor4(SIMD::Swizzle4<3, 2, 1, 3>(q), negZ), row2);
+
+		row0 = SIMD::ClearW4(SIMD::Add4(row0, SIMD::Set4(1.0f, 0.0f, 0.0f, 0.0f)));
+		row1 = SIMD::ClearW4(SIMD::Add4(row1, SIMD::Set4(0.0f, 1.0f, 0.0f, 0.0f)));
+		row2 = SIMD::ClearW4(SIMD::Add4(row2, SIMD::Set4(0.0f, 0.0f, 1.0f, 0.0f)));
+
+		SIMD::Store4(m[0], SIMD::Mul4(row0, SIMD::Set4(scale.x)));
+		SIMD::Store4(m[1], SIMD::Mul4(row1, SIMD::Set4(scale.y)));
+		SIMD::Store4(m[2], SIMD::Mul4(row2, SIMD::Set4(scale.z)));
+		SIMD::Store4(m[3], SIMD::Set4(translation.x, translation.y, translation.z, 1.0f));
+#else
 		Matrix3 rot3x3;
 		rotation.ToRotationMatrix(rot3x3);
 
@@ -192,6 +336,7 @@ namespace tyr
 		m[3][1] = translation.y; 
 		m[3][2] = translation.z; 
 		m[3][3] = 1;
+#endif
 	}
 
 	void Matrix4::SetInverseTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
@@ -409,6 +554,72 @@ namespace tyr
 		return mat;
 	}
 
+	void Matrix4::MultiplyBatch(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, uint count)
+	{
+#if TYR_USE_SIMD
+		GetMathKernels().multiplyMatrices(&lhs->m[0][0], &rhs->m[0][0], &output->m[0][0], count);
+#else
+		for (uint i = 0; i < count; ++i)
+		{
+			Multiply(lhs[i], rhs[i], output[i]);
+		}
+#endif
+	}
+
+	void Matrix4::MultiplyBatch(const Matrix4& lhs, const Matrix4* rhs, Matrix4* output, uint count)
+	{
+#if TYR_USE_SIMD
+		GetMathKernels().multiplyMatrixByMatrices(&lhs.m[0][0], &rhs->m[0][0], &output->m[0][0], count);
+#else
+		// Copied in case output aliases lhs
+		const Matrix4 left = lhs;
+		for (uint i = 0; i < count; ++i)
+		{
+			Multiply(left, rhs[i], output[i]);
+		}
+#endif
+	}
+
+	void Matrix4::CreateTRSBatch(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4* output, uint count)
+	{
+#if TYR_USE_SIMD
+		GetMathKernels().createTRS(&translations->x, &rotations->x, &scales->x, &output->m[0][0], count);
+#else
+		for (uint i = 0; i < count; ++i)
+		{
+			output[i].SetTRS(translations[i], rotations[i], scales[i]);
+		}
+#endif
+	}
+
+	void Matrix4::MultiplyBatch(const Vector4* vectors, Vector4* output, uint count) const
+	{
+#if TYR_USE_SIMD
+		GetMathKernels().transformVectors(&m[0][0], &vectors->x, &output->x, count);
+#else
+		for (uint i = 0; i < count; ++i)
+		{
+			output[i] = Multiply(vectors[i]);
+		}
+#endif
+	}
+
+	void Matrix4::TransformPoints(const Vector3* points, Vector3* output, uint count) const
+	{
+#if TYR_USE_SIMD
+		GetMathKernels().transformPoints(&m[0][0], &points->x, &output->x, count);
+#else
+		for (uint i = 0; i < count; ++i)
+		{
+			const Vector3& point = points[i];
+			output[i] = Vector3(
+				m[0][0] * point.x + m[1][0] * point.y + m[2][0] * point.z + m[3][0],
+				m[0][1] * point.x + m[1][1] * point.y + m[2][1] * point.z + m[3][1],
+				m[0][2] * point.x + m[1][2] * point.y + m[2][2] * point.z + m[3][2]);
+		}
+#endif
+	}
+
 	Matrix4 Matrix4::CreateInverseTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
 	{
 		Matrix4 mat;
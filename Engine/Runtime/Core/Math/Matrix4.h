@@ -73,17 +73,7 @@ namespace tyr
 		Matrix4 operator* (const Matrix4 &rhs) const
 		{
 			Matrix4 prod;
-			for (uint row = 0; row < 4; ++row)
-			{
-				for (uint col = 0; col < 4; ++col)
-				{
-					prod.m[row][col] = 
-						m[row][0] * rhs.m[0][col] +
-						m[row][1] * rhs.m[1][col] + 
-						m[row][2] * rhs.m[2][col] +
-						m[row][3] * rhs.m[3][col];
-				}
-			}
+			Multiply(*this, rhs, prod);
 			return prod;
 		}
 
@@ -412,10 +402,67 @@ namespace tyr
 		/// @note	This is cheaper than setTRS() and then performing inverse().	 
 		static Matrix4 CreateInverseTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
 
+		/// Multiplies each matrix in lhs by the matrix at the same index in rhs. output may alias either input.
+		static void MultiplyBatch(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, uint count);
+
+		/// Multiplies lhs by each matrix in rhs, eg. a view-projection matrix by world matrices. output may alias rhs.
+		static void MultiplyBatch(const Matrix4& lhs, const Matrix4* rhs, Matrix4* output, uint count);
+
+		/// Creates a matrix from translation, rotation and scale for each index. See CreateTRS().
+		static void CreateTRSBatch(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4* output, uint count);
+
+		/// Transforms 4D vectors by this matrix. See Multiply(). output may alias vectors.
+		void MultiplyBatch(const Vector4* vectors, Vector4* output, uint count) const;
+
+		/// Transforms 3D points by this matrix, treating them as having w = 1. output may alias points.
+		/// @note	Matrix must be affine.
+		void TransformPoints(const Vector3* points, Vector3* output, uint count) const;
+
 		static const Matrix4 c_Zero;
 		static const Matrix4 c_Identity;
 
 	private:
-		float m[4][4];
+		/// Writes lhs * rhs to output, which may alias either input.
+		static void Multiply(const Matrix4& lhs, const Matrix4& rhs, Matrix4& output)
+		{
+#if TYR_USE_SIMD
+			const Reg4 r0 = SIMD::Load4(rhs.m[0]);
+			const Reg4 r1 = SIMD::Load4(rhs.m[1]);
+			const Reg4 r2 = SIMD::Load4(rhs.m[2]);
+			const Reg4 r3 = SIMD::Load4(rhs.m[3]);
+
+			Reg4 rows[4];
+			for (uint row = 0; row < 4; ++row)
+			{
+				const Reg4 l = SIMD::Load4(lhs.m[row]);
+				Reg4 p = SIMD::Mul4(SIMD::Splat4<0>(l), r0);
+				p = SIMD::MulAdd4(SIMD::Splat4<1>(l), r1, p);
+				p = SIMD::MulAdd4(SIMD::Splat4<2>(l), r2, p);
+				rows[row] = SIMD::MulAdd4(SIMD::Splat4<3>(l), r3, p);
+			}
+
+			for (uint row = 0; row < 4; ++row)
+			{
+				SIMD::Store4(output.m[row], rows[row]);
+			}
+#else
+			Matrix4 prod;
+			for (uint row = 0; row < 4; ++row)
+			{
+				for (uint col = 0; col < 4; ++col)
+				{
+					prod.m[row][col] = 
+						lhs.m[row][0] * rhs.m[0][col] +
+						lhs.m[row][1] * rhs.m[1][col] + 
+						lhs.m[row][2] * rhs.m[2][col] +
+						lhs.m[row][3] * rhs.m[3][col];
+				}
+			}
+			output = prod;
+#endif
+		}
+
+		// Aligned for the SIMD paths, which load whole rows
+		alignas(16) float m[4][4];
 	};
 }
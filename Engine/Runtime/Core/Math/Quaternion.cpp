@@ -413,4 +413,43 @@ namespace tyr
 
 		return q;
 	}
+
+	void Quaternion::RotateBatch(const Vector3* vectors, Vector3* output, uint count) const
+	{
+#if TYR_USE_SIMD
+		const Reg4 q = SIMD::Load4(&x);
+		for (uint i = 0; i < count; ++i)
+		{
+			SIMD::Store3(&output[i].x, Rotate(q, SIMD::Load3(&vectors[i].x)));
+		}
+#else
+		for (uint i = 0; i < count; ++i)
+		{
+			output[i] = Rotate(vectors[i]);
+		}
+#endif
+	}
+
+	void Quaternion::MultiplyBatch(const Quaternion* lhs, const Quaternion* rhs, Quaternion* output, uint count)
+	{
+		for (uint i = 0; i < count; ++i)
+		{
+			output[i] = lhs[i] * rhs[i];
+		}
+	}
+
+	void Quaternion::RotateBatch(const Quaternion* rotations, const Vector3* vectors, Vector3* output, uint count)
+	{
+#if TYR_USE_SIMD
+		for (uint i = 0; i < count; ++i)
+		{
+			SIMD::Store3(&output[i].x, Rotate(SIMD::Load4(&rotations[i].x), SIMD::Load3(&vectors[i].x)));
+		}
+#else
+		for (uint i = 0; i < count; ++i)
+		{
+			output[i] = rotations[i].Rotate(vectors[i]);
+		}
+#endif
+	}
 }
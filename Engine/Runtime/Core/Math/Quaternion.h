@@ -172,6 +172,11 @@ namespace tyr
 
 		Quaternion operator* (const Quaternion& rhs) const
 		{
+#if TYR_USE_SIMD
+			Quaternion output;
+			SIMD::Store4(&output.x, Multiply(SIMD::Load4(&x), SIMD::Load4(&rhs.x)));
+			return output;
+#else
 			return Quaternion
 			(
 				w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z,
@@ -179,6 +184,7 @@ namespace tyr
 				w * rhs.y + y * rhs.w + z * rhs.x - x * rhs.z,
 				w * rhs.z + z * rhs.w + x * rhs.y - y * rhs.x
 			);
+#endif
 		}
 
 		Quaternion operator* (float rhs) const
@@ -287,14 +293,23 @@ namespace tyr
 		/// Rotates the provided vector. 
 		Vector3 Rotate(const Vector3& v) const
 		{
+#if TYR_USE_SIMD
+			alignas(16) float output[4];
+			SIMD::Store4(output, Rotate(SIMD::Load4(&x), SIMD::Set4(v.x, v.y, v.z, 0.0f)));
+			return Vector3(output[0], output[1], output[2]);
+#else
 			const Vector3 u(x, y, z);
 			Vector3 vOut = (2.0f * (u.Dot(v))) * u; 
 			vOut += ((w * w) - (u.Dot(u))) * v;
 			vOut += 2.0f * w * (u.Cross(v));
 
 			return vOut;
+#endif
 		}
 
+		/// Rotates each of the provided vectors. output may alias vectors.
+		void RotateBatch(const Vector3* vectors, Vector3* output, uint count) const;
+
 		/// Orients the quaternion so its negative z axis points to the provided direction.
 		///
 		/// @param[in]	forwardDir	Direction to orient towards.
@@ -355,12 +370,54 @@ namespace tyr
 		/// Gets the shortest arc quaternion to rotate this vector to the destination vector. 
 		static Quaternion GetRotationBetweenVectors(const Vector3& from, const Vector3& dest, const Vector3& fallbackAxis = Vector3::c_Zero);
 
+		/// Multiplies each quaternion in lhs by the quaternion at the same index in rhs. output may alias either input.
+		static void MultiplyBatch(const Quaternion* lhs, const Quaternion* rhs, Quaternion* output, uint count);
+
+		/// Rotates each vector by the quaternion at the same index. output may alias vectors.
+		static void RotateBatch(const Quaternion* rotations, const Vector3* vectors, Vector3* output, uint count);
+
 		static constexpr float c_Epsilon = 1e-03f;
 
 		static const Quaternion c_Zero;
 		static const Quaternion c_Identity;
 
-		float x, y, z, w; 
+		// Aligned for the SIMD paths, which load all 4 components. The order (x, y, z, w) is relied on there.
+		alignas(16) float x;
+		float y, z, w; 
+
+	private:
+#if TYR_USE_SIMD
+		/// Multiplies quaternions stored as (x, y, z, w). 
+		static Reg4 Multiply(Reg4 lhs, Reg4 rhs)
+		{
+			const Reg4 signsXW = SIMD::Set4(0.0f, -0.0f, 0.0f, -0.0f);
+			const Reg4 signsZW = SIMD::Set4(0.0f, 0.0f, -0.0f, -0.0f);
+			const Reg4 signsXWNeg = SIMD::Set4(-0.0f, 0.0f, 0.0f, -0.0f);
+
+			Reg4 output = SIMD::Mul4(SIMD::Splat4<3>(lhs), rhs);
+			output = SIMD::MulAdd4(SIMD::Splat4<0>(lhs), SIMD::Xor4(SIMD::Swizzle4<3, 2, 1, 0>(rhs), signsXW), output);
+			output = SIMD::MulAdd4(SIMD::Splat4<1>(lhs), SIMD::Xor4(SIMD::Swizzle4<2, 3, 0, 1>(rhs), signsZW), output);
+			output = SIMD::MulAdd4(SIMD::Splat4<2>(lhs), SIMD::Xor4(SIMD::Swizzle4<1, 0, 3, 2>(rhs), signsXWNeg), output);
+
+			return output;
+		}
+
+		/// Rotates the vector (x, y, z, 0) by the quaternion (x, y, z, w). 
+		static Reg4 Rotate(Reg4 q, Reg4 v)
+		{
+			const Reg4 u = SIMD::ClearW4(q);
+			const Reg4 w = SIMD::Splat4<3>(q);
+			const Reg4 two = SIMD::Set4(2.0f);
+			const Reg4 uDotV = SIMD::HorizontalSum4(SIMD::Mul4(u, v));
+			const Reg4 uDotU = SIMD::HorizontalSum4(SIMD::Mul4(u, u));
+
+			Reg4 output = SIMD::Mul4(SIMD::Mul4(two, uDotV), u);
+			output = SIMD::MulAdd4(SIMD::Sub4(SIMD::Mul4(w, w), uDotU), v, output);
+			output = SIMD::MulAdd4(SIMD::Mul4(two, w), SIMD::Cross3(u, v), output);
+
+			return output;
+		}
+#endif
 	};
 }
 
@@ -2,165 +2,780 @@
 
 #include "Base/Base.h"
 
-#if defined(_WIN32) || defined(__linux__)
-#define TYR_USE_AVX2
+// The baseline backend is SSE4.2 on x86 and NEON on ARM64, which every supported CPU has.
+// The AVX2 and AVX-512 sections are only compiled in translation units built with those instruction sets, whose code
+// is picked at runtime based on the CPU (see MathKernels.h).
+#if TYR_ARCH_TYPE == TYR_ARCHITECTURE_ARM64
+#define TYR_SIMD_NEON
+#include <arm_neon.h>
+#elif TYR_ARCH_TYPE == TYR_ARCHITECTURE_x86_64 || TYR_ARCH_TYPE == TYR_ARCHITECTURE_x86_32
+#define TYR_SIMD_SSE
+#include <immintrin.h>
+#if defined(__AVX2__)
+#define TYR_SIMD_AVX2
+#endif
+#if defined(__AVX512F__)
+#define TYR_SIMD_AVX512
+#endif
+#else
+#error "SIMD not supported on this architecture yet"
 #endif
 
-#ifdef TYR_USE_AVX2
-#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Each instruction set gets its own namespace for the SIMD class. Otherwise the linker could replace the baseline
+// copy of a function that wasn't inlined with one compiled for a wider instruction set.
+#if defined(TYR_SIMD_AVX512)
+#define TYR_SIMD_NAMESPACE SIMDAVX512
+#elif defined(TYR_SIMD_AVX2)
+#define TYR_SIMD_NAMESPACE SIMDAVX2
+#elif defined(TYR_SIMD_NEON)
+#define TYR_SIMD_NAMESPACE SIMDNEON
 #else
-#error "AVX2 not supported on this platform yet"
+#define TYR_SIMD_NAMESPACE SIMDSSE
 #endif
 
 namespace tyr
 {
-#ifdef TYR_USE_AVX2
+#if defined(TYR_SIMD_SSE)
+    using Reg4 = __m128;    // Float SIMD register (4 x float)
+    using RegB = __m128i;   // Byte SIMD register (16 x int8)
+#elif defined(TYR_SIMD_NEON)
+    using Reg4 = float32x4_t;
+    using RegB = uint8x16_t;
+#endif
+
+#ifdef TYR_SIMD_AVX2
     // Type aliases for AVX2 registers
     using RegI = __m256i;   // Integer SIMD register (8 x int32)
     using Reg = __m256;     // Float SIMD register (8 x float)
     using RegD = __m256d;   // Double SIMD register (4 x double)
+#endif
 
+#ifdef TYR_SIMD_AVX512
+    using Reg16 = __m512;   // Float SIMD register (16 x float)
 #endif
 
-    class SIMD
+    inline namespace TYR_SIMD_NAMESPACE
     {
-    public:
-#ifdef TYR_USE_AVX2
-        // --- Integer operations ---
-
-        static inline RegI LoadI(const int* ptr)
-        {
-            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
-        }
-
-        static inline void StoreI(int* ptr, RegI v)
-        {
-            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), v);
-        }
-
-        static inline RegI AddI(RegI a, RegI b)
-        {
-            return _mm256_add_epi32(a, b);
-        }
-
-        static inline RegI SubI(RegI a, RegI b)
+        class SIMD
         {
-            return _mm256_sub_epi32(a, b);
-        }
-
-        static inline RegI MulI(RegI a, RegI b)
-        {
-            return _mm256_mullo_epi32(a, b);
-        }
-
-        static inline RegI AndI(RegI a, RegI b)
-        {
-            return _mm256_and_si256(a, b);
-        }
-
-        static inline RegI OrI(RegI a, RegI b)
-        {
-            return _mm256_or_si256(a, b);
-        }
-
-        static inline RegI XorI(RegI a, RegI b)
-        {
-            return _mm256_xor_si256(a, b);
-        }
-
-        static inline RegI SetI(int v)
-        {
-            return _mm256_set1_epi32(v);
-        }
-
-        // --- Float operations ---
-
-        static inline Reg Load(const float* ptr)
-        {
-            return _mm256_loadu_ps(ptr);
-        }
-
-        static inline void Store(float* ptr, Reg v)
-        {
-            _mm256_storeu_ps(ptr, v);
-        }
-
-        static inline Reg Add(Reg a, Reg b)
-        {
-            return _mm256_add_ps(a, b);
-        }
-
-        static inline Reg Sub(Reg a, Reg b)
-        {
-            return _mm256_sub_ps(a, b);
-        }
-
-        static inline Reg Mul(Reg a, Reg b)
-        {
-            return _mm256_mul_ps(a, b);
-        }
-
-        static inline Reg Div(Reg a, Reg b)
-        {
-            return _mm256_div_ps(a, b);
-        }
-
-        static inline Reg Set(float v)
-        {
-            return _mm256_set1_ps(v);
-        }
-
-        static inline Reg Sqrt(Reg a)
-        {
-            return _mm256_sqrt_ps(a);
-        }
-
-        static inline Reg Rcp(Reg a)
-        {
-            return _mm256_rcp_ps(a);
-        }
-
-        // --- Double operations ---
-
-        static inline RegD LoadD(const double* ptr)
-        {
-            return _mm256_loadu_pd(ptr);
-        }
-
-        static inline void StoreD(double* ptr, RegD v)
-        {
-            _mm256_storeu_pd(ptr, v);
-        }
-
-        static inline RegD AddD(RegD a, RegD b)
-        {
-            return _mm256_add_pd(a, b);
-        }
-
-        static inline RegD SubD(RegD a, RegD b)
-        {
-            return _mm256_sub_pd(a, b);
-        }
-
-        static inline RegD MulD(RegD a, RegD b)
-        {
-            return _mm256_mul_pd(a, b);
-        }
-
-        static inline RegD DivD(RegD a, RegD b)
-        {
-            return _mm256_div_pd(a, b);
-        }
+        public:
+#if defined(TYR_SIMD_SSE)
+            // --- 4 x float operations ---
+
+            // ptr must be 16 byte aligned
+            static inline Reg4 Load4(const float* ptr)
+            {
+                return _mm_load_ps(ptr);
+            }
+
+            static inline Reg4 LoadU4(const float* ptr)
+            {
+                return _mm_loadu_ps(ptr);
+            }
+
+            // ptr must be 16 byte aligned
+            static inline void Store4(float* ptr, Reg4 v)
+            {
+                _mm_store_ps(ptr, v);
+            }
+
+            static inline void StoreU4(float* ptr, Reg4 v)
+            {
+                _mm_storeu_ps(ptr, v);
+            }
+
+            // Loads 3 floats and sets w to 0. The 64-bit integer load is used for x and y since, unlike the double
+            // one, it may be unaligned.
+            static inline Reg4 Load3(const float* ptr)
+            {
+                const Reg4 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr)));
+                return _mm_movelh_ps(xy, _mm_load_ss(ptr + 2));
+            }
+
+            // Stores x, y and z only
+            static inline void Store3(float* ptr, Reg4 v)
+            {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(ptr), _mm_castps_si128(v));
+                _mm_store_ss(ptr + 2, _mm_movehl_ps(v, v));
+            }
+
+            static inline Reg4 Set4(float v)
+            {
+                return _mm_set1_ps(v);
+            }
+
+            static inline Reg4 Set4(float x, float y, float z, float w)
+            {
+                return _mm_setr_ps(x, y, z, w);
+            }
+
+            static inline Reg4 Add4(Reg4 a, Reg4 b)
+            {
+                return _mm_add_ps(a, b);
+            }
+
+            static inline Reg4 Sub4(Reg4 a, Reg4 b)
+            {
+                return _mm_sub_ps(a, b);
+            }
+
+            static inline Reg4 Mul4(Reg4 a, Reg4 b)
+            {
+                return _mm_mul_ps(a, b);
+            }
+
+            static inline Reg4 Div4(Reg4 a, Reg4 b)
+            {
+                return _mm_div_ps(a, b);
+            }
+
+            static inline Reg4 Sqrt4(Reg4 a)
+            {
+                return _mm_sqrt_ps(a);
+            }
+
+            static inline Reg4 Min4(Reg4 a, Reg4 b)
+            {
+                return _mm_min_ps(a, b);
+            }
+
+            static inline Reg4 Max4(Reg4 a, Reg4 b)
+            {
+                return _mm_max_ps(a, b);
+            }
+
+            // Returns all bits set in the elements where a > b
+            static inline Reg4 CmpGt4(Reg4 a, Reg4 b)
+            {
+                return _mm_cmpgt_ps(a, b);
+            }
+
+            // Returns a where mask is set and b elsewhere
+            static inline Reg4 Select4(Reg4 mask, Reg4 a, Reg4 b)
+            {
+                return _mm_blendv_ps(b, a, mask);
+            }
+
+            // Returns a * b + c. Not fused so that results match the scalar code.
+            static inline Reg4 MulAdd4(Reg4 a, Reg4 b, Reg4 c)
+            {
+                return _mm_add_ps(_mm_mul_ps(a, b), c);
+            }
+
+            static inline Reg4 ClearW4(Reg4 a)
+            {
+                return _mm_blend_ps(a, _mm_setzero_ps(), 0x8);
+            }
+
+            static inline Reg4 And4(Reg4 a, Reg4 b)
+            {
+                return _mm_and_ps(a, b);
+            }
+
+            static inline Reg4 Or4(Reg4 a, Reg4 b)
+            {
+                return _mm_or_ps(a, b);
+            }
+
+            static inline Reg4 Xor4(Reg4 a, Reg4 b)
+            {
+                return _mm_xor_ps(a, b);
+            }
+
+            // Returns the sign bit of every element as a 4-bit mask where bit i is element i
+            static inline uint MoveMask4(Reg4 a)
+            {
+                return static_cast<uint>(_mm_movemask_ps(a));
+            }
+
+            // Returns (a[X], a[Y], b[Z], b[W])
+            template<int X, int Y, int Z, int W>
+            static inline Reg4 Shuffle4(Reg4 a, Reg4 b)
+            {
+                return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+            }
+
+            // Returns (a[X], a[Y], a[Z], a[W])
+            template<int X, int Y, int Z, int W>
+            static inline Reg4 Swizzle4(Reg4 a)
+            {
+                return _mm_shuffle_ps(a, a, _MM_SHUFFLE(W, Z, Y, X));
+            }
+
+            template<int I>
+            static inline Reg4 Splat4(Reg4 a)
+            {
+                return Swizzle4<I, I, I, I>(a);
+            }
+
+            // Returns (a.x, a.y, b.x, b.y)
+            static inline Reg4 MoveLH4(Reg4 a, Reg4 b)
+            {
+                return _mm_movelh_ps(a, b);
+            }
+
+            // Returns (a.z, a.w, b.z, b.w)
+            static inline Reg4 MoveHL4(Reg4 a, Reg4 b)
+            {
+                return _mm_movehl_ps(b, a);
+            }
+
+            // Returns the sum of all elements in every element
+            static inline Reg4 HorizontalSum4(Reg4 a)
+            {
+                const Reg4 sum = _mm_hadd_ps(a, a);
+                return _mm_hadd_ps(sum, sum);
+            }
+
+            static inline void Transpose4(Reg4& r0, Reg4& r1, Reg4& r2, Reg4& r3)
+            {
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            }
+
+            static inline float GetX4(Reg4 a)
+            {
+                return _mm_cvtss_f32(a);
+            }
+
+            // --- Byte operations (16 x int8) ---
+
+            static inline RegB LoadBytes(const uint8* ptr)
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+            }
+
+            static inline RegB SetBytes(int8 v)
+            {
+                return _mm_set1_epi8(v);
+            }
+
+            static inline RegB CmpEqBytes(RegB a, RegB b)
+            {
+                return _mm_cmpeq_epi8(a, b);
+            }
+
+            // Returns the top bit of every byte as a 16-bit mask where bit i is byte i
+            static inline uint MoveMaskBytes(RegB v)
+            {
+                return static_cast<uint>(_mm_movemask_epi8(v));
+            }
+#elif defined(TYR_SIMD_NEON)
+            // --- 4 x float operations ---
+
+            // ptr must be 16 byte aligned
+            static inline Reg4 Load4(const float* ptr)
+            {
+                return vld1q_f32(ptr);
+            }
+
+            static inline Reg4 LoadU4(const float* ptr)
+            {
+                return vld1q_f32(ptr);
+            }
+
+            // ptr must be 16 byte aligned
+            static inline void Store4(float* ptr, Reg4 v)
+            {
+                vst1q_f32(ptr, v);
+            }
+
+            static inline void StoreU4(float* ptr, Reg4 v)
+            {
+                vst1q_f32(ptr, v);
+            }
+
+            // Loads 3 floats and sets w to 0
+            static inline Reg4 Load3(const float* ptr)
+            {
+                return vcombine_f32(vld1_f32(ptr), vset_lane_f32(ptr[2], vdup_n_f32(0.0f), 0));
+            }
+
+            // Stores x, y and z only
+            static inline void Store3(float* ptr, Reg4 v)
+            {
+                vst1_f32(ptr, vget_low_f32(v));
+                vst1q_lane_f32(ptr + 2, v, 2);
+            }
+
+            static inline Reg4 Set4(float v)
+            {
+                return vdupq_n_f32(v);
+            }
+
+            static inline Reg4 Set4(float x, float y, float z, float w)
+            {
+                alignas(16) const float values[4] = { x, y, z, w };
+                return vld1q_f32(values);
+            }
+
+            static inline Reg4 Add4(Reg4 a, Reg4 b)
+            {
+                return vaddq_f32(a, b);
+            }
+
+            static inline Reg4 Sub4(Reg4 a, Reg4 b)
+            {
+                return vsubq_f32(a, b);
+            }
+
+            static inline Reg4 Mul4(Reg4 a, Reg4 b)
+            {
+                return vmulq_f32(a, b);
+            }
+
+            static inline Reg4 Div4(Reg4 a, Reg4 b)
+            {
+                return vdivq_f32(a, b);
+            }
+
+            static inline Reg4 Sqrt4(Reg4 a)
+            {
+                return vsqrtq_f32(a);
+            }
+
+            static inline Reg4 Min4(Reg4 a, Reg4 b)
+            {
+                return vminq_f32(a, b);
+            }
+
+            static inline Reg4 Max4(Reg4 a, Reg4 b)
+            {
+                return vmaxq_f32(a, b);
+            }
+
+            // Returns all bits set in the elements where a > b
+            static inline Reg4 CmpGt4(Reg4 a, Reg4 b)
+            {
+                return vreinterpretq_f32_u32(vcgtq_f32(a, b));
+            }
+
+            // Returns a where mask is set and b elsewhere
+            static inline Reg4 Select4(Reg4 mask, Reg4 a, Reg4 b)
+            {
+                return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+            }
+
+            // Returns a * b + c. Not fused so that results match the scalar code.
+            static inline Reg4 MulAdd4(Reg4 a, Reg4 b, Reg4 c)
+            {
+                return vaddq_f32(vmulq_f32(a, b), c);
+            }
+
+            static inline Reg4 ClearW4(Reg4 a)
+            {
+                return vsetq_lane_f32(0.0f, a, 3);
+            }
+
+            static inline Reg4 And4(Reg4 a, Reg4 b)
+            {
+                return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+            }
+
+            static inline Reg4 Or4(Reg4 a, Reg4 b)
+            {
+                return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+            }
+
+            static inline Reg4 Xor4(Reg4 a, Reg4 b)
+            {
+                return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+            }
+
+            // Returns the sign bit of every element as a 4-bit mask where bit i is element i
+            static inline uint MoveMask4(Reg4 a)
+            {
+                alignas(16) static constexpr uint c_BitWeights[4] = { 1, 2, 4, 8 };
+                const uint32x4_t signBits = vshrq_n_u32(vreinterpretq_u32_f32(a), 31);
+                return vaddvq_u32(vmulq_u32(signBits, vld1q_u32(c_BitWeights)));
+            }
+
+            // Returns (a[X], a[Y], b[Z], b[W]). Compilers turn the lane moves into permutes.
+            template<int X, int Y, int Z, int W>
+            static inline Reg4 Shuffle4(Reg4 a, Reg4 b)
+            {
+                Reg4 result = vdupq_laneq_f32(a, X);
+                result = vcopyq_laneq_f32(result, 1, a, Y);
+                result = vcopyq_laneq_f32(result, 2, b, Z);
+                return vcopyq_laneq_f32(result, 3, b, W);
+            }
+
+            // Returns (a[X], a[Y], a[Z], a[W])
+            template<int X, int Y, int Z, int W>
+            static inline Reg4 Swizzle4(Reg4 a)
+            {
+                return Shuffle4<X, Y, Z, W>(a, a);
+            }
+
+            template<int I>
+            static inline Reg4 Splat4(Reg4 a)
+            {
+                return vdupq_laneq_f32(a, I);
+            }
+
+            // Returns (a.x, a.y, b.x, b.y)
+            static inline Reg4 MoveLH4(Reg4 a, Reg4 b)
+            {
+                return vcombine_f32(vget_low_f32(a), vget_low_f32(b));
+            }
+
+            // Returns (a.z, a.w, b.z, b.w)
+            static inline Reg4 MoveHL4(Reg4 a, Reg4 b)
+            {
+                return vcombine_f32(vget_high_f32(a), vget_high_f32(b));
+            }
+
+            // Returns the sum of all elements in every element
+            static inline Reg4 HorizontalSum4(Reg4 a)
+            {
+                return vdupq_n_f32(vaddvq_f32(a));
+            }
+
+            static inline void Transpose4(Reg4& r0, Reg4& r1, Reg4& r2, Reg4& r3)
+            {
+                // (r0.x, r1.x, r0.z, r1.z) and (r0.y, r1.y, r0.w, r1.w)
+                const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+                const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+                r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+                r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+                r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+                r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+            }
+
+            static inline float GetX4(Reg4 a)
+            {
+                return vgetq_lane_f32(a, 0);
+            }
+
+            // --- Byte operations (16 x int8) ---
+
+            static inline RegB LoadBytes(const uint8* ptr)
+            {
+                return vld1q_u8(ptr);
+            }
+
+            static inline RegB SetBytes(int8 v)
+            {
+                return vdupq_n_u8(static_cast<uint8>(v));
+            }
+
+            static inline RegB CmpEqBytes(RegB a, RegB b)
+            {
+                return vceqq_u8(a, b);
+            }
+
+            // Returns the top bit of every byte as a 16-bit mask where bit i is byte i
+            static inline uint MoveMaskBytes(RegB v)
+            {
+                alignas(16) static constexpr uint8 c_BitWeights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+                const uint8x16_t topBits = vreinterpretq_u8_s8(vshrq_n_s8(vreinterpretq_s8_u8(v), 7));
+                const uint8x16_t bits = vandq_u8(topBits, vld1q_u8(c_BitWeights));
+                return static_cast<uint>(vaddv_u8(vget_low_u8(bits))) | (static_cast<uint>(vaddv_u8(vget_high_u8(bits))) << 8);
+            }
+#endif
 
-        static inline RegD SetD(double v)
-        {
-            return _mm256_set1_pd(v);
-        }
+            // Returns the index of the lowest set bit. mask must not be zero. Kernels use this instead of
+            // std::countr_zero so that no out of line copy of it is compiled with a wider instruction set.
+            static inline uint CountTrailingZeros(uint mask)
+            {
+#if defined(_MSC_VER)
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return static_cast<uint>(index);
+#else
+                return static_cast<uint>(__builtin_ctz(mask));
+#endif
+            }
+
+            static inline Reg4 Cross3(Reg4 a, Reg4 b)
+            {
+                const Reg4 c = Sub4(Mul4(a, Swizzle4<1, 2, 0, 3>(b)), Mul4(Swizzle4<1, 2, 0, 3>(a), b));
+                return Swizzle4<1, 2, 0, 3>(c);
+            }
+
+            // Returns the minimum of all elements
+            static inline float HorizontalMin4(Reg4 a)
+            {
+                const Reg4 m = Min4(a, Swizzle4<2, 3, 0, 1>(a));
+                return GetX4(Min4(m, Swizzle4<1, 0, 3, 2>(m)));
+            }
+
+            // Returns the maximum of all elements
+            static inline float HorizontalMax4(Reg4 a)
+            {
+                const Reg4 m = Max4(a, Swizzle4<2, 3, 0, 1>(a));
+                return GetX4(Max4(m, Swizzle4<1, 0, 3, 2>(m)));
+            }
+
+#ifdef TYR_SIMD_AVX2
+            // --- Integer operations ---
+
+            static inline RegI LoadI(const int* ptr)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+            }
+
+            static inline void StoreI(int* ptr, RegI v)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), v);
+            }
+
+            static inline RegI AddI(RegI a, RegI b)
+            {
+                return _mm256_add_epi32(a, b);
+            }
+
+            static inline RegI SubI(RegI a, RegI b)
+            {
+                return _mm256_sub_epi32(a, b);
+            }
+
+            static inline RegI MulI(RegI a, RegI b)
+            {
+                return _mm256_mullo_epi32(a, b);
+            }
+
+            static inline RegI AndI(RegI a, RegI b)
+            {
+                return _mm256_and_si256(a, b);
+            }
+
+            static inline RegI OrI(RegI a, RegI b)
+            {
+                return _mm256_or_si256(a, b);
+            }
+
+            static inline RegI XorI(RegI a, RegI b)
+            {
+                return _mm256_xor_si256(a, b);
+            }
+
+            static inline RegI SetI(int v)
+            {
+                return _mm256_set1_epi32(v);
+            }
+
+            // --- Float operations ---
+
+            static inline Reg Load(const float* ptr)
+            {
+                return _mm256_loadu_ps(ptr);
+            }
+
+            static inline void Store(float* ptr, Reg v)
+            {
+                _mm256_storeu_ps(ptr, v);
+            }
+
+            static inline Reg Add(Reg a, Reg b)
+            {
+                return _mm256_add_ps(a, b);
+            }
+
+            static inline Reg Sub(Reg a, Reg b)
+            {
+                return _mm256_sub_ps(a, b);
+            }
+
+            static inline Reg Mul(Reg a, Reg b)
+            {
+                return _mm256_mul_ps(a, b);
+            }
+
+            static inline Reg Div(Reg a, Reg b)
+            {
+                return _mm256_div_ps(a, b);
+            }
+
+            static inline Reg Set(float v)
+            {
+                return _mm256_set1_ps(v);
+            }
+
+            static inline Reg Sqrt(Reg a)
+            {
+                return _mm256_sqrt_ps(a);
+            }
+
+            static inline Reg Rcp(Reg a)
+            {
+                return _mm256_rcp_ps(a);
+            }
+
+            static inline Reg Min(Reg a, Reg b)
+            {
+                return _mm256_min_ps(a, b);
+            }
+
+            static inline Reg Max(Reg a, Reg b)
+            {
+                return _mm256_max_ps(a, b);
+            }
+
+            // Returns all bits set in the elements where a > b
+            static inline Reg CmpGt(Reg a, Reg b)
+            {
+                return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+            }
+
+            // Returns a where mask is set and b elsewhere
+            static inline Reg Select(Reg mask, Reg a, Reg b)
+            {
+                return _mm256_blendv_ps(b, a, mask);
+            }
+
+            static inline Reg Or(Reg a, Reg b)
+            {
+                return _mm256_or_ps(a, b);
+            }
+
+            static inline Reg And(Reg a, Reg b)
+            {
+                return _mm256_and_ps(a, b);
+            }
+
+            // Clears the sign bit of every element
+            static inline Reg Abs(Reg a)
+            {
+                return And(a, _mm256_castsi256_ps(SetI(0x7FFFFFFF)));
+            }
+
+            // Returns the sign bit of every element as an 8-bit mask where bit i is element i
+            static inline uint MoveMask(Reg a)
+            {
+                return static_cast<uint>(_mm256_movemask_ps(a));
+            }
+
+            // Returns (a[X], a[Y], b[Z], b[W]) within each 128-bit lane
+            template<int X, int Y, int Z, int W>
+            static inline Reg Shuffle(Reg a, Reg b)
+            {
+                return _mm256_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+            }
+
+            // Returns 128-bit lanes Low and High, where lanes 0 and 1 are from a and lanes 2 and 3 are from b
+            template<int Low, int High>
+            static inline Reg PermuteLanes(Reg a, Reg b)
+            {
+                return _mm256_permute2f128_ps(a, b, Low | (High << 4));
+            }
+
+            // Copies the 4 floats at ptr to both 128-bit lanes
+            static inline Reg Broadcast4(const float* ptr)
+            {
+                return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(ptr));
+            }
+
+            // Copies element I of each 128-bit lane to the rest of that lane
+            template<int I>
+            static inline Reg SplatLanes(Reg a)
+            {
+                return _mm256_shuffle_ps(a, a, _MM_SHUFFLE(I, I, I, I));
+            }
+
+            // Returns low in the lower 128-bit lane and high in the upper one
+            static inline Reg Combine(Reg4 low, Reg4 high)
+            {
+                return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+            }
+
+            static inline Reg4 GetLow(Reg a)
+            {
+                return _mm256_castps256_ps128(a);
+            }
+
+            static inline Reg4 GetHigh(Reg a)
+            {
+                return _mm256_extractf128_ps(a, 1);
+            }
+
+            // --- Double operations ---
+
+            static inline RegD LoadD(const double* ptr)
+            {
+                return _mm256_loadu_pd(ptr);
+            }
+
+            static inline void StoreD(double* ptr, RegD v)
+            {
+                _mm256_storeu_pd(ptr, v);
+            }
+
+            static inline RegD AddD(RegD a, RegD b)
+            {
+                return _mm256_add_pd(a, b);
+            }
+
+            static inline RegD SubD(RegD a, RegD b)
+            {
+                return _mm256_sub_pd(a, b);
+            }
+
+            static inline RegD MulD(RegD a, RegD b)
+            {
+                return _mm256_mul_pd(a, b);
+            }
+
+            static inline RegD DivD(RegD a, RegD b)
+            {
+                return _mm256_div_pd(a, b);
+            }
+
+            static inline RegD SetD(double v)
+            {
+                return _mm256_set1_pd(v);
+            }
+
+            static inline RegD SqrtD(RegD a)
+            {
+                return _mm256_sqrt_pd(a);
+            }
+#endif
 
-        static inline RegD SqrtD(RegD a)
-        {
-            return _mm256_sqrt_pd(a);
-        }
-    };
+#ifdef TYR_SIMD_AVX512
+            // --- 16 x float operations ---
+
+            static inline Reg16 Load16(const float* ptr)
+            {
+                return _mm512_loadu_ps(ptr);
+            }
+
+            static inline void Store16(float* ptr, Reg16 v)
+            {
+                _mm512_storeu_ps(ptr, v);
+            }
+
+            static inline Reg16 Add16(Reg16 a, Reg16 b)
+            {
+                return _mm512_add_ps(a, b);
+            }
+
+            static inline Reg16 Mul16(Reg16 a, Reg16 b)
+            {
+                return _mm512_mul_ps(a, b);
+            }
+
+            // The unmasked broadcast and permute intrinsics pass an undefined register as their merge source, which GCC
+            // reports as maybe uninitialized. The zero masked forms with every lane enabled compile to the same
+            // instructions.
+            static constexpr __mmask16 c_AllLanes16 = 0xFFFF;
+
+            // Copies the 4 floats at ptr to all four 128-bit lanes
+            static inline Reg16 Broadcast4To16(const float* ptr)
+            {
+                return _mm512_maskz_broadcast_f32x4(c_AllLanes16, _mm_loadu_ps(ptr));
+            }
+
+            // Copies element I of each 128-bit lane to the rest of that lane
+            template<int I>
+            static inline Reg16 SplatLanes16(Reg16 a)
+            {
+                return _mm512_maskz_permute_ps(c_AllLanes16, a, _MM_SHUFFLE(I, I, I, I));
+            }
 #endif
-} 
+        };
+    }
+}
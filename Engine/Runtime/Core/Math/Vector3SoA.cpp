@@ -0,0 +1,257 @@
+#include "Math/Vector3SoA.h"
+#include "Math/MathKernels.h"
+#include "Memory/Allocation.h"
+#include <algorithm>
+#include <cstring>
+
+namespace tyr
+{
+	Vector3SoA::Vector3SoA()
+		: m_Data(nullptr)
+		, m_Size(0)
+		, m_PaddedSize(0)
+	{
+
+	}
+
+	Vector3SoA::Vector3SoA(uint size)
+		: Vector3SoA()
+	{
+		Resize(size);
+	}
+
+	Vector3SoA::Vector3SoA(Vector3SoA&& other) noexcept
+		: m_Data(other.m_Data)
+		, m_Size(other.m_Size)
+		, m_PaddedSize(other.m_PaddedSize)
+	{
+		other.m_Data = nullptr;
+		other.m_Size = 0;
+		other.m_PaddedSize = 0;
+	}
+
+	Vector3SoA::~Vector3SoA()
+	{
+		if (m_Data)
+		{
+			FreeAligned(m_Data);
+		}
+	}
+
+	Vector3SoA& Vector3SoA::operator=(Vector3SoA&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_Data)
+			{
+				FreeAligned(m_Data);
+			}
+			m_Data = other.m_Data;
+			m_Size = other.m_Size;
+			m_PaddedSize = other.m_PaddedSize;
+			other.m_Data = nullptr;
+			other.m_Size = 0;
+			other.m_PaddedSize = 0;
+		}
+		return *this;
+	}
+
+	void Vector3SoA::Resize(uint size)
+	{
+		const uint paddedSize = (size + c_LaneCount - 1) & ~(c_LaneCount - 1);
+		if (paddedSize == m_PaddedSize)
+		{
+			// Vectors that become padding are cleared
+			if (size < m_Size)
+			{
+				const size_t clearSize = (m_Size - size) * sizeof(float);
+				std::memset(X() + size, 0, clearSize);
+				std::memset(Y() + size, 0, clearSize);
+				std::memset(Z() + size, 0, clearSize);
+			}
+			m_Size = size;
+			return;
+		}
+
+		float* data = nullptr;
+		if (paddedSize > 0)
+		{
+			data = static_cast<float*>(AllocAligned(3 * paddedSize * sizeof(float), c_Alignment));
+			std::memset(data, 0, 3 * paddedSize * sizeof(float));
+		}
+
+		if (m_Data)
+		{
+			const size_t copySize = (size < m_Size ? size : m_Size) * sizeof(float);
+			if (copySize > 0)
+			{
+				std::memcpy(data, X(), copySize);
+				std::memcpy(data + paddedSize, Y(), copySize);
+				std::memcpy(data + 2 * paddedSize, Z(), copySize);
+			}
+			FreeAligned(m_Data);
+		}
+
+		m_Data = data;
+		m_Size = size;
+		m_PaddedSize = paddedSize;
+	}
+
+	void Vector3SoA::FromAoS(const Vector3* vectors, uint count)
+	{
+		Resize(count);
+#if TYR_USE_SIMD
+		GetMathKernels().aosToSoA(&vectors->x, m_Data, m_PaddedSize, count);
+#else
+		for (uint i = 0; i < count; ++i)
+		{
+			Set(i, vectors[i]);
+		}
+#endif
+	}
+
+	void Vector3SoA::ToAoS(Vector3* output) const
+	{
+#if TYR_USE_SIMD
+		GetMathKernels().soaToAoS(m_Data, m_PaddedSize, &output->x, m_Size);
+#else
+		for (uint i = 0; i < m_Size; ++i)
+		{
+			output[i] = Get(i);
+		}
+#endif
+	}
+
+	void Vector3SoA::GetBounds(Vector3& min, Vector3& max) const
+	{
+		TYR_ASSERT(m_Size > 0);
+#if TYR_USE_SIMD
+		const MathKernels& kernels = GetMathKernels();
+		kernels.minMaxStream(X(), m_Size, &min.x, &max.x);
+		kernels.minMaxStream(Y(), m_Size, &min.y, &max.y);
+		kernels.minMaxStream(Z(), m_Size, &min.z, &max.z);
+#else
+		min = Get(0);
+		max = min;
+		for (uint i = 1; i < m_Size; ++i)
+		{
+			const Vector3 vec = Get(i);
+			min = Vector3(std::min(min.x, vec.x), std::min(min.y, vec.y), std::min(min.z, vec.z));
+			max = Vector3(std::max(max.x, vec.x), std::max(max.y, vec.y), std::max(max.z, vec.z));
+		}
+#endif
+	}
+
+	void Vector3SoA::Add(const Vector3SoA& a, const Vector3SoA& b, Vector3SoA& output)
+	{
+		TYR_ASSERT(a.m_Size == b.m_Size);
+		output.Resize(a.m_Size);
+#if TYR_USE_SIMD
+		GetMathKernels().addStreams(a.m_Data, b.m_Data, output.m_Data, 3 * a.m_PaddedSize);
+#else
+		for (uint i = 0; i < 3 * a.m_PaddedSize; ++i)
+		{
+			output.m_Data[i] = a.m_Data[i] + b.m_Data[i];
+		}
+#endif
+	}
+
+	void Vector3SoA::Sub(const Vector3SoA& a, const Vector3SoA& b, Vector3SoA& output)
+	{
+		TYR_ASSERT(a.m_Size == b.m_Size);
+		output.Resize(a.m_Size);
+#if TYR_USE_SIMD
+		GetMathKernels().subStreams(a.m_Data, b.m_Data, output.m_Data, 3 * a.m_PaddedSize);
+#else
+		for (uint i = 0; i < 3 * a.m_PaddedSize; ++i)
+		{
+			output.m_Data[i] = a.m_Data[i] - b.m_Data[i];
+		}
+#endif
+	}
+
+	void Vector3SoA::Mul(const Vector3SoA& a, const Vector3SoA& b, Vector3SoA& output)
+	{
+		TYR_ASSERT(a.m_Size == b.m_Size);
+		output.Resize(a.m_Size);
+#if TYR_USE_SIMD
+		GetMathKernels().mulStreams(a.m_Data, b.m_Data, output.m_Data, 3 * a.m_PaddedSize);
+#else
+		for (uint i = 0; i < 3 * a.m_PaddedSize; ++i)
+		{
+			output.m_Data[i] = a.m_Data[i] * b.m_Data[i];
+		}
+#endif
+	}
+
+	void Vector3SoA::MulAdd(const Vector3SoA& a, const Vector3SoA& b, const Vector3SoA& c, Vector3SoA& output)
+	{
+		TYR_ASSERT(a.m_Size == b.m_Size && a.m_Size == c.m_Size);
+		output.Resize(a.m_Size);
+#if TYR_USE_SIMD
+		GetMathKernels().mulAddStreams(a.m_Data, b.m_Data, c.m_Data, output.m_Data, 3 * a.m_PaddedSize);
+#else
+		for (uint i = 0; i < 3 * a.m_PaddedSize; ++i)
+		{
+			output.m_Data[i] = a.m_Data[i] * b.m_Data[i] + c.m_Data[i];
+		}
+#endif
+	}
+
+	void Vector3SoA::Cross(const Vector3SoA& a, const Vector3SoA& b, Vector3SoA& output)
+	{
+		TYR_ASSERT(a.m_Size == b.m_Size);
+		output.Resize(a.m_Size);
+#if TYR_USE_SIMD
+		GetMathKernels().crossStreams(a.m_Data, b.m_Data, output.m_Data, a.m_PaddedSize);
+#else
+		for (uint i = 0; i < a.m_Size; ++i)
+		{
+			output.Set(i, a.Get(i).Cross(b.Get(i)));
+		}
+#endif
+	}
+
+	void Vector3SoA::Dot(const Vector3SoA& a, const Vector3SoA& b, float* output)
+	{
+		TYR_ASSERT(a.m_Size == b.m_Size);
+#if TYR_USE_SIMD
+		GetMathKernels().dotStreams(a.m_Data, b.m_Data, output, a.m_PaddedSize);
+#else
+		for (uint i = 0; i < a.m_PaddedSize; ++i)
+		{
+			output[i] = a.X()[i] * b.X()[i] + a.Y()[i] * b.Y()[i] + a.Z()[i] * b.Z()[i];
+		}
+#endif
+	}
+
+	void Vector3SoA::Length(const Vector3SoA& a, float* output)
+	{
+#if TYR_USE_SIMD
+		GetMathKernels().lengthStreams(a.m_Data, output, a.m_PaddedSize);
+#else
+		for (uint i = 0; i < a.m_PaddedSize; ++i)
+		{
+			output[i] = Math::Sqrt(a.X()[i] * a.X()[i] + a.Y()[i] * a.Y()[i] + a.Z()[i] * a.Z()[i]);
+		}
+#endif
+	}
+
+	void Vector3SoA::Normalize(const Vector3SoA& a, Vector3SoA& output)
+	{
+		output.Resize(a.m_Size);
+#if TYR_USE_SIMD
+		GetMathKernels().normalizeStreams(a.m_Data, output.m_Data, a.m_PaddedSize);
+#else
+		for (uint i = 0; i < a.m_Size; ++i)
+		{
+			Vector3 vec = a.Get(i);
+			if (vec.Length() > 0.0f)
+			{
+				vec.Normalize();
+			}
+			output.Set(i, vec);
+		}
+#endif
+	}
+}
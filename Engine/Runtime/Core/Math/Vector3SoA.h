@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Math/Vector3.h"
+#include "Base/INonCopyable.h"
+
+namespace tyr
+{
+	/// A stream of 3D vectors stored as separate x, y and z arrays so that SIMD code can process 4 or 8 vectors per
+	/// instruction.
+	///
+	/// The arrays share one 32 byte aligned allocation and each is padded to a multiple of c_LaneCount elements.
+	/// Padding elements are kept at zero so kernels can always work on whole registers.
+	/// Operations taking several streams require them to have the same size. The output stream may be one of the
+	/// inputs and is resized to the size of the inputs.
+	class TYR_CORE_EXPORT Vector3SoA final : public INonCopyable
+	{
+	public:
+		static constexpr uint c_LaneCount = 8;
+		static constexpr size_t c_Alignment = 32;
+
+		Vector3SoA();
+		explicit Vector3SoA(uint size);
+		Vector3SoA(Vector3SoA&& other) noexcept;
+		~Vector3SoA();
+
+		Vector3SoA& operator=(Vector3SoA&& other) noexcept;
+
+		/// Changes the number of vectors. Vectors below the new size are kept and new ones are zero.
+		void Resize(uint size);
+
+		uint Size() const { return m_Size; }
+
+		/// Returns the length of each array, which is the size rounded up to a multiple of c_LaneCount.
+		uint PaddedSize() const { return m_PaddedSize; }
+
+		float* X() { return m_Data; }
+		float* Y() { return m_Data + m_PaddedSize; }
+		float* Z() { return m_Data + 2 * m_PaddedSize; }
+		const float* X() const { return m_Data; }
+		const float* Y() const { return m_Data + m_PaddedSize; }
+		const float* Z() const { return m_Data + 2 * m_PaddedSize; }
+
+		Vector3 Get(uint index) const
+		{
+			TYR_ASSERT(index < m_Size);
+			return Vector3(X()[index], Y()[index], Z()[index]);
+		}
+
+		void Set(uint index, const Vector3& vec)
+		{
+			TYR_ASSERT(index < m_Size);
+			X()[index] = vec.x;
+			Y()[index] = vec.y;
+			Z()[index] = vec.z;
+		}
+
+		/// Resizes the stream to count and copies the vectors into it.
+		void FromAoS(const Vector3* vectors, uint count);
+
+		/// Copies the vectors to output, which must hold Size() vectors.
+		void ToAoS(Vector3* output) const;
+
+		/// Gets the component wise minimum and maximum of the vectors. The stream must not be empty.
+		void GetBounds(Vector3& min, Vector3& max) const;
+
+		static void Add(const Vector3SoA& a, const Vector3SoA& b, Vector3SoA& output);
+
+		static void Sub(const Vector3SoA& a, const Vector3SoA& b, Vector3SoA& output);
+
+		/// Multiplies the vectors component wise.
+		static void Mul(const Vector3SoA& a, const Vector3SoA& b, Vector3SoA& output);
+
+		/// Computes a * b + c component wise. Not fused so that results match the scalar code.
+		static void MulAdd(const Vector3SoA& a, const Vector3SoA& b, const Vector3SoA& c, Vector3SoA& output);
+
+		static void Cross(const Vector3SoA& a, const Vector3SoA& b, Vector3SoA& output);
+
+		/// Writes the dot product of each pair of vectors to output, which must hold PaddedSize() floats.
+		static void Dot(const Vector3SoA& a, const Vector3SoA& b, float* output);
+
+		/// Writes the length of each vector to output, which must hold PaddedSize() floats.
+		static void Length(const Vector3SoA& a, float* output);
+
+		/// Normalizes each vector. Vectors with zero length are left unchanged.
+		static void Normalize(const Vector3SoA& a, Vector3SoA& output);
+
+	private:
+		// x, y and z arrays one after another
+		float* m_Data;
+		uint m_Size;
+		uint m_PaddedSize;
+	};
+}
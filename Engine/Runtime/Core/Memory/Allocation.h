@@ -14,6 +14,7 @@
 #include "CoreMacros.h"
 #include "Base/Primitives.h"
 #include <limits>
+#include <utility>
 
 namespace tyr
 {
@@ -1,45 +1,153 @@
 #include "Memory/FrameAllocation.h"
 #include "ScratchAllocator.h"
+#include "Threading/Threading.h"
 
 namespace tyr
 {
-	TYR_THREADLOCAL ScratchAllocator* FrameAllocator::s_Allocator = nullptr;
+	struct FrameThreadAllocators
+	{
+		ScratchAllocator* allocators[FrameAllocator::c_FrameGenerationCount];
+	};
+
+	namespace
+	{
+		// Every thread's allocators so that BeginFrame() can recycle a generation on all of them
+		Mutex s_RegistryMutex;
+		Array<FrameThreadAllocators*> s_Registry;
+		Atomic<uint64> s_FrameIndex = 0;
+
+		// Settings used for threads whose allocators are created on first use
+		uint s_BlockSize = 1024 * 1024;
+		VirtualArenaConfig s_ArenaConfig;
+		bool s_UseArena = false;
+	}
+
+	TYR_THREADLOCAL FrameThreadAllocators* FrameAllocator::s_ThreadAllocators = nullptr;
+
+	FrameThreadAllocators* FrameAllocator::GetThreadAllocators()
+	{
+		if (s_ThreadAllocators == nullptr)
+		{
+			FrameThreadAllocators* threadAllocators = new FrameThreadAllocators();
+
+			LockGuard guard(s_RegistryMutex);
+			for (uint i = 0; i < c_FrameGenerationCount; ++i)
+			{
+				threadAllocators->allocators[i] = s_UseArena ? new ScratchAllocator(s_ArenaConfig) : new ScratchAllocator(s_BlockSize);
+			}
+			s_Registry.Add(threadAllocators);
+			s_ThreadAllocators = threadAllocators;
+		}
+		return s_ThreadAllocators;
+	}
 
 	void FrameAllocator::Create(uint blockSize)
 	{
-		if (s_Allocator != nullptr)
+		if (s_ThreadAllocators != nullptr)
 		{
 			Destroy();
 		}
 
-		s_Allocator = new ScratchAllocator(blockSize);
+		{
+			LockGuard guard(s_RegistryMutex);
+			s_BlockSize = blockSize;
+			s_UseArena = false;
+		}
+		GetThreadAllocators();
 	}
 
-	uint8* FrameAllocator::Alloc(uint amount)
+	void FrameAllocator::Create(const VirtualArenaConfig& arenaConfig)
 	{
-		TYR_ASSERT(s_Allocator != nullptr);
+		if (s_ThreadAllocators != nullptr)
+		{
+			Destroy();
+		}
 
-		return s_Allocator->Alloc(amount);
+		{
+			LockGuard guard(s_RegistryMutex);
+			s_ArenaConfig = arenaConfig;
+			s_UseArena = true;
+		}
+		GetThreadAllocators();
+	}
+
+	uint8* FrameAllocator::Alloc(uint amount)
+	{
+		const uint generation = static_cast<uint>(s_FrameIndex.load(std::memory_order_acquire) % c_FrameGenerationCount);
+		return GetThreadAllocators()->allocators[generation]->Alloc(amount);
 	}
 
 	uint8* FrameAllocator::AllocAligned(uint amount, uint alignment)
 	{
-		TYR_ASSERT(s_Allocator != nullptr);
+		const uint generation = static_cast<uint>(s_FrameIndex.load(std::memory_order_acquire) % c_FrameGenerationCount);
+		return GetThreadAllocators()->allocators[generation]->AllocAligned(amount, alignment);
+	}
+
+	void FrameAllocator::BeginFrame(uint64 frameIndex)
+	{
+		TYR_ASSERT(frameIndex >= s_FrameIndex.load(std::memory_order_relaxed));
 
-		return s_Allocator->AllocAligned(amount, alignment);
+		// The generation was last used for frame frameIndex - c_FrameGenerationCount, which every thread has finished with.
+		// It is reset before the new index is published so no thread allocates from it while it is being reset.
+		const uint generation = static_cast<uint>(frameIndex % c_FrameGenerationCount);
+		{
+			LockGuard guard(s_RegistryMutex);
+			for (FrameThreadAllocators* threadAllocators : s_Registry)
+			{
+				threadAllocators->allocators[generation]->Reset();
+			}
+		}
+
+		s_FrameIndex.store(frameIndex, std::memory_order_release);
+	}
+
+	uint64 FrameAllocator::GetFrameIndex()
+	{
+		return s_FrameIndex.load(std::memory_order_acquire);
 	}
 
 	void FrameAllocator::Reset()
 	{
-		TYR_ASSERT(s_Allocator != nullptr);
+		TYR_ASSERT(s_ThreadAllocators != nullptr);
 
-		s_Allocator->Reset();
+		const uint generation = static_cast<uint>(s_FrameIndex.load(std::memory_order_acquire) % c_FrameGenerationCount);
+		s_ThreadAllocators->allocators[generation]->Reset();
 	}
 
 	void FrameAllocator::Destroy()
 	{
-		TYR_ASSERT(s_Allocator != nullptr);
+		TYR_ASSERT(s_ThreadAllocators != nullptr);
 
-		TYR_SAFE_DELETE(s_Allocator);
+		LockGuard guard(s_RegistryMutex);
+		for (uint i = 0; i < s_Registry.Size(); ++i)
+		{
+			if (s_Registry[i] == s_ThreadAllocators)
+			{
+				s_Registry.Erase(i);
+				break;
+			}
+		}
+
+		for (uint i = 0; i < c_FrameGenerationCount; ++i)
+		{
+			TYR_SAFE_DELETE(s_ThreadAllocators->allocators[i]);
+		}
+		TYR_SAFE_DELETE(s_ThreadAllocators);
+	}
+
+	void FrameAllocator::DestroyAll()
+	{
+		LockGuard guard(s_RegistryMutex);
+		for (FrameThreadAllocators* threadAllocators : s_Registry)
+		{
+			for (uint i = 0; i < c_FrameGenerationCount; ++i)
+			{
+				TYR_SAFE_DELETE(threadAllocators->allocators[i]);
+			}
+			delete threadAllocators;
+		}
+		s_Registry.Clear();
+		// Other threads' pointers are left dangling, which is why none may allocate afterwards
+		s_ThreadAllocators = nullptr;
 	}
-}
\ No newline at end of file
+}
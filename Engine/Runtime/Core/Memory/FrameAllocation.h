@@ -6,22 +6,47 @@
 
 namespace tyr
 {
-	/// A frame allocator which uses a scratch allocator per thread  
+	struct VirtualArenaConfig;
+	struct FrameThreadAllocators;
+
+	/// A frame allocator which uses a set of scratch allocators per thread.
+	/// Each thread has one allocator per frame generation. Allocations go to the generation of the current frame and
+	/// stay valid for c_FrameGenerationCount frames, so data allocated on any thread can be handed to the render thread.
+	/// Threads that haven't called Create() get their allocators on first use with the settings of the last Create().
 	class FrameAllocator
 	{
 	public:
+		/// Number of frames an allocation stays alive for. Must cover every frame that can be in flight.
+		static constexpr uint c_FrameGenerationCount = 3;
+
 		static TYR_CORE_EXPORT void Create(uint blockSize = 1024 * 1024);
 
+		/// Creates the calling thread's frame allocators backed by virtual arenas.
+		static TYR_CORE_EXPORT void Create(const VirtualArenaConfig& arenaConfig);
+
 		static TYR_CORE_EXPORT uint8* Alloc(uint amount);
 
 		static TYR_CORE_EXPORT uint8* AllocAligned(uint amount, uint alignment);
 
+		/// Starts a new frame. Recycles the generation last used c_FrameGenerationCount frames ago on every thread.
+		/// Should be called once per frame by the main thread. Frame indices must increase.
+		static TYR_CORE_EXPORT void BeginFrame(uint64 frameIndex);
+
+		static TYR_CORE_EXPORT uint64 GetFrameIndex();
+
+		/// Clears the calling thread's allocations for the current frame.
 		static TYR_CORE_EXPORT void Reset();
 
+		/// Destroys the calling thread's allocators.
 		static TYR_CORE_EXPORT void Destroy();
 
+		/// Destroys the allocators of every thread. No thread may allocate during or after the call.
+		static TYR_CORE_EXPORT void DestroyAll();
+
 	private:
-		static TYR_THREADLOCAL class ScratchAllocator* s_Allocator;
+		static FrameThreadAllocators* GetThreadAllocators();
+
+		static TYR_THREADLOCAL FrameThreadAllocators* s_ThreadAllocators;
 	};
 
 	inline void* FrameAlloc(uint count)
@@ -171,7 +196,9 @@ namespace tyr
 		}
 	};
 
-	template <typename T, typename A>
+	/// An array allocated with the frame allocator. Clear() keeps the storage, so an array reused in a later frame must
+	/// be reassigned rather than cleared once the frame generation that allocated it is recycled.
+	template <typename T>
 	using FrameArray = Array<T, FrameAllocator>;
 }
 
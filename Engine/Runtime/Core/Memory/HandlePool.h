@@ -0,0 +1,275 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Allocation.h"
+#include "Threading/Threading.h"
+
+namespace tyr
+{
+    /// Growable object pool addressed by 32-bit generational handles.
+    ///
+    /// - A handle packs a slot index in the low c_IndexBits and the slot's generation in the rest. The generation is
+    ///   bumped every time a slot is freed, so a stale handle no longer matches the slot. Debug builds assert on stale
+    ///   handles and IsValid() can check one in any build.
+    /// - Slots live in fixed-size chunks that are allocated as the pool grows and never move, so object addresses are
+    ///   stable and growth never copies.
+    /// - Create and delete are O(1) using a free list threaded through the freed slots.
+    /// - With ThreadSafe set, create and delete can be called from any thread. The free list is then a lock-free stack
+    ///   with a tagged head and only allocating a new chunk takes a lock.
+    template<class T, bool ThreadSafe = false, uint ChunkSize = 1024>
+    class HandlePool final
+    {
+    public:
+        static constexpr uint c_IndexBits = 20;
+        static constexpr uint c_IndexMask = (1u << c_IndexBits) - 1;
+        static constexpr uint c_GenerationMask = ~0u >> c_IndexBits;
+        static constexpr uint c_InvalidHandle = ~0u;
+        // The last index is never used so that no valid handle equals c_InvalidHandle
+        static constexpr uint c_MaxObjects = c_IndexMask;
+
+        HandlePool()
+            : m_ChunkCount(0)
+            , m_NextIndex(0)
+            , m_ObjectCount(0)
+            , m_FreeHead(PackFreeHead(c_InvalidIndex, 0))
+        {
+            TYR_STATIC_ASSERT(((ChunkSize & (ChunkSize - 1)) == 0), "ChunkSize must be a power of 2");
+            for (uint i = 0; i < c_MaxChunks; ++i)
+            {
+                m_Chunks[i] = nullptr;
+            }
+        }
+
+        ~HandlePool()
+        {
+            TYR_ASSERT(GetObjectCount() == 0);
+            const uint chunkCount = m_ChunkCount.load(std::memory_order_relaxed);
+            for (uint i = 0; i < chunkCount; ++i)
+            {
+                FreeAligned(m_Chunks[i]);
+            }
+        }
+
+        /// Creates an object and writes its handle to handle.
+        template<class... Args>
+        T* Create(uint& handle, Args&&... args)
+        {
+            uint index = PopFreeIndex();
+            if (index == c_InvalidIndex)
+            {
+                index = m_NextIndex.fetch_add(1, std::memory_order_relaxed);
+                TYR_ASSERT(index < c_MaxObjects);
+                EnsureChunk(index / ChunkSize);
+            }
+
+            Slot& slot = GetSlot(index);
+            T* object = reinterpret_cast<T*>(slot.storage);
+            new (object) T(std::forward<Args>(args)...);
+            slot.nextFree.store(c_InUse, std::memory_order_relaxed);
+            m_ObjectCount.fetch_add(1, std::memory_order_relaxed);
+
+            handle = (slot.generation.load(std::memory_order_relaxed) << c_IndexBits) | index;
+            return object;
+        }
+
+        void Delete(uint handle)
+        {
+            TYR_ASSERT(IsValid(handle));
+            const uint index = handle & c_IndexMask;
+            Slot& slot = GetSlot(index);
+            reinterpret_cast<T*>(slot.storage)->~T();
+            slot.generation.store((slot.generation.load(std::memory_order_relaxed) + 1) & c_GenerationMask, std::memory_order_relaxed);
+            m_ObjectCount.fetch_sub(1, std::memory_order_relaxed);
+            PushFreeIndex(index);
+        }
+
+        void Delete(T* object)
+        {
+            Delete(GetHandle(object));
+        }
+
+        /// Returns the handle of an object created by the pool.
+        uint GetHandle(const T* object) const
+        {
+            TYR_ASSERT(object != nullptr);
+            // The storage is the first member so the object and slot addresses are the same
+            const Slot* slot = reinterpret_cast<const Slot*>(object);
+            return (slot->generation.load(std::memory_order_relaxed) << c_IndexBits) | slot->index;
+        }
+
+        /// Returns true if the handle refers to a live object.
+        bool IsValid(uint handle) const
+        {
+            const uint index = handle & c_IndexMask;
+            if (handle == c_InvalidHandle || index >= GetCapacity())
+            {
+                return false;
+            }
+            const Slot& slot = GetSlot(index);
+            return slot.generation.load(std::memory_order_relaxed) == (handle >> c_IndexBits)
+                && slot.nextFree.load(std::memory_order_relaxed) == c_InUse;
+        }
+
+        const T* GetObject(uint handle) const
+        {
+            return &GetObjectRef(handle);
+        }
+
+        T* GetObject(uint handle)
+        {
+            return &GetObjectRef(handle);
+        }
+
+        const T& GetObjectRef(uint handle) const
+        {
+            TYR_ASSERT(IsValid(handle));
+            return *reinterpret_cast<const T*>(GetSlot(handle & c_IndexMask).storage);
+        }
+
+        T& GetObjectRef(uint handle)
+        {
+            TYR_ASSERT(IsValid(handle));
+            return *reinterpret_cast<T*>(GetSlot(handle & c_IndexMask).storage);
+        }
+
+        uint GetObjectCount() const
+        {
+            return m_ObjectCount.load(std::memory_order_relaxed);
+        }
+
+        /// Returns the number of slots allocated across all chunks.
+        uint GetCapacity() const
+        {
+            return m_ChunkCount.load(std::memory_order_relaxed) * ChunkSize;
+        }
+
+    private:
+        static constexpr uint c_MaxChunks = (c_MaxObjects + ChunkSize - 1) / ChunkSize;
+        static constexpr uint c_InvalidIndex = ~0u;
+        // Marks a slot that holds a live object
+        static constexpr uint c_InUse = ~0u - 1;
+        // Marks a slot that has never held an object
+        static constexpr uint c_Unused = ~0u - 2;
+
+        struct Slot
+        {
+            alignas(T) uint8 storage[sizeof(T)];
+            uint index;
+            // Index of the next free slot, c_InUse or c_Unused
+            Atomic<uint> nextFree;
+            Atomic<uint> generation;
+        };
+
+        static uint64 PackFreeHead(uint index, uint tag)
+        {
+            return (static_cast<uint64>(tag) << 32) | index;
+        }
+
+        Slot& GetSlot(uint index) const
+        {
+            return m_Chunks[index / ChunkSize][index & (ChunkSize - 1)];
+        }
+
+        void EnsureChunk(uint chunkIndex)
+        {
+            if (chunkIndex < m_ChunkCount.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            if constexpr (ThreadSafe)
+            {
+                LockGuard guard(m_ChunkMutex);
+                AllocateChunks(chunkIndex);
+            }
+            else
+            {
+                AllocateChunks(chunkIndex);
+            }
+        }
+
+        void AllocateChunks(uint chunkIndex)
+        {
+            uint chunkCount = m_ChunkCount.load(std::memory_order_relaxed);
+            while (chunkCount <= chunkIndex)
+            {
+                Slot* chunk = static_cast<Slot*>(AllocAligned(sizeof(Slot) * ChunkSize, std::max<size_t>(alignof(Slot), 16)));
+                for (uint i = 0; i < ChunkSize; ++i)
+                {
+                    Slot* slot = new (&chunk[i]) Slot();
+                    slot->index = chunkCount * ChunkSize + i;
+                    slot->nextFree.store(c_Unused, std::memory_order_relaxed);
+                    slot->generation.store(0, std::memory_order_relaxed);
+                }
+                m_Chunks[chunkCount] = chunk;
+                // Publish the chunk before the count so that other threads never see a null chunk
+                m_ChunkCount.store(++chunkCount, std::memory_order_release);
+            }
+        }
+
+        uint PopFreeIndex()
+        {
+            if constexpr (ThreadSafe)
+            {
+                uint64 head = m_FreeHead.load(std::memory_order_acquire);
+                while (true)
+                {
+                    const uint index = static_cast<uint>(head);
+                    if (index == c_InvalidIndex)
+                    {
+                        return c_InvalidIndex;
+                    }
+                    const uint next = GetSlot(index).nextFree.load(std::memory_order_relaxed);
+                    // The tag changes on every push so a slot that was popped and pushed back in between fails the CAS
+                    const uint64 newHead = PackFreeHead(next, static_cast<uint>(head >> 32));
+                    if (m_FreeHead.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+                    {
+                        return index;
+                    }
+                }
+            }
+            else
+            {
+                const uint64 head = m_FreeHead.load(std::memory_order_relaxed);
+                const uint index = static_cast<uint>(head);
+                if (index != c_InvalidIndex)
+                {
+                    Slot& slot = GetSlot(index);
+                    m_FreeHead.store(PackFreeHead(slot.nextFree.load(std::memory_order_relaxed), 0), std::memory_order_relaxed);
+                }
+                return index;
+            }
+        }
+
+        void PushFreeIndex(uint index)
+        {
+            Slot& slot = GetSlot(index);
+            if constexpr (ThreadSafe)
+            {
+                uint64 head = m_FreeHead.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    slot.nextFree.store(static_cast<uint>(head), std::memory_order_relaxed);
+                    const uint64 newHead = PackFreeHead(index, static_cast<uint>(head >> 32) + 1);
+                    if (m_FreeHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                }
+            }
+            else
+            {
+                slot.nextFree.store(static_cast<uint>(m_FreeHead.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+                m_FreeHead.store(PackFreeHead(index, 0), std::memory_order_relaxed);
+            }
+        }
+
+        Slot* m_Chunks[c_MaxChunks];
+        Atomic<uint> m_ChunkCount;
+        Atomic<uint> m_NextIndex;
+        Atomic<uint> m_ObjectCount;
+        // Index of the first free slot in the low 32 bits and an ABA tag in the high 32 bits
+        Atomic<uint64> m_FreeHead;
+        Mutex m_ChunkMutex;
+    };
+}
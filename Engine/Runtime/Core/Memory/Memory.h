@@ -5,6 +5,7 @@
 #include "MemoryOverrides.h"
 #include "StackAllocation.h"
 #include "Memory/LocalObjectPool.h"
+#include "Memory/HandlePool.h"
 #include "Memory/ObjectPool.h"
 
 namespace tyr
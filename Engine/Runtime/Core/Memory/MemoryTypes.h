@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include "Base/Base.h"
 #include "Memory/Allocation.h"
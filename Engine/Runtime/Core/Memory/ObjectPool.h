@@ -1,94 +1,70 @@
 #pragma once
 
 #include "Base/Base.h"
-#include "Containers/Array.h"
-#include "Threading/Threading.h"
+#include "HandlePool.h"
 
 namespace tyr
 {
-    template<class T>
+    /// Object pool that grows on demand. Objects are referred to by generational handles from the underlying HandlePool.
+    template<class T, bool ThreadSafe = false>
     class ObjectPool final
     {
     public:
-        ObjectPool(uint16 maxObjects)
-            : m_MaxObjects(maxObjects)
+        ObjectPool() = default;
+
+        template<class ...Args>
+        T* Create(Args&&... args) 
         {
-            m_Pool = AllocN<T>(maxObjects);
-            m_FreeSpaces.Reserve(m_MaxObjects);
+            uint handle;
+            return m_Pool.Create(handle, std::forward<Args>(args)...);
         }
 
-        ~ObjectPool()
+        uint GetHandle(const T* object) const
         {
-            TYR_ASSERT(m_ObjectCount == 0);
-            Free(m_Pool);
+            return m_Pool.GetHandle(object);
         }
 
-        template<class ...Args>
-        T* Create(Args&&... args) 
+        bool IsValid(uint handle) const
         {
-            TYR_ASSERT(m_ObjectCount < m_MaxObjects);
-            uint16 index;
-            if (!m_FreeSpaces.IsEmpty()) 
-            {
-                index = m_FreeSpaces.Back();
-                m_FreeSpaces.PopBack();
-            }
-            else 
-            {
-                index = m_Pos++;
-            }
-            T* object = &m_Pool[index];
-            Construct<T>(object, std::forward<Args>(args)...);
-            m_ObjectCount++;
-            return object;
+            return m_Pool.IsValid(handle);
         }
 
-        uint16 GetIndex(const T* object) const
+        const T* GetObject(uint handle) const
         {
-            TYR_ASSERT(object != nullptr && m_ObjectCount > 0);
-            return object - m_Pool;
+            return m_Pool.GetObject(handle);
         }
 
-        const T* GetObject(uint16 index) const
+        T* GetObject(uint handle)
         {
-            return m_Pool[index];
+            return m_Pool.GetObject(handle);
         }
 
-        T* GetObject(uint16 index)
+        const T& GetObjectRef(uint handle) const
         {
-            return m_Pool[index];
+            return m_Pool.GetObjectRef(handle);
         }
 
-        const T& GetObjectRef(uint16 index) const
+        T& GetObjectRef(uint handle)
         {
-            return m_Pool[index];
+            return m_Pool.GetObjectRef(handle);
         }
 
-        T& GetObjectRef(uint16 index)
+        void Delete(T* object)
         {
-            return m_Pool[index];
+            m_Pool.Delete(object);
         }
 
-        void Delete(T* object)
+        void Delete(uint handle)
         {
-            TYR_ASSERT(object != nullptr && m_ObjectCount > 0);
-            const uint16 index = object - m_Pool;
-            m_FreeSpaces.Add(index);
-            object->~T();
-            m_ObjectCount--;
+            m_Pool.Delete(handle);
         }
 
-        void Delete(uint16 index)
+        uint GetObjectCount() const
         {
-            Delete(GetObject(index));
+            return m_Pool.GetObjectCount();
         }
 
     private:
-        T* m_Pool;
-        Array<uint16> m_FreeSpaces;
-        uint16 m_Pos = 0;
-        uint16 m_ObjectCount = 0;
-        const uint16 m_MaxObjects;
+        HandlePool<T, ThreadSafe> m_Pool;
     };
 }
-
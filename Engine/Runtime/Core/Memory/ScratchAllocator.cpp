@@ -5,12 +5,23 @@ namespace tyr
 	ScratchAllocator::ScratchAllocator(uint blockSize)
 		: m_MinBlockSize(blockSize)
 		, m_CurBlock(nullptr)
+		, m_Arena(nullptr)
 	{
 		TYR_ASSERT(blockSize > 0);
 	}
 
+	ScratchAllocator::ScratchAllocator(const VirtualArenaConfig& arenaConfig)
+		: m_MinBlockSize(0)
+		, m_CurBlock(nullptr)
+		, m_Arena(new VirtualArena(arenaConfig))
+	{
+
+	}
+
 	ScratchAllocator::~ScratchAllocator()
 	{
+		TYR_SAFE_DELETE(m_Arena);
+
 		const uint numBlocks = static_cast<uint>(m_Blocks.Size());
 		for (uint i = 0; i < numBlocks; ++i)
 		{
@@ -22,6 +33,11 @@ namespace tyr
 	{
 		TYR_ASSERT(amount != 0);
 
+		if (m_Arena)
+		{
+			return m_Arena->Alloc(amount);
+		}
+
 		uint freeMem = 0;
 		if (m_CurBlock)
 		{
@@ -38,6 +54,11 @@ namespace tyr
 
 	uint8* ScratchAllocator::AllocAligned(uint amount, uint alignment)
 	{
+		if (m_Arena)
+		{
+			return m_Arena->AllocAligned(amount, alignment);
+		}
+
 		uint freeMem = 0;
 		uint pos = 0;
 
@@ -98,6 +119,12 @@ namespace tyr
 
 	void ScratchAllocator::Reset()
 	{
+		if (m_Arena)
+		{
+			m_Arena->Reset();
+			return;
+		}
+
 		if (m_CurBlock)
 		{
 			const uint numBlocks = static_cast<uint>(m_Blocks.Size());
@@ -124,6 +151,11 @@ namespace tyr
 
 	uint ScratchAllocator::GetTotalSize() const
 	{
+		if (m_Arena)
+		{
+			return static_cast<uint>(m_Arena->GetCommittedSize());
+		}
+
 		uint totalSize = 0;
 		for (const Block* block : m_Blocks)
 		{
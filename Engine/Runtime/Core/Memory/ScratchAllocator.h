@@ -3,10 +3,12 @@
 #include "Allocation.h"
 #include "Utility/Utility.h"
 #include "Containers/Array.h"
+#include "VirtualArena.h"
 
 namespace tyr
 {
 	/// Allocates blocks of memory as required and all memory is freed at once. 
+	/// Can instead be backed by a virtual arena, which grows in place and keeps its pages between resets.
 	class TYR_CORE_EXPORT ScratchAllocator final
 	{
 	private:
@@ -43,6 +45,7 @@ namespace tyr
 
 	public:
 		ScratchAllocator(uint blockSize = 1024 * 1024);
+		ScratchAllocator(const VirtualArenaConfig& arenaConfig);
 		~ScratchAllocator();
 
 		/// Allocates memory of the size provided using 16 byte alignment.
@@ -53,6 +56,7 @@ namespace tyr
 		uint8* AllocAligned(uint amount, uint alignment);
 
 		/// Clears all allocations, combines all blocks into one and starts a new period from scratch.
+		/// In arena mode the arena is reset instead, which decommits pages above the last period's high-water mark.
 		void Reset();
 
 		uint GetTotalSize() const;
@@ -67,6 +71,8 @@ namespace tyr
 		uint m_MinBlockSize;
 		Array<Block*> m_Blocks;
 		Block* m_CurBlock;
+		// Only set in arena mode, in which case no blocks are used
+		VirtualArena* m_Arena;
 	};
 
 	template <uint N>
@@ -82,6 +88,15 @@ namespace tyr
 			}
 		}
 
+		ScratchAllocatorPool(const VirtualArenaConfig& arenaConfig)
+			: m_AllocatorIndex(0)
+		{
+			for (uint i = 0; i < N; ++i)
+			{
+				m_Allocators[i] = new ScratchAllocator(arenaConfig);
+			}
+		}
+
 		~ScratchAllocatorPool()
 		{
 			for (uint i = 0; i < N; ++i)
@@ -3,6 +3,7 @@
 
 #include "Allocation.h"
 #include "Utility/Utility.h"
+#include <utility>
 
 namespace tyr
 {
@@ -0,0 +1,98 @@
+#include "Memory/VirtualArena.h"
+#include "Platform/Platform.h"
+#include "Math/Math.h"
+
+namespace tyr
+{
+	static size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	VirtualArena::VirtualArena(const VirtualArenaConfig& config)
+		: m_Committed(0)
+		, m_Pos(0)
+		, m_HighWaterMark(0)
+		, m_UseHugePages(config.useHugePages)
+	{
+		const size_t pageSize = Platform::GetPageSize();
+		m_CommitGranularity = m_UseHugePages ? c_HugePageSize : std::max(pageSize, c_MinCommitSize);
+		m_Reserved = AlignUp(config.reserveSize, m_CommitGranularity);
+
+		// Over-reserve so that the base can be aligned to the huge page size
+		m_MappingSize = m_UseHugePages ? m_Reserved + c_HugePageSize : m_Reserved;
+		m_Mapping = Platform::ReserveVirtualMemory(m_MappingSize);
+		TYR_ASSERT(m_Mapping != nullptr);
+
+		m_Base = reinterpret_cast<uint8*>(AlignUp(reinterpret_cast<size_t>(m_Mapping), m_UseHugePages ? c_HugePageSize : pageSize));
+		if (m_UseHugePages)
+		{
+			Platform::AdviseHugePages(m_Base, m_Reserved);
+		}
+	}
+
+	VirtualArena::~VirtualArena()
+	{
+		if (m_Mapping)
+		{
+			Platform::ReleaseVirtualMemory(m_Mapping, m_MappingSize);
+		}
+	}
+
+	uint8* VirtualArena::Alloc(size_t amount)
+	{
+		return AllocAligned(amount, 16);
+	}
+
+	uint8* VirtualArena::AllocAligned(size_t amount, size_t alignment)
+	{
+		TYR_ASSERT(amount != 0);
+		TYR_ASSERT(Math::IsPowerOfTwo(static_cast<uint>(alignment)));
+
+		const size_t start = AlignUp(m_Pos, alignment);
+		const size_t end = start + amount;
+		if (end > m_Committed && !Commit(end))
+		{
+			return nullptr;
+		}
+
+		m_Pos = end;
+		if (m_Pos > m_HighWaterMark)
+		{
+			m_HighWaterMark = m_Pos;
+		}
+		return m_Base + start;
+	}
+
+	bool VirtualArena::Commit(size_t requiredSize)
+	{
+		if (requiredSize > m_Reserved)
+		{
+			TYR_ASSERT(false);
+			return false;
+		}
+
+		const size_t newCommitted = std::min(AlignUp(requiredSize, m_CommitGranularity), m_Reserved);
+		if (!Platform::CommitVirtualMemory(m_Base + m_Committed, newCommitted - m_Committed))
+		{
+			TYR_ASSERT(false);
+			return false;
+		}
+		m_Committed = newCommitted;
+		return true;
+	}
+
+	void VirtualArena::Reset()
+	{
+		// Keep what the last period needed so the next one doesn't fault the same pages in again
+		const size_t keep = AlignUp(m_HighWaterMark, m_CommitGranularity);
+		if (m_Committed > keep)
+		{
+			Platform::DecommitVirtualMemory(m_Base + keep, m_Committed - keep);
+			m_Committed = keep;
+		}
+
+		m_Pos = 0;
+		m_HighWaterMark = 0;
+	}
+}
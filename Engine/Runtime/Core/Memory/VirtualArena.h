@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Allocation.h"
+#include "Base/INonCopyable.h"
+
+namespace tyr
+{
+	struct VirtualArenaConfig
+	{
+		// Address space reserved up front. Only the part that is used gets backed by memory.
+		size_t reserveSize = 1024ull * 1024ull * 1024ull;
+		// Requests transparent huge pages for the range where the OS supports it
+		bool useHugePages = false;
+	};
+
+	/// Linear allocator over a single reserved range of virtual memory.
+	/// Pages are committed on demand as the arena grows, so pointers are stable and growth never copies.
+	/// Reset() keeps the pages needed by the largest period since the previous reset and decommits the rest.
+	class TYR_CORE_EXPORT VirtualArena final : public INonCopyable
+	{
+	public:
+		static constexpr size_t c_HugePageSize = 2 * 1024 * 1024;
+		// Smallest amount committed at once to keep the number of commit calls down
+		static constexpr size_t c_MinCommitSize = 64 * 1024;
+
+		VirtualArena(const VirtualArenaConfig& config = VirtualArenaConfig());
+		~VirtualArena();
+
+		/// Allocates memory of the size provided using 16 byte alignment.
+		uint8* Alloc(size_t amount);
+
+		/// Allocates memory of the size provided with the specified alignment as the boundary.
+		/// @note The alignment must be a power of 2
+		uint8* AllocAligned(size_t amount, size_t alignment);
+
+		/// Clears all allocations and decommits pages above the high-water mark of the period that just ended.
+		void Reset();
+
+		size_t GetUsedSize() const { return m_Pos; }
+		size_t GetCommittedSize() const { return m_Committed; }
+		size_t GetReservedSize() const { return m_Reserved; }
+		size_t GetHighWaterMark() const { return m_HighWaterMark; }
+
+	private:
+		bool Commit(size_t requiredSize);
+
+		// Start of the mapping as returned by the OS, which can be before m_Base when it was aligned for huge pages
+		void* m_Mapping;
+		size_t m_MappingSize;
+		uint8* m_Base;
+		size_t m_Reserved;
+		size_t m_Committed;
+		size_t m_Pos;
+		size_t m_HighWaterMark;
+		size_t m_CommitGranularity;
+		bool m_UseHugePages;
+	};
+}
@@ -2,6 +2,7 @@
 
 #include "ModuleManager.h"
 #include "IModule.h"
+#include "Profiling/Profiler.h"
 
 namespace tyr
 {
@@ -50,6 +51,7 @@ namespace tyr
 
     void ModuleManager::UpdateModules(float deltaTime)
     {
+        TYR_PROFILE_SCOPE("ModuleManager::UpdateModules");
         TYR_ASSERT(m_ModulesInitialized);
 
         for (IModule* module : m_Modules)
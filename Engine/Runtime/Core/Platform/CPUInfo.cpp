@@ -0,0 +1,148 @@
+#include "CPUInfo.h"
+
+#if TYR_ARCH_TYPE == TYR_ARCHITECTURE_x86_64 || TYR_ARCH_TYPE == TYR_ARCHITECTURE_x86_32
+#if TYR_COMPILER == TYR_COMPILER_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace tyr
+{
+	namespace
+	{
+#if TYR_ARCH_TYPE == TYR_ARCHITECTURE_x86_64 || TYR_ARCH_TYPE == TYR_ARCHITECTURE_x86_32
+		struct CPUIDResult
+		{
+			uint eax, ebx, ecx, edx;
+		};
+
+		CPUIDResult CPUID(uint leaf, uint subleaf)
+		{
+			CPUIDResult result;
+#if TYR_COMPILER == TYR_COMPILER_MSVC
+			int registers[4];
+			__cpuidex(registers, static_cast<int>(leaf), static_cast<int>(subleaf));
+			result = { static_cast<uint>(registers[0]), static_cast<uint>(registers[1]), static_cast<uint>(registers[2]), static_cast<uint>(registers[3]) };
+#else
+			__cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+			return result;
+		}
+
+		// Returns the register states the OS saves (XCR0). Only valid if OSXSAVE is set.
+		uint64 GetEnabledRegisterStates()
+		{
+#if TYR_COMPILER == TYR_COMPILER_MSVC
+			return _xgetbv(0);
+#else
+			uint eax, edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (static_cast<uint64>(edx) << 32) | eax;
+#endif
+		}
+
+		bool HasBit(uint reg, uint bit)
+		{
+			return (reg & (1u << bit)) != 0;
+		}
+
+		CPUFeatures DetectFeatures()
+		{
+			CPUFeatures features;
+
+			const uint maxLeaf = CPUID(0, 0).eax;
+			const CPUIDResult leaf1 = CPUID(1, 0);
+			features.sse42 = HasBit(leaf1.ecx, 20);
+			features.popcnt = HasBit(leaf1.ecx, 23);
+
+			// XMM and YMM state for AVX, plus opmask and ZMM state for AVX-512
+			constexpr uint64 avxStates = 0x6;
+			constexpr uint64 avx512States = 0xE6;
+			const uint64 states = HasBit(leaf1.ecx, 27) ? GetEnabledRegisterStates() : 0;
+			const bool osAVX = (states & avxStates) == avxStates;
+			const bool osAVX512 = (states & avx512States) == avx512States;
+
+			features.avx = osAVX && HasBit(leaf1.ecx, 28);
+			features.fma = features.avx && HasBit(leaf1.ecx, 12);
+
+			if (maxLeaf >= 7)
+			{
+				const CPUIDResult leaf7 = CPUID(7, 0);
+				features.avx2 = features.avx && HasBit(leaf7.ebx, 5);
+				features.bmi2 = HasBit(leaf7.ebx, 8);
+				features.avx512f = osAVX512 && HasBit(leaf7.ebx, 16);
+				features.avx512dq = features.avx512f && HasBit(leaf7.ebx, 17);
+				features.avx512bw = features.avx512f && HasBit(leaf7.ebx, 30);
+				features.avx512vl = features.avx512f && HasBit(leaf7.ebx, 31);
+			}
+
+			return features;
+		}
+#elif TYR_ARCH_TYPE == TYR_ARCHITECTURE_ARM64
+		CPUFeatures DetectFeatures()
+		{
+			// NEON is part of the ARMv8-A base
+			CPUFeatures features;
+			features.neon = true;
+			return features;
+		}
+#else
+		CPUFeatures DetectFeatures()
+		{
+			return CPUFeatures();
+		}
+#endif
+
+		SIMDLevel DetectSIMDLevel(const CPUFeatures& features)
+		{
+			if (features.neon)
+			{
+				return SIMDLevel::NEON;
+			}
+			if (features.avx512f && features.avx2)
+			{
+				return SIMDLevel::AVX512;
+			}
+			if (features.avx2)
+			{
+				return SIMDLevel::AVX2;
+			}
+			if (features.sse42)
+			{
+				return SIMDLevel::SSE42;
+			}
+			return SIMDLevel::Scalar;
+		}
+	}
+
+	const CPUFeatures& CPUInfo::GetFeatures()
+	{
+		static const CPUFeatures features = DetectFeatures();
+		return features;
+	}
+
+	SIMDLevel CPUInfo::GetSIMDLevel()
+	{
+		static const SIMDLevel level = DetectSIMDLevel(GetFeatures());
+		return level;
+	}
+
+	const char* CPUInfo::GetSIMDLevelName(SIMDLevel level)
+	{
+		switch (level)
+		{
+		case SIMDLevel::SSE42:
+			return "SSE4.2";
+		case SIMDLevel::AVX2:
+			return "AVX2";
+		case SIMDLevel::AVX512:
+			return "AVX-512";
+		case SIMDLevel::NEON:
+			return "NEON";
+		default:
+			return "Scalar";
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMacros.h"
+#include "Base/Base.h"
+
+namespace tyr
+{
+	/// Instruction set levels that SIMD code can be compiled for. x86 levels are ordered from least to most capable.
+	enum class SIMDLevel : uint8
+	{
+		Scalar,
+		SSE42,
+		AVX2,
+		AVX512,
+		NEON
+	};
+
+	struct CPUFeatures
+	{
+		bool sse42 = false;
+		bool popcnt = false;
+		bool avx = false;
+		bool avx2 = false;
+		bool fma = false;
+		bool bmi2 = false;
+		bool avx512f = false;
+		bool avx512dq = false;
+		bool avx512bw = false;
+		bool avx512vl = false;
+		bool neon = false;
+	};
+
+	class TYR_CORE_EXPORT CPUInfo
+	{
+	public:
+		/// Returns the instruction sets of the CPU. They are detected on the first call.
+		/// @note	AVX and AVX-512 are only reported if the OS also saves their registers on context switches.
+		static const CPUFeatures& GetFeatures();
+
+		/// Returns the widest instruction set level supported by the CPU.
+		static SIMDLevel GetSIMDLevel();
+
+		static const char* GetSIMDLevelName(SIMDLevel level);
+	};
+}
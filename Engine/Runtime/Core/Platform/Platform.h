@@ -42,12 +42,32 @@ namespace tyr
 		/// Returns true if the application has an attached debugger. 
 		static bool IsDebuggerAttached();
 
+		/// Returns the width in pixels of the primary screen, or 0 if there is no display to query.
 		static int GetScreenWidth();
 
+		/// Returns the height in pixels of the primary screen, or 0 if there is no display to query.
 		static int GetScreenHeight();
 
 		static uint64 GetCpuCycles();
 
+		/// Returns the size of a virtual memory page in bytes.
+		static size_t GetPageSize();
+
+		/// Reserves a range of address space without backing it with memory. Returns nullptr on failure.
+		static void* ReserveVirtualMemory(size_t size);
+
+		/// Backs a page aligned part of a reserved range with read/write memory.
+		static bool CommitVirtualMemory(void* address, size_t size);
+
+		/// Returns the memory of a page aligned part of a reserved range to the OS but keeps the range reserved.
+		static void DecommitVirtualMemory(void* address, size_t size);
+
+		/// Releases a range returned by ReserveVirtualMemory().
+		static void ReleaseVirtualMemory(void* address, size_t size);
+
+		/// Hints that a reserved range should be backed by huge pages. Does nothing where that isn't supported.
+		static void AdviseHugePages(void* address, size_t size);
+
 		static FileHandle OpenOrCreateFile(const char* filename, FileAccess access, FileCreationMode creationMode);
 
 		static size_t GetSizeOfFile(FileHandle handle);
@@ -0,0 +1,288 @@
+#include "Profiler.h"
+
+#if TYR_PROFILER
+
+#include "IO/FileStream.h"
+#include "String/StringTypes.h"
+#include "Threading/Threading.h"
+#include <chrono>
+#include <cstdio>
+
+namespace tyr
+{
+	struct ProfilerThreadBuffer
+	{
+		struct Record
+		{
+			uint64 timestamp;
+			// Null for end records
+			const char* name;
+		};
+
+		static constexpr uint64 c_Mask = Profiler::c_ThreadBufferCapacity - 1;
+
+		// Written by the owning thread and read by the collector
+		alignas(c_CacheLineSize) Atomic<uint64> head = 0;
+		// Written by the collector and read by the owning thread
+		alignas(c_CacheLineSize) Atomic<uint64> tail = 0;
+
+		// Only accessed by the owning thread
+		alignas(c_CacheLineSize) uint depth = 0;
+		// Number of begin records written whose end record has not been written yet
+		uint openCount = 0;
+		static_assert(Profiler::c_MaxZoneDepth <= 64, "The dropped mask has a bit per depth");
+		// Bit n is set if the zone at depth n was dropped
+		uint64 droppedMask = 0;
+
+		Atomic<uint64> droppedCount = 0;
+		uint threadID = 0;
+		char name[32] = {};
+		Record records[Profiler::c_ThreadBufferCapacity];
+	};
+
+	namespace
+	{
+		Mutex s_RegistryMutex;
+		Array<ProfilerThreadBuffer*> s_Registry;
+		Array<ProfileEvent> s_CapturedEvents;
+		bool s_Capturing = false;
+
+		// Reference points used to convert timestamps to microseconds
+		const uint64 s_StartTimestamp = Profiler::ReadTimestamp();
+		const std::chrono::steady_clock::time_point s_StartTime = std::chrono::steady_clock::now();
+
+		// The tick rate is measured against the steady clock over the whole run so it gets more accurate over time
+		double GetTicksPerMicrosecond()
+		{
+			const uint64 now = Profiler::ReadTimestamp();
+			const double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - s_StartTime).count();
+			return elapsedUs > 0.0 ? static_cast<double>(now - s_StartTimestamp) / elapsedUs : 1.0;
+		}
+
+		double ToMicroseconds(uint64 timestamp, double ticksPerUs)
+		{
+			return static_cast<double>(static_cast<int64>(timestamp - s_StartTimestamp)) / ticksPerUs;
+		}
+
+		void AppendEscaped(String& json, const char* str)
+		{
+			for (const char* c = str; *c != '\0'; ++c)
+			{
+				if (*c == '"' || *c == '\\')
+				{
+					json += '\\';
+				}
+				json += *c;
+			}
+		}
+	}
+
+	TYR_THREADLOCAL ProfilerThreadBuffer* Profiler::s_ThreadBuffer = nullptr;
+
+	ProfilerThreadBuffer* Profiler::GetThreadBuffer()
+	{
+		if (s_ThreadBuffer == nullptr)
+		{
+			ProfilerThreadBuffer* buffer = new ProfilerThreadBuffer();
+
+			LockGuard guard(s_RegistryMutex);
+			buffer->threadID = s_Registry.Size();
+			std::snprintf(buffer->name, sizeof(buffer->name), "Thread %u", buffer->threadID);
+			s_Registry.Add(buffer);
+			s_ThreadBuffer = buffer;
+		}
+		return s_ThreadBuffer;
+	}
+
+	void Profiler::BeginZone(const char* name)
+	{
+		ProfilerThreadBuffer* buffer = GetThreadBuffer();
+		const uint depth = buffer->depth++;
+		TYR_ASSERT(depth < c_MaxZoneDepth);
+		// Zones nested deeper than the dropped mask can track are always dropped so their ends stay balanced
+		if (depth >= c_MaxZoneDepth)
+		{
+			buffer->droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		const uint64 head = buffer->head.load(std::memory_order_relaxed);
+		const uint64 used = head - buffer->tail.load(std::memory_order_acquire);
+		// Leave room for the end records of every open zone so that end records are never dropped
+		if (used + buffer->openCount + 2 > c_ThreadBufferCapacity)
+		{
+			buffer->droppedMask |= 1ull << depth;
+			buffer->droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		buffer->records[head & ProfilerThreadBuffer::c_Mask] = { ReadTimestamp(), name };
+		buffer->head.store(head + 1, std::memory_order_release);
+		buffer->openCount++;
+	}
+
+	void Profiler::EndZone()
+	{
+		const uint64 timestamp = ReadTimestamp();
+		ProfilerThreadBuffer* buffer = s_ThreadBuffer;
+		TYR_ASSERT(buffer != nullptr && buffer->depth > 0);
+		const uint depth = --buffer->depth;
+		if (depth >= c_MaxZoneDepth)
+		{
+			return;
+		}
+
+		const uint64 depthBit = 1ull << depth;
+		if (buffer->droppedMask & depthBit)
+		{
+			buffer->droppedMask &= ~depthBit;
+			return;
+		}
+
+		const uint64 head = buffer->head.load(std::memory_order_relaxed);
+		buffer->records[head & ProfilerThreadBuffer::c_Mask] = { timestamp, nullptr };
+		buffer->head.store(head + 1, std::memory_order_release);
+		buffer->openCount--;
+	}
+
+	void Profiler::SetThreadName(const char* name)
+	{
+		ProfilerThreadBuffer* buffer = GetThreadBuffer();
+		LockGuard guard(s_RegistryMutex);
+		std::snprintf(buffer->name, sizeof(buffer->name), "%s", name);
+	}
+
+	void Profiler::EndFrame()
+	{
+		TYR_PROFILE_SCOPE("Profiler::EndFrame");
+
+		LockGuard guard(s_RegistryMutex);
+		for (ProfilerThreadBuffer* buffer : s_Registry)
+		{
+			const uint64 head = buffer->head.load(std::memory_order_acquire);
+			const uint64 tail = buffer->tail.load(std::memory_order_relaxed);
+			if (s_Capturing)
+			{
+				s_CapturedEvents.Reserve(s_CapturedEvents.Size() + static_cast<uint>(head - tail));
+				for (uint64 i = tail; i < head; ++i)
+				{
+					const ProfilerThreadBuffer::Record& record = buffer->records[i & ProfilerThreadBuffer::c_Mask];
+					ProfileEvent event;
+					event.timestamp = record.timestamp;
+					event.name = record.name;
+					event.threadID = buffer->threadID;
+					event.type = record.name ? ProfileEventType::Begin : ProfileEventType::End;
+					s_CapturedEvents.Add(event);
+				}
+			}
+			buffer->tail.store(head, std::memory_order_release);
+		}
+	}
+
+	void Profiler::BeginCapture()
+	{
+		LockGuard guard(s_RegistryMutex);
+		s_Capturing = true;
+	}
+
+	void Profiler::EndCapture()
+	{
+		LockGuard guard(s_RegistryMutex);
+		s_Capturing = false;
+	}
+
+	bool Profiler::IsCapturing()
+	{
+		LockGuard guard(s_RegistryMutex);
+		return s_Capturing;
+	}
+
+	void Profiler::ClearCapture()
+	{
+		LockGuard guard(s_RegistryMutex);
+		s_CapturedEvents.Clear();
+	}
+
+	const Array<ProfileEvent>& Profiler::GetCapturedEvents()
+	{
+		return s_CapturedEvents;
+	}
+
+	bool Profiler::WriteChromeTrace(const char* filePath)
+	{
+		String json;
+		json.reserve(64 + s_CapturedEvents.Size() * 64);
+		json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		const double ticksPerUs = GetTicksPerMicrosecond();
+		char buffer[128];
+		bool first = true;
+		{
+			LockGuard guard(s_RegistryMutex);
+			for (const ProfilerThreadBuffer* threadBuffer : s_Registry)
+			{
+				std::snprintf(buffer, sizeof(buffer), "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"",
+					first ? "" : ",", threadBuffer->threadID);
+				json += buffer;
+				AppendEscaped(json, threadBuffer->name);
+				json += "\"}}";
+				first = false;
+			}
+		}
+
+		for (const ProfileEvent& event : s_CapturedEvents)
+		{
+			const double time = ToMicroseconds(event.timestamp, ticksPerUs);
+			if (event.type == ProfileEventType::Begin)
+			{
+				std::snprintf(buffer, sizeof(buffer), "%s{\"ph\":\"B\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"name\":\"",
+					first ? "" : ",", event.threadID, time);
+				json += buffer;
+				AppendEscaped(json, event.name);
+				json += "\"}";
+			}
+			else
+			{
+				std::snprintf(buffer, sizeof(buffer), "%s{\"ph\":\"E\",\"pid\":0,\"tid\":%u,\"ts\":%.3f}",
+					first ? "" : ",", event.threadID, time);
+				json += buffer;
+			}
+			first = false;
+		}
+		json += "]}";
+
+		FileStream stream(filePath, BinaryStream::Operation::Write);
+		return stream.Write(json.data(), json.size()) == json.size();
+	}
+
+	uint64 Profiler::GetDroppedZoneCount()
+	{
+		LockGuard guard(s_RegistryMutex);
+		uint64 count = 0;
+		for (const ProfilerThreadBuffer* buffer : s_Registry)
+		{
+			count += buffer->droppedCount.load(std::memory_order_relaxed);
+		}
+		return count;
+	}
+
+	double Profiler::TimestampToMicroseconds(uint64 timestamp)
+	{
+		return ToMicroseconds(timestamp, GetTicksPerMicrosecond());
+	}
+
+	void Profiler::Shutdown()
+	{
+		LockGuard guard(s_RegistryMutex);
+		for (ProfilerThreadBuffer* buffer : s_Registry)
+		{
+			delete buffer;
+		}
+		s_Registry.Clear();
+		s_CapturedEvents.Clear();
+		s_Capturing = false;
+		s_ThreadBuffer = nullptr;
+	}
+}
+
+#endif
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Containers/Array.h"
+
+#ifndef TYR_PROFILER
+#	define TYR_PROFILER 0
+#endif
+
+#if TYR_PROFILER
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#	include <x86intrin.h>
+#else
+#	include <chrono>
+#endif
+
+namespace tyr
+{
+	enum class ProfileEventType : uint8
+	{
+		Begin,
+		End
+	};
+
+	/// A zone begin or end event gathered from a thread's buffer.
+	struct ProfileEvent
+	{
+		uint64 timestamp;
+		// Null for end events
+		const char* name;
+		uint threadID;
+		ProfileEventType type;
+	};
+
+	struct ProfilerThreadBuffer;
+
+	/// Hierarchical CPU profiler.
+	///
+	/// Zones write begin and end events with a TSC timestamp into a lock-free buffer owned by the calling thread.
+	/// EndFrame() drains every thread's buffer and keeps the events while a capture is running.
+	/// A capture can be written as a Chrome trace that Chrome's about://tracing or Perfetto can open.
+	class TYR_CORE_EXPORT Profiler final
+	{
+	public:
+		/// Maximum number of events a thread can buffer between calls to EndFrame(). Further zones are dropped.
+		static constexpr uint c_ThreadBufferCapacity = 1 << 16;
+		/// Maximum zone nesting depth per thread. Deeper zones are dropped.
+		static constexpr uint c_MaxZoneDepth = 64;
+
+		/// Zone names must outlive the capture, normally they are string literals.
+		static void BeginZone(const char* name);
+
+		static void EndZone();
+
+		/// Sets the name shown for the calling thread in the trace.
+		static void SetThreadName(const char* name);
+
+		/// Collects the events of all threads. Called once per frame by the engine.
+		static void EndFrame();
+
+		static void BeginCapture();
+
+		static void EndCapture();
+
+		static bool IsCapturing();
+
+		static void ClearCapture();
+
+		static const Array<ProfileEvent>& GetCapturedEvents();
+
+		/// Writes the captured events to a file in the Chrome trace event JSON format.
+		static bool WriteChromeTrace(const char* filePath);
+
+		/// Number of zones dropped because a thread's buffer was full.
+		static uint64 GetDroppedZoneCount();
+
+		/// Converts a timestamp to microseconds since the profiler started.
+		static double TimestampToMicroseconds(uint64 timestamp);
+
+		/// Frees the thread buffers. Threads must not record zones afterwards.
+		static void Shutdown();
+
+		static TYR_FORCEINLINE uint64 ReadTimestamp()
+		{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+#elif defined(__aarch64__)
+			uint64 value;
+			asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+			return value;
+#else
+			return static_cast<uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+		}
+
+	private:
+		static ProfilerThreadBuffer* GetThreadBuffer();
+
+		static TYR_THREADLOCAL ProfilerThreadBuffer* s_ThreadBuffer;
+	};
+
+	/// Records a zone for the lifetime of the object.
+	class ProfileScope final
+	{
+	public:
+		ProfileScope(const char* name)
+		{
+			Profiler::BeginZone(name);
+		}
+
+		~ProfileScope()
+		{
+			Profiler::EndZone();
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+	};
+}
+
+#define TYR_PROFILE_CONCAT_INNER(a, b) a##b
+#define TYR_PROFILE_CONCAT(a, b) TYR_PROFILE_CONCAT_INNER(a, b)
+#define TYR_PROFILE_SCOPE(name) ::tyr::ProfileScope TYR_PROFILE_CONCAT(tyrProfileScope, __LINE__)(name)
+#define TYR_PROFILE_FUNCTION() TYR_PROFILE_SCOPE(__FUNCTION__)
+#define TYR_PROFILE_THREAD_NAME(name) ::tyr::Profiler::SetThreadName(name)
+#define TYR_PROFILE_END_FRAME() ::tyr::Profiler::EndFrame()
+#define TYR_PROFILE_SHUTDOWN() ::tyr::Profiler::Shutdown()
+
+#else
+
+#define TYR_PROFILE_SCOPE(name)
+#define TYR_PROFILE_FUNCTION()
+#define TYR_PROFILE_THREAD_NAME(name)
+#define TYR_PROFILE_END_FRAME()
+#define TYR_PROFILE_SHUTDOWN()
+
+#endif
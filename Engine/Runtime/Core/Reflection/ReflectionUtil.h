@@ -152,7 +152,7 @@ namespace tyr
 
 #elif defined(__GNUC__) || defined(__clang__)  // GCC & Clang use __PRETTY_FUNCTION__
         constexpr StringView sig = __PRETTY_FUNCTION__;
-        constexpr StringView key = "Type = ";
+        constexpr StringView key = "T = ";
 
         size_t start = sig.find(key);
         if (start == StringView::npos)
@@ -224,7 +224,7 @@ namespace tyr
     template<typename Class, typename FieldType>
     constexpr size_t GetFieldOffset(FieldType Class::* fieldPtr)
     {
-        return reinterpret_cast<size_t>(&(reinterpret_cast<Class*>(nullptr)->*fieldPtr));
+        return reinterpret_cast<size_t>(&(static_cast<Class*>(nullptr)->*fieldPtr));
     }
 }
 
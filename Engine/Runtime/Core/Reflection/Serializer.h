@@ -4,6 +4,7 @@
 #include "ReflectionUtil.h"
 #include "TypeRegistry.h"
 #include "IO/BufferedFileStream.h"
+#include "Profiling/Profiler.h"
 
 namespace tyr
 {
@@ -160,9 +161,9 @@ namespace tyr
             {
                 using ElementType = typename CArrayTraits<T>::elementType;
                 const Id64 typeID = GetTypeID<ElementType>();
-                const uint count = static_cast<uint>(CArrayTraits<T>::c_Capacity);
                 const TypeInfo& typeInfo = TypeRegistry::Instance().GetType(typeID);
-                DeserializeCArray(stream, reinterpret_cast<uint8*>(&data), count, typeInfo);
+                // The element count is read from the stream
+                DeserializeCArray(stream, reinterpret_cast<uint8*>(&data), typeInfo);
             }
             else if constexpr (std::is_class<T>::value)
             {
@@ -179,6 +180,7 @@ namespace tyr
         template <typename T>
         void SerializeToFile(const char* filePath, const T& data, bool overwrite = true)
         {
+            TYR_PROFILE_SCOPE("Serializer::SerializeToFile");
             BufferedFileStream stream(m_Buffer, c_BufferSize, filePath, BinaryStream::Operation::Write, overwrite);
             Serialize<T>(stream, data);
         }
@@ -186,6 +188,7 @@ namespace tyr
         template <typename T>
         void DeserializeFromFile(const char* filePath, T& data)
         {
+            TYR_PROFILE_SCOPE("Serializer::DeserializeFromFile");
             BufferedFileStream stream(m_Buffer, c_BufferSize, filePath, BinaryStream::Operation::Read);
             Deserialize<T>(stream, data);
         }
@@ -1,6 +1,8 @@
 #pragma once
 
-#include "Base/base.h"
+#include "Base/Base.h"
+#include <charconv>
+#include <cstring>
 
 namespace tyr
 {
@@ -15,7 +17,7 @@ namespace tyr
 		{
 			m_TotalSize = strlen(data) + 1;
 			TYR_ASSERT(m_TotalSize <= c_Capacity);
-			strcpy_s(m_Data, m_TotalSize, data);
+			memcpy(m_Data, data, m_TotalSize);
 		}
 
 		void Copy(const char* data, size_t size)
@@ -80,7 +82,10 @@ namespace tyr
 
 		LocalString& operator+=(const LocalString& other)
 		{
-			strcpy_s(&m_Data[m_TotalSize - 1], c_Capacity, other.m_Data);
+			const size_t size = m_TotalSize + other.m_TotalSize - 1;
+			TYR_ASSERT(size <= c_Capacity);
+			memcpy(&m_Data[m_TotalSize - 1], other.m_Data, other.m_TotalSize);
+			m_TotalSize = size;
 			return *this;
 		}
 
@@ -104,8 +109,8 @@ namespace tyr
 			const uint size = lhs.m_TotalSize + rhs.m_TotalSize - 1;
 			TYR_ASSERT(size <= c_Capacity);
 			LocalString str;
-			strcpy_s(str.m_Data, str.c_Capacity, lhs.m_Data);
-			strcpy_s(&str.m_Data[lhs.m_TotalSize - 1], str.c_Capacity - lhs.c_Capacity, rhs.m_Data);
+			memcpy(str.m_Data, lhs.m_Data, lhs.m_TotalSize);
+			memcpy(&str.m_Data[lhs.m_TotalSize - 1], rhs.m_Data, rhs.m_TotalSize);
 			str.m_TotalSize = size;
 			return str;
 		}
@@ -114,7 +119,7 @@ namespace tyr
 		{
 			const uint lhsSize = lhs.m_TotalSize - 1;
 			LocalString str;
-			strcpy_s(str.m_Data, str.c_Capacity, lhs.m_Data);
+			memcpy(str.m_Data, lhs.m_Data, lhs.m_TotalSize);
 			char* first = str.m_Data + lhsSize;
 			const auto result = std::to_chars(first, str.m_Data + str.c_Capacity, rhs);
 			TYR_ASSERT(result.ec == std::errc());
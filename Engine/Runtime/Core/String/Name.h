@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Base/base.h"
+#include "Base/Base.h"
 #include "LocalString.h"
 
 namespace tyr
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "StringTypes.h"
+#include <memory>
 
 namespace tyr
 {
@@ -16,7 +17,7 @@ namespace tyr
 				return "";
 			}
 			const size_t size = static_cast<size_t>(sizeS);
-			char* buf = std::make_unique<char[]>(size);
+			std::unique_ptr<char[]> buf = std::make_unique<char[]>(size);
 			std::snprintf(buf.get(), size, format.c_str(), args ...);
 			return String(buf.get(), buf.get() + size - 1); // We don't want the '\0' inside
 		}
@@ -0,0 +1,414 @@
+#include "JobSystem.h"
+#include "Math/Math.h"
+#include "Profiling/Profiler.h"
+#include <cstdio>
+
+namespace tyr
+{
+    // Number of failed attempts to find work before a worker goes to sleep
+    static constexpr uint c_SpinCount = 64;
+
+    TYR_THREADLOCAL uint JobSystem::s_WorkerIndex = JobSystem::c_InvalidWorkerIndex;
+
+    JobSystem& JobSystem::Instance()
+    {
+        static JobSystem jobSystem;
+        return jobSystem;
+    }
+
+    JobSystem::JobSystem()
+        : m_Workers(nullptr)
+        , m_WorkerCount(0)
+        , m_ExternalTaskPool(nullptr)
+        , m_ExternalTaskPoolIndex(0)
+        , m_QueuedCount(0)
+        , m_SleepingCount(0)
+        , m_Stop(false)
+        , m_Initialized(false)
+    {
+
+    }
+
+    JobSystem::~JobSystem()
+    {
+        if (m_Initialized)
+        {
+            Shutdown();
+        }
+    }
+
+    void JobSystem::Initialize(const JobSystemConfig& config)
+    {
+        TYR_ASSERT(!m_Initialized);
+
+        uint workerCount = config.workerCount;
+        if (workerCount == 0)
+        {
+            workerCount = static_cast<uint>(Thread::hardware_concurrency());
+        }
+        m_WorkerCount = Math::Clamp(workerCount, 1u, c_MaxWorkers);
+
+        m_Workers = new Worker[m_WorkerCount];
+        for (uint i = 0; i < m_WorkerCount; ++i)
+        {
+            m_Workers[i].taskPool = new Task[c_TaskPoolCapacity];
+            m_Workers[i].stealSeed = i * 0x9E3779B9u + 1u;
+        }
+        m_ExternalTaskPool = new Task[c_TaskPoolCapacity];
+
+        m_Stop.store(false, std::memory_order_relaxed);
+        m_Initialized = true;
+
+        // The initializing thread is worker 0
+        s_WorkerIndex = 0;
+        for (uint i = 1; i < m_WorkerCount; ++i)
+        {
+            m_Workers[i].thread = Thread(&JobSystem::WorkerMain, this, i);
+        }
+    }
+
+    void JobSystem::Shutdown()
+    {
+        TYR_ASSERT(m_Initialized);
+        TYR_ASSERT(GetCurrentWorkerIndex() == 0);
+
+        // Finish any outstanding work so that no task is left referencing freed memory
+        while (TryRunJob()) { }
+
+        {
+            LockGuard guard(m_SleepMutex);
+            m_Stop.store(true, std::memory_order_seq_cst);
+        }
+        m_SleepCV.notify_all();
+
+        for (uint i = 1; i < m_WorkerCount; ++i)
+        {
+            if (m_Workers[i].thread.joinable())
+            {
+                m_Workers[i].thread.join();
+            }
+        }
+
+        for (uint i = 0; i < m_WorkerCount; ++i)
+        {
+            delete[] m_Workers[i].taskPool;
+        }
+        delete[] m_Workers;
+        delete[] m_ExternalTaskPool;
+        m_Workers = nullptr;
+        m_ExternalTaskPool = nullptr;
+        m_WorkerCount = 0;
+        s_WorkerIndex = c_InvalidWorkerIndex;
+        m_Initialized = false;
+    }
+
+    uint JobSystem::GetCurrentWorkerIndex()
+    {
+        return s_WorkerIndex;
+    }
+
+    void JobSystem::Submit(Task* task, JobCounter* counter)
+    {
+        TYR_ASSERT(m_Initialized && task != nullptr);
+
+        const uint workerIndex = s_WorkerIndex;
+        if (counter)
+        {
+            counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+        }
+        Enqueue(task, counter, workerIndex);
+        WakeWorkers(1);
+    }
+
+    void JobSystem::Submit(Task* tasks, uint count, JobCounter* counter)
+    {
+        TYR_ASSERT(m_Initialized && tasks != nullptr);
+
+        const uint workerIndex = s_WorkerIndex;
+        if (counter)
+        {
+            counter->m_Count.fetch_add(count, std::memory_order_relaxed);
+        }
+        if (workerIndex != c_InvalidWorkerIndex)
+        {
+            for (uint i = 0; i < count; ++i)
+            {
+                Enqueue(&tasks[i], counter, workerIndex);
+            }
+        }
+        else
+        {
+            EnqueueExternalBatch(tasks, count, counter);
+        }
+        WakeWorkers(count);
+    }
+
+    void JobSystem::Submit(Callable&& callable, JobCounter* counter)
+    {
+        TYR_ASSERT(m_Initialized);
+
+        const uint workerIndex = s_WorkerIndex;
+        Task* task = AcquirePoolTask(workerIndex);
+        task->SetCallable(std::move(callable));
+        if (counter)
+        {
+            counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+        }
+        Enqueue(task, counter, workerIndex);
+        WakeWorkers(1);
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        TYR_ASSERT(m_Initialized);
+
+        while (!counter.IsDone())
+        {
+            if (!TryRunJob())
+            {
+                TYR_THREAD_YIELD
+            }
+        }
+    }
+
+    bool JobSystem::TryRunJob()
+    {
+        Task* task = FindTask(s_WorkerIndex);
+        if (task)
+        {
+            RunTask(task);
+            return true;
+        }
+        return false;
+    }
+
+    void JobSystem::Enqueue(Task* task, JobCounter* counter, uint workerIndex)
+    {
+        TYR_ASSERT(!task->IsPending());
+
+        task->m_Counter = counter;
+        task->m_State.store(TaskState::Pending, std::memory_order_relaxed);
+
+        // Must be counted before the task becomes visible so that it can't go negative
+        m_QueuedCount.fetch_add(1, std::memory_order_seq_cst);
+
+        if (workerIndex != c_InvalidWorkerIndex)
+        {
+            if (m_Workers[workerIndex].queue.Push(task))
+            {
+                return;
+            }
+            // The queue is full so run it now rather than block
+            m_QueuedCount.fetch_sub(1, std::memory_order_relaxed);
+            RunTask(task);
+            return;
+        }
+
+        // The external queue is full so help out until there is space
+        while (!m_ExternalQueue.TryEnqueue(task))
+        {
+            if (!TryRunJob())
+            {
+                TYR_THREAD_YIELD
+            }
+        }
+    }
+
+    void JobSystem::EnqueueExternalBatch(Task* tasks, uint count, JobCounter* counter)
+    {
+        // Enqueued in small batches so only one claim on the shared queue is needed per batch
+        constexpr uint c_BatchSize = 64;
+        Task* batch[c_BatchSize];
+
+        for (uint start = 0; start < count; start += c_BatchSize)
+        {
+            const uint batchCount = std::min(c_BatchSize, count - start);
+            for (uint i = 0; i < batchCount; ++i)
+            {
+                Task* task = &tasks[start + i];
+                TYR_ASSERT(!task->IsPending());
+                task->m_Counter = counter;
+                task->m_State.store(TaskState::Pending, std::memory_order_relaxed);
+                batch[i] = task;
+            }
+
+            m_QueuedCount.fetch_add(batchCount, std::memory_order_seq_cst);
+
+            uint enqueued = 0;
+            while (enqueued < batchCount)
+            {
+                enqueued += m_ExternalQueue.TryEnqueueBatch(&batch[enqueued], batchCount - enqueued);
+                if (enqueued < batchCount && !TryRunJob())
+                {
+                    TYR_THREAD_YIELD
+                }
+            }
+        }
+    }
+
+    Task* JobSystem::AcquirePoolTask(uint workerIndex)
+    {
+        while (true)
+        {
+            // Tasks still in flight are skipped rather than waited on. One of them may be the job that is submitting,
+            // or a job further down the calling thread's stack that is waiting on it, so it can't finish first.
+            for (uint i = 0; i < c_TaskPoolCapacity; ++i)
+            {
+                Task* task;
+                if (workerIndex != c_InvalidWorkerIndex)
+                {
+                    Worker& worker = m_Workers[workerIndex];
+                    task = &worker.taskPool[worker.taskPoolIndex];
+                    worker.taskPoolIndex = Math::ComputeWrappedIncrement<c_TaskPoolCapacity>(worker.taskPoolIndex);
+                }
+                else
+                {
+                    LockGuard guard(m_ExternalMutex);
+                    task = &m_ExternalTaskPool[m_ExternalTaskPoolIndex];
+                    m_ExternalTaskPoolIndex = Math::ComputeWrappedIncrement<c_TaskPoolCapacity>(m_ExternalTaskPoolIndex);
+                }
+
+                if (!task->IsPending())
+                {
+                    return task;
+                }
+            }
+
+            // Every task in the pool is in flight so help out until one is done
+            if (!TryRunJob())
+            {
+                TYR_THREAD_YIELD
+            }
+        }
+    }
+
+    Task* JobSystem::FindTask(uint workerIndex)
+    {
+        if (m_QueuedCount.load(std::memory_order_relaxed) == 0)
+        {
+            return nullptr;
+        }
+
+        Optional<Task*> task;
+        uint seed;
+        if (workerIndex != c_InvalidWorkerIndex)
+        {
+            Worker& worker = m_Workers[workerIndex];
+            task = worker.queue.Pop();
+            if (task)
+            {
+                m_QueuedCount.fetch_sub(1, std::memory_order_relaxed);
+                return task.value();
+            }
+
+            // Xorshift to spread thieves over the victims
+            seed = worker.stealSeed;
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            worker.stealSeed = seed;
+        }
+        else
+        {
+            seed = 0;
+        }
+
+        const uint start = seed % m_WorkerCount;
+        for (uint i = 0; i < m_WorkerCount; ++i)
+        {
+            const uint victim = (start + i) % m_WorkerCount;
+            if (victim == workerIndex)
+            {
+                continue;
+            }
+            task = m_Workers[victim].queue.Steal();
+            if (task)
+            {
+                m_QueuedCount.fetch_sub(1, std::memory_order_relaxed);
+                return task.value();
+            }
+        }
+
+        task = m_ExternalQueue.TryDequeue();
+        if (task)
+        {
+            m_QueuedCount.fetch_sub(1, std::memory_order_relaxed);
+            return task.value();
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::RunTask(Task* task)
+    {
+        // Read before running as a pooled task may be reused as soon as it has finished
+        JobCounter* counter = task->m_Counter;
+        task->Run();
+        if (counter)
+        {
+            counter->m_Count.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void JobSystem::WakeWorkers(uint count)
+    {
+        if (m_SleepingCount.load(std::memory_order_seq_cst) == 0)
+        {
+            return;
+        }
+
+        {
+            // Taking the lock ensures a worker that is about to sleep sees the queued job or gets the notification
+            LockGuard guard(m_SleepMutex);
+        }
+
+        if (count > 1)
+        {
+            m_SleepCV.notify_all();
+        }
+        else
+        {
+            m_SleepCV.notify_one();
+        }
+    }
+
+    void JobSystem::WorkerMain(uint workerIndex)
+    {
+        s_WorkerIndex = workerIndex;
+
+#if TYR_PROFILER
+        char threadName[32];
+        std::snprintf(threadName, sizeof(threadName), "Job Worker %u", workerIndex);
+        TYR_PROFILE_THREAD_NAME(threadName);
+#endif
+
+        uint failedAttempts = 0;
+        while (!m_Stop.load(std::memory_order_relaxed))
+        {
+            Task* task = FindTask(workerIndex);
+            if (task)
+            {
+                RunTask(task);
+                failedAttempts = 0;
+                continue;
+            }
+
+            if (++failedAttempts < c_SpinCount)
+            {
+                TYR_THREAD_YIELD
+                continue;
+            }
+
+            Lock lock(m_SleepMutex);
+            m_SleepingCount.fetch_add(1, std::memory_order_seq_cst);
+            m_SleepCV.wait(lock, [this]()
+            {
+                return m_Stop.load(std::memory_order_relaxed) || m_QueuedCount.load(std::memory_order_seq_cst) > 0;
+            });
+            m_SleepingCount.fetch_sub(1, std::memory_order_relaxed);
+            failedAttempts = 0;
+        }
+
+        s_WorkerIndex = c_InvalidWorkerIndex;
+    }
+}
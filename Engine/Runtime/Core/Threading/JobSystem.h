@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Base/INonCopyable.h"
+#include "Containers/MPMCRingBuffer.h"
+#include "Containers/WorkStealingQueue.h"
+#include "Threading.h"
+#include "Task.h"
+
+namespace tyr
+{
+    struct JobSystemConfig
+    {
+        // Number of threads that run jobs, including the thread that initializes the job system.
+        // Zero means one per logical core.
+        uint workerCount = 0;
+    };
+
+    /// Tracks a group of jobs. Incremented on submit and decremented when each job finishes.
+    class JobCounter final : public INonCopyable
+    {
+    public:
+        JobCounter()
+            : m_Count(0)
+        {
+
+        }
+
+        ~JobCounter()
+        {
+            TYR_ASSERT(IsDone());
+        }
+
+        bool IsDone() const
+        {
+            return m_Count.load(std::memory_order_acquire) == 0;
+        }
+
+        uint GetCount() const
+        {
+            return m_Count.load(std::memory_order_acquire);
+        }
+
+    private:
+        friend class JobSystem;
+
+        Atomic<uint> m_Count;
+    };
+
+    /// Work-stealing job system.
+    ///
+    /// Each worker owns a Chase-Lev deque. Jobs submitted from a worker are pushed to its own deque and idle workers
+    /// steal from the others. Jobs submitted from threads that are not workers go to a shared queue.
+    /// The thread that calls Initialize() becomes worker 0 and runs jobs while it waits on a counter.
+    class TYR_CORE_EXPORT JobSystem final : public INonCopyable
+    {
+    public:
+        static constexpr uint c_MaxWorkers = 64;
+        static constexpr uint c_QueueCapacity = 4096;
+        // Number of tasks per worker used by the Callable overload of Submit
+        static constexpr uint c_TaskPoolCapacity = 4096;
+        static constexpr uint c_InvalidWorkerIndex = ~0u;
+
+        static JobSystem& Instance();
+
+        JobSystem();
+        ~JobSystem();
+
+        void Initialize(const JobSystemConfig& config = {});
+
+        void Shutdown();
+
+        /// Submits a task owned by the caller. The task must stay alive until it has finished.
+        void Submit(Task* task, JobCounter* counter = nullptr);
+
+        /// Submits an array of tasks owned by the caller.
+        void Submit(Task* tasks, uint count, JobCounter* counter = nullptr);
+
+        /// Submits a callable using a task from the calling thread's task pool.
+        void Submit(Callable&& callable, JobCounter* counter = nullptr);
+
+        /// Blocks until all jobs tracked by the counter have finished. The calling thread runs jobs while it waits.
+        void Wait(JobCounter& counter);
+
+        /// Runs one pending job on the calling thread if there is one. Returns false if no job was found.
+        bool TryRunJob();
+
+        uint GetWorkerCount() const { return m_WorkerCount; }
+
+        bool IsInitialized() const { return m_Initialized; }
+
+        /// Returns the worker index of the calling thread or c_InvalidWorkerIndex if it isn't a worker.
+        static uint GetCurrentWorkerIndex();
+
+    private:
+        struct alignas(c_CacheLineSize) Worker
+        {
+            WorkStealingQueue<Task*, c_QueueCapacity> queue;
+            Task* taskPool = nullptr;
+            uint taskPoolIndex = 0;
+            uint stealSeed = 0;
+            Thread thread;
+        };
+
+        void WorkerMain(uint workerIndex);
+        void Enqueue(Task* task, JobCounter* counter, uint workerIndex);
+        void EnqueueExternalBatch(Task* tasks, uint count, JobCounter* counter);
+        Task* AcquirePoolTask(uint workerIndex);
+        Task* FindTask(uint workerIndex);
+        void RunTask(Task* task);
+        void WakeWorkers(uint count);
+
+        static TYR_THREADLOCAL uint s_WorkerIndex;
+
+        Worker* m_Workers;
+        uint m_WorkerCount;
+
+        // Jobs submitted by threads that aren't workers
+        MPMCRingBuffer<Task*, c_QueueCapacity> m_ExternalQueue;
+        // Guards the external task pool index
+        Mutex m_ExternalMutex;
+        Task* m_ExternalTaskPool;
+        uint m_ExternalTaskPoolIndex;
+
+        // Number of jobs that have been queued but not picked up yet. Used to decide if workers may sleep.
+        alignas(c_CacheLineSize) Atomic<uint> m_QueuedCount;
+        alignas(c_CacheLineSize) Atomic<uint> m_SleepingCount;
+        Mutex m_SleepMutex;
+        ConditionVariable m_SleepCV;
+        Atomic<bool> m_Stop;
+        bool m_Initialized;
+    };
+}
@@ -0,0 +1,77 @@
+#include "Parallel.h"
+#include "JobSystem.h"
+
+namespace tyr
+{
+    namespace
+    {
+        struct DispatchContext
+        {
+            Parallel::ChunkFunc func;
+            void* context;
+            uint chunkCount;
+            Atomic<uint> nextChunk;
+        };
+
+        void RunChunks(void* data)
+        {
+            DispatchContext& dispatch = *static_cast<DispatchContext*>(data);
+            uint chunk;
+            while ((chunk = dispatch.nextChunk.fetch_add(1, std::memory_order_relaxed)) < dispatch.chunkCount)
+            {
+                dispatch.func(dispatch.context, chunk);
+            }
+        }
+    }
+
+    uint Parallel::ComputeChunkCount(uint count, uint grainSize)
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        if (grainSize == 0)
+        {
+            const JobSystem& jobSystem = JobSystem::Instance();
+            const uint workerCount = jobSystem.IsInitialized() ? jobSystem.GetWorkerCount() : 1;
+            const uint targetChunkCount = workerCount * c_ChunksPerWorker;
+            grainSize = std::max(c_MinGrainSize, (count + targetChunkCount - 1) / targetChunkCount);
+        }
+
+        return static_cast<uint>((static_cast<uint64>(count) + grainSize - 1) / grainSize);
+    }
+
+    void Parallel::Dispatch(uint chunkCount, ChunkFunc func, void* context)
+    {
+        JobSystem& jobSystem = JobSystem::Instance();
+        if (chunkCount <= 1 || !jobSystem.IsInitialized() || jobSystem.GetWorkerCount() == 1)
+        {
+            for (uint i = 0; i < chunkCount; ++i)
+            {
+                func(context, i);
+            }
+            return;
+        }
+
+        DispatchContext dispatch;
+        dispatch.func = func;
+        dispatch.context = context;
+        dispatch.chunkCount = chunkCount;
+        dispatch.nextChunk.store(0, std::memory_order_relaxed);
+
+        // The calling thread takes part so one less job is needed
+        const uint jobCount = std::min(chunkCount, jobSystem.GetWorkerCount()) - 1;
+        JobCounter counter;
+        for (uint i = 0; i < jobCount; ++i)
+        {
+            Callable callable;
+            callable.Execute = &RunChunks;
+            callable.Context = &dispatch;
+            jobSystem.Submit(std::move(callable), &counter);
+        }
+
+        RunChunks(&dispatch);
+        jobSystem.Wait(counter);
+    }
+}
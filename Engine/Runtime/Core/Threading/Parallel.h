@@ -0,0 +1,384 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Containers/Array.h"
+#include <algorithm>
+#include <functional>
+
+namespace tyr
+{
+    /// Splits work into chunks and runs them on the job system.
+    /// The templated algorithms below are built on Dispatch(). Work runs on the calling thread if the job system
+    /// isn't initialized or there is only one chunk.
+    class TYR_CORE_EXPORT Parallel final
+    {
+    public:
+        using ChunkFunc = void(*)(void* context, uint chunkIndex);
+
+        // Smallest number of elements per chunk when the grain size is chosen automatically
+        static constexpr uint c_MinGrainSize = 64;
+        // Number of chunks created per worker when the grain size is chosen automatically so that uneven work balances out
+        static constexpr uint c_ChunksPerWorker = 8;
+
+        /// Returns the number of chunks to split count elements into. A grain size of zero selects one automatically.
+        static uint ComputeChunkCount(uint count, uint grainSize = 0);
+
+        /// Calls func for every chunk in [0, chunkCount) and returns once all have finished.
+        /// The calling thread processes chunks too. Chunks are handed out dynamically so slow chunks don't stall the rest.
+        static void Dispatch(uint chunkCount, ChunkFunc func, void* context);
+
+        static uint GetChunkBegin(uint chunkIndex, uint chunkCount, uint count)
+        {
+            return static_cast<uint>((static_cast<uint64>(chunkIndex) * count) / chunkCount);
+        }
+    };
+
+    /// Calls func(begin, end) for contiguous sub-ranges covering [0, count).
+    template<typename Func>
+    void ParallelForRange(uint count, Func&& func, uint grainSize = 0)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        struct Context
+        {
+            std::remove_reference_t<Func>* func;
+            uint count;
+            uint chunkCount;
+        };
+
+        Context context { &func, count, Parallel::ComputeChunkCount(count, grainSize) };
+
+        Parallel::Dispatch(context.chunkCount, [](void* data, uint chunkIndex)
+        {
+            const Context& ctx = *static_cast<Context*>(data);
+            const uint begin = Parallel::GetChunkBegin(chunkIndex, ctx.chunkCount, ctx.count);
+            const uint end = Parallel::GetChunkBegin(chunkIndex + 1, ctx.chunkCount, ctx.count);
+            (*ctx.func)(begin, end);
+        }, &context);
+    }
+
+    /// Calls func(index) for every index in [0, count).
+    template<typename Func>
+    void ParallelFor(uint count, Func&& func, uint grainSize = 0)
+    {
+        ParallelForRange(count, [&func](uint begin, uint end)
+        {
+            for (uint i = begin; i < end; ++i)
+            {
+                func(i);
+            }
+        }, grainSize);
+    }
+
+    /// Reduces map(index) over [0, count) with combine. combine must be associative.
+    /// Partial results are combined in index order so the result is deterministic for a given chunk count.
+    template<typename T, typename MapFunc, typename CombineFunc>
+    T ParallelReduce(uint count, const T& identity, MapFunc&& map, CombineFunc&& combine, uint grainSize = 0)
+    {
+        if (count == 0)
+        {
+            return identity;
+        }
+
+        const uint chunkCount = Parallel::ComputeChunkCount(count, grainSize);
+        Array<T> partials(chunkCount);
+
+        ParallelForRange(chunkCount, [&](uint chunkBegin, uint chunkEnd)
+        {
+            for (uint chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+            {
+                const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, count);
+                const uint end = Parallel::GetChunkBegin(chunk + 1, chunkCount, count);
+                T result = identity;
+                for (uint i = begin; i < end; ++i)
+                {
+                    result = combine(result, map(i));
+                }
+                partials[chunk] = std::move(result);
+            }
+        }, 1);
+
+        T result = identity;
+        for (uint i = 0; i < chunkCount; ++i)
+        {
+            result = combine(result, partials[i]);
+        }
+        return result;
+    }
+
+    /// Prefix scan of input into output with an associative op. output may be the same as input.
+    /// An inclusive scan includes input[i] in output[i], an exclusive scan starts with identity.
+    template<typename T, typename OpFunc>
+    void ParallelScan(const T* input, T* output, uint count, const T& identity, OpFunc&& op, bool inclusive, uint grainSize = 0)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        const uint chunkCount = Parallel::ComputeChunkCount(count, grainSize);
+        Array<T> chunkOffsets(chunkCount);
+
+        // Sum each chunk
+        ParallelForRange(chunkCount, [&](uint chunkBegin, uint chunkEnd)
+        {
+            for (uint chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+            {
+                const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, count);
+                const uint end = Parallel::GetChunkBegin(chunk + 1, chunkCount, count);
+                T sum = identity;
+                for (uint i = begin; i < end; ++i)
+                {
+                    sum = op(sum, input[i]);
+                }
+                chunkOffsets[chunk] = std::move(sum);
+            }
+        }, 1);
+
+        // Exclusive scan of the chunk sums gives each chunk its starting value
+        T running = identity;
+        for (uint i = 0; i < chunkCount; ++i)
+        {
+            T sum = std::move(chunkOffsets[i]);
+            chunkOffsets[i] = running;
+            running = op(running, sum);
+        }
+
+        ParallelForRange(chunkCount, [&](uint chunkBegin, uint chunkEnd)
+        {
+            for (uint chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+            {
+                const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, count);
+                const uint end = Parallel::GetChunkBegin(chunk + 1, chunkCount, count);
+                T sum = chunkOffsets[chunk];
+                for (uint i = begin; i < end; ++i)
+                {
+                    // Read before writing in case the scan is in place
+                    T value = input[i];
+                    if (inclusive)
+                    {
+                        sum = op(sum, value);
+                        output[i] = sum;
+                    }
+                    else
+                    {
+                        output[i] = sum;
+                        sum = op(sum, value);
+                    }
+                }
+            }
+        }, 1);
+    }
+
+    template<typename T, typename OpFunc = std::plus<T>>
+    void ParallelInclusiveScan(const T* input, T* output, uint count, const T& identity = T(), OpFunc&& op = OpFunc(), uint grainSize = 0)
+    {
+        ParallelScan(input, output, count, identity, op, true, grainSize);
+    }
+
+    template<typename T, typename OpFunc = std::plus<T>>
+    void ParallelExclusiveScan(const T* input, T* output, uint count, const T& identity = T(), OpFunc&& op = OpFunc(), uint grainSize = 0)
+    {
+        ParallelScan(input, output, count, identity, op, false, grainSize);
+    }
+
+    /// Stable parallel merge sort. Chunks are sorted independently and then merged in passes.
+    /// Each merge is split into independent pieces with a binary search so that the final passes still use every worker.
+    template<typename T, typename Compare = std::less<T>>
+    void ParallelSort(T* data, uint count, Compare&& comp = Compare(), uint grainSize = 0)
+    {
+        const uint chunkCount = Parallel::ComputeChunkCount(count, grainSize == 0 ? 1024u : grainSize);
+        if (chunkCount <= 1)
+        {
+            std::stable_sort(data, data + count, comp);
+            return;
+        }
+
+        ParallelFor(chunkCount, [&](uint chunk)
+        {
+            const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, count);
+            const uint end = Parallel::GetChunkBegin(chunk + 1, chunkCount, count);
+            std::stable_sort(data + begin, data + end, comp);
+        }, 1);
+
+        struct MergePiece
+        {
+            uint aBegin, aEnd;
+            uint bBegin, bEnd;
+            uint outBegin;
+        };
+
+        Array<T> temp(count);
+        T* src = data;
+        T* dst = temp.Data();
+        Array<MergePiece> pieces;
+        const uint targetPieces = chunkCount;
+
+        // Runs are chunk aligned, doubling in size every pass
+        for (uint runChunks = 1; runChunks < chunkCount; runChunks *= 2)
+        {
+            pieces.Clear();
+            const uint pairCount = (chunkCount + runChunks * 2 - 1) / (runChunks * 2);
+            const uint piecesPerPair = std::max(1u, targetPieces / pairCount);
+
+            for (uint pair = 0; pair < pairCount; ++pair)
+            {
+                const uint aBegin = Parallel::GetChunkBegin(pair * runChunks * 2, chunkCount, count);
+                const uint aEnd = Parallel::GetChunkBegin(std::min(pair * runChunks * 2 + runChunks, chunkCount), chunkCount, count);
+                const uint bEnd = Parallel::GetChunkBegin(std::min((pair + 1) * runChunks * 2, chunkCount), chunkCount, count);
+
+                // Split on A and find the matching split in B. B elements equal to the A split go after it to keep the sort stable.
+                uint prevA = aBegin;
+                uint prevB = aEnd;
+                for (uint piece = 1; piece <= piecesPerPair; ++piece)
+                {
+                    uint splitA;
+                    uint splitB;
+                    if (piece == piecesPerPair)
+                    {
+                        splitA = aEnd;
+                        splitB = bEnd;
+                    }
+                    else
+                    {
+                        splitA = aBegin + static_cast<uint>((static_cast<uint64>(aEnd - aBegin) * piece) / piecesPerPair);
+                        splitB = splitA < aEnd
+                            ? static_cast<uint>(std::lower_bound(src + prevB, src + bEnd, src[splitA], comp) - src)
+                            : bEnd;
+                    }
+                    pieces.Add({ prevA, splitA, prevB, splitB, prevA + (prevB - aEnd) });
+                    prevA = splitA;
+                    prevB = splitB;
+                }
+            }
+
+            ParallelFor(pieces.Size(), [&](uint i)
+            {
+                const MergePiece& piece = pieces[i];
+                std::merge(std::make_move_iterator(src + piece.aBegin), std::make_move_iterator(src + piece.aEnd),
+                    std::make_move_iterator(src + piece.bBegin), std::make_move_iterator(src + piece.bEnd), dst + piece.outBegin, comp);
+            }, 1);
+
+            std::swap(src, dst);
+        }
+
+        if (src != data)
+        {
+            ParallelForRange(count, [&](uint begin, uint end)
+            {
+                std::move(src + begin, src + end, data + begin);
+            });
+        }
+    }
+
+    template<typename T, typename A, typename Compare = std::less<T>>
+    void ParallelSort(Array<T, A>& array, Compare&& comp = Compare(), uint grainSize = 0)
+    {
+        ParallelSort(array.Data(), array.Size(), std::forward<Compare>(comp), grainSize);
+    }
+
+    /// Stable parallel LSD radix sort on an unsigned integer key returned by getKey(element).
+    /// Passes where every element has the same digit are skipped.
+    template<typename T, typename KeyFunc>
+    void ParallelRadixSort(T* data, uint count, KeyFunc&& getKey, uint grainSize = 0)
+    {
+        using Key = std::decay_t<decltype(getKey(*data))>;
+        TYR_STATIC_ASSERT(std::is_unsigned_v<Key>, "Radix sort keys must be unsigned integers");
+
+        constexpr uint c_RadixBits = 8;
+        constexpr uint c_BucketCount = 1u << c_RadixBits;
+        constexpr uint c_PassCount = sizeof(Key) * 8 / c_RadixBits;
+
+        if (count <= 1)
+        {
+            return;
+        }
+
+        const uint chunkCount = Parallel::ComputeChunkCount(count, grainSize == 0 ? 4096u : grainSize);
+        Array<T> temp(count);
+        Array<uint> offsets(chunkCount * c_BucketCount);
+        T* src = data;
+        T* dst = temp.Data();
+
+        for (uint pass = 0; pass < c_PassCount; ++pass)
+        {
+            const uint shift = pass * c_RadixBits;
+
+            // Per chunk histograms
+            ParallelFor(chunkCount, [&](uint chunk)
+            {
+                uint* histogram = &offsets[chunk * c_BucketCount];
+                std::fill(histogram, histogram + c_BucketCount, 0u);
+                const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, count);
+                const uint end = Parallel::GetChunkBegin(chunk + 1, chunkCount, count);
+                for (uint i = begin; i < end; ++i)
+                {
+                    ++histogram[(getKey(src[i]) >> shift) & (c_BucketCount - 1)];
+                }
+            }, 1);
+
+            // Convert to scatter offsets, bucket major so that earlier chunks write first within a bucket
+            uint total = 0;
+            bool skipPass = false;
+            for (uint bucket = 0; bucket < c_BucketCount; ++bucket)
+            {
+                uint bucketTotal = 0;
+                for (uint chunk = 0; chunk < chunkCount; ++chunk)
+                {
+                    uint& offset = offsets[chunk * c_BucketCount + bucket];
+                    const uint chunkBucketCount = offset;
+                    offset = total + bucketTotal;
+                    bucketTotal += chunkBucketCount;
+                }
+                if (bucketTotal == count)
+                {
+                    skipPass = true;
+                    break;
+                }
+                total += bucketTotal;
+            }
+
+            if (skipPass)
+            {
+                continue;
+            }
+
+            ParallelFor(chunkCount, [&](uint chunk)
+            {
+                uint* chunkOffsets = &offsets[chunk * c_BucketCount];
+                const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, count);
+                const uint end = Parallel::GetChunkBegin(chunk + 1, chunkCount, count);
+                for (uint i = begin; i < end; ++i)
+                {
+                    const uint bucket = (getKey(src[i]) >> shift) & (c_BucketCount - 1);
+                    dst[chunkOffsets[bucket]++] = std::move(src[i]);
+                }
+            }, 1);
+
+            std::swap(src, dst);
+        }
+
+        if (src != data)
+        {
+            ParallelForRange(count, [&](uint begin, uint end)
+            {
+                std::move(src + begin, src + end, data + begin);
+            });
+        }
+    }
+
+    template<typename T>
+    void ParallelRadixSort(T* data, uint count)
+    {
+        ParallelRadixSort(data, count, [](const T& value) { return value; });
+    }
+
+    template<typename T, typename A, typename KeyFunc>
+    void ParallelRadixSort(Array<T, A>& array, KeyFunc&& getKey, uint grainSize = 0)
+    {
+        ParallelRadixSort(array.Data(), array.Size(), std::forward<KeyFunc>(getKey), grainSize);
+    }
+}
@@ -6,6 +6,7 @@ namespace tyr
 {
     Task::Task(Callable&& callable)
         : m_Callable(std::move(callable))
+        , m_State(TaskState::Inactive)
     {
 
     }
@@ -19,7 +20,8 @@ namespace tyr
 
     void Task::Run()
     {
-        TYR_ASSERT(m_Callable && !IsActive());
+        // Tasks submitted to the job system are pending when run
+        TYR_ASSERT(m_Callable && m_State.load(std::memory_order_relaxed) != TaskState::Running);
        
         m_State.store(TaskState::Running, std::memory_order_release);
 
@@ -15,6 +15,8 @@ namespace tyr
         Finished
     };
 
+    class JobCounter;
+
     class Task final
     {
     public:
@@ -28,12 +30,27 @@ namespace tyr
         {
             return m_State.load(std::memory_order_acquire) != TaskState::Inactive;
         }
+
+        // Returns true if the task has been submitted to the job system and has not finished yet
+        bool IsPending() const
+        {
+            const TaskState state = m_State.load(std::memory_order_acquire);
+            return state == TaskState::Pending || state == TaskState::Running;
+        }
+
+        bool IsFinished() const
+        {
+            return m_State.load(std::memory_order_acquire) == TaskState::Finished;
+        }
         
     private:
         friend class PooledThread;
+        friend class JobSystem;
         void Run();
 
         Callable m_Callable;
+        // Counter decremented by the job system once the task has run
+        JobCounter* m_Counter = nullptr;
 
         std::atomic<TaskState> m_State;
     };
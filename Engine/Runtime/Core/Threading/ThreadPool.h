@@ -14,7 +14,7 @@ namespace tyr
     };
 
     struct Task;
-    class PooledThread final : public INonCopyable
+    class TYR_CORE_EXPORT PooledThread final : public INonCopyable
     {
     public:
         PooledThread();
@@ -31,12 +31,12 @@ namespace tyr
         Mutex m_Mutex;
         ConditionVariable m_CV;
 
-        Task* m_Task;
+        Task* m_Task = nullptr;
         std::atomic<bool> m_Stop = false;
         bool m_IsRunningTask = false;
     };
 
-    class ThreadPool final
+    class TYR_CORE_EXPORT ThreadPool final
     {
     public:
         ThreadPool(const ThreadPoolConfig& config);
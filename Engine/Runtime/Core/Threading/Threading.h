@@ -1,8 +1,11 @@
 #pragma once
 
+#include "Base/Primitives.h"
 #include <thread>
 #include <chrono>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
 
 namespace tyr
 {
@@ -18,6 +21,12 @@ namespace tyr
 	/// Causes the current thread to sleep for the provided amount of nanoseconds. 
 	#define TYR_THREAD_SLEEP_NS(ns) std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
 
+	/// Gives up the rest of the current thread's time slice. 
+	#define TYR_THREAD_YIELD std::this_thread::yield();
+
+	/// Size of a cache line in bytes. Used to pad data written by different threads to avoid false sharing.
+	static constexpr uint c_CacheLineSize = 64;
+
 	using Mutex = std::mutex;
 
 	using RecursiveMutex = std::recursive_mutex;
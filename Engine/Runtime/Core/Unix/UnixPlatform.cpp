@@ -0,0 +1,344 @@
+#include "Platform/Platform.h"
+#include "Identifiers/Guid.h"
+#include "Utility/PathUtil.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace tyr
+{
+	namespace
+	{
+		// File descriptors are stored offset by one so that descriptor 0 is not a null handle
+		int ToFileDescriptor(FileHandle handle)
+		{
+			return static_cast<int>(reinterpret_cast<intptr_t>(handle)) - 1;
+		}
+
+		FileHandle ToFileHandle(int fd)
+		{
+			return reinterpret_cast<FileHandle>(static_cast<intptr_t>(fd) + 1);
+		}
+
+		// Queries the default screen of the X display. Xlib is loaded at runtime so that Core doesn't link X11 and
+		// headless processes still work, in which case the size is 0.
+		void GetDefaultScreenSize(int& width, int& height)
+		{
+			width = 0;
+			height = 0;
+
+			void* xlib = dlopen("libX11.so.6", RTLD_NOW | RTLD_LOCAL);
+			if (!xlib)
+			{
+				return;
+			}
+
+			using OpenDisplayFunc = void* (*)(const char*);
+			using DisplayFunc = int (*)(void*);
+			using ScreenFunc = int (*)(void*, int);
+			const auto openDisplay = reinterpret_cast<OpenDisplayFunc>(dlsym(xlib, "XOpenDisplay"));
+			const auto closeDisplay = reinterpret_cast<DisplayFunc>(dlsym(xlib, "XCloseDisplay"));
+			const auto defaultScreen = reinterpret_cast<DisplayFunc>(dlsym(xlib, "XDefaultScreen"));
+			const auto displayWidth = reinterpret_cast<ScreenFunc>(dlsym(xlib, "XDisplayWidth"));
+			const auto displayHeight = reinterpret_cast<ScreenFunc>(dlsym(xlib, "XDisplayHeight"));
+
+			if (openDisplay && closeDisplay && defaultScreen && displayWidth && displayHeight)
+			{
+				if (void* display = openDisplay(nullptr))
+				{
+					const int screen = defaultScreen(display);
+					width = displayWidth(display, screen);
+					height = displayHeight(display, screen);
+					closeDisplay(display);
+				}
+			}
+			dlclose(xlib);
+		}
+	}
+
+	const char* Platform::c_DynamicLibExtension = ".so";
+
+	const String Platform::c_BinaryDirectory = GetBinaryDirectoryPath();
+
+	void Platform::Exit(bool cleanup)
+	{
+		if (cleanup)
+		{
+			std::exit(0);
+		}
+		else
+		{
+			std::_Exit(0);
+		}
+	}
+
+	Handle Platform::OpenLibrary(const char* filename, bool addFileExtension)
+	{
+		String filePath = String(filename);
+		if (addFileExtension)
+		{
+			filePath += Platform::c_DynamicLibExtension;
+		}
+		return dlopen(filePath.c_str(), RTLD_NOW | RTLD_LOCAL);
+	}
+
+	bool Platform::CloseLibrary(Handle library)
+	{
+		return dlclose(library) == 0;
+	}
+
+	void* Platform::GetProcessAddress(const Handle library, const char* function)
+	{
+		return dlsym(library, function);
+	}
+
+	bool Platform::IsDebuggerAttached()
+	{
+		// A traced process has a non-zero TracerPid in its status
+		FILE* file = std::fopen("/proc/self/status", "r");
+		if (!file)
+		{
+			return false;
+		}
+
+		bool attached = false;
+		char line[256];
+		while (std::fgets(line, sizeof(line), file))
+		{
+			if (std::strncmp(line, "TracerPid:", 10) == 0)
+			{
+				attached = std::atoi(line + 10) != 0;
+				break;
+			}
+		}
+		std::fclose(file);
+		return attached;
+	}
+
+	int Platform::GetScreenWidth()
+	{
+		int width, height;
+		GetDefaultScreenSize(width, height);
+		return width;
+	}
+
+	int Platform::GetScreenHeight()
+	{
+		int width, height;
+		GetDefaultScreenSize(width, height);
+		return height;
+	}
+
+	uint64 Platform::GetCpuCycles()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		timespec time;
+		clock_gettime(CLOCK_MONOTONIC, &time);
+		return static_cast<uint64>(time.tv_sec) * 1000000000ull + static_cast<uint64>(time.tv_nsec);
+#endif
+	}
+
+	size_t Platform::GetPageSize()
+	{
+		return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	}
+
+	void* Platform::ReserveVirtualMemory(size_t size)
+	{
+		void* address = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		return address != MAP_FAILED ? address : nullptr;
+	}
+
+	bool Platform::CommitVirtualMemory(void* address, size_t size)
+	{
+		// Pages are only backed by physical memory on first touch
+		return mprotect(address, size, PROT_READ | PROT_WRITE) == 0;
+	}
+
+	void Platform::DecommitVirtualMemory(void* address, size_t size)
+	{
+		madvise(address, size, MADV_DONTNEED);
+		mprotect(address, size, PROT_NONE);
+	}
+
+	void Platform::ReleaseVirtualMemory(void* address, size_t size)
+	{
+		munmap(address, size);
+	}
+
+	void Platform::AdviseHugePages(void* address, size_t size)
+	{
+#ifdef MADV_HUGEPAGE
+		madvise(address, size, MADV_HUGEPAGE);
+#endif
+	}
+
+	FileHandle Platform::OpenOrCreateFile(const char* filename, FileAccess access, FileCreationMode creationMode)
+	{
+		int flags;
+		switch (access)
+		{
+		case FileAccess::Read:
+		case FileAccess::Execute:
+			flags = O_RDONLY;
+			break;
+		case FileAccess::Write:
+			flags = O_WRONLY;
+			break;
+		case FileAccess::All:
+			flags = O_RDWR;
+			break;
+		default:
+			TYR_ASSERT(false);
+			return nullptr;
+		}
+
+		switch (creationMode)
+		{
+		case FileCreationMode::CreateAlways:
+			flags |= O_CREAT | O_TRUNC;
+			break;
+		case FileCreationMode::CreateNew:
+			flags |= O_CREAT | O_EXCL;
+			break;
+		case FileCreationMode::OpenAlways:
+			flags |= O_CREAT;
+			break;
+		case FileCreationMode::OpenExisting:
+			break;
+		case FileCreationMode::TruncateExisting:
+			flags |= O_TRUNC;
+			break;
+		default:
+			TYR_ASSERT(false);
+			return nullptr;
+		}
+
+		const int fd = open(filename, flags | O_CLOEXEC, 0644);
+		TYR_ASSERT(fd >= 0);
+		return fd >= 0 ? ToFileHandle(fd) : nullptr;
+	}
+
+	size_t Platform::GetSizeOfFile(FileHandle handle)
+	{
+		TYR_ASSERT(handle);
+		struct stat info;
+		if (fstat(ToFileDescriptor(handle), &info) != 0)
+		{
+			TYR_ASSERT(false);
+			return 0;
+		}
+		return static_cast<size_t>(info.st_size);
+	}
+
+	void Platform::SetFilePosition(FileHandle handle, size_t position)
+	{
+		const off_t newPos = lseek(ToFileDescriptor(handle), static_cast<off_t>(position), SEEK_SET);
+		TYR_ASSERT(newPos >= 0);
+	}
+
+	void Platform::SetFilePositionToEnd(FileHandle handle)
+	{
+		const off_t newPos = lseek(ToFileDescriptor(handle), 0, SEEK_END);
+		TYR_ASSERT(newPos >= 0);
+	}
+
+	size_t Platform::GetFilePosition(FileHandle handle)
+	{
+		const off_t pos = lseek(ToFileDescriptor(handle), 0, SEEK_CUR);
+		TYR_ASSERT(pos >= 0);
+		return static_cast<size_t>(pos);
+	}
+
+	bool Platform::IsEOF(FileHandle handle)
+	{
+		return GetFilePosition(handle) >= GetSizeOfFile(handle);
+	}
+
+	void Platform::ReadFromFile(FileHandle handle, uint8* buffer, size_t numberOfBytesToRead, size_t& bytesRead)
+	{
+		TYR_ASSERT(handle);
+		const int fd = ToFileDescriptor(handle);
+		bytesRead = 0;
+		while (bytesRead < numberOfBytesToRead)
+		{
+			const ssize_t result = read(fd, buffer + bytesRead, numberOfBytesToRead - bytesRead);
+			if (result <= 0)
+			{
+				TYR_ASSERT(result == 0);
+				break;
+			}
+			bytesRead += static_cast<size_t>(result);
+		}
+	}
+
+	void Platform::WriteToFile(FileHandle handle, const uint8* buffer, size_t bufferSize, size_t& bytesWritten)
+	{
+		TYR_ASSERT(handle);
+		const int fd = ToFileDescriptor(handle);
+		bytesWritten = 0;
+		while (bytesWritten < bufferSize)
+		{
+			const ssize_t result = write(fd, buffer + bytesWritten, bufferSize - bytesWritten);
+			if (result <= 0)
+			{
+				break;
+			}
+			bytesWritten += static_cast<size_t>(result);
+		}
+		TYR_ASSERT(bytesWritten == bufferSize);
+	}
+
+	void Platform::CloseFile(FileHandle handle)
+	{
+		TYR_ASSERT(handle);
+		const int result = close(ToFileDescriptor(handle));
+		TYR_ASSERT(result == 0);
+	}
+
+	void Platform::ShowAlertMessage(const char* msg)
+	{
+		std::fprintf(stderr, "Alert! %s\n", msg);
+	}
+
+	void Platform::CreateGuid(Guid& guid)
+	{
+		// Version 4 (random) UUID
+		const int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+		TYR_ASSERT(fd >= 0);
+		const ssize_t result = read(fd, &guid, sizeof(Guid));
+		TYR_ASSERT(result == sizeof(Guid));
+		close(fd);
+		guid.data3 = static_cast<uint16>((guid.data3 & 0x0FFF) | 0x4000);
+		guid.data4[0] = static_cast<uint8>((guid.data4[0] & 0x3F) | 0x80);
+	}
+
+	void Platform::GetBinaryDirectoryPath(char* dirPath)
+	{
+		char executablePath[TYR_MAX_PATH_TOTAL_SIZE];
+		const ssize_t length = readlink("/proc/self/exe", executablePath, TYR_MAX_PATH);
+		executablePath[length > 0 ? length : 0] = '\0';
+		PathUtil::GetDirectoryPathFromFilePath(executablePath, dirPath);
+	}
+
+	String Platform::GetBinaryDirectoryPath()
+	{
+		char buffer[TYR_MAX_PATH_TOTAL_SIZE];
+		const ssize_t length = readlink("/proc/self/exe", buffer, TYR_MAX_PATH);
+		buffer[length > 0 ? length : 0] = '\0';
+		String executablePath = buffer;
+		String executableDirectory = executablePath.substr(0, executablePath.find_last_of("/"));
+		return executableDirectory;
+	}
+}
@@ -11,19 +11,26 @@ namespace tyr
 
 	#define TYR_CONCAT(first, second) first second
 
-	#if defined(_DEBUG) || defined(TYR_ENABLE_PROFILING)
-	#define TYR_LOG(level, desc, ...)                                                                \
-			Logger::Instance().LogError(level, __PRETTY_FUNCTION__, __FILE__, __LINE__, desc, __VA_ARGS__);     \
-			if (level == LogLevel::Fatal)                                                          \
-				Platform::Exit(false); 
+	// The level and category filters are checked before the arguments are evaluated.
+	// Fatal messages are flushed by the logger before the application exits.
+	#if TYR_DEBUG || defined(TYR_ENABLE_PROFILING)
+	#define TYR_LOG_CATEGORY(level, category, desc, ...)                                                 \
+			{ if (Logger::Instance().IsEnabled(level, category))                                        \
+			{                                                                                            \
+				Logger::Instance().Log(level, category, LogSource{ __FUNCTION__, __FILE__, __LINE__ }, desc, ##__VA_ARGS__); \
+				if (level == LogLevel::Fatal)                                                            \
+					Platform::Exit(false);                                                               \
+			} }
 	#else
-	#	define TYR_LOG(desc, level)
+	#	define TYR_LOG_CATEGORY(level, category, desc, ...)
 	#endif
 
-	#define TYR_LOG_FATAL(desc, ...) TYR_LOG(LogLevel::Fatal, desc, __VA_ARGS__)                           																																			        
-	#define TYR_LOG_ERROR(desc, ...) TYR_LOG(LogLevel::Error, desc, __VA_ARGS__) 
-	#define TYR_LOG_WARNING(desc, ...) TYR_LOG(LogLevel::Warning, desc, __VA_ARGS__) 
-	#define TYR_LOG_INFO(desc, ...) TYR_LOG(LogLevel::Info, desc, __VA_ARGS__) 
+	#define TYR_LOG(level, desc, ...) TYR_LOG_CATEGORY(level, LogCategory::Unspecified, desc, ##__VA_ARGS__)
+
+	#define TYR_LOG_FATAL(desc, ...) TYR_LOG(LogLevel::Fatal, desc, ##__VA_ARGS__)                           																																			        
+	#define TYR_LOG_ERROR(desc, ...) TYR_LOG(LogLevel::Error, desc, ##__VA_ARGS__) 
+	#define TYR_LOG_WARNING(desc, ...) TYR_LOG(LogLevel::Warning, desc, ##__VA_ARGS__) 
+	#define TYR_LOG_INFO(desc, ...) TYR_LOG(LogLevel::Info, desc, ##__VA_ARGS__) 
 
 	#define TYR_ALERT(msg) Platform::ShowAlertMessage(msg);
 
@@ -31,7 +38,7 @@ namespace tyr
 	#if TYR_DEBUG 
 	#   define TYR_ASSERT_MSG(v, m) { if ( !(v) ) { TYR_LOG_WARNING(m); } }
 	#else
-	#	define TYR_ASSERT(v)
+	#	define TYR_ASSERT_MSG(v, m)
 	#endif
 
 	template <typename T>
@@ -29,7 +29,7 @@ namespace tyr
                 DWORD e = GetLastError();
                 StringStream ss;
                 ss << "Failed to load module handle: " << e << ".";
-                TYR_LOG_FATAL(ss.str().c_str());
+                TYR_LOG_FATAL("%s", ss.str());
             }
 
             ATOM result = RegisterWindowClass(m_Properties);
@@ -38,7 +38,7 @@ namespace tyr
                 DWORD e = GetLastError();
                 StringStream ss;
                 ss << "Failed to register window class with error code: " << e << ".";
-                TYR_LOG_FATAL(ss.str().c_str());
+                TYR_LOG_FATAL("%s", ss.str());
             }
         }
 
@@ -55,7 +55,7 @@ namespace tyr
             DWORD e = GetLastError();
             StringStream ss;
             ss << "Failed to create window with error code: " << e << ".";
-            TYR_LOG_FATAL(ss.str().c_str());
+            TYR_LOG_FATAL("%s", ss.str());
         }
         
         ShowWindow(hwnd, properties.showFlag);
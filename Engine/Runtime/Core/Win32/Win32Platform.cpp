@@ -69,6 +69,39 @@ namespace tyr
 		return __rdtsc();
 	}
 
+	size_t Platform::GetPageSize()
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return static_cast<size_t>(info.dwPageSize);
+	}
+
+	void* Platform::ReserveVirtualMemory(size_t size)
+	{
+		return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+	}
+
+	bool Platform::CommitVirtualMemory(void* address, size_t size)
+	{
+		return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+	}
+
+	void Platform::DecommitVirtualMemory(void* address, size_t size)
+	{
+		VirtualFree(address, size, MEM_DECOMMIT);
+	}
+
+	void Platform::ReleaseVirtualMemory(void* address, size_t size)
+	{
+		// The size must be zero when releasing
+		VirtualFree(address, 0, MEM_RELEASE);
+	}
+
+	void Platform::AdviseHugePages(void* address, size_t size)
+	{
+		// Large pages on Windows must be requested at reservation time and need a user privilege, so this is a no-op
+	}
+
 	FileHandle Platform::OpenOrCreateFile(const char* filename, FileAccess access, FileCreationMode creationMode)
 	{
 		DWORD desiredAccess;
@@ -1,4 +1,5 @@
 #include "WindowModule.h"
+#include "Window/Window.h"
 
 #if TYR_PLATFORM == TYR_PLATFORM_WINDOWS
 #include "Win32/PCWindow.h"
@@ -0,0 +1,318 @@
+#include "TransformHierarchy.h"
+#include "Threading/Parallel.h"
+#include <cstring>
+
+namespace tyr
+{
+	TransformHierarchy::TransformHierarchy()
+		: m_OrderVersion(0)
+		, m_NeedsSort(false)
+	{
+		m_RangeBegins.Add(0);
+	}
+
+	TransformHierarchy::~TransformHierarchy()
+	{
+		for (uint handle : m_Handles)
+		{
+			if (handle != c_InvalidHandle)
+			{
+				m_Indices.Delete(handle);
+			}
+		}
+	}
+
+	uint TransformHierarchy::AddNode(const Transform& local, uint parent)
+	{
+		// Appending keeps parents before children but the node's root subtree is no longer contiguous
+		const uint index = m_Handles.Size();
+		uint handle;
+		*m_Indices.Create(handle) = index;
+
+		m_Handles.Add(handle);
+		m_Locals.Add(local);
+		m_Parents.Add(parent == c_InvalidHandle ? -1 : static_cast<int>(GetIndex(parent)));
+		m_Dirty.Add(1);
+		m_WorldMatrices.Add(Matrix4::c_Identity);
+		m_NeedsSort = true;
+		return handle;
+	}
+
+	void TransformHierarchy::RemoveNode(uint handle)
+	{
+		// The node stays in the arrays until the next sort so that the indices of the other nodes don't change
+		m_Handles[GetIndex(handle)] = c_InvalidHandle;
+		m_Indices.Delete(handle);
+		m_NeedsSort = true;
+	}
+
+	void TransformHierarchy::SetParent(uint handle, uint parent)
+	{
+		const uint index = GetIndex(handle);
+		int parentIndex = -1;
+		if (parent != c_InvalidHandle)
+		{
+			parentIndex = static_cast<int>(GetIndex(parent));
+			for (int ancestor = parentIndex; ancestor >= 0; ancestor = m_Parents[ancestor])
+			{
+				TYR_ASSERT(ancestor != static_cast<int>(index));
+			}
+		}
+
+		m_Parents[index] = parentIndex;
+		m_Dirty[index] = 1;
+		m_NeedsSort = true;
+	}
+
+	void TransformHierarchy::SetLocal(uint handle, const Transform& local)
+	{
+		const uint index = GetIndex(handle);
+		m_Locals[index] = local;
+		m_Dirty[index] = 1;
+	}
+
+	void TransformHierarchy::Update()
+	{
+		if (m_NeedsSort)
+		{
+			Sort();
+			++m_OrderVersion;
+			m_NeedsSort = false;
+		}
+
+		const uint rangeCount = m_RangeBegins.Size() - 1;
+		ParallelFor(rangeCount, [this](uint range)
+		{
+			UpdateRange(m_RangeBegins[range], m_RangeBegins[range + 1]);
+		}, 1);
+	}
+
+	void TransformHierarchy::Sort()
+	{
+		const uint count = m_Handles.Size();
+
+		// Children of removed nodes move to the closest ancestor that is still there
+		uint liveCount = 0;
+		for (uint i = 0; i < count; ++i)
+		{
+			if (m_Handles[i] == c_InvalidHandle)
+			{
+				continue;
+			}
+			++liveCount;
+			int parent = m_Parents[i];
+			while (parent >= 0 && m_Handles[parent] == c_InvalidHandle)
+			{
+				parent = m_Parents[parent];
+			}
+			if (parent != m_Parents[i])
+			{
+				m_Parents[i] = parent;
+				m_Dirty[i] = 1;
+			}
+		}
+
+		// Children of each node in index order
+		Array<uint> childOffsets(count + 1);
+		std::memset(childOffsets.Data(), 0, (count + 1) * sizeof(uint));
+		for (uint i = 0; i < count; ++i)
+		{
+			if (m_Handles[i] != c_InvalidHandle && m_Parents[i] >= 0)
+			{
+				++childOffsets[m_Parents[i] + 1];
+			}
+		}
+		for (uint i = 0; i < count; ++i)
+		{
+			childOffsets[i + 1] += childOffsets[i];
+		}
+		Array<uint> children(childOffsets[count]);
+		Array<uint> cursors(count);
+		std::memcpy(cursors.Data(), childOffsets.Data(), count * sizeof(uint));
+		for (uint i = 0; i < count; ++i)
+		{
+			if (m_Handles[i] != c_InvalidHandle && m_Parents[i] >= 0)
+			{
+				children[cursors[m_Parents[i]]++] = i;
+			}
+		}
+
+		// Depth first order makes every root's subtree contiguous. Roots keep their relative order.
+		Array<uint> order;
+		order.Reserve(liveCount);
+		Array<uint> depths(count);
+		Array<uint> stack;
+		m_RangeBegins.Clear();
+		for (uint root = 0; root < count; ++root)
+		{
+			if (m_Handles[root] == c_InvalidHandle || m_Parents[root] >= 0)
+			{
+				continue;
+			}
+
+			if (m_RangeBegins.IsEmpty() || order.Size() - m_RangeBegins.Back() >= c_GrainSize)
+			{
+				m_RangeBegins.Add(order.Size());
+			}
+
+			depths[root] = 0;
+			stack.Add(root);
+			while (!stack.IsEmpty())
+			{
+				const uint node = stack.Back();
+				stack.PopBack();
+				order.Add(node);
+				// Pushed in reverse so that children are visited in index order
+				for (uint i = childOffsets[node + 1]; i-- > childOffsets[node];)
+				{
+					depths[children[i]] = depths[node] + 1;
+					stack.Add(children[i]);
+				}
+			}
+		}
+		TYR_ASSERT(order.Size() == liveCount);
+		m_RangeBegins.Add(liveCount);
+
+		// Within each range order the nodes by depth with a stable counting sort so that each level can be composed in
+		// batches
+		Array<uint> sorted(liveCount);
+		Array<uint> depthOffsets;
+		for (uint range = 0; range + 1 < m_RangeBegins.Size(); ++range)
+		{
+			const uint begin = m_RangeBegins[range];
+			const uint end = m_RangeBegins[range + 1];
+			uint maxDepth = 0;
+			for (uint i = begin; i < end; ++i)
+			{
+				maxDepth = std::max(maxDepth, depths[order[i]]);
+			}
+
+			depthOffsets.Clear();
+			depthOffsets.Resize(maxDepth + 2, 0u);
+			for (uint i = begin; i < end; ++i)
+			{
+				++depthOffsets[depths[order[i]] + 1];
+			}
+			depthOffsets[0] = begin;
+			for (uint depth = 0; depth <= maxDepth; ++depth)
+			{
+				depthOffsets[depth + 1] += depthOffsets[depth];
+			}
+			for (uint i = begin; i < end; ++i)
+			{
+				sorted[depthOffsets[depths[order[i]]]++] = order[i];
+			}
+		}
+
+		// Move the nodes to their sorted positions
+		Array<uint> newIndices(count);
+		for (uint i = 0; i < liveCount; ++i)
+		{
+			newIndices[sorted[i]] = i;
+		}
+
+		Array<uint> handles(liveCount);
+		Array<Transform> locals(liveCount);
+		Array<int> parents(liveCount);
+		Array<uint8> dirty(liveCount);
+		Array<Matrix4> worldMatrices(liveCount);
+		for (uint i = 0; i < liveCount; ++i)
+		{
+			const uint old = sorted[i];
+			handles[i] = m_Handles[old];
+			locals[i] = m_Locals[old];
+			parents[i] = m_Parents[old] >= 0 ? static_cast<int>(newIndices[m_Parents[old]]) : -1;
+			dirty[i] = m_Dirty[old];
+			worldMatrices[i] = m_WorldMatrices[old];
+			m_Indices.GetObjectRef(handles[i]) = i;
+		}
+
+		m_Handles = std::move(handles);
+		m_Locals = std::move(locals);
+		m_Parents = std::move(parents);
+		m_Dirty = std::move(dirty);
+		m_WorldMatrices = std::move(worldMatrices);
+	}
+
+	void TransformHierarchy::UpdateRange(uint begin, uint end)
+	{
+		uint batch[c_BatchSize];
+		uint batchSize = 0;
+		for (uint i = begin; i < end; ++i)
+		{
+			const int parent = m_Parents[i];
+			if (parent >= 0 && m_Dirty[parent])
+			{
+				// The parent's matrix must be final before the node is composed, which it isn't while it waits in
+				// the batch. With nodes ordered by depth this only happens when a new level starts.
+				if (batchSize && static_cast<uint>(parent) >= batch[0])
+				{
+					ComposeBatch(batch, batchSize);
+					batchSize = 0;
+				}
+				m_Dirty[i] = 1;
+			}
+
+			if (m_Dirty[i])
+			{
+				batch[batchSize++] = i;
+				if (batchSize == c_BatchSize)
+				{
+					ComposeBatch(batch, batchSize);
+					batchSize = 0;
+				}
+			}
+		}
+		if (batchSize)
+		{
+			ComposeBatch(batch, batchSize);
+		}
+
+		// Flags are cleared last because descendants test their parent's flag
+		std::memset(m_Dirty.Data() + begin, 0, end - begin);
+	}
+
+	void TransformHierarchy::ComposeBatch(const uint* indices, uint count)
+	{
+		Vector3 translations[c_BatchSize] = {};
+		Quaternion rotations[c_BatchSize] = {};
+		Vector3 scales[c_BatchSize] = {};
+		for (uint i = 0; i < count; ++i)
+		{
+			const Transform& local = m_Locals[indices[i]];
+			translations[i] = local.position;
+			rotations[i] = local.rotation;
+			scales[i] = local.scale;
+		}
+
+		Matrix4 locals[c_BatchSize];
+		Matrix4::CreateTRSBatch(translations, rotations, scales, locals, count);
+
+		// Roots are done, children are packed to the front and multiplied by their parents together. Points are row
+		// vectors so a child's world matrix is its local matrix times its parent's.
+		Matrix4 parentMatrices[c_BatchSize];
+		uint childIndices[c_BatchSize];
+		uint childCount = 0;
+		for (uint i = 0; i < count; ++i)
+		{
+			const uint index = indices[i];
+			const int parent = m_Parents[index];
+			if (parent < 0)
+			{
+				m_WorldMatrices[index] = locals[i];
+			}
+			else
+			{
+				locals[childCount] = locals[i];
+				parentMatrices[childCount] = m_WorldMatrices[parent];
+				childIndices[childCount++] = index;
+			}
+		}
+
+		Matrix4::MultiplyBatch(locals, parentMatrices, locals, childCount);
+		for (uint i = 0; i < childCount; ++i)
+		{
+			m_WorldMatrices[childIndices[i]] = locals[i];
+		}
+	}
+}
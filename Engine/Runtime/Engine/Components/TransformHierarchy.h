@@ -0,0 +1,90 @@
+#pragma once
+
+#include "EngineMacros.h"
+#include "Core.h"
+#include "Components.h"
+#include "Math/Matrix4.h"
+#include "Memory/HandlePool.h"
+
+namespace tyr
+{
+	/// Computes world matrices of a hierarchy of transforms.
+	///
+	/// - Nodes are kept sorted so that each root's subtree is contiguous and, within groups of root subtrees, nodes are
+	///   ordered by depth. Parents therefore always come before their children and a level's nodes don't depend on
+	///   each other. Adding, removing and reparenting nodes re-sorts the hierarchy on the next Update().
+	/// - Setting a node's local transform marks it dirty. Update() propagates dirty flags to descendants in the same
+	///   pass that recomputes them, so unchanged subtrees cost a flag test per node.
+	/// - Dirty nodes are composed in batches with Matrix4::CreateTRSBatch() and Matrix4::MultiplyBatch(), and the
+	///   groups of root subtrees are updated in parallel on the job system.
+	/// - World matrices are stored in node order in a contiguous array that can be copied straight into an instance
+	///   buffer. Parents are stored as indices into the same order, like ComponentTransform::parentIndex.
+	class TYR_ENGINE_EXPORT TransformHierarchy final : INonCopyable
+	{
+	public:
+		static constexpr uint c_InvalidHandle = HandlePool<uint>::c_InvalidHandle;
+		// Root subtrees are grouped into ranges of at least this many nodes for the job system
+		static constexpr uint c_GrainSize = 4096;
+		// Dirty nodes are composed this many at a time
+		static constexpr uint c_BatchSize = 64;
+
+		TransformHierarchy();
+
+		~TransformHierarchy();
+
+		/// Adds a node under parent, or as a root if parent is c_InvalidHandle, and returns its handle.
+		uint AddNode(const Transform& local, uint parent = c_InvalidHandle);
+
+		/// Removes a node. Its children move to its parent and keep their local transforms.
+		void RemoveNode(uint handle);
+
+		/// Moves a node and its subtree under parent, or makes it a root if parent is c_InvalidHandle. The parent must
+		/// not be in the node's subtree.
+		void SetParent(uint handle, uint parent);
+
+		void SetLocal(uint handle, const Transform& local);
+
+		const Transform& GetLocal(uint handle) const { return m_Locals[GetIndex(handle)]; }
+
+		/// Re-sorts the nodes if the hierarchy changed and recomputes the world matrices of dirty nodes and their
+		/// descendants.
+		void Update();
+
+		/// Returns the node's index in GetWorldMatrices(). Indices change when Update() re-sorts the nodes.
+		uint GetIndex(uint handle) const { return m_Indices.GetObjectRef(handle); }
+
+		const Matrix4& GetWorldMatrix(uint handle) const { return m_WorldMatrices[GetIndex(handle)]; }
+
+		/// World matrices in node order. Valid after Update().
+		const Matrix4* GetWorldMatrices() const { return m_WorldMatrices.Data(); }
+
+		uint GetNodeCount() const { return m_WorldMatrices.Size(); }
+
+		/// Increments every time Update() re-sorts the nodes, so that users of indices know when to refresh them.
+		uint GetOrderVersion() const { return m_OrderVersion; }
+
+	private:
+		/// Drops removed nodes, sorts the rest and splits them into ranges of root subtrees.
+		void Sort();
+
+		/// Propagates dirty flags and recomputes the world matrices of the dirty nodes in a range of root subtrees.
+		void UpdateRange(uint begin, uint end);
+
+		/// Computes the world matrices of dirty nodes whose parents are already up to date.
+		void ComposeBatch(const uint* indices, uint count);
+
+		// Maps handles to indices
+		HandlePool<uint> m_Indices;
+		// Handle of each node, c_InvalidHandle for nodes removed since the last sort
+		Array<uint> m_Handles;
+		Array<Transform> m_Locals;
+		// Index of each node's parent or -1 for roots
+		Array<int> m_Parents;
+		Array<uint8> m_Dirty;
+		Array<Matrix4> m_WorldMatrices;
+		// Index of the first node of each range of root subtrees followed by the node count
+		Array<uint> m_RangeBegins;
+		uint m_OrderVersion;
+		bool m_NeedsSort;
+	};
+}
@@ -0,0 +1,213 @@
+#include "Archetype.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// Component arrays start on this boundary so that they can be loaded with SIMD instructions
+		constexpr uint c_ColumnAlignment = 16;
+
+		uint AlignUp(uint value, uint alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	Archetype::Archetype(ComponentMask mask)
+		: m_Mask(mask)
+		, m_ChunkCapacity(0)
+		, m_EntityCount(0)
+	{
+		for (uint i = 0; i < c_MaxComponentTypes; ++i)
+		{
+			m_Offsets[i] = c_NoColumn;
+			m_AddEdges[i] = c_NoArchetype;
+			m_RemoveEdges[i] = c_NoArchetype;
+		}
+		ComputeLayout();
+	}
+
+	Archetype::~Archetype()
+	{
+		Clear();
+	}
+
+	void Archetype::ComputeLayout()
+	{
+		const ComponentRegistry& registry = ComponentRegistry::Instance();
+		uint rowSize = sizeof(Entity);
+		for (uint id = 0; id < c_MaxComponentTypes; ++id)
+		{
+			if (HasComponent(static_cast<ComponentId>(id)) && registry.GetInfo(static_cast<ComponentId>(id)).size)
+			{
+				TYR_ASSERT(registry.GetInfo(static_cast<ComponentId>(id)).alignment <= c_CacheLineSize);
+				m_Columns.Add(static_cast<ComponentId>(id));
+				rowSize += registry.GetInfo(static_cast<ComponentId>(id)).size;
+			}
+		}
+
+		// Start from the capacity that ignores padding and shrink it until the padded arrays fit
+		for (uint capacity = c_ChunkSize / rowSize; capacity > 0; --capacity)
+		{
+			uint offset = capacity * sizeof(Entity);
+			for (ComponentId id : m_Columns)
+			{
+				const ComponentInfo& info = registry.GetInfo(id);
+				offset = AlignUp(offset, std::max(info.alignment, c_ColumnAlignment));
+				m_Offsets[id] = static_cast<uint16>(offset);
+				offset += capacity * info.size;
+			}
+			if (offset <= c_ChunkSize)
+			{
+				m_ChunkCapacity = capacity;
+				break;
+			}
+		}
+		TYR_ASSERT(m_ChunkCapacity > 0);
+	}
+
+	Entity Archetype::GetEntity(uint row) const
+	{
+		return GetEntities(m_Chunks[row / m_ChunkCapacity])[row % m_ChunkCapacity];
+	}
+
+	void* Archetype::GetComponent(uint row, ComponentId id) const
+	{
+		uint8* components = static_cast<uint8*>(GetComponents(m_Chunks[row / m_ChunkCapacity], id));
+		if (!components)
+		{
+			return nullptr;
+		}
+		return components + (row % m_ChunkCapacity) * ComponentRegistry::Instance().GetInfo(id).size;
+	}
+
+	uint Archetype::AddRow(Entity entity)
+	{
+		const uint row = m_EntityCount;
+		const uint chunkIndex = row / m_ChunkCapacity;
+		if (chunkIndex == m_Chunks.Size())
+		{
+			m_Chunks.Add({ static_cast<uint8*>(AllocAligned(c_ChunkSize, c_CacheLineSize)), 0 });
+		}
+
+		ArchetypeChunk& chunk = m_Chunks[chunkIndex];
+		GetEntities(chunk)[chunk.count++] = entity;
+		++m_EntityCount;
+		return row;
+	}
+
+	Entity Archetype::RemoveRow(uint row)
+	{
+		TYR_ASSERT(row < m_EntityCount);
+		const uint lastRow = m_EntityCount - 1;
+		Entity moved = c_InvalidEntity;
+		if (row != lastRow)
+		{
+			MoveRow(row, lastRow);
+			moved = GetEntity(row);
+		}
+
+		--m_Chunks[lastRow / m_ChunkCapacity].count;
+		--m_EntityCount;
+
+		// Keep at most one spare chunk
+		while (m_Chunks.Size() > GetChunkCount() + 1)
+		{
+			FreeAligned(m_Chunks.Back().data);
+			m_Chunks.PopBack();
+		}
+		return moved;
+	}
+
+	void Archetype::MoveRow(uint dstRow, uint srcRow)
+	{
+		const ComponentRegistry& registry = ComponentRegistry::Instance();
+		const ArchetypeChunk& dstChunk = m_Chunks[dstRow / m_ChunkCapacity];
+		const ArchetypeChunk& srcChunk = m_Chunks[srcRow / m_ChunkCapacity];
+		const uint dstIndex = dstRow % m_ChunkCapacity;
+		const uint srcIndex = srcRow % m_ChunkCapacity;
+
+		GetEntities(dstChunk)[dstIndex] = GetEntities(srcChunk)[srcIndex];
+		for (ComponentId id : m_Columns)
+		{
+			const ComponentInfo& info = registry.GetInfo(id);
+			uint8* dst = dstChunk.data + m_Offsets[id] + dstIndex * info.size;
+			uint8* src = srcChunk.data + m_Offsets[id] + srcIndex * info.size;
+			if (info.relocate)
+			{
+				info.relocate(dst, src, 1);
+			}
+			else
+			{
+				std::memcpy(dst, src, info.size);
+			}
+		}
+	}
+
+	void Archetype::ConstructComponents(uint row, ComponentMask mask)
+	{
+		const ComponentRegistry& registry = ComponentRegistry::Instance();
+		for (ComponentId id : m_Columns)
+		{
+			if ((mask >> id) & 1)
+			{
+				registry.GetInfo(id).construct(GetComponent(row, id), 1);
+			}
+		}
+	}
+
+	void Archetype::DestructComponents(uint row, ComponentMask mask)
+	{
+		const ComponentRegistry& registry = ComponentRegistry::Instance();
+		for (ComponentId id : m_Columns)
+		{
+			const ComponentInfo& info = registry.GetInfo(id);
+			if (((mask >> id) & 1) && info.destruct)
+			{
+				info.destruct(GetComponent(row, id), 1);
+			}
+		}
+	}
+
+	void Archetype::RelocateComponents(uint row, Archetype& source, uint sourceRow)
+	{
+		const ComponentRegistry& registry = ComponentRegistry::Instance();
+		for (ComponentId id : m_Columns)
+		{
+			const ComponentInfo& info = registry.GetInfo(id);
+			void* dst = GetComponent(row, id);
+			if (!source.HasComponent(id))
+			{
+				info.construct(dst, 1);
+			}
+			else if (info.relocate)
+			{
+				info.relocate(dst, source.GetComponent(sourceRow, id), 1);
+			}
+			else
+			{
+				std::memcpy(dst, source.GetComponent(sourceRow, id), info.size);
+			}
+		}
+		source.DestructComponents(sourceRow, source.m_Mask & ~m_Mask);
+	}
+
+	void Archetype::Clear()
+	{
+		const ComponentRegistry& registry = ComponentRegistry::Instance();
+		for (const ArchetypeChunk& chunk : m_Chunks)
+		{
+			for (ComponentId id : m_Columns)
+			{
+				const ComponentInfo& info = registry.GetInfo(id);
+				if (info.destruct && chunk.count)
+				{
+					info.destruct(GetComponents(chunk, id), chunk.count);
+				}
+			}
+			FreeAligned(chunk.data);
+		}
+		m_Chunks.Clear();
+		m_EntityCount = 0;
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ComponentRegistry.h"
+
+namespace tyr
+{
+	/// Fixed size block of memory holding the entities of an archetype and an array per component type
+	struct ArchetypeChunk
+	{
+		uint8* data;
+		uint count;
+	};
+
+	/// Stores every entity that has exactly the same set of components. Entities are packed into chunks in order of
+	/// their row so that every chunk but the last is full. Rows are removed by moving the last row into them.
+	class TYR_ENGINE_EXPORT Archetype final : INonCopyable
+	{
+	public:
+		static constexpr uint c_ChunkSize = 16 * 1024;
+		static constexpr uint c_NoArchetype = ~0u;
+
+		explicit Archetype(ComponentMask mask);
+
+		~Archetype();
+
+		ComponentMask GetMask() const { return m_Mask; }
+
+		bool HasComponent(ComponentId id) const { return (m_Mask >> id) & 1; }
+
+		uint GetEntityCount() const { return m_EntityCount; }
+
+		/// Returns the number of entities a chunk holds.
+		uint GetChunkCapacity() const { return m_ChunkCapacity; }
+
+		/// Returns the number of chunks that hold entities.
+		uint GetChunkCount() const { return (m_EntityCount + m_ChunkCapacity - 1) / m_ChunkCapacity; }
+
+		const ArchetypeChunk& GetChunk(uint index) const { return m_Chunks[index]; }
+
+		Entity* GetEntities(const ArchetypeChunk& chunk) const { return reinterpret_cast<Entity*>(chunk.data); }
+
+		/// Returns the array of components of a type in the chunk. Returns null for tags and types the archetype
+		/// doesn't have.
+		void* GetComponents(const ArchetypeChunk& chunk, ComponentId id) const
+		{
+			const uint16 offset = m_Offsets[id];
+			return offset == c_NoColumn ? nullptr : chunk.data + offset;
+		}
+
+		Entity GetEntity(uint row) const;
+
+		void* GetComponent(uint row, ComponentId id) const;
+
+		/// Adds a row for the entity at the end and returns it. The components are left unconstructed.
+		uint AddRow(Entity entity);
+
+		/// Removes a row by moving the last row into it. The row's components must already have been destroyed or moved
+		/// out. Returns the entity that was moved into the row, or c_InvalidEntity if the row was the last.
+		Entity RemoveRow(uint row);
+
+		/// Default constructs the components of a row that are in mask.
+		void ConstructComponents(uint row, ComponentMask mask);
+
+		/// Destroys the components of a row that are in mask.
+		void DestructComponents(uint row, ComponentMask mask);
+
+		/// Moves the components that both archetypes have from a row of source to a row of this archetype, destroys
+		/// the source components that this archetype doesn't have and default constructs the rest.
+		void RelocateComponents(uint row, Archetype& source, uint sourceRow);
+
+		/// Destroys every component and frees the chunks.
+		void Clear();
+
+		/// Archetypes reached by adding or removing a single component, cached by the entity manager
+		uint GetAddEdge(ComponentId id) const { return m_AddEdges[id]; }
+
+		uint GetRemoveEdge(ComponentId id) const { return m_RemoveEdges[id]; }
+
+		void SetAddEdge(ComponentId id, uint archetype) { m_AddEdges[id] = archetype; }
+
+		void SetRemoveEdge(ComponentId id, uint archetype) { m_RemoveEdges[id] = archetype; }
+
+	private:
+		static constexpr uint16 c_NoColumn = 0xFFFF;
+
+		void ComputeLayout();
+
+		void MoveRow(uint dstRow, uint srcRow);
+
+		ComponentMask m_Mask;
+		// Components with storage in increasing order of id
+		LocalArray<ComponentId, c_MaxComponentTypes> m_Columns;
+		// Byte offset of each component's array in a chunk
+		uint16 m_Offsets[c_MaxComponentTypes];
+		uint m_ChunkCapacity;
+		uint m_EntityCount;
+		// Chunks past the last row are spares kept to avoid freeing and allocating when the count moves back and forth
+		Array<ArchetypeChunk> m_Chunks;
+		uint m_AddEdges[c_MaxComponentTypes];
+		uint m_RemoveEdges[c_MaxComponentTypes];
+	};
+}
@@ -0,0 +1,34 @@
+#include "ComponentRegistry.h"
+
+namespace tyr
+{
+	ComponentRegistry& ComponentRegistry::Instance()
+	{
+		static ComponentRegistry registry;
+		return registry;
+	}
+
+	ComponentRegistry::ComponentRegistry()
+		: m_Count(0)
+	{
+
+	}
+
+	ComponentId ComponentRegistry::Register(const ComponentInfo& info)
+	{
+		LockGuard guard(m_Mutex);
+
+		const Id64 key(info.name);
+		const ComponentId* existing = m_Ids.Find(key);
+		if (existing)
+		{
+			return *existing;
+		}
+
+		TYR_ASSERT(m_Count < c_MaxComponentTypes);
+		const ComponentId id = static_cast<ComponentId>(m_Count++);
+		m_Infos[id] = info;
+		m_Ids.Insert(key, id);
+		return id;
+	}
+}
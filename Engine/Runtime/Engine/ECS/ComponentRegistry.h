@@ -0,0 +1,125 @@
+#pragma once
+
+#include "EngineMacros.h"
+#include "Core.h"
+#include "Identifiers/Identifiers.h"
+#include "Threading/Threading.h"
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace tyr
+{
+	/// Generational handle of an entity
+	using Entity = uint;
+	static constexpr Entity c_InvalidEntity = ~0u;
+
+	using ComponentId = uint8;
+	// Set of component types with one bit per component id
+	using ComponentMask = uint64;
+	static constexpr uint c_MaxComponentTypes = 64;
+
+	/// Layout and lifetime functions of a component type. Archetype chunks store components without their types so they
+	/// construct, move and destroy them through these. Empty types are tags that have a size of zero and no storage.
+	struct ComponentInfo
+	{
+		using ConstructFunc = void(*)(void* dst, uint count);
+		using DestructFunc = void(*)(void* dst, uint count);
+		// Move constructs count components into dst and destroys the moved from components
+		using RelocateFunc = void(*)(void* dst, void* src, uint count);
+
+		const char* name;
+		uint size;
+		uint alignment;
+		ConstructFunc construct;
+		// Null if the type is trivially destructible
+		DestructFunc destruct;
+		// Null if the type is trivially copyable, in which case components are moved with memcpy
+		RelocateFunc relocate;
+
+		template<typename T>
+		static ComponentInfo Create(const char* name)
+		{
+			TYR_STATIC_ASSERT(std::is_default_constructible_v<T> && std::is_move_constructible_v<T>,
+				"Components must be default and move constructible");
+
+			ComponentInfo info;
+			info.name = name;
+			info.size = std::is_empty_v<T> ? 0 : sizeof(T);
+			info.alignment = alignof(T);
+			info.construct = [](void* dst, uint count)
+			{
+				T* components = static_cast<T*>(dst);
+				for (uint i = 0; i < count; ++i)
+				{
+					new (&components[i]) T();
+				}
+			};
+			info.destruct = nullptr;
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				info.destruct = [](void* dst, uint count)
+				{
+					T* components = static_cast<T*>(dst);
+					for (uint i = 0; i < count; ++i)
+					{
+						components[i].~T();
+					}
+				};
+			}
+			info.relocate = nullptr;
+			if constexpr (!std::is_trivially_copyable_v<T>)
+			{
+				info.relocate = [](void* dst, void* src, uint count)
+				{
+					T* to = static_cast<T*>(dst);
+					T* from = static_cast<T*>(src);
+					for (uint i = 0; i < count; ++i)
+					{
+						new (&to[i]) T(std::move(from[i]));
+						from[i].~T();
+					}
+				};
+			}
+			return info;
+		}
+	};
+
+	/// Assigns ids to component types. Types are registered by name, so every module that uses a type gets the same id.
+	class TYR_ENGINE_EXPORT ComponentRegistry final : INonCopyable
+	{
+	public:
+		static ComponentRegistry& Instance();
+
+		/// Returns the id of the type with the info's name, registering it if this is the first time it's seen.
+		/// Thread safe.
+		ComponentId Register(const ComponentInfo& info);
+
+		const ComponentInfo& GetInfo(ComponentId id) const { return m_Infos[id]; }
+
+	private:
+		ComponentRegistry();
+		~ComponentRegistry() = default;
+
+		Mutex m_Mutex;
+		HashMap<Id64, ComponentId> m_Ids;
+		ComponentInfo m_Infos[c_MaxComponentTypes];
+		uint m_Count;
+	};
+
+	/// Returns the id of a component type, registering it on first use.
+	template<typename T>
+	ComponentId GetComponentId()
+	{
+		// The function's signature names the type, which makes it a name that is unique per type
+		static const ComponentId id = ComponentRegistry::Instance().Register(ComponentInfo::Create<T>(__PRETTY_FUNCTION__));
+		return id;
+	}
+
+	/// Returns the mask with the bits of the component types set.
+	template<typename... Ts>
+	ComponentMask GetComponentMask()
+	{
+		return (ComponentMask(0) | ... | (ComponentMask(1) << GetComponentId<Ts>()));
+	}
+}
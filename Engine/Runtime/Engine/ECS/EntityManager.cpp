@@ -0,0 +1,185 @@
+#include "EntityManager.h"
+#include <bit>
+
+namespace tyr
+{
+	EntityQuery::EntityQuery(EntityManager& manager, ComponentMask all, ComponentMask none)
+		: m_Manager(&manager)
+		, m_All(all)
+		, m_None(none)
+		, m_CheckedCount(0)
+	{
+		TYR_ASSERT((all & none) == 0);
+	}
+
+	void EntityQuery::Update()
+	{
+		const uint archetypeCount = m_Manager->GetArchetypeCount();
+		for (; m_CheckedCount < archetypeCount; ++m_CheckedCount)
+		{
+			const Archetype& archetype = m_Manager->GetArchetype(m_CheckedCount);
+			const ComponentMask mask = archetype.GetMask();
+			if ((mask & m_All) == m_All && (mask & m_None) == 0)
+			{
+				m_Archetypes.Add(&archetype);
+			}
+		}
+	}
+
+	uint EntityQuery::GetEntityCount()
+	{
+		Update();
+		uint count = 0;
+		for (const Archetype* archetype : m_Archetypes)
+		{
+			count += archetype->GetEntityCount();
+		}
+		return count;
+	}
+
+	EntityManager::EntityManager()
+	{
+		// Entities without components live in the empty archetype
+		GetOrCreateArchetype(0);
+	}
+
+	EntityManager::~EntityManager()
+	{
+		Clear();
+	}
+
+	Entity EntityManager::CreateEntity(ComponentMask mask)
+	{
+		const uint archetypeIndex = GetOrCreateArchetype(mask);
+		Archetype& archetype = *m_Archetypes[archetypeIndex];
+
+		Entity entity;
+		EntityRecord* record = m_Entities.Create(entity);
+		record->archetype = archetypeIndex;
+		record->row = archetype.AddRow(entity);
+		archetype.ConstructComponents(record->row, mask);
+		return entity;
+	}
+
+	void EntityManager::DestroyEntity(Entity entity)
+	{
+		const EntityRecord record = GetRecord(entity);
+		Archetype& archetype = *m_Archetypes[record.archetype];
+		archetype.DestructComponents(record.row, archetype.GetMask());
+		RemoveRow(archetype, record.row);
+		m_Entities.Delete(entity);
+	}
+
+	void EntityManager::Clear()
+	{
+		for (const URef<Archetype>& archetype : m_Archetypes)
+		{
+			const uint chunkCount = archetype->GetChunkCount();
+			for (uint i = 0; i < chunkCount; ++i)
+			{
+				const ArchetypeChunk& chunk = archetype->GetChunk(i);
+				const Entity* entities = archetype->GetEntities(chunk);
+				for (uint j = 0; j < chunk.count; ++j)
+				{
+					m_Entities.Delete(entities[j]);
+				}
+			}
+			archetype->Clear();
+		}
+	}
+
+	void EntityManager::AddComponents(Entity entity, ComponentMask mask)
+	{
+		const uint archetype = GetRecord(entity).archetype;
+		const ComponentMask current = m_Archetypes[archetype]->GetMask();
+		if ((current | mask) != current)
+		{
+			MoveEntity(entity, GetTargetArchetype(archetype, current | mask));
+		}
+	}
+
+	void EntityManager::RemoveComponents(Entity entity, ComponentMask mask)
+	{
+		const uint archetype = GetRecord(entity).archetype;
+		const ComponentMask current = m_Archetypes[archetype]->GetMask();
+		if ((current & ~mask) != current)
+		{
+			MoveEntity(entity, GetTargetArchetype(archetype, current & ~mask));
+		}
+	}
+
+	void* EntityManager::GetComponent(Entity entity, ComponentId id) const
+	{
+		const EntityRecord& record = GetRecord(entity);
+		const Archetype& archetype = *m_Archetypes[record.archetype];
+		return archetype.HasComponent(id) ? archetype.GetComponent(record.row, id) : nullptr;
+	}
+
+	uint EntityManager::GetOrCreateArchetype(ComponentMask mask)
+	{
+		const uint* existing = m_ArchetypeIndices.Find(mask);
+		if (existing)
+		{
+			return *existing;
+		}
+
+		const uint index = m_Archetypes.Size();
+		m_Archetypes.Add(MakeURef<Archetype>(mask));
+		m_ArchetypeIndices.Insert(mask, index);
+		return index;
+	}
+
+	uint EntityManager::GetTargetArchetype(uint archetype, ComponentMask mask)
+	{
+		Archetype& source = *m_Archetypes[archetype];
+		const ComponentMask difference = source.GetMask() ^ mask;
+		if (std::popcount(difference) != 1)
+		{
+			return GetOrCreateArchetype(mask);
+		}
+
+		const ComponentId id = static_cast<ComponentId>(std::countr_zero(difference));
+		const bool adding = (mask & difference) != 0;
+		uint target = adding ? source.GetAddEdge(id) : source.GetRemoveEdge(id);
+		if (target == Archetype::c_NoArchetype)
+		{
+			target = GetOrCreateArchetype(mask);
+			// Creating the archetype may have moved the array of archetypes but not the archetypes themselves
+			Archetype& destination = *m_Archetypes[target];
+			if (adding)
+			{
+				source.SetAddEdge(id, target);
+				destination.SetRemoveEdge(id, archetype);
+			}
+			else
+			{
+				source.SetRemoveEdge(id, target);
+				destination.SetAddEdge(id, archetype);
+			}
+		}
+		return target;
+	}
+
+	void EntityManager::MoveEntity(Entity entity, uint archetype)
+	{
+		EntityRecord& record = m_Entities.GetObjectRef(entity);
+		Archetype& source = *m_Archetypes[record.archetype];
+		Archetype& destination = *m_Archetypes[archetype];
+
+		const uint row = destination.AddRow(entity);
+		destination.RelocateComponents(row, source, record.row);
+		RemoveRow(source, record.row);
+
+		record.archetype = archetype;
+		record.row = row;
+	}
+
+	void EntityManager::RemoveRow(Archetype& archetype, uint row)
+	{
+		const Entity moved = archetype.RemoveRow(row);
+		if (moved != c_InvalidEntity)
+		{
+			m_Entities.GetObjectRef(moved).row = row;
+		}
+	}
+}
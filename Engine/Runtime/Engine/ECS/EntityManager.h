@@ -0,0 +1,253 @@
+#pragma once
+
+#include "Archetype.h"
+#include "Memory/HandlePool.h"
+#include "Memory/MemoryTypes.h"
+#include "Threading/Parallel.h"
+#include <tuple>
+
+namespace tyr
+{
+	class EntityManager;
+
+	/// View of one chunk of an archetype passed to query callbacks
+	class EntityChunk
+	{
+	public:
+		EntityChunk(const Archetype& archetype, const ArchetypeChunk& chunk)
+			: m_Archetype(&archetype)
+			, m_Chunk(&chunk)
+		{ }
+
+		uint Size() const { return m_Chunk->count; }
+
+		const Entity* GetEntities() const { return m_Archetype->GetEntities(*m_Chunk); }
+
+		/// Returns the chunk's array of components of type T, or null if the archetype doesn't have T.
+		template<typename T>
+		T* GetComponents() const
+		{
+			return static_cast<T*>(m_Archetype->GetComponents(*m_Chunk, GetComponentId<T>()));
+		}
+
+		template<typename T>
+		bool HasComponent() const { return m_Archetype->HasComponent(GetComponentId<T>()); }
+
+	private:
+		const Archetype* m_Archetype;
+		const ArchetypeChunk* m_Chunk;
+	};
+
+	/// Cached list of the archetypes that have every component in an all mask and none in a none mask. The list is brought
+	/// up to date with archetypes created since the last use whenever the query is run, so it is only rebuilt
+	/// incrementally. Iteration walks the matching chunks linearly.
+	///
+	/// Callbacks may modify components but must not add or remove entities or components.
+	class TYR_ENGINE_EXPORT EntityQuery final
+	{
+	public:
+		EntityQuery(EntityManager& manager, ComponentMask all, ComponentMask none = 0);
+
+		/// Calls func(EntityChunk&) for every chunk of the matching archetypes.
+		template<typename Func>
+		void ForEachChunk(Func&& func);
+
+		/// Same as ForEachChunk() with the chunks processed in parallel on the job system.
+		template<typename Func>
+		void ParallelForEachChunk(Func&& func);
+
+		/// Calls func(Entity, Ts&...) for every matching entity. Every T must be in the all mask.
+		template<typename... Ts, typename Func>
+		void ForEach(Func&& func);
+
+		/// Same as ForEach() with the chunks processed in parallel on the job system.
+		template<typename... Ts, typename Func>
+		void ParallelForEach(Func&& func);
+
+		/// Returns the number of matching entities.
+		uint GetEntityCount();
+
+	private:
+		/// Adds the archetypes created since the last update that match.
+		void Update();
+
+		template<typename... Ts, typename Func>
+		static void ForEachInChunk(const EntityChunk& chunk, Func& func)
+		{
+			TYR_STATIC_ASSERT((!std::is_empty_v<Ts> && ...), "Tags have no storage to pass to the callback");
+			const Entity* entities = chunk.GetEntities();
+			const std::tuple<Ts*...> columns(chunk.GetComponents<Ts>()...);
+			for (uint i = 0; i < chunk.Size(); ++i)
+			{
+				std::apply([&](Ts*... components) { func(entities[i], components[i]...); }, columns);
+			}
+		}
+
+		EntityManager* m_Manager;
+		ComponentMask m_All;
+		ComponentMask m_None;
+		Array<const Archetype*> m_Archetypes;
+		// Number of the manager's archetypes already checked
+		uint m_CheckedCount;
+		// Chunks of the last parallel run, reused to avoid allocating every frame
+		Array<EntityChunk> m_Chunks;
+	};
+
+	/// Owns the entities of a world and their components, which are stored in archetypes of 16 KB chunks with an array per
+	/// component type.
+	///
+	/// - Entities are generational handles, so stale handles can be detected with IsValid().
+	/// - Creating and destroying entities and adding and removing components are O(1). Rows freed in an archetype are
+	///   filled by moving the last row into them. Adding or removing a component moves the entity to another archetype,
+	///   which is found through a cached edge after the first time.
+	/// - Structural changes are not thread safe and must not happen while a query runs. Queries may run on any thread.
+	class TYR_ENGINE_EXPORT EntityManager final : INonCopyable
+	{
+	public:
+		EntityManager();
+
+		~EntityManager();
+
+		/// Creates an entity with default constructed components.
+		Entity CreateEntity(ComponentMask mask = 0);
+
+		template<typename... Ts>
+		Entity CreateEntity() { return CreateEntity(GetComponentMask<Ts...>()); }
+
+		void DestroyEntity(Entity entity);
+
+		/// Destroys every entity. Archetypes are kept so that queries stay valid.
+		void Clear();
+
+		bool IsValid(Entity entity) const { return m_Entities.IsValid(entity); }
+
+		uint GetEntityCount() const { return m_Entities.GetObjectCount(); }
+
+		ComponentMask GetMask(Entity entity) const { return m_Archetypes[GetRecord(entity).archetype]->GetMask(); }
+
+		/// Adds default constructed components that the entity doesn't already have.
+		void AddComponents(Entity entity, ComponentMask mask);
+
+		/// Removes the components in mask that the entity has.
+		void RemoveComponents(Entity entity, ComponentMask mask);
+
+		/// Returns the entity's component or null if the entity doesn't have it or it is a tag.
+		void* GetComponent(Entity entity, ComponentId id) const;
+
+		/// Adds a component, assigning it one constructed from args if there are any, and returns it. Returns nothing
+		/// for tags.
+		template<typename T, typename... Args>
+		decltype(auto) AddComponent(Entity entity, Args&&... args)
+		{
+			AddComponents(entity, GetComponentMask<T>());
+			if constexpr (!std::is_empty_v<T>)
+			{
+				T& component = GetComponent<T>(entity);
+				if constexpr (sizeof...(Args) > 0)
+				{
+					component = T(std::forward<Args>(args)...);
+				}
+				return component;
+			}
+		}
+
+		template<typename T>
+		void RemoveComponent(Entity entity) { RemoveComponents(entity, GetComponentMask<T>()); }
+
+		template<typename T>
+		bool HasComponent(Entity entity) const { return (GetMask(entity) & GetComponentMask<T>()) != 0; }
+
+		template<typename T>
+		T& GetComponent(Entity entity) const
+		{
+			T* component = static_cast<T*>(GetComponent(entity, GetComponentId<T>()));
+			TYR_ASSERT(component);
+			return *component;
+		}
+
+		uint GetArchetypeCount() const { return m_Archetypes.Size(); }
+
+		const Archetype& GetArchetype(uint index) const { return *m_Archetypes[index]; }
+
+	private:
+		struct EntityRecord
+		{
+			uint archetype;
+			uint row;
+		};
+
+		const EntityRecord& GetRecord(Entity entity) const { return m_Entities.GetObjectRef(entity); }
+
+		/// Returns the index of the archetype with the mask, creating it if needed.
+		uint GetOrCreateArchetype(ComponentMask mask);
+
+		/// Returns the archetype reached from another by adding or removing components, using the cached edges when
+		/// a single component changes.
+		uint GetTargetArchetype(uint archetype, ComponentMask mask);
+
+		/// Moves the entity to another archetype, keeping the components both have.
+		void MoveEntity(Entity entity, uint archetype);
+
+		/// Removes a row from an archetype and updates the record of the entity moved into it.
+		void RemoveRow(Archetype& archetype, uint row);
+
+		HandlePool<EntityRecord> m_Entities;
+		Array<URef<Archetype>> m_Archetypes;
+		HashMap<ComponentMask, uint> m_ArchetypeIndices;
+	};
+
+	template<typename Func>
+	void EntityQuery::ForEachChunk(Func&& func)
+	{
+		Update();
+		for (const Archetype* archetype : m_Archetypes)
+		{
+			const uint chunkCount = archetype->GetChunkCount();
+			for (uint i = 0; i < chunkCount; ++i)
+			{
+				const EntityChunk chunk(*archetype, archetype->GetChunk(i));
+				func(chunk);
+			}
+		}
+	}
+
+	template<typename Func>
+	void EntityQuery::ParallelForEachChunk(Func&& func)
+	{
+		Update();
+		m_Chunks.Clear();
+		for (const Archetype* archetype : m_Archetypes)
+		{
+			const uint chunkCount = archetype->GetChunkCount();
+			for (uint i = 0; i < chunkCount; ++i)
+			{
+				m_Chunks.Add(EntityChunk(*archetype, archetype->GetChunk(i)));
+			}
+		}
+
+		ParallelFor(m_Chunks.Size(), [&](uint i)
+		{
+			func(static_cast<const EntityChunk&>(m_Chunks[i]));
+		}, 1);
+	}
+
+	template<typename... Ts, typename Func>
+	void EntityQuery::ForEach(Func&& func)
+	{
+		TYR_ASSERT((m_All & GetComponentMask<Ts...>()) == GetComponentMask<Ts...>());
+		ForEachChunk([&](const EntityChunk& chunk)
+		{
+			ForEachInChunk<Ts...>(chunk, func);
+		});
+	}
+
+	template<typename... Ts, typename Func>
+	void EntityQuery::ParallelForEach(Func&& func)
+	{
+		TYR_ASSERT((m_All & GetComponentMask<Ts...>()) == GetComponentMask<Ts...>());
+		ParallelForEachChunk([&](const EntityChunk& chunk)
+		{
+			ForEachInChunk<Ts...>(chunk, func);
+		});
+	}
+}
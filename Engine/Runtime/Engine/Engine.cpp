@@ -9,17 +9,25 @@
 #include "World/WorldManager.h"
 #include "World/WorldModule.h"
 #include "RendererModule.h"
+#include "Rendering/Renderer.h"
 #include "BuildConfig.h"
 #include "World/Camera.h"
 #include "Time/Timer.h"
 #include "Math/Vector2.h"
 #include "RenderAPI/Device.h"
+#include "Threading/JobSystem.h"
+#include "Memory/FrameAllocation.h"
+#include "Profiling/Profiler.h"
+#include "Logging/Logger.h"
+#include "Platform/Platform.h"
+#include "Platform/CPUInfo.h"
 
 namespace tyr
 {
 	Engine::Engine()
 		: m_Initialized(false)
 		, m_LastFrameTime(0)
+		, m_FrameIndex(0)
 	{
 
 	}
@@ -35,6 +43,18 @@ namespace tyr
 	void Engine::Initialize(AppModuleRegistrationCallback appModuleRegistrationCallback)
 	{
 		TYR_ASSERT(!m_Initialized);
+
+		TYR_PROFILE_THREAD_NAME("Main");
+
+		LoggerConfig loggerConfig;
+		loggerConfig.filePath = Platform::c_BinaryDirectory + "/Tyrant.log";
+		Logger::Instance().Initialize(loggerConfig);
+		TYR_LOG_INFO("CPU SIMD level: %s", CPUInfo::GetSIMDLevelName(CPUInfo::GetSIMDLevel()));
+
+		// The main thread becomes worker 0 of the job system
+		JobSystem::Instance().Initialize(JobSystemConfig());
+		// Worker threads get their frame allocators on first use with the same settings
+		FrameAllocator::Create();
 		
 		TYR_REGISTER_MODULE(WindowModule);
 		TYR_REGISTER_MODULE(RendererModule);
@@ -60,6 +80,9 @@ namespace tyr
 		WindowModule* windowModule;
 		TYR_GET_MODULE(WindowModule, windowModule);
 		Window* primaryWindow = windowModule->GetPrimaryWindow();
+		RendererModule* rendererModule;
+		TYR_GET_MODULE(RendererModule, rendererModule);
+		Renderer* renderer = rendererModule->GetRenderer();
 		Timer timer;
 
 		while (primaryWindow->IsActive())
@@ -69,11 +92,18 @@ namespace tyr
 
 			const float deltaTime = static_cast<float>(currentTime - m_LastFrameTime);
 
+			// Back-pressure from the render thread. Waiting before the frame allocator recycles a generation keeps the
+			// allocations of frames still being rendered alive.
+			renderer->WaitForFreeFrame();
+			FrameAllocator::BeginFrame(m_FrameIndex++);
+
 			ModuleManager::Instance().UpdateModules(deltaTime);
 
 			m_LastFrameTime = currentTime;
 
 			primaryWindow->PollEvents();
+
+			TYR_PROFILE_END_FRAME();
 		}
 	}
 
@@ -83,6 +113,11 @@ namespace tyr
 
 		ModuleManager::Instance().ShutdownModules();
 
+		JobSystem::Instance().Shutdown();
+		FrameAllocator::DestroyAll();
+		Logger::Instance().Shutdown();
+		TYR_PROFILE_SHUTDOWN();
+
 		m_Initialized = false;
 	}
 }
\ No newline at end of file
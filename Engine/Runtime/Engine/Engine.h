@@ -23,6 +23,8 @@ namespace tyr
 		bool m_Initialized;
 
 		float m_LastFrameTime;
+
+		uint64 m_FrameIndex;
 	};
 	
 }
\ No newline at end of file
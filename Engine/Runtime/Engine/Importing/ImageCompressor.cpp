@@ -98,6 +98,7 @@ namespace tyr
 
     bool ImageCompressor::CompressImage2D(const Image2DCompressionDesc& desc)
     {
+        TYR_PROFILE_SCOPE("ImageCompressor::CompressImage2D");
         TYR_ASSERT(desc.mipCount > 0);
 
         const nvtt::InputFormat inputFormat = ToNvttInputFormat(desc.inputFormat);
@@ -159,6 +160,7 @@ namespace tyr
 
     bool ImageCompressor::CompressCubemap(const CubemapCompressionDesc& desc)
     {
+        TYR_PROFILE_SCOPE("ImageCompressor::CompressCubemap");
         nvtt::CubeSurface cubeSurface;
         if (!cubeSurface.load(desc.inputFilePath, desc.mip))
         {
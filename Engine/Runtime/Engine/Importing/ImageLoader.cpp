@@ -1,4 +1,5 @@
 #include "ImageLoader.h"
+#include "Profiling/Profiler.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -24,6 +25,7 @@ namespace tyr
 
 	uint8* ImageLoader::LoadImage8U(const char* filePath, int channelCount)
 	{
+		TYR_PROFILE_SCOPE("ImageLoader::LoadImage8U");
 		int width, height, origChannelCount;
 		uint8* image = stbi_load(filePath, &width, &height, &origChannelCount, channelCount);
 		TYR_ASSERT(image != nullptr);
@@ -32,6 +34,7 @@ namespace tyr
 
 	uint16* ImageLoader::LoadImage16U(const char* filePath, int channelCount)
 	{
+		TYR_PROFILE_SCOPE("ImageLoader::LoadImage16U");
 		int width, height, origChannelCount;
 		uint16* image = stbi_load_16(filePath, &width, &height, &origChannelCount, channelCount);
 		TYR_ASSERT(image != nullptr);
@@ -40,6 +43,7 @@ namespace tyr
 
 	float* ImageLoader::LoadImage32F(const char* filePath, int channelCount)
 	{
+		TYR_PROFILE_SCOPE("ImageLoader::LoadImage32F");
 		int width, height, origChannelCount;
 		float* image = stbi_loadf(filePath, &width, &height, &origChannelCount, channelCount);
 		TYR_ASSERT(image != nullptr);
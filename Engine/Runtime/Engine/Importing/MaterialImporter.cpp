@@ -6,6 +6,7 @@
 #include "AssetSystem/AssetUtil.h"
 #include "AssetSystem/AssetRegistry.h"
 #include "AssetSystem/TextureAsset.h"
+#include "Profiling/Profiler.h"
 
 namespace tyr
 {
@@ -17,6 +18,7 @@ namespace tyr
 
 	bool MaterialImporter::ImportAlbedoTexture(const char* outputFolderPath, const char* textureName, const char* albedoPath, bool isSRGB, AssetID& textureID, AssetID* refID) const
 	{
+		TYR_PROFILE_SCOPE("MaterialImporter::ImportAlbedoTexture");
 		ImageInfo info;
 		ImageLoader::LoadImageInfo(albedoPath, info);
 
@@ -367,6 +369,7 @@ namespace tyr
 
 	bool MaterialImporter::ImportPbrMaterial(const PbrMaterialImportDesc& desc) const
 	{
+		TYR_PROFILE_SCOPE("MaterialImporter::ImportPbrMaterial");
 		MaterialAssetFile material;
 		material.type = MaterialType::PBR;
 
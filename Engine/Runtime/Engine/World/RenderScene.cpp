@@ -0,0 +1,30 @@
+#include "RenderScene.h"
+
+namespace tyr
+{
+	RenderScene::RenderScene()
+		: m_ResetPending(true)
+	{
+
+	}
+
+	void RenderScene::WriteDelta(SceneDelta& delta) const
+	{
+		delta.reset |= m_ResetPending;
+		m_RigidMeshInstances.WriteDelta(delta.rigidMeshInstances);
+		m_DirLights.WriteDelta(delta.dirLights);
+		m_PointLights.WriteDelta(delta.pointLights);
+		m_SpotLights.WriteDelta(delta.spotLights);
+		m_Materials.WriteDelta(delta.materials);
+	}
+
+	void RenderScene::ClearChanges()
+	{
+		m_ResetPending = false;
+		m_RigidMeshInstances.ClearChanges();
+		m_DirLights.ClearChanges();
+		m_PointLights.ClearChanges();
+		m_SpotLights.ClearChanges();
+		m_Materials.ClearChanges();
+	}
+}
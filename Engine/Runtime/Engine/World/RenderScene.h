@@ -0,0 +1,53 @@
+#pragma once
+
+#include "EngineMacros.h"
+#include "Core.h"
+#include "SceneObjectTracker.h"
+
+namespace tyr
+{
+	/// The render content of a world: mesh instances, lights and materials. The renderer keeps its own copy which is
+	/// updated from the changes sent each frame, so the cost of a frame depends on how much changed rather than on the
+	/// size of the scene.
+	class TYR_ENGINE_EXPORT RenderScene final : INonCopyable
+	{
+	public:
+		RenderScene();
+
+		SceneObjectTracker<RigidMeshInstance>& GetRigidMeshInstances() { return m_RigidMeshInstances; }
+
+		const SceneObjectTracker<RigidMeshInstance>& GetRigidMeshInstances() const { return m_RigidMeshInstances; }
+
+		SceneObjectTracker<DirectionalLight>& GetDirectionalLights() { return m_DirLights; }
+
+		const SceneObjectTracker<DirectionalLight>& GetDirectionalLights() const { return m_DirLights; }
+
+		SceneObjectTracker<PointLight>& GetPointLights() { return m_PointLights; }
+
+		const SceneObjectTracker<PointLight>& GetPointLights() const { return m_PointLights; }
+
+		SceneObjectTracker<SpotLight>& GetSpotLights() { return m_SpotLights; }
+
+		const SceneObjectTracker<SpotLight>& GetSpotLights() const { return m_SpotLights; }
+
+		SceneObjectTracker<Material>& GetMaterials() { return m_Materials; }
+
+		const SceneObjectTracker<Material>& GetMaterials() const { return m_Materials; }
+
+		/// Appends the changes the renderer hasn't accepted yet to a delta.
+		void WriteDelta(SceneDelta& delta) const;
+
+		/// Forgets the changes once the renderer has accepted the frame they were written to. Until then every delta
+		/// written repeats them.
+		void ClearChanges();
+
+	private:
+		SceneObjectTracker<RigidMeshInstance> m_RigidMeshInstances;
+		SceneObjectTracker<DirectionalLight> m_DirLights;
+		SceneObjectTracker<PointLight> m_PointLights;
+		SceneObjectTracker<SpotLight> m_SpotLights;
+		SceneObjectTracker<Material> m_Materials;
+		// The renderer's copy of the scene may hold another world's content until the first delta is accepted
+		bool m_ResetPending;
+	};
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Core.h"
+#include "RenderUpdate/SceneDelta.h"
+
+namespace tyr
+{
+	/// Stores one kind of scene object on the world side and records which objects were created, modified and destroyed
+	/// since the renderer last accepted a delta. Each changed object is recorded once however often it changes, so
+	/// writing a delta costs one step per changed object and nothing for the rest of the scene.
+	template<typename T>
+	class SceneObjectTracker final
+	{
+	public:
+		SceneObjectId Create(const T& data)
+		{
+			SceneObjectId id;
+			if (m_FreeIds.IsEmpty())
+			{
+				id = m_Objects.Size();
+				m_Objects.Add(data);
+				m_States.Add(0);
+			}
+			else
+			{
+				id = m_FreeIds.Back();
+				m_FreeIds.PopBack();
+				m_Objects[id] = data;
+			}
+
+			m_States[id] = c_Alive;
+			MarkChanged(id, c_Created);
+			++m_Count;
+			return id;
+		}
+
+		/// Destroys an object. Its id is reused once the renderer has accepted the delta that destroys it.
+		void Destroy(SceneObjectId id)
+		{
+			TYR_ASSERT(IsValid(id));
+			m_States[id] &= ~c_Alive;
+			MarkChanged(id, c_Destroyed);
+			--m_Count;
+		}
+
+		/// Returns the object for writing and marks it modified.
+		T& Modify(SceneObjectId id)
+		{
+			TYR_ASSERT(IsValid(id));
+			MarkChanged(id, c_Modified);
+			return m_Objects[id];
+		}
+
+		void Set(SceneObjectId id, const T& data) { Modify(id) = data; }
+
+		const T& Get(SceneObjectId id) const
+		{
+			TYR_ASSERT(IsValid(id));
+			return m_Objects[id];
+		}
+
+		bool IsValid(SceneObjectId id) const { return id < m_States.Size() && (m_States[id] & c_Alive); }
+
+		uint GetCount() const { return m_Count; }
+
+		/// Number of objects changed since the renderer last accepted a delta.
+		uint GetChangeCount() const { return m_Changed.Size(); }
+
+		/// Appends the changes the renderer hasn't accepted yet to a delta. Objects created and destroyed since then are
+		/// left out, and objects created and then modified are sent as created with their current data.
+		void WriteDelta(SceneObjectDelta<T>& delta) const
+		{
+			if (m_Changed.IsEmpty())
+			{
+				return;
+			}
+
+			// Counted first so that each frame allocated stream is allocated once
+			uint createdCount = 0;
+			uint modifiedCount = 0;
+			uint destroyedCount = 0;
+			for (SceneObjectId id : m_Changed)
+			{
+				const uint8 state = m_States[id];
+				if (state & c_Destroyed)
+				{
+					destroyedCount += (state & c_Created) ? 0 : 1;
+				}
+				else if (state & c_Created)
+				{
+					++createdCount;
+				}
+				else
+				{
+					++modifiedCount;
+				}
+			}
+			delta.created.Reserve(delta.created.Size() + createdCount);
+			delta.modified.Reserve(delta.modified.Size() + modifiedCount);
+			delta.destroyed.Reserve(delta.destroyed.Size() + destroyedCount);
+
+			for (SceneObjectId id : m_Changed)
+			{
+				const uint8 state = m_States[id];
+				if (state & c_Destroyed)
+				{
+					if (!(state & c_Created))
+					{
+						delta.destroyed.Add(id);
+					}
+				}
+				else if (state & c_Created)
+				{
+					delta.created.Add({ id, m_Objects[id] });
+				}
+				else
+				{
+					delta.modified.Add({ id, m_Objects[id] });
+				}
+			}
+		}
+
+		/// Forgets the changes once the renderer has accepted the delta they were written to and frees the ids of
+		/// destroyed objects.
+		void ClearChanges()
+		{
+			for (SceneObjectId id : m_Changed)
+			{
+				if (m_States[id] & c_Destroyed)
+				{
+					m_States[id] = 0;
+					m_FreeIds.Add(id);
+				}
+				else
+				{
+					m_States[id] = c_Alive;
+				}
+			}
+			m_Changed.Clear();
+		}
+
+	private:
+		static constexpr uint8 c_Alive = 1 << 0;
+		static constexpr uint8 c_Created = 1 << 1;
+		static constexpr uint8 c_Modified = 1 << 2;
+		static constexpr uint8 c_Destroyed = 1 << 3;
+		static constexpr uint8 c_ChangeMask = c_Created | c_Modified | c_Destroyed;
+
+		void MarkChanged(SceneObjectId id, uint8 change)
+		{
+			if (!(m_States[id] & c_ChangeMask))
+			{
+				m_Changed.Add(id);
+			}
+			m_States[id] |= change;
+		}
+
+		// Indexed by id. Objects of free ids keep their old data.
+		Array<T> m_Objects;
+		Array<uint8> m_States;
+		// Ids with changes the renderer hasn't accepted yet
+		Array<SceneObjectId> m_Changed;
+		Array<SceneObjectId> m_FreeIds;
+		uint m_Count = 0;
+	};
+}
@@ -4,8 +4,6 @@
 
 namespace tyr
 {
-	uint8 World::s_NextSceneIndex = 0;
-
 	World::World()
 		: m_Initialized(false)
 		, m_Camera(nullptr)
@@ -20,14 +18,19 @@ namespace tyr
 		
 	}
 
-	void World::Initialize(const WorldParams& params)
+	void World::Initialize(const WorldParams& params, uint8 sceneIndex)
 	{
 		TYR_ASSERT(!m_Initialized);
+		TYR_ASSERT(sceneIndex < Scene::c_MaxScenes);
 
 		m_Name = params.name;
 		m_Camera = params.camera;
 		m_ViewArea = params.viewArea;
-		m_SceneIndex = s_NextSceneIndex++ % Scene::c_MaxScenes;
+		m_SceneIndex = sceneIndex;
+		m_SpatialIndex = SpatialIndex::Create(params.spatialIndex);
+		m_EntityManager = MakeURef<EntityManager>();
+		m_TransformHierarchy = MakeURef<TransformHierarchy>();
+		m_RenderScene = MakeURef<RenderScene>();
 
 		m_Initialized = true;
 	}
@@ -36,6 +39,10 @@ namespace tyr
 	{
 		TYR_ASSERT(m_Initialized);
 
+		m_RenderScene.reset();
+		m_TransformHierarchy.reset();
+		m_EntityManager.reset();
+		m_SpatialIndex.reset();
 		m_Initialized = false;
 	}
 
@@ -46,6 +53,8 @@ namespace tyr
 			return;
 		}
 
+		m_TransformHierarchy->Update();
+
 		sceneFrame.visible = m_Visible;
 		sceneFrame.view.viewArea = m_ViewArea;
 		sceneFrame.view.camera.position = m_Camera->GetPosition();
@@ -3,6 +3,10 @@
 #include "Core.h"
 #include "Math/Vector3.h"
 #include "Math/Matrix4.h"
+#include "Geometry/SpatialIndex.h"
+#include "ECS/EntityManager.h"
+#include "Components/TransformHierarchy.h"
+#include "RenderScene.h"
 #include "EngineMacros.h"
 #include "Rendering/Scene.h"
 
@@ -17,6 +21,8 @@ namespace tyr
 		SceneViewArea viewArea;
 		// The world is provided the camera but its dimensions will be updated by the world manager when the window resizes
 		Camera* camera = nullptr;
+		// Spatial index over the world's instances
+		SpatialIndexDesc spatialIndex;
 	};
 
 	/// A class that represents a world / scene in an app.
@@ -26,7 +32,8 @@ namespace tyr
 		World();
 		~World();
 
-		void Initialize(const WorldParams& params);
+		/// sceneIndex is the world's slot in each render frame. The world manager keeps it unique among its worlds.
+		void Initialize(const WorldParams& params, uint8 sceneIndex);
 
 		void Shutdown();
 
@@ -52,14 +59,37 @@ namespace tyr
 
 		bool IsVisible() const { return m_Visible; }
 
+		/// Index for culling, light assignment and proximity queries. Objects are added by whoever owns the instances
+		/// and moved when their transforms change.
+		SpatialIndex& GetSpatialIndex() { return *m_SpatialIndex; }
+
+		const SpatialIndex& GetSpatialIndex() const { return *m_SpatialIndex; }
+
+		/// Entities of the world and their components.
+		EntityManager& GetEntityManager() { return *m_EntityManager; }
+
+		const EntityManager& GetEntityManager() const { return *m_EntityManager; }
+
+		/// Transforms of the world's objects. World matrices are recomputed at the start of each update.
+		TransformHierarchy& GetTransformHierarchy() { return *m_TransformHierarchy; }
+
+		const TransformHierarchy& GetTransformHierarchy() const { return *m_TransformHierarchy; }
+
+		/// Render content of the world. Changes are sent to the renderer at the end of each update.
+		RenderScene& GetRenderScene() { return *m_RenderScene; }
+
+		const RenderScene& GetRenderScene() const { return *m_RenderScene; }
+
 	private:
 		friend class WorldManager;
 
-		static uint8 s_NextSceneIndex;
-
 		Name m_Name;
 		Camera* m_Camera;
 		SceneViewArea m_ViewArea;
+		URef<SpatialIndex> m_SpatialIndex;
+		URef<EntityManager> m_EntityManager;
+		URef<TransformHierarchy> m_TransformHierarchy;
+		URef<RenderScene> m_RenderScene;
 		uint8 m_SceneIndex;
 		bool m_Active;
 		bool m_Visible;
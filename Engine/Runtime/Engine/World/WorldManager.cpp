@@ -2,12 +2,16 @@
 #include "BuildConfig.h"
 #include "RendererModule.h"
 #include "Rendering/Renderer.h"
+#include "Threading/Parallel.h"
+#include <bit>
+#include <cstring>
 
 namespace tyr
 {
 	WorldManager::WorldManager()
 		:  m_RenderFrameIndex(0)
 	{
+		std::memset(m_Dependencies, 0, sizeof(m_Dependencies));
 		RendererModule* rendererModule;
 		TYR_GET_MODULE(RendererModule, rendererModule);
 		m_Renderer = rendererModule->GetRenderer();
@@ -15,37 +19,105 @@ namespace tyr
 
 	WorldManager::~WorldManager()
 	{
+		// The render thread may still be reading the render frames
+		m_Renderer->WaitForFrames();
 		RemoveWorlds();
 	}
 
 	void WorldManager::Update(float deltaTime)
 	{
+		TYR_PROFILE_SCOPE("WorldManager::Update");
 		RenderFrame& renderFrame = m_RenderFrames[m_RenderFrameIndex];
 		renderFrame.Clear();
 
 		// TODO: Set this if window has resized
 		renderFrame.windowResize = false;
-		for (World* world : m_Worlds)
+
+		// Worlds update in waves. Each wave holds the worlds whose dependencies updated in earlier waves and its worlds
+		// update concurrently, each writing only its own scene frame.
+		SceneMask updated = 0;
+		while (true)
 		{
-			world->Update(deltaTime, renderFrame.sceneFrames[world->GetSceneIndex()]);
+			LocalArray<World*, c_MaxWorlds> wave;
+			for (World* world : m_Worlds)
+			{
+				const SceneMask bit = 1 << world->GetSceneIndex();
+				if (!(updated & bit) && (m_Dependencies[world->GetSceneIndex()] & ~updated) == 0)
+				{
+					wave.Add(world);
+				}
+			}
+			if (wave.IsEmpty())
+			{
+				break;
+			}
+
+			ParallelFor(wave.Size(), [&](uint i)
+			{
+				UpdateWorld(*wave[i], deltaTime, renderFrame);
+			}, 1);
+
+			for (World* world : wave)
+			{
+				updated |= 1 << world->GetSceneIndex();
+			}
 		}
+		TYR_ASSERT(std::popcount(updated) == static_cast<int>(m_Worlds.Size()));
 
-		m_Renderer->TryAddFrame(&renderFrame);
+		// Worlds only write their own scene frames, so the frame is complete once every wave has finished. A frame the
+		// renderer didn't accept is rebuilt next update with the same changes plus any new ones. Advancing only on
+		// success also keeps frames in the renderer's queue from being overwritten.
+		if (m_Renderer->TryAddFrame(&renderFrame))
+		{
+			for (World* world : m_Worlds)
+			{
+				world->GetRenderScene().ClearChanges();
+			}
+			m_RenderFrameIndex = (m_RenderFrameIndex + 1) % RenderFrame::c_MaxRenderFrames;
+		}
+	}
 
-		m_RenderFrameIndex = (m_RenderFrameIndex + 1) % RenderFrame::c_MaxRenderFrames;
+	void WorldManager::UpdateWorld(World& world, float deltaTime, RenderFrame& renderFrame)
+	{
+		TYR_PROFILE_SCOPE("WorldManager::UpdateWorld");
+		SceneFrame& sceneFrame = renderFrame.sceneFrames[world.GetSceneIndex()];
+		world.Update(deltaTime, sceneFrame);
+		// Inactive worlds still send their changes so that the renderer's copy of the scene stays in sync
+		world.GetRenderScene().WriteDelta(sceneFrame.delta);
 	}
 
 	World* WorldManager::AddWorld(const WorldParams& params)
 	{
-		uint16 index;
-		World* world = m_WorldPool.Create(index);
-		world->Initialize(params);
+		TYR_ASSERT(m_Worlds.Size() < c_MaxWorlds);
+
+		// The lowest scene index not in use so that every world writes its own scene frame
+		SceneMask used = 0;
+		for (World* world : m_Worlds)
+		{
+			used |= 1 << world->GetSceneIndex();
+		}
+		uint8 sceneIndex = 0;
+		while (used & (1 << sceneIndex))
+		{
+			++sceneIndex;
+		}
+
+		uint handle;
+		World* world = m_WorldPool.Create(handle);
+		world->Initialize(params, sceneIndex);
 		m_Worlds.Add(world);
 		return world;
 	}
 
 	void WorldManager::RemoveWorld(World* world)
 	{
+		const uint8 sceneIndex = world->GetSceneIndex();
+		m_Dependencies[sceneIndex] = 0;
+		for (SceneMask& dependencies : m_Dependencies)
+		{
+			dependencies &= ~(1 << sceneIndex);
+		}
+
 		world->Shutdown();
 		for (uint i = 0; i < m_Worlds.Size(); ++i)
 		{
@@ -66,5 +138,38 @@ namespace tyr
 			m_WorldPool.Delete(world);
 		}
 		m_Worlds.Clear();
+		std::memset(m_Dependencies, 0, sizeof(m_Dependencies));
+	}
+
+	void WorldManager::AddDependency(World* world, World* dependency)
+	{
+		TYR_ASSERT(world != dependency);
+		TYR_ASSERT(!DependsOn(*dependency, *world));
+		m_Dependencies[world->GetSceneIndex()] |= 1 << dependency->GetSceneIndex();
+	}
+
+	void WorldManager::RemoveDependency(World* world, World* dependency)
+	{
+		m_Dependencies[world->GetSceneIndex()] &= ~(1 << dependency->GetSceneIndex());
+	}
+
+	bool WorldManager::DependsOn(const World& world, const World& dependency) const
+	{
+		// Follows dependencies breadth first over scene indices until nothing new is reached
+		SceneMask reached = m_Dependencies[world.GetSceneIndex()];
+		SceneMask visited = 0;
+		while (reached != visited)
+		{
+			const SceneMask next = reached & ~visited;
+			visited = reached;
+			for (uint8 i = 0; i < c_MaxWorlds; ++i)
+			{
+				if (next & (1 << i))
+				{
+					reached |= m_Dependencies[i];
+				}
+			}
+		}
+		return (reached & (1 << dependency.GetSceneIndex())) != 0;
 	}
 }
\ No newline at end of file
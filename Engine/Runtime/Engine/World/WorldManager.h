@@ -24,9 +24,27 @@ namespace tyr
 
 		void RemoveWorlds();
 
+		/// Makes world update after dependency finished updating. Worlds without dependencies between them update
+		/// concurrently as jobs, so worlds that share data must depend on each other. Dependencies must not form a
+		/// cycle and are removed with either world.
+		void AddDependency(World* world, World* dependency);
+
+		void RemoveDependency(World* world, World* dependency);
+
 	private:
-		LocalObjectPool<World, c_MaxWorlds, false> m_WorldPool;
+		using SceneMask = uint8;
+		TYR_STATIC_ASSERT(c_MaxWorlds <= sizeof(SceneMask) * 8, "Every world must have a bit in a scene mask");
+
+		/// Updates a world and writes its changes to its own scene frame. Runs on any worker.
+		void UpdateWorld(World& world, float deltaTime, RenderFrame& renderFrame);
+
+		/// Returns true if world depends on dependency directly or through other worlds.
+		bool DependsOn(const World& world, const World& dependency) const;
+
+		HandlePool<World> m_WorldPool;
 		LocalArray<World*, c_MaxWorlds> m_Worlds;
+		// Scene indices of the worlds each world depends on, indexed by scene index
+		SceneMask m_Dependencies[c_MaxWorlds];
 		RenderFrame m_RenderFrames[RenderFrame::c_MaxRenderFrames];
 		Renderer* m_Renderer;
 		uint8 m_RenderFrameIndex;
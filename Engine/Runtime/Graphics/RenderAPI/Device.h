@@ -26,24 +26,6 @@ namespace tyr
 	class TYR_GRAPHICS_EXPORT Device
 	{
 	public:
-		static constexpr uint16 c_MaxBuffers = 20;
-		static constexpr uint16 c_MaxBufferViews = c_MaxBuffers * 3;
-		static constexpr uint16 c_MaxImages = 3000;
-		static constexpr uint16 c_MaxImageViews = c_MaxImages * 3;
-		static constexpr uint16 c_MaxSamplers = 20;
-		static constexpr uint16 c_MaxRenderPasses = 1;
-		static constexpr uint16 c_MaxGraphicsPipelines = 10;
-		static constexpr uint16 c_MaxComputePipelines = 10;
-		static constexpr uint16 c_MaxRayTracingPipelines = 10;
-		static constexpr uint16 c_MaxAccelerationStructures = 20;
-		static constexpr uint16 c_MaxDescriptorPools = 5;
-		static constexpr uint16 c_MaxDescriptorSetLayouts = 20;
-		static constexpr uint16 c_MaxDescriptorSetGroups = 20;
-		static constexpr uint16 c_MaxFences = 20;
-		static constexpr uint16 c_MaxSemaphores = 20;
-		static constexpr uint16 c_MaxEvents = 20;
-		static constexpr uint16 c_MaxShaderModules = 50;
-
 		Device(uint index);
 		virtual ~Device();
 		
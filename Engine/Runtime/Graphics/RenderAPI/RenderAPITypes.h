@@ -571,11 +571,12 @@ namespace tyr
 		Extents2 extents;
 	};
 
-	static constexpr uint16 c_InvalidGraphicsResourceID = UINT16_MAX;
+	static constexpr uint c_InvalidGraphicsResourceID = UINT32_MAX;
 
 	struct ResourceHandle
 	{
-		uint16 id = c_InvalidGraphicsResourceID;
+		// Generational handle from the device's resource pool
+		uint id = c_InvalidGraphicsResourceID;
 
 		operator bool() const
 		{
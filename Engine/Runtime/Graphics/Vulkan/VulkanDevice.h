@@ -9,7 +9,7 @@
 #include "VulkanShaderModule.h"
 #include "VulkanDescriptorSetGroup.h"
 #include "VulkanSync.h"
-#include "Memory/LocalObjectPool.h"
+#include "Memory/HandlePool.h"
 
 namespace tyr
 {
@@ -89,23 +89,23 @@ namespace tyr
 
 		VulkanQueueGroup m_QueueGroups[c_QueueGroupCount];
 
-		LocalObjectPool<Buffer, c_MaxBuffers> m_BufferPool;
-		LocalObjectPool<BufferView, c_MaxBufferViews> m_BufferViewPool;
-		LocalObjectPool<Image, c_MaxImages> m_ImagePool;
-		LocalObjectPool<ImageView, c_MaxImageViews> m_ImageViewPool;
-		LocalObjectPool<Sampler, c_MaxSamplers> m_SamplerPool;
-		LocalObjectPool<RenderPass, c_MaxRenderPasses> m_RenderPassPool;
-		LocalObjectPool<GraphicsPipeline, c_MaxGraphicsPipelines> m_GraphicsPipelinePool;
-		LocalObjectPool<ComputePipeline, c_MaxComputePipelines> m_ComputePipelinePool;
-		LocalObjectPool<RayTracingPipeline, c_MaxRayTracingPipelines> m_RayTracingPipelinePool;
-		LocalObjectPool<AccelerationStructure, c_MaxAccelerationStructures> m_AccelerationStructurePool;
-		LocalObjectPool<DescriptorPool, c_MaxDescriptorPools> m_DescriptorPoolPool;
-		LocalObjectPool<DescriptorSetLayout, c_MaxDescriptorSetLayouts> m_DescriptorSetLayoutPool;
-		LocalObjectPool<DescriptorSetGroup, c_MaxDescriptorSetGroups> m_DescriptorSetGroupPool;
-		LocalObjectPool<Fence, c_MaxFences> m_FencePool;
-		LocalObjectPool<Semaphore, c_MaxSemaphores> m_SemaphorePool;
-		LocalObjectPool<Event, c_MaxEvents> m_EventPool;
-		LocalObjectPool<ShaderModule, c_MaxShaderModules> m_ShaderModulePool;
+		HandlePool<Buffer> m_BufferPool;
+		HandlePool<BufferView> m_BufferViewPool;
+		HandlePool<Image> m_ImagePool;
+		HandlePool<ImageView> m_ImageViewPool;
+		HandlePool<Sampler> m_SamplerPool;
+		HandlePool<RenderPass> m_RenderPassPool;
+		HandlePool<GraphicsPipeline> m_GraphicsPipelinePool;
+		HandlePool<ComputePipeline> m_ComputePipelinePool;
+		HandlePool<RayTracingPipeline> m_RayTracingPipelinePool;
+		HandlePool<AccelerationStructure> m_AccelerationStructurePool;
+		HandlePool<DescriptorPool> m_DescriptorPoolPool;
+		HandlePool<DescriptorSetLayout> m_DescriptorSetLayoutPool;
+		HandlePool<DescriptorSetGroup> m_DescriptorSetGroupPool;
+		HandlePool<Fence> m_FencePool;
+		HandlePool<Semaphore> m_SemaphorePool;
+		HandlePool<Event> m_EventPool;
+		HandlePool<ShaderModule> m_ShaderModulePool;
 
 	public:
 		TYR_FORCEINLINE	const Buffer& GetBuffer(BufferHandle handle) const
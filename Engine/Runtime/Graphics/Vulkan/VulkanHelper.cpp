@@ -54,7 +54,7 @@ namespace tyr
 			ss << ep.extensionName << std::endl;
 		}
 		const String s = ss.str();
-		TYR_LOG_INFO(s.c_str());
+		TYR_LOG_INFO("%s", s);
 	}
 
 	void VulkanHelper::GetRequiredInstanceExtensions(Array<const char*>& extensions, bool validationLayersEnabled)
@@ -117,7 +117,7 @@ namespace tyr
 			DWORD e = GetLastError();
 			StringStream ss;
 			ss << "Failed to load module handle: " << e << ".";
-			TYR_LOG_FATAL(ss.str().c_str());
+			TYR_LOG_FATAL("%s", ss.str());
 		}*/
 
 		createInfo.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
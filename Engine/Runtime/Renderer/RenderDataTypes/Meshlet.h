@@ -0,0 +1,47 @@
+#pragma once
+
+#include "RendererMacros.h"
+#include "Core.h"
+#include "Math/Vector3.h"
+
+namespace tyr
+{
+	/// A small cluster of a mesh's triangles drawn by one mesh shader work group. The layout matches the structured
+	/// buffer read by the shader.
+	struct Meshlet
+	{
+		// First entry of the meshlet in MeshletData::vertexIndices and MeshletData::triangles
+		uint vertexOffset;
+		uint triangleOffset;
+		uint vertexCount;
+		uint triangleCount;
+	};
+
+	/// Culling data of a meshlet in mesh space. The layout matches the structured buffer read by the shader, where it is
+	/// three float4s.
+	struct MeshletBounds
+	{
+		// Sphere around the meshlet's vertices
+		Vector3 centre;
+		float radius;
+		// Every triangle faces away from a camera for which dot(normalize(coneApex - camera), coneAxis) >= coneCutoff.
+		// The cutoff is greater than 1 when the normals are too spread out for the meshlet to ever be culled.
+		Vector3 coneAxis;
+		float coneCutoff;
+		Vector3 coneApex;
+		float padding;
+	};
+
+	/// Meshlets of a mesh and the buffers they index. Each triangle is packed into a uint as three 8 bit indices into
+	/// the meshlet's range of vertexIndices, which holds indices into the mesh's vertex buffer.
+	struct MeshletData
+	{
+		Array<Meshlet> meshlets;
+		Array<MeshletBounds> bounds;
+		Array<uint> vertexIndices;
+		Array<uint> triangles;
+	};
+
+	TYR_STATIC_ASSERT(sizeof(Meshlet) == 16, "Meshlet must match the shader layout");
+	TYR_STATIC_ASSERT(sizeof(MeshletBounds) == 48, "MeshletBounds must match the shader layout");
+}
@@ -5,5 +5,6 @@
 #include "RenderDataTypes/Lights.h"
 #include "RenderDataTypes/Material.h"
 #include "RenderDataTypes/RigidMesh.h"
+#include "RenderDataTypes/Meshlet.h"
 #include "RenderDataTypes/SkeletalMesh.h"
 #include "RenderDataTypes/GUI.h"
\ No newline at end of file
@@ -4,12 +4,33 @@
 #include "Core.h"
 #include "Math/Quaternion.h"
 #include "Math/Matrix4.h"
+#include "Geometry/BoundingSphere.h"
 #include "Material.h"
 #include "Resources/RenderBuffer.h"
 #include "RenderDataTypesCommon.h"
 
 namespace tyr
 {
+	/// A level of detail of a mesh given by a range of the mesh's index buffer
+	struct MeshLod
+	{
+		uint indexOffset;
+		uint indexCount;
+		// Root mean square distance, in mesh units, of this level's surface from the full detail mesh, estimated from
+		// the quadrics of the worst collapse. It isn't a bound, so parts of the surface can be further away.
+		float error;
+	};
+
+	/// Levels of detail of a mesh from the full mesh at index 0 to the coarsest. Every level indexes the same vertices.
+	struct MeshLodChain
+	{
+		static constexpr uint c_MaxLods = 8;
+
+		// Bounds of the mesh in mesh space
+		BoundingSphere bounds;
+		LocalArray<MeshLod, c_MaxLods> lods;
+	};
+
 	struct RigidMeshInstance
 	{
 		// Accessor for the mesh instance data in the shader
@@ -17,5 +38,7 @@ namespace tyr
 		Matrix4 transform;
 		// The material is not part of rigid mesh as it may be overwritten
 		Material* material;
+		// Level of detail to draw, chosen each frame by LodSelector
+		uint lod = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,475 @@
+#include "MeshOptimizer.h"
+#include "RenderDataTypes/Vertex.h"
+#include "Containers/HashMap.h"
+#include "Identifiers/Hashing.h"
+#include <algorithm>
+#include <cstring>
+
+namespace tyr
+{
+	namespace
+	{
+		constexpr uint c_NoVertex = ~0u;
+
+		// Vertices are compared by their bytes so that welding never merges vertices that differ in any attribute
+		struct VertexKey
+		{
+			const Vertex* vertex;
+
+			bool operator==(const VertexKey& other) const
+			{
+				return std::memcmp(vertex, other.vertex, sizeof(Vertex)) == 0;
+			}
+		};
+
+		struct VertexKeyHash
+		{
+			size_t operator()(const VertexKey& key) const
+			{
+				return static_cast<size_t>(FNV1aHash<uint64, c_FNVOffsetBasis64, c_FNVPrime64>(reinterpret_cast<const char*>(key.vertex), sizeof(Vertex)));
+			}
+		};
+
+		// FIFO model of the post-transform vertex cache. A vertex is cached if fewer than cacheSize misses happened
+		// since it was loaded.
+		class VertexCache
+		{
+		public:
+			VertexCache(uint numVertices, uint cacheSize)
+				: m_LoadTimes(numVertices)
+				, m_CacheSize(cacheSize)
+				, m_Time(cacheSize + 1)
+			{
+				for (uint& time : m_LoadTimes)
+				{
+					time = 0;
+				}
+			}
+
+			// Empties the cache by moving time on far enough that every vertex has been evicted.
+			void Reset()
+			{
+				m_Time += m_CacheSize + 1;
+			}
+
+			// Returns the number of vertices of the triangle that were missing from the cache.
+			uint AddTriangle(const uint* triangle)
+			{
+				uint misses = 0;
+				for (uint i = 0; i < 3; ++i)
+				{
+					const uint vertex = triangle[i];
+					if (m_Time - m_LoadTimes[vertex] > m_CacheSize)
+					{
+						m_LoadTimes[vertex] = m_Time++;
+						++misses;
+					}
+				}
+				return misses;
+			}
+
+		private:
+			Array<uint> m_LoadTimes;
+			uint m_CacheSize;
+			uint m_Time;
+		};
+
+		// Lists the triangles that use each vertex
+		struct VertexTriangles
+		{
+			VertexTriangles(const uint* indices, uint numIndices, uint numVertices)
+				: offsets(numVertices + 1)
+				, triangles(numIndices)
+			{
+				for (uint& offset : offsets)
+				{
+					offset = 0;
+				}
+				for (uint i = 0; i < numIndices; ++i)
+				{
+					offsets[indices[i] + 1]++;
+				}
+				for (uint i = 0; i < numVertices; ++i)
+				{
+					offsets[i + 1] += offsets[i];
+				}
+
+				Array<uint> cursors(numVertices);
+				std::memcpy(cursors.Data(), offsets.Data(), numVertices * sizeof(uint));
+				for (uint i = 0; i < numIndices; ++i)
+				{
+					triangles[cursors[indices[i]]++] = i / 3;
+				}
+			}
+
+			uint GetCount(uint vertex) const { return offsets[vertex + 1] - offsets[vertex]; }
+
+			Array<uint> offsets;
+			Array<uint> triangles;
+		};
+
+		struct Cluster
+		{
+			uint begin;
+			uint end;
+			float sortKey;
+		};
+
+		// Splits the triangles where the cache has to load all three vertices of a triangle, which happens where
+		// Tipsify jumps to a new part of the mesh
+		void FindHardBoundaries(const uint* indices, uint numTriangles, VertexCache& cache, Array<uint>& boundaries)
+		{
+			for (uint i = 0; i < numTriangles; ++i)
+			{
+				if (cache.AddTriangle(indices + i * 3) == 3 || i == 0)
+				{
+					boundaries.Add(i);
+				}
+			}
+			boundaries.Add(numTriangles);
+		}
+
+		// Splits each hard cluster further wherever the piece so far, drawn with an empty cache, has an ACMR within the
+		// threshold of the whole cluster's. Pieces may then be drawn in any order without losing much cache efficiency.
+		void FindSoftBoundaries(const uint* indices, const Array<uint>& hardBoundaries, VertexCache& cache, float threshold, Array<Cluster>& clusters)
+		{
+			for (uint i = 0; i + 1 < hardBoundaries.Size(); ++i)
+			{
+				const uint begin = hardBoundaries[i];
+				const uint end = hardBoundaries[i + 1];
+
+				cache.Reset();
+				uint clusterMisses = 0;
+				for (uint t = begin; t < end; ++t)
+				{
+					clusterMisses += cache.AddTriangle(indices + t * 3);
+				}
+				const float maxAcmr = threshold * clusterMisses / (end - begin);
+
+				cache.Reset();
+				uint pieceBegin = begin;
+				uint pieceMisses = 0;
+				for (uint t = begin; t < end; ++t)
+				{
+					pieceMisses += cache.AddTriangle(indices + t * 3);
+					if (t + 1 < end && static_cast<float>(pieceMisses) / (t + 1 - pieceBegin) <= maxAcmr)
+					{
+						clusters.Add({ pieceBegin, t + 1, 0.0f });
+						pieceBegin = t + 1;
+						pieceMisses = 0;
+						cache.Reset();
+					}
+				}
+				clusters.Add({ pieceBegin, end, 0.0f });
+			}
+		}
+	}
+
+	MeshOptimizationStats MeshOptimizer::Optimize(Array<Vertex>& vertices, Array<uint>& indices, uint cacheSize)
+	{
+		MeshOptimizationStats stats;
+		stats.vertexCountBefore = vertices.Size();
+		stats.before = AnalyzeVertexCache(indices.Data(), indices.Size(), vertices.Size(), cacheSize);
+
+		uint numVertices = WeldVertices(vertices.Data(), vertices.Size(), indices.Data(), indices.Size());
+		OptimizeVertexCache(indices.Data(), indices.Size(), numVertices, cacheSize);
+		OptimizeOverdraw(indices.Data(), indices.Size(), vertices.Data(), numVertices, cacheSize);
+		numVertices = OptimizeVertexFetch(vertices.Data(), numVertices, indices.Data(), indices.Size());
+		vertices.Resize(numVertices);
+
+		stats.vertexCountAfter = numVertices;
+		stats.after = AnalyzeVertexCache(indices.Data(), indices.Size(), numVertices, cacheSize);
+		return stats;
+	}
+
+	uint MeshOptimizer::WeldVertices(Vertex* vertices, uint numVertices, uint* indices, uint numIndices)
+	{
+		HashMap<VertexKey, uint, VertexKeyHash> uniqueVertices;
+		uniqueVertices.Reserve(numVertices);
+		Array<uint> remap(numVertices);
+
+		uint numUnique = 0;
+		for (uint i = 0; i < numVertices; ++i)
+		{
+			const uint* existing = uniqueVertices.Find(VertexKey { &vertices[i] });
+			if (existing)
+			{
+				remap[i] = *existing;
+				continue;
+			}
+
+			// Unique vertices are compacted in place. The slot written to is never one that a key points at.
+			if (numUnique != i)
+			{
+				vertices[numUnique] = vertices[i];
+			}
+			uniqueVertices.Insert(VertexKey { &vertices[numUnique] }, numUnique);
+			remap[i] = numUnique++;
+		}
+
+		for (uint i = 0; i < numIndices; ++i)
+		{
+			indices[i] = remap[indices[i]];
+		}
+		return numUnique;
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(uint* indices, uint numIndices, uint numVertices, uint cacheSize)
+	{
+		// Tipsify from Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+		const uint numTriangles = numIndices / 3;
+		if (numTriangles == 0)
+		{
+			return;
+		}
+
+		const VertexTriangles adjacency(indices, numTriangles * 3, numVertices);
+
+		// Triangles not yet emitted per vertex
+		Array<uint> liveCounts(numVertices);
+		for (uint v = 0; v < numVertices; ++v)
+		{
+			liveCounts[v] = adjacency.GetCount(v);
+		}
+
+		Array<uint> cacheTimes(numVertices);
+		for (uint& time : cacheTimes)
+		{
+			time = 0;
+		}
+		uint time = cacheSize + 1;
+
+		Array<bool> emitted(numTriangles);
+		for (bool& triangleEmitted : emitted)
+		{
+			triangleEmitted = false;
+		}
+
+		Array<uint> output(numTriangles * 3);
+		uint outputSize = 0;
+		// Recently used vertices to fall back on when the fanning vertex has no triangles left
+		Array<uint> deadEndStack;
+		deadEndStack.Reserve(numIndices);
+		Array<uint> candidates;
+		// Next vertex to try when the dead end stack is empty
+		uint cursor = 0;
+
+		auto skipDeadEnd = [&]() -> uint
+		{
+			while (!deadEndStack.IsEmpty())
+			{
+				const uint vertex = deadEndStack.Back();
+				deadEndStack.PopBack();
+				if (liveCounts[vertex] > 0)
+				{
+					return vertex;
+				}
+			}
+			while (cursor < numVertices)
+			{
+				if (liveCounts[cursor] > 0)
+				{
+					return cursor;
+				}
+				++cursor;
+			}
+			return c_NoVertex;
+		};
+
+		uint fanningVertex = skipDeadEnd();
+		while (fanningVertex != c_NoVertex)
+		{
+			candidates.Clear();
+			for (uint i = adjacency.offsets[fanningVertex]; i < adjacency.offsets[fanningVertex + 1]; ++i)
+			{
+				const uint triangle = adjacency.triangles[i];
+				if (emitted[triangle])
+				{
+					continue;
+				}
+				emitted[triangle] = true;
+
+				for (uint corner = 0; corner < 3; ++corner)
+				{
+					const uint vertex = indices[triangle * 3 + corner];
+					output[outputSize++] = vertex;
+					deadEndStack.Add(vertex);
+					candidates.Add(vertex);
+					liveCounts[vertex]--;
+					if (time - cacheTimes[vertex] > cacheSize)
+					{
+						cacheTimes[vertex] = time++;
+					}
+				}
+			}
+
+			// Pick the candidate that will still be in the cache after its remaining triangles are emitted and has
+			// been in it the longest, so that its cache entry is used before it is evicted
+			uint bestVertex = c_NoVertex;
+			int bestPriority = -1;
+			for (uint vertex : candidates)
+			{
+				if (liveCounts[vertex] == 0)
+				{
+					continue;
+				}
+				int priority = 0;
+				const uint age = time - cacheTimes[vertex];
+				if (age + 2 * liveCounts[vertex] <= cacheSize)
+				{
+					priority = static_cast<int>(age);
+				}
+				if (priority > bestPriority)
+				{
+					bestPriority = priority;
+					bestVertex = vertex;
+				}
+			}
+
+			fanningVertex = bestVertex != c_NoVertex ? bestVertex : skipDeadEnd();
+		}
+
+		std::memcpy(indices, output.Data(), outputSize * sizeof(uint));
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(uint* indices, uint numIndices, const Vertex* vertices, uint numVertices, uint cacheSize, float threshold)
+	{
+		const uint numTriangles = numIndices / 3;
+		if (numTriangles == 0)
+		{
+			return;
+		}
+
+		VertexCache cache(numVertices, cacheSize);
+		Array<uint> hardBoundaries;
+		FindHardBoundaries(indices, numTriangles, cache, hardBoundaries);
+		Array<Cluster> clusters;
+		FindSoftBoundaries(indices, hardBoundaries, cache, threshold, clusters);
+		if (clusters.Size() <= 1)
+		{
+			return;
+		}
+
+		// Area weighted centroids and normals of the clusters and the mesh
+		Array<Vector3> clusterCentroids(clusters.Size());
+		Array<Vector3> clusterNormals(clusters.Size());
+		Vector3 meshCentroid = Vector3::c_Zero;
+		float meshArea = 0.0f;
+		for (uint c = 0; c < clusters.Size(); ++c)
+		{
+			Vector3 centroid = Vector3::c_Zero;
+			Vector3 normal = Vector3::c_Zero;
+			float area = 0.0f;
+			for (uint t = clusters[c].begin; t < clusters[c].end; ++t)
+			{
+				const Vector3& p0 = vertices[indices[t * 3]].position;
+				const Vector3& p1 = vertices[indices[t * 3 + 1]].position;
+				const Vector3& p2 = vertices[indices[t * 3 + 2]].position;
+				// Same orientation as MeshUtil
+				const Vector3 faceNormal = (p2 - p0).Cross(p1 - p0);
+				const float faceArea = faceNormal.Length();
+				centroid += (p0 + p1 + p2) * (faceArea / 3.0f);
+				normal += faceNormal;
+				area += faceArea;
+			}
+
+			meshCentroid += centroid;
+			meshArea += area;
+			clusterCentroids[c] = area > 0.0f ? centroid / area : centroid;
+			clusterNormals[c] = normal;
+		}
+		if (meshArea > 0.0f)
+		{
+			meshCentroid /= meshArea;
+		}
+
+		// Clusters on the outside of the mesh facing away from its centre are the ones most likely to occlude others
+		for (uint c = 0; c < clusters.Size(); ++c)
+		{
+			const Vector3 normal = clusterNormals[c];
+			const float normalLength = normal.Length();
+			clusters[c].sortKey = normalLength > 0.0f ? (clusterCentroids[c] - meshCentroid).Dot(normal) / normalLength : 0.0f;
+		}
+		std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b)
+		{
+			return a.sortKey > b.sortKey;
+		});
+
+		Array<uint> sorted(numTriangles * 3);
+		uint* output = sorted.Data();
+		for (const Cluster& cluster : clusters)
+		{
+			const uint count = (cluster.end - cluster.begin) * 3;
+			std::memcpy(output, indices + cluster.begin * 3, count * sizeof(uint));
+			output += count;
+		}
+		std::memcpy(indices, sorted.Data(), numTriangles * 3 * sizeof(uint));
+	}
+
+	uint MeshOptimizer::OptimizeVertexFetch(Vertex* vertices, uint numVertices, uint* indices, uint numIndices)
+	{
+		Array<uint> remap(numVertices);
+		for (uint& index : remap)
+		{
+			index = c_NoVertex;
+		}
+
+		uint numUsed = 0;
+		for (uint i = 0; i < numIndices; ++i)
+		{
+			uint& newIndex = remap[indices[i]];
+			if (newIndex == c_NoVertex)
+			{
+				newIndex = numUsed++;
+			}
+			indices[i] = newIndex;
+		}
+
+		Array<Vertex> original(numVertices);
+		std::memcpy(original.Data(), vertices, numVertices * sizeof(Vertex));
+		for (uint v = 0; v < numVertices; ++v)
+		{
+			if (remap[v] != c_NoVertex)
+			{
+				vertices[remap[v]] = original[v];
+			}
+		}
+		return numUsed;
+	}
+
+	VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint* indices, uint numIndices, uint numVertices, uint cacheSize)
+	{
+		VertexCacheStats stats;
+		const uint numTriangles = numIndices / 3;
+		if (numTriangles == 0)
+		{
+			return stats;
+		}
+
+		VertexCache cache(numVertices, cacheSize);
+		uint misses = 0;
+		for (uint t = 0; t < numTriangles; ++t)
+		{
+			misses += cache.AddTriangle(indices + t * 3);
+		}
+
+		Array<bool> used(numVertices);
+		for (bool& vertexUsed : used)
+		{
+			vertexUsed = false;
+		}
+		uint numUsed = 0;
+		for (uint i = 0; i < numTriangles * 3; ++i)
+		{
+			if (!used[indices[i]])
+			{
+				used[indices[i]] = true;
+				++numUsed;
+			}
+		}
+
+		stats.acmr = static_cast<float>(misses) / numTriangles;
+		stats.atvr = static_cast<float>(misses) / numUsed;
+		return stats;
+	}
+}
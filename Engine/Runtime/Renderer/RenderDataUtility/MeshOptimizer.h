@@ -0,0 +1,61 @@
+#pragma once
+
+#include "RendererMacros.h"
+#include "Core.h"
+
+namespace tyr
+{
+	struct Vertex;
+
+	/// Post-transform vertex cache efficiency of a triangle list, measured with a FIFO cache
+	struct VertexCacheStats
+	{
+		// Average cache misses per triangle. Ranges from about 0.5 for a large regular grid to 3.
+		float acmr = 0.0f;
+		// Average cache misses per vertex used. 1 is ideal.
+		float atvr = 0.0f;
+	};
+
+	struct MeshOptimizationStats
+	{
+		uint vertexCountBefore = 0;
+		uint vertexCountAfter = 0;
+		VertexCacheStats before;
+		VertexCacheStats after;
+	};
+
+	/// Import time optimisations that reorder a triangle list and its vertices for faster drawing. They don't change
+	/// how the mesh looks, only the order triangles and vertices are stored in.
+	class TYR_RENDERER_EXPORT MeshOptimizer
+	{
+	public:
+		// Size of the FIFO cache the optimisations target and the stats are measured with
+		static constexpr uint c_DefaultCacheSize = 16;
+		// How much worse than the cache optimised order the overdraw optimisation may make the ACMR
+		static constexpr float c_DefaultOverdrawThreshold = 1.05f;
+
+		/// Welds the vertices and optimises for the vertex cache, overdraw and vertex fetch in that order. The arrays
+		/// are shrunk to the vertices that remain.
+		static MeshOptimizationStats Optimize(Array<Vertex>& vertices, Array<uint>& indices, uint cacheSize = c_DefaultCacheSize);
+
+		/// Merges bitwise identical vertices and rewrites the indices to use them. The unique vertices are moved to the
+		/// front in order of first occurrence. Returns the number of unique vertices.
+		static uint WeldVertices(Vertex* vertices, uint numVertices, uint* indices, uint numIndices);
+
+		/// Reorders the triangles for the post-transform vertex cache with Tipsify, which runs in linear time.
+		static void OptimizeVertexCache(uint* indices, uint numIndices, uint numVertices, uint cacheSize = c_DefaultCacheSize);
+
+		/// Splits the triangles into clusters and draws the clusters that face outwards from the centre of the mesh
+		/// first, so that they hide what is behind them. The indices should already be optimised for the vertex cache.
+		/// Clusters are only split where the ACMR stays within threshold times that of the whole cluster. A triangle
+		/// (p0, p1, p2) faces along (p2 - p0) x (p1 - p0), the same as the normals MeshUtil computes.
+		static void OptimizeOverdraw(uint* indices, uint numIndices, const Vertex* vertices, uint numVertices,
+			uint cacheSize = c_DefaultCacheSize, float threshold = c_DefaultOverdrawThreshold);
+
+		/// Reorders the vertices in the order the indices first use them and drops unused vertices. Returns the number
+		/// of vertices used.
+		static uint OptimizeVertexFetch(Vertex* vertices, uint numVertices, uint* indices, uint numIndices);
+
+		static VertexCacheStats AnalyzeVertexCache(const uint* indices, uint numIndices, uint numVertices, uint cacheSize = c_DefaultCacheSize);
+	};
+}
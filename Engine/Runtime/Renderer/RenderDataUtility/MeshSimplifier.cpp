@@ -0,0 +1,611 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "RenderDataTypes/Vertex.h"
+#include "RenderDataTypes/RigidMesh.h"
+#include "Containers/HashMap.h"
+#include "Geometry/AABB.h"
+#include "Identifiers/Hashing.h"
+#include "Threading/Parallel.h"
+#include <cstring>
+#include <limits>
+
+namespace tyr
+{
+	namespace
+	{
+		constexpr uint c_NoVertex = ~0u;
+
+		// Candidate costs are computed in chunks of at least this many on the job system
+		constexpr uint c_CostGrainSize = 4096;
+		// Border edges are held in place by planes through them perpendicular to their face, weighted this much more
+		// than the faces themselves
+		constexpr double c_BorderWeight = 10.0;
+		// Collapses may rotate a triangle's normal by at most about 75 degrees
+		constexpr float c_MinNormalCosine = 0.25f;
+		// A level must have at most this fraction of the previous level's triangles to be kept
+		constexpr float c_MinLodReduction = 0.85f;
+
+		enum class VertexKind : uint8
+		{
+			// Interior vertex that can collapse onto any neighbour
+			Manifold,
+			// Vertex on an open border that can only collapse along the border
+			Border,
+			// Seam or non-manifold vertex that never moves
+			Locked
+		};
+
+		// Sum of squared distances to a set of weighted planes, divided by the total weight when evaluated so that the
+		// cost is a squared distance regardless of the mesh's scale
+		struct Quadric
+		{
+			double a00, a01, a02, a11, a12, a22;
+			double b0, b1, b2;
+			double c;
+			double weight;
+
+			void AddPlane(const Vector3& normal, float distance, double planeWeight)
+			{
+				const double nx = normal.x, ny = normal.y, nz = normal.z, d = distance;
+				a00 += planeWeight * nx * nx;
+				a01 += planeWeight * nx * ny;
+				a02 += planeWeight * nx * nz;
+				a11 += planeWeight * ny * ny;
+				a12 += planeWeight * ny * nz;
+				a22 += planeWeight * nz * nz;
+				b0 += planeWeight * nx * d;
+				b1 += planeWeight * ny * d;
+				b2 += planeWeight * nz * d;
+				c += planeWeight * d * d;
+				weight += planeWeight;
+			}
+
+			void Add(const Quadric& other)
+			{
+				a00 += other.a00; a01 += other.a01; a02 += other.a02;
+				a11 += other.a11; a12 += other.a12; a22 += other.a22;
+				b0 += other.b0; b1 += other.b1; b2 += other.b2;
+				c += other.c;
+				weight += other.weight;
+			}
+
+			double Evaluate(const Vector3& p) const
+			{
+				const double x = p.x, y = p.y, z = p.z;
+				const double error = x * (a00 * x + 2.0 * (a01 * y + a02 * z + b0))
+					+ y * (a11 * y + 2.0 * (a12 * z + b1))
+					+ z * (a22 * z + 2.0 * b2)
+					+ c;
+				return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+			}
+		};
+
+		struct PositionKey
+		{
+			const Vector3* position;
+
+			bool operator==(const PositionKey& other) const
+			{
+				return std::memcmp(position, other.position, sizeof(Vector3)) == 0;
+			}
+		};
+
+		struct PositionKeyHash
+		{
+			size_t operator()(const PositionKey& key) const
+			{
+				return static_cast<size_t>(FNV1aHash<uint64, c_FNVOffsetBasis64, c_FNVPrime64>(reinterpret_cast<const char*>(key.position), sizeof(Vector3)));
+			}
+		};
+
+		struct Collapse
+		{
+			uint source;
+			uint target;
+			float cost;
+		};
+
+		uint64 GetEdgeKey(uint from, uint to)
+		{
+			return (static_cast<uint64>(from) << 32) | to;
+		}
+
+		// Removes triangles with two corners at the same position, which collapses leave behind
+		uint RemoveDegenerateTriangles(uint* indices, uint numIndices, const uint* positionIds)
+		{
+			uint count = 0;
+			for (uint i = 0; i < numIndices; i += 3)
+			{
+				const uint p0 = positionIds[indices[i]];
+				const uint p1 = positionIds[indices[i + 1]];
+				const uint p2 = positionIds[indices[i + 2]];
+				if (p0 != p1 && p1 != p2 && p0 != p2)
+				{
+					indices[count] = indices[i];
+					indices[count + 1] = indices[i + 1];
+					indices[count + 2] = indices[i + 2];
+					count += 3;
+				}
+			}
+			return count;
+		}
+
+		class Simplifier
+		{
+		public:
+			Simplifier(const Vertex* vertices, uint numVertices)
+				: m_Vertices(vertices)
+				, m_NumVertices(numVertices)
+				, m_PositionIds(numVertices)
+				, m_Kinds(numVertices)
+				, m_BorderNext(numVertices)
+				, m_BorderPrev(numVertices)
+				, m_Quadrics(numVertices)
+			{ }
+
+			uint Run(uint* indices, uint numIndices, uint targetIndexCount, float maxRmsError, float& error)
+			{
+				FindPositions();
+				ClassifyVertices(indices, numIndices);
+				ComputeQuadrics(indices, numIndices);
+				numIndices = RemoveDegenerateTriangles(indices, numIndices, m_PositionIds.Data());
+
+				const double maxCost = static_cast<double>(maxRmsError) * maxRmsError;
+				double largestCost = 0.0;
+				while (numIndices > targetIndexCount)
+				{
+					const uint collapseCount = CollapseEdges(indices, numIndices, targetIndexCount, maxCost, largestCost);
+					if (collapseCount == 0)
+					{
+						break;
+					}
+					numIndices = RemoveDegenerateTriangles(indices, numIndices, m_PositionIds.Data());
+				}
+
+				error = Math::Sqrt(static_cast<float>(largestCost));
+				return numIndices;
+			}
+
+		private:
+			// Gives vertices with the same position the id of the first of them
+			void FindPositions()
+			{
+				HashMap<PositionKey, uint, PositionKeyHash> positions;
+				positions.Reserve(m_NumVertices);
+				for (uint v = 0; v < m_NumVertices; ++v)
+				{
+					const PositionKey key { &m_Vertices[v].position };
+					const uint* existing = positions.Find(key);
+					if (existing)
+					{
+						m_PositionIds[v] = *existing;
+					}
+					else
+					{
+						positions.Insert(key, v);
+						m_PositionIds[v] = v;
+					}
+				}
+			}
+
+			void ClassifyVertices(const uint* indices, uint numIndices)
+			{
+				Array<uint> wedgeCounts(m_NumVertices);
+				for (uint v = 0; v < m_NumVertices; ++v)
+				{
+					wedgeCounts[v] = 0;
+					m_BorderNext[v] = c_NoVertex;
+					m_BorderPrev[v] = c_NoVertex;
+				}
+				for (uint v = 0; v < m_NumVertices; ++v)
+				{
+					wedgeCounts[m_PositionIds[v]]++;
+				}
+
+				// Count the half edges between positions. An edge without a twin is on a border.
+				HashMap<uint64, uint> halfEdges;
+				halfEdges.Reserve(numIndices);
+				for (uint i = 0; i < numIndices; ++i)
+				{
+					const uint from = m_PositionIds[indices[i]];
+					const uint to = m_PositionIds[indices[i - i % 3 + (i + 1) % 3]];
+					uint* count = halfEdges.Find(GetEdgeKey(from, to));
+					if (count)
+					{
+						(*count)++;
+					}
+					else
+					{
+						halfEdges.Insert(GetEdgeKey(from, to), 1);
+					}
+				}
+
+				Array<bool> locked(m_NumVertices);
+				for (uint v = 0; v < m_NumVertices; ++v)
+				{
+					locked[v] = wedgeCounts[m_PositionIds[v]] > 1;
+				}
+				for (uint i = 0; i < numIndices; ++i)
+				{
+					const uint from = m_PositionIds[indices[i]];
+					const uint to = m_PositionIds[indices[i - i % 3 + (i + 1) % 3]];
+					if (*halfEdges.Find(GetEdgeKey(from, to)) > 1)
+					{
+						// Non-manifold edge
+						locked[from] = locked[to] = true;
+					}
+					else if (!halfEdges.Contains(GetEdgeKey(to, from)))
+					{
+						// A border vertex must have exactly one border edge in and one out
+						if (m_BorderNext[from] != c_NoVertex || m_BorderPrev[to] != c_NoVertex)
+						{
+							locked[from] = locked[to] = true;
+						}
+						m_BorderNext[from] = to;
+						m_BorderPrev[to] = from;
+					}
+				}
+
+				for (uint v = 0; v < m_NumVertices; ++v)
+				{
+					const uint position = m_PositionIds[v];
+					if (locked[position] || locked[v])
+					{
+						m_Kinds[v] = VertexKind::Locked;
+					}
+					else if (m_BorderNext[position] != c_NoVertex || m_BorderPrev[position] != c_NoVertex)
+					{
+						const bool hasBothNeighbours = m_BorderNext[position] != c_NoVertex && m_BorderPrev[position] != c_NoVertex;
+						m_Kinds[v] = hasBothNeighbours ? VertexKind::Border : VertexKind::Locked;
+					}
+					else
+					{
+						m_Kinds[v] = VertexKind::Manifold;
+					}
+				}
+			}
+
+			// Quadrics are kept per position so that every wedge of a seam vertex shares one
+			void ComputeQuadrics(const uint* indices, uint numIndices)
+			{
+				std::memset(m_Quadrics.Data(), 0, m_NumVertices * sizeof(Quadric));
+				for (uint i = 0; i < numIndices; i += 3)
+				{
+					const uint ids[3] = { m_PositionIds[indices[i]], m_PositionIds[indices[i + 1]], m_PositionIds[indices[i + 2]] };
+					const Vector3& p0 = m_Vertices[ids[0]].position;
+					const Vector3& p1 = m_Vertices[ids[1]].position;
+					const Vector3& p2 = m_Vertices[ids[2]].position;
+					Vector3 normal = (p1 - p0).Cross(p2 - p0);
+					const float doubleArea = normal.Length();
+					if (doubleArea <= 0.0f)
+					{
+						continue;
+					}
+					normal /= doubleArea;
+
+					const float distance = -normal.Dot(p0);
+					for (uint corner = 0; corner < 3; ++corner)
+					{
+						m_Quadrics[ids[corner]].AddPlane(normal, distance, doubleArea * 0.5);
+					}
+
+					for (uint corner = 0; corner < 3; ++corner)
+					{
+						const uint from = ids[corner];
+						const uint to = ids[(corner + 1) % 3];
+						if (m_BorderNext[from] != to)
+						{
+							continue;
+						}
+						const Vector3 edge = m_Vertices[to].position - m_Vertices[from].position;
+						const float edgeLength = edge.Length();
+						if (edgeLength <= 0.0f)
+						{
+							continue;
+						}
+						const Vector3 borderNormal = edge.Cross(normal) / edgeLength;
+						const float borderDistance = -borderNormal.Dot(m_Vertices[from].position);
+						const double weight = c_BorderWeight * edgeLength * edgeLength;
+						m_Quadrics[from].AddPlane(borderNormal, borderDistance, weight);
+						m_Quadrics[to].AddPlane(borderNormal, borderDistance, weight);
+					}
+				}
+			}
+
+			bool CanCollapse(uint source, uint target) const
+			{
+				switch (m_Kinds[source])
+				{
+				case VertexKind::Manifold:
+					return true;
+				case VertexKind::Border:
+				{
+					const uint position = m_PositionIds[target];
+					return m_BorderNext[source] == position || m_BorderPrev[source] == position;
+				}
+				default:
+					return false;
+				}
+			}
+
+			void AddCandidates(const uint* indices, uint numIndices, Array<Collapse>& candidates) const
+			{
+				candidates.Clear();
+				for (uint i = 0; i < numIndices; ++i)
+				{
+					const uint a = indices[i];
+					const uint b = indices[i - i % 3 + (i + 1) % 3];
+					const uint positionA = m_PositionIds[a];
+					const uint positionB = m_PositionIds[b];
+					// Interior edges appear twice, once in each direction, so they are only added from one side
+					if (positionA < positionB || m_BorderNext[positionA] == positionB)
+					{
+						if (CanCollapse(a, b))
+						{
+							candidates.Add({ a, b, 0.0f });
+						}
+						if (CanCollapse(b, a))
+						{
+							candidates.Add({ b, a, 0.0f });
+						}
+					}
+				}
+			}
+
+			// Returns false if moving the source onto the target would flip or badly rotate one of its triangles
+			bool PreservesOrientation(uint source, uint target, const uint* indices) const
+			{
+				const uint targetPosition = m_PositionIds[target];
+				const Vector3& newPosition = m_Vertices[target].position;
+				for (uint i = m_TriangleOffsets[source]; i < m_TriangleOffsets[source + 1]; ++i)
+				{
+					const uint* triangle = indices + m_VertexTriangles[i] * 3;
+					Vector3 corners[3];
+					bool removed = false;
+					uint sourceCorner = 0;
+					for (uint corner = 0; corner < 3; ++corner)
+					{
+						removed |= m_PositionIds[triangle[corner]] == targetPosition;
+						sourceCorner = triangle[corner] == source ? corner : sourceCorner;
+						corners[corner] = m_Vertices[triangle[corner]].position;
+					}
+					if (removed)
+					{
+						continue;
+					}
+
+					const Vector3 oldNormal = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+					corners[sourceCorner] = newPosition;
+					const Vector3 newNormal = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+					const float lengths = Math::Sqrt(oldNormal.SqrLength() * newNormal.SqrLength());
+					if (lengths <= 0.0f || oldNormal.Dot(newNormal) < c_MinNormalCosine * lengths)
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			void BuildVertexTriangles(const uint* indices, uint numIndices)
+			{
+				m_TriangleOffsets.Resize(m_NumVertices + 1);
+				std::memset(m_TriangleOffsets.Data(), 0, (m_NumVertices + 1) * sizeof(uint));
+				for (uint i = 0; i < numIndices; ++i)
+				{
+					m_TriangleOffsets[indices[i] + 1]++;
+				}
+				for (uint v = 0; v < m_NumVertices; ++v)
+				{
+					m_TriangleOffsets[v + 1] += m_TriangleOffsets[v];
+				}
+
+				Array<uint> cursors(m_NumVertices);
+				std::memcpy(cursors.Data(), m_TriangleOffsets.Data(), m_NumVertices * sizeof(uint));
+				m_VertexTriangles.Resize(numIndices);
+				for (uint i = 0; i < numIndices; ++i)
+				{
+					m_VertexTriangles[cursors[indices[i]]++] = i / 3;
+				}
+			}
+
+			// Does one pass of collapses over edges that don't share neighbourhoods and returns how many were made
+			uint CollapseEdges(uint* indices, uint numIndices, uint targetIndexCount, double maxCost, double& largestCost)
+			{
+				AddCandidates(indices, numIndices, m_Candidates);
+				ParallelFor(m_Candidates.Size(), [&](uint i)
+				{
+					Collapse& collapse = m_Candidates[i];
+					Quadric quadric = m_Quadrics[m_PositionIds[collapse.source]];
+					quadric.Add(m_Quadrics[m_PositionIds[collapse.target]]);
+					collapse.cost = static_cast<float>(quadric.Evaluate(m_Vertices[collapse.target].position));
+				}, c_CostGrainSize);
+				ParallelSort(m_Candidates.Data(), m_Candidates.Size(), [](const Collapse& a, const Collapse& b)
+				{
+					return a.cost < b.cost;
+				});
+
+				BuildVertexTriangles(indices, numIndices);
+
+				// A collapse locks the neighbourhood of its source so that the triangles checked for it don't change
+				// during the pass
+				m_Locked.Resize(m_NumVertices);
+				std::memset(m_Locked.Data(), 0, m_NumVertices * sizeof(bool));
+
+				// Each collapse removes about two triangles. Many candidates are skipped because their neighbourhoods are
+				// locked, so the pass accepts costs somewhat above that of the last collapse it ideally needs.
+				const uint collapsesNeeded = (numIndices - targetIndexCount) / 6 + 1;
+				double costLimit = maxCost;
+				if (collapsesNeeded < m_Candidates.Size())
+				{
+					costLimit = std::min(maxCost, 1.5 * m_Candidates[collapsesNeeded].cost);
+				}
+
+				uint collapseCount = ApplyCollapses(indices, collapsesNeeded, costLimit, largestCost);
+				if (collapseCount == 0 && costLimit < maxCost)
+				{
+					collapseCount = ApplyCollapses(indices, collapsesNeeded, maxCost, largestCost);
+				}
+				return collapseCount;
+			}
+
+			// Makes the collapses in order of cost until the limits are reached and returns how many were made
+			uint ApplyCollapses(uint* indices, uint collapsesNeeded, double costLimit, double& largestCost)
+			{
+				uint collapseCount = 0;
+				for (const Collapse& collapse : m_Candidates)
+				{
+					if (collapse.cost > costLimit || collapseCount >= collapsesNeeded)
+					{
+						break;
+					}
+
+					const uint sourcePosition = m_PositionIds[collapse.source];
+					const uint targetPosition = m_PositionIds[collapse.target];
+					if (m_Locked[sourcePosition] || m_Locked[targetPosition] || !PreservesOrientation(collapse.source, collapse.target, indices))
+					{
+						continue;
+					}
+
+					for (uint i = m_TriangleOffsets[collapse.source]; i < m_TriangleOffsets[collapse.source + 1]; ++i)
+					{
+						uint* triangle = indices + m_VertexTriangles[i] * 3;
+						for (uint corner = 0; corner < 3; ++corner)
+						{
+							m_Locked[m_PositionIds[triangle[corner]]] = true;
+							if (triangle[corner] == collapse.source)
+							{
+								triangle[corner] = collapse.target;
+							}
+						}
+					}
+
+					// The source is a single vertex at its position, so it's now gone from the mesh
+					m_Quadrics[targetPosition].Add(m_Quadrics[sourcePosition]);
+					m_PositionIds[collapse.source] = targetPosition;
+					if (m_Kinds[collapse.source] == VertexKind::Border)
+					{
+						const uint next = m_BorderNext[sourcePosition];
+						const uint prev = m_BorderPrev[sourcePosition];
+						if (next == targetPosition)
+						{
+							m_BorderNext[prev] = targetPosition;
+							m_BorderPrev[targetPosition] = prev;
+						}
+						else
+						{
+							m_BorderPrev[next] = targetPosition;
+							m_BorderNext[targetPosition] = next;
+						}
+					}
+
+					largestCost = std::max(largestCost, static_cast<double>(collapse.cost));
+					++collapseCount;
+				}
+				return collapseCount;
+			}
+
+			const Vertex* m_Vertices;
+			uint m_NumVertices;
+			// Id of the first vertex with the same position. Collapsed vertices get their target's id.
+			Array<uint> m_PositionIds;
+			Array<VertexKind> m_Kinds;
+			// Neighbouring positions along open borders, by position id
+			Array<uint> m_BorderNext;
+			Array<uint> m_BorderPrev;
+			Array<Quadric> m_Quadrics;
+
+			// Scratch data of a pass
+			Array<Collapse> m_Candidates;
+			Array<uint> m_TriangleOffsets;
+			Array<uint> m_VertexTriangles;
+			Array<bool> m_Locked;
+		};
+
+		BoundingSphere ComputeBounds(const Vertex* vertices, const uint* indices, uint numIndices)
+		{
+			AABB box = AABB::CreateEmpty();
+			for (uint i = 0; i < numIndices; ++i)
+			{
+				box.Merge(vertices[indices[i]].position);
+			}
+			if (numIndices == 0)
+			{
+				return BoundingSphere(Vector3::c_Zero, 0.0f);
+			}
+
+			const Vector3 centre = box.GetCentre();
+			float sqrRadius = 0.0f;
+			for (uint i = 0; i < numIndices; ++i)
+			{
+				sqrRadius = std::max(sqrRadius, (vertices[indices[i]].position - centre).SqrLength());
+			}
+			return BoundingSphere(centre, Math::Sqrt(sqrRadius));
+		}
+	}
+
+	uint MeshSimplifier::Simplify(const Vertex* vertices, uint numVertices, const uint* indices, uint numIndices,
+		uint targetIndexCount, float maxRmsError, uint* outIndices, float* error)
+	{
+		numIndices -= numIndices % 3;
+		std::memcpy(outIndices, indices, numIndices * sizeof(uint));
+
+		Simplifier simplifier(vertices, numVertices);
+		float reachedError = 0.0f;
+		const uint count = simplifier.Run(outIndices, numIndices, targetIndexCount, maxRmsError, reachedError);
+		if (error)
+		{
+			*error = reachedError;
+		}
+		return count;
+	}
+
+	void MeshSimplifier::GenerateLods(const Vertex* vertices, uint numVertices, const uint* indices, uint numIndices,
+		const float* errorThresholds, uint numThresholds, Array<uint>& lodIndices, MeshLodChain& chain)
+	{
+		numIndices -= numIndices % 3;
+		numThresholds = std::min(numThresholds, MeshLodChain::c_MaxLods - 1);
+		chain.bounds = ComputeBounds(vertices, indices, numIndices);
+		chain.lods.Clear();
+
+		struct Level
+		{
+			Array<uint> indices;
+			float error;
+		};
+		Array<Level> levels(numThresholds);
+
+		// Each level is simplified from the full mesh, which avoids compounding errors and lets levels run in parallel
+		ParallelFor(numThresholds, [&](uint i)
+		{
+			Level& level = levels[i];
+			level.indices.Resize(numIndices);
+			const float maxRmsError = errorThresholds[i] * chain.bounds.GetRadius();
+			const uint count = Simplify(vertices, numVertices, indices, numIndices, 0, maxRmsError, level.indices.Data(), &level.error);
+			level.indices.Resize(count);
+			MeshOptimizer::OptimizeVertexCache(level.indices.Data(), count, numVertices);
+		}, 1);
+
+		lodIndices.Clear();
+		lodIndices.Reserve(numIndices);
+		for (uint i = 0; i < numIndices; ++i)
+		{
+			lodIndices.Add(indices[i]);
+		}
+		chain.lods.Add({ 0, numIndices, 0.0f });
+
+		for (const Level& level : levels)
+		{
+			const MeshLod& previous = chain.lods[chain.lods.Size() - 1];
+			if (level.indices.IsEmpty() || level.indices.Size() > previous.indexCount * c_MinLodReduction)
+			{
+				continue;
+			}
+
+			chain.lods.Add({ lodIndices.Size(), level.indices.Size(), std::max(level.error, previous.error) });
+			for (uint index : level.indices)
+			{
+				lodIndices.Add(index);
+			}
+		}
+	}
+}
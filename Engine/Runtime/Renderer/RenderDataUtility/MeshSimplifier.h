@@ -0,0 +1,36 @@
+#pragma once
+
+#include "RendererMacros.h"
+#include "Core.h"
+
+namespace tyr
+{
+	struct Vertex;
+	struct MeshLodChain;
+
+	/// Quadric error metric simplification and level of detail generation.
+	///
+	/// Edges are collapsed onto one of their existing vertices, so simplified meshes index the original vertex buffer.
+	/// Vertices that share a position with other vertices, which is how UV and normal seams are stored, are never moved
+	/// so seams stay intact. Vertices on open borders only move along the border.
+	class TYR_RENDERER_EXPORT MeshSimplifier
+	{
+	public:
+		/// Collapses edges, cheapest first, until at most targetIndexCount indices remain or the next collapse would
+		/// have an error above maxRmsError. The error of a collapse is the root mean square distance, in mesh units, of
+		/// the kept vertex from the planes of the original triangles merged into it, weighted by area. Writes the indices
+		/// to outIndices, which must hold numIndices, and returns how many were written. If error isn't null it
+		/// receives the largest collapse error reached, as MeshLod::error stores it.
+		///
+		/// Collapses are done in passes of independent edges whose costs are computed on the job system.
+		static uint Simplify(const Vertex* vertices, uint numVertices, const uint* indices, uint numIndices,
+			uint targetIndexCount, float maxRmsError, uint* outIndices, float* error = nullptr);
+
+		/// Builds a chain with the full mesh and a level for each error threshold. Thresholds are the maxRmsError of
+		/// Simplify() relative to the radius of the mesh's bounds and must increase. Levels that would barely reduce the triangle count are
+		/// dropped. The indices of every level are written to lodIndices one after the other and optimised for the
+		/// vertex cache. Levels are generated in parallel.
+		static void GenerateLods(const Vertex* vertices, uint numVertices, const uint* indices, uint numIndices,
+			const float* errorThresholds, uint numThresholds, Array<uint>& lodIndices, MeshLodChain& chain);
+	};
+}
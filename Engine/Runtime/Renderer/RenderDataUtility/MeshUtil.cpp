@@ -1,77 +1,160 @@
 #include "MeshUtil.h"
 #include "RenderDataTypes/Vertex.h"
-#include "Memory/StackAllocation.h"
+#include "Threading/Parallel.h"
 
 namespace tyr
 {
-	void MeshUtil::CreateNormalsAndTangents(Vertex* vertices, uint numVertices, const uint* indices, uint numIndices)
+	namespace
 	{
-		const uint numFaces = numIndices / 3;
+		// Faces and vertices are split into chunks of at least this many for the job system
+		constexpr uint c_GrainSize = 2048;
 
-		Vector3* faceNormals = StackNew<Vector3>(numFaces);
-		Vector3* faceTangents = StackNew<Vector3>(numFaces);
+		// Squared lengths below this are treated as zero
+		constexpr float c_DegenerateSqrLength = 1e-20f;
 
-		// Compute face normals
-		for (uint i = 0; i < numFaces; ++i)
+		struct FaceFrame
 		{
-			const uint index = i * 3;
-			Vertex& v0 = vertices[indices[index]];
-			Vertex& v1 = vertices[indices[index + 2]];
-			// Get the vector describing one edge of our triangle (edge 0,2)
-			const Vector3 edge1 = vertices[indices[index]].position - vertices[indices[index + 2]].position;
-
-			// Get the vector describing another edge of our triangle (edge 2,1)
-			const Vector3 edge2 = vertices[indices[index + 2]].position - vertices[indices[index + 1]].position;
+			// Unit normal and tangent. The tangent is zero if the texture coordinates don't span the face.
+			Vector3 normal;
+			Vector3 tangent;
+			float area;
+		};
+
+		// Angle at the corner between the edges to the other two corners of the face
+		float GetCornerAngle(const Vector3& corner, const Vector3& a, const Vector3& b)
+		{
+			const Vector3 edgeA = a - corner;
+			const Vector3 edgeB = b - corner;
+			const float sqrLengths = edgeA.SqrLength() * edgeB.SqrLength();
+			if (sqrLengths < c_DegenerateSqrLength)
+			{
+				return 0.0f;
+			}
+			return Math::Acos(edgeA.Dot(edgeB) * Math::InvSqrt(sqrLengths));
+		}
 
-			// Cross multiply the two edge vectors to get the un-normalized face normal
-			faceNormals[i] = Vector3::Cross(edge1, edge2);
+		FaceFrame ComputeFaceFrame(const Vertex& v0, const Vertex& v1, const Vertex& v2)
+		{
+			FaceFrame face;
+			const Vector3 edge1 = v1.position - v0.position;
+			const Vector3 edge2 = v2.position - v0.position;
+
+			// Faces point along (p2 - p0) x (p1 - p0), the orientation the engine's meshes are authored for
+			face.normal = edge2.Cross(edge1);
+			const float normalLength = face.normal.Length();
+			if (normalLength * normalLength < c_DegenerateSqrLength)
+			{
+				face.normal = Vector3::c_Zero;
+				face.tangent = Vector3::c_Zero;
+				face.area = 0.0f;
+				return face;
+			}
+			face.normal /= normalLength;
+			face.area = normalLength * 0.5f;
+
+			// Solve for the direction of increasing u. Only the sign of the texture space area is used so that faces
+			// with tiny texture coordinates count as much as the others, like MikkTSpace does.
+			const Vector2 texEdge1 = v1.texCoord - v0.texCoord;
+			const Vector2 texEdge2 = v2.texCoord - v0.texCoord;
+			const float texArea = texEdge1.x * texEdge2.y - texEdge2.x * texEdge1.y;
+			face.tangent = edge1 * texEdge2.y - edge2 * texEdge1.y;
+			const float sqrTangentLength = face.tangent.SqrLength();
+			if (texArea == 0.0f || sqrTangentLength < c_DegenerateSqrLength)
+			{
+				face.tangent = Vector3::c_Zero;
+			}
+			else
+			{
+				face.tangent *= (texArea > 0.0f ? 1.0f : -1.0f) * Math::InvSqrt(sqrTangentLength);
+			}
+			return face;
+		}
+	}
 
-			// Find first image coordinate edge 2d vector
-			const Vector2 tc1 = vertices[indices[index]].texCoord - vertices[indices[index + 2]].texCoord;
+	void MeshUtil::CreateNormalsAndTangents(Vertex* vertices, uint numVertices, const uint* indices, uint numIndices, NormalWeighting weighting)
+	{
+		const uint numFaces = numIndices / 3;
+		numIndices = numFaces * 3;
 
-			// Find second image coordinate edge 2d vector
-			const Vector2 tc2 = vertices[indices[index + 2]].texCoord - vertices[indices[index + 1]].texCoord;
+		// Weight of every corner and the frame of every face
+		Array<FaceFrame> faces(numFaces);
+		Array<float> cornerWeights(numIndices);
+		ParallelFor(numFaces, [&](uint faceIndex)
+		{
+			const uint* face = indices + faceIndex * 3;
+			const Vertex& v0 = vertices[face[0]];
+			const Vertex& v1 = vertices[face[1]];
+			const Vertex& v2 = vertices[face[2]];
+			faces[faceIndex] = ComputeFaceFrame(v0, v1, v2);
+
+			float* weights = &cornerWeights[faceIndex * 3];
+			if (weighting == NormalWeighting::Angle && faces[faceIndex].area > 0.0f)
+			{
+				weights[0] = GetCornerAngle(v0.position, v1.position, v2.position);
+				weights[1] = GetCornerAngle(v1.position, v2.position, v0.position);
+				weights[2] = GetCornerAngle(v2.position, v0.position, v1.position);
+			}
+			else
+			{
+				weights[0] = weights[1] = weights[2] = faces[faceIndex].area;
+			}
+		}, c_GrainSize);
 
-			// Find tangent using both tex coord edges and position edges
-			faceTangents[i] = (tc1.y * edge1 - tc2.y * edge2) * (1.0f / (tc1.x * tc2.y - tc2.x * tc1.y));
+		// Corners of each vertex in index order, so that the sums below don't depend on scheduling
+		Array<uint> cornerCounts(numVertices);
+		for (uint i = 0; i < numVertices; ++i)
+		{
+			cornerCounts[i] = 0;
+		}
+		for (uint i = 0; i < numIndices; ++i)
+		{
+			cornerCounts[indices[i]]++;
 		}
 
-		// Compute vertex normals and tangents (normal/tangent averaging)
-
-		int facesUsing = 0;
+		Array<uint> cornerOffsets(numVertices + 1);
+		ParallelExclusiveScan(cornerCounts.Data(), cornerOffsets.Data(), numVertices, 0u);
+		cornerOffsets[numVertices] = numIndices;
 
-		//Go through each vertex
+		// Reuse the counts as write cursors
+		uint* cursors = cornerCounts.Data();
 		for (uint i = 0; i < numVertices; ++i)
 		{
-			Vertex& vertex = vertices[i];
-			vertex.normal = Vector3::c_Zero;
-			vertex.tangent = Vector3::c_Zero;
+			cursors[i] = cornerOffsets[i];
+		}
+		Array<uint> vertexCorners(numIndices);
+		for (uint i = 0; i < numIndices; ++i)
+		{
+			vertexCorners[cursors[indices[i]]++] = i;
+		}
 
-			//Check which triangles use this vertex
-			for (uint j = 0; j < numFaces; ++j)
+		ParallelFor(numVertices, [&](uint vertexIndex)
+		{
+			Vector3 normal = Vector3::c_Zero;
+			Vector3 tangent = Vector3::c_Zero;
+			for (uint i = cornerOffsets[vertexIndex]; i < cornerOffsets[vertexIndex + 1]; ++i)
 			{
-				const uint index = j * 3;
-				if (indices[index] == i ||
-					indices[index + 1] == i ||
-					indices[index + 2] == i)
-				{
-					vertex.normal += faceNormals[j];
-					vertex.tangent += faceTangents[j];
-					facesUsing++;
-				}
+				const uint corner = vertexCorners[i];
+				const FaceFrame& face = faces[corner / 3];
+				const float weight = cornerWeights[corner];
+				normal += face.normal * weight;
+				tangent += face.tangent * weight;
 			}
 
-			// Get the actual normal and tangent by dividing the sums by the number of faces sharing the vertex
-			vertex.normal /= facesUsing;
-			vertex.tangent /= facesUsing;
-
-			vertex.normal.SafeNormalize();
-			vertex.tangent.SafeNormalize();
-
-			facesUsing = 0;
-		}
-
-		StackDelete<Vector3>(faceTangents);
-		StackDelete<Vector3>(faceNormals);
+			Vertex& vertex = vertices[vertexIndex];
+			const float sqrNormalLength = normal.SqrLength();
+			if (sqrNormalLength < c_DegenerateSqrLength)
+			{
+				vertex.normal = Vector3::c_Zero;
+				vertex.tangent = Vector3::c_Zero;
+				return;
+			}
+			normal *= Math::InvSqrt(sqrNormalLength);
+
+			// Gram-Schmidt against the normal. Vertices without usable texture coordinates get any perpendicular.
+			tangent -= normal * normal.Dot(tangent);
+			const float sqrTangentLength = tangent.SqrLength();
+			vertex.normal = normal;
+			vertex.tangent = sqrTangentLength < c_DegenerateSqrLength ? normal.Perpendicular() : tangent * Math::InvSqrt(sqrTangentLength);
+		}, c_GrainSize);
 	}
-}
\ No newline at end of file
+}
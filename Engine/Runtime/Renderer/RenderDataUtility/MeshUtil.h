@@ -9,6 +9,22 @@ namespace tyr
 	class TYR_RENDERER_EXPORT MeshUtil
 	{
 	public:
-		static void CreateNormalsAndTangents(Vertex* vertices, uint numVertices, const uint* indices, uint numIndices);
+		/// How the faces around a vertex are weighted when their normals and tangents are averaged
+		enum class NormalWeighting : uint8
+		{
+			// Weight by face area so that large faces dominate
+			Area,
+			// Weight by the angle of the face's corner at the vertex, as MikkTSpace does. The result doesn't depend on how
+			// the surface is split into triangles.
+			Angle
+		};
+
+		/// Computes smooth vertex normals and tangents from the triangles that share each vertex. Tangents are
+		/// orthogonalized against the normal. Vertices not used by any triangle get zero vectors. A triangle (p0, p1, p2)
+		/// faces along (p2 - p0) x (p1 - p0).
+		///
+		/// Runs in time linear in the vertex and index counts, with the face and vertex passes split over the job system.
+		static void CreateNormalsAndTangents(Vertex* vertices, uint numVertices, const uint* indices, uint numIndices,
+			NormalWeighting weighting = NormalWeighting::Area);
 	};
-}
\ No newline at end of file
+}
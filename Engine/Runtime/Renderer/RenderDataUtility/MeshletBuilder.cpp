@@ -0,0 +1,512 @@
+#include "MeshletBuilder.h"
+#include "RenderDataTypes/Vertex.h"
+#include "Containers/HashMap.h"
+#include "Geometry/AABB.h"
+#include "Geometry/BoundingSphere.h"
+#include "Geometry/Frustum.h"
+#include "Threading/Parallel.h"
+#include <cstring>
+#include <limits>
+
+namespace tyr
+{
+	namespace
+	{
+		constexpr uint c_None = ~0u;
+
+		// Bits per axis of the Morton codes that order triangles
+		constexpr uint c_MortonBits = 10;
+		// Normals must stay within about 84 degrees of the cone axis for the cone to be usable
+		constexpr float c_MinConeCosine = 0.1f;
+		// Cutoff of a cone that never culls
+		constexpr float c_NoConeCutoff = 2.0f;
+
+		// Spreads the low 10 bits of v so that there are two zero bits between each.
+		uint SpreadBits(uint v)
+		{
+			v = (v | (v << 16)) & 0x030000FF;
+			v = (v | (v << 8)) & 0x0300F00F;
+			v = (v | (v << 4)) & 0x030C30C3;
+			v = (v | (v << 2)) & 0x09249249;
+			return v;
+		}
+
+		uint ComputeMortonCode(const Vector3& point, const Vector3& min, const Vector3& scale)
+		{
+			constexpr float c_MaxCell = static_cast<float>((1u << c_MortonBits) - 1);
+			uint code = 0;
+			for (uint axis = 0; axis < 3; ++axis)
+			{
+				const float cell = std::clamp((point[axis] - min[axis]) * scale[axis], 0.0f, c_MaxCell);
+				code |= SpreadBits(static_cast<uint>(cell)) << axis;
+			}
+			return code;
+		}
+
+		// Meshlets of a chunk with offsets relative to the chunk's own buffers
+		struct ChunkMeshlets
+		{
+			Array<Meshlet> meshlets;
+			Array<uint> vertexIndices;
+			Array<uint> triangles;
+		};
+
+		// Grows meshlets over one chunk of triangles. Vertices are renumbered within the chunk so that the per vertex
+		// state is proportional to the chunk rather than the mesh.
+		class ChunkBuilder
+		{
+		public:
+			ChunkBuilder(const uint* indices, const Vector3* centroids, uint maxVertices, uint maxTriangles)
+				: m_Indices(indices)
+				, m_Centroids(centroids)
+				, m_MaxVertices(maxVertices)
+				, m_MaxTriangles(maxTriangles)
+				, m_Meshlet()
+				, m_Output(nullptr)
+			{ }
+
+			void Build(const uint* triangles, uint numTriangles, ChunkMeshlets& output)
+			{
+				m_Triangles = triangles;
+				m_Output = &output;
+				BuildAdjacency(numTriangles);
+
+				m_Used.Resize(numTriangles, false);
+				m_CandidateStamps.Resize(numTriangles, c_None);
+				m_NewVertexCounts.Resize(numTriangles, 3);
+				m_MeshletStamps.Resize(m_GlobalVertices.Size(), c_None);
+				m_LocalIndices.Resize(m_GlobalVertices.Size(), 0);
+				m_MeshletIndex = 0;
+				BeginMeshlet();
+
+				// Triangles are in Morton order, so when a meshlet runs out of neighbours the next unused triangle
+				// is usually close by
+				uint cursor = 0;
+				while (true)
+				{
+					uint triangle = FindBestCandidate();
+					if (triangle == c_None)
+					{
+						while (cursor < numTriangles && m_Used[cursor])
+						{
+							++cursor;
+						}
+						if (cursor == numTriangles)
+						{
+							break;
+						}
+						triangle = cursor;
+					}
+
+					if (m_Meshlet.triangleCount == m_MaxTriangles || m_Meshlet.vertexCount + CountNewVertices(triangle) > m_MaxVertices)
+					{
+						EndMeshlet();
+						BeginMeshlet();
+					}
+					AddTriangle(triangle);
+				}
+				EndMeshlet();
+			}
+
+		private:
+			void BuildAdjacency(uint numTriangles)
+			{
+				HashMap<uint, uint> localIds(numTriangles);
+				m_Corners.Resize(numTriangles * 3);
+				for (uint t = 0; t < numTriangles; ++t)
+				{
+					const uint* triangle = m_Indices + m_Triangles[t] * 3;
+					for (uint c = 0; c < 3; ++c)
+					{
+						const uint* existing = localIds.Find(triangle[c]);
+						if (existing)
+						{
+							m_Corners[t * 3 + c] = *existing;
+						}
+						else
+						{
+							m_Corners[t * 3 + c] = m_GlobalVertices.Size();
+							localIds.Insert(triangle[c], m_GlobalVertices.Size());
+							m_GlobalVertices.Add(triangle[c]);
+						}
+					}
+				}
+
+				const uint numVertices = m_GlobalVertices.Size();
+				m_TriangleOffsets.Resize(numVertices + 1, 0);
+				for (uint corner : m_Corners)
+				{
+					++m_TriangleOffsets[corner + 1];
+				}
+				for (uint v = 0; v < numVertices; ++v)
+				{
+					m_TriangleOffsets[v + 1] += m_TriangleOffsets[v];
+				}
+
+				Array<uint> cursors(numVertices);
+				std::memcpy(cursors.Data(), m_TriangleOffsets.Data(), numVertices * sizeof(uint));
+				m_VertexTriangles.Resize(m_Corners.Size());
+				for (uint i = 0; i < m_Corners.Size(); ++i)
+				{
+					m_VertexTriangles[cursors[m_Corners[i]]++] = i / 3;
+				}
+			}
+
+			uint CountNewVertices(uint triangle) const
+			{
+				if (m_CandidateStamps[triangle] == m_MeshletIndex)
+				{
+					return m_NewVertexCounts[triangle];
+				}
+
+				uint count = 0;
+				for (uint c = 0; c < 3; ++c)
+				{
+					count += m_MeshletStamps[m_Corners[triangle * 3 + c]] != m_MeshletIndex;
+				}
+				return count;
+			}
+
+			// Returns the unused neighbour that adds the fewest vertices, then the one closest to the meshlet's centre.
+			// Used candidates are dropped on the way.
+			uint FindBestCandidate()
+			{
+				uint best = c_None;
+				uint bestNewVertices = 4;
+				float bestDistance = std::numeric_limits<float>::max();
+				const Vector3 centre = m_Meshlet.triangleCount ? m_CentroidSum / static_cast<float>(m_Meshlet.triangleCount) : Vector3::c_Zero;
+
+				uint kept = 0;
+				for (uint i = 0; i < m_Candidates.Size(); ++i)
+				{
+					const uint triangle = m_Candidates[i];
+					if (m_Used[triangle])
+					{
+						continue;
+					}
+					m_Candidates[kept++] = triangle;
+
+					const uint newVertices = m_NewVertexCounts[triangle];
+					if (newVertices > bestNewVertices)
+					{
+						continue;
+					}
+					const float distance = (m_Centroids[m_Triangles[triangle]] - centre).SqrLength();
+					if (newVertices < bestNewVertices || distance < bestDistance)
+					{
+						best = triangle;
+						bestNewVertices = newVertices;
+						bestDistance = distance;
+					}
+				}
+				m_Candidates.Resize(kept);
+				return best;
+			}
+
+			void BeginMeshlet()
+			{
+				m_Meshlet.vertexOffset = m_Output->vertexIndices.Size();
+				m_Meshlet.triangleOffset = m_Output->triangles.Size();
+				m_Meshlet.vertexCount = 0;
+				m_Meshlet.triangleCount = 0;
+				m_CentroidSum = Vector3::c_Zero;
+				m_Candidates.Clear();
+				++m_MeshletIndex;
+			}
+
+			void EndMeshlet()
+			{
+				if (m_Meshlet.triangleCount)
+				{
+					m_Output->meshlets.Add(m_Meshlet);
+				}
+			}
+
+			void AddTriangle(uint triangle)
+			{
+				uint packed = 0;
+				for (uint c = 0; c < 3; ++c)
+				{
+					const uint vertex = m_Corners[triangle * 3 + c];
+					if (m_MeshletStamps[vertex] != m_MeshletIndex)
+					{
+						m_MeshletStamps[vertex] = m_MeshletIndex;
+						m_LocalIndices[vertex] = m_Meshlet.vertexCount++;
+						m_Output->vertexIndices.Add(m_GlobalVertices[vertex]);
+
+						// Triangles around a new vertex become candidates, or need one vertex fewer if they already were
+						for (uint i = m_TriangleOffsets[vertex]; i < m_TriangleOffsets[vertex + 1]; ++i)
+						{
+							const uint neighbour = m_VertexTriangles[i];
+							if (m_Used[neighbour])
+							{
+								continue;
+							}
+							if (m_CandidateStamps[neighbour] != m_MeshletIndex)
+							{
+								m_CandidateStamps[neighbour] = m_MeshletIndex;
+								m_NewVertexCounts[neighbour] = 3;
+								m_Candidates.Add(neighbour);
+							}
+							--m_NewVertexCounts[neighbour];
+						}
+					}
+					packed |= m_LocalIndices[vertex] << (c * 8);
+				}
+
+				m_Output->triangles.Add(packed);
+				m_Used[triangle] = true;
+				m_CentroidSum += m_Centroids[m_Triangles[triangle]];
+				++m_Meshlet.triangleCount;
+			}
+
+			const uint* m_Indices;
+			const Vector3* m_Centroids;
+			uint m_MaxVertices;
+			uint m_MaxTriangles;
+
+			// Mesh triangles of the chunk and the chunk vertex of each of their corners
+			const uint* m_Triangles;
+			Array<uint> m_Corners;
+			Array<uint> m_GlobalVertices;
+			// Triangles around each chunk vertex
+			Array<uint> m_TriangleOffsets;
+			Array<uint> m_VertexTriangles;
+
+			Array<bool> m_Used;
+			Array<uint> m_Candidates;
+			// A triangle is a candidate and a vertex is in the meshlet when their stamp is the meshlet's index
+			Array<uint> m_CandidateStamps;
+			// Vertices each candidate would add to the meshlet
+			Array<uint8> m_NewVertexCounts;
+			Array<uint> m_MeshletStamps;
+			Array<uint> m_LocalIndices;
+
+			Meshlet m_Meshlet;
+			uint m_MeshletIndex;
+			Vector3 m_CentroidSum;
+			ChunkMeshlets* m_Output;
+		};
+	}
+
+	void MeshletBuilder::Build(const Vertex* vertices, const uint* indices, uint numIndices, MeshletData& data,
+		uint maxVertices, uint maxTriangles)
+	{
+		TYR_ASSERT(numIndices % 3 == 0);
+		TYR_ASSERT(maxVertices >= 3 && maxVertices <= c_MaxVertices);
+		TYR_ASSERT(maxTriangles >= 1 && maxTriangles <= c_MaxTriangles);
+
+		data.meshlets.Clear();
+		data.bounds.Clear();
+		data.vertexIndices.Clear();
+		data.triangles.Clear();
+
+		const uint numTriangles = numIndices / 3;
+		if (numTriangles == 0)
+		{
+			return;
+		}
+
+		// Sort the triangles along a Morton curve through the mesh's bounds so that chunks are compact
+		Array<Vector3> centroids(numTriangles);
+		ParallelFor(numTriangles, [&](uint t)
+		{
+			const uint* triangle = indices + t * 3;
+			centroids[t] = (vertices[triangle[0]].position + vertices[triangle[1]].position + vertices[triangle[2]].position) / 3.0f;
+		});
+
+		AABB bounds(centroids[0], centroids[0]);
+		for (const Vector3& centroid : centroids)
+		{
+			bounds.Merge(centroid);
+		}
+		const Vector3 size = bounds.GetMax() - bounds.GetMin();
+		const float maxCell = static_cast<float>(1u << c_MortonBits);
+		Vector3 scale;
+		for (uint axis = 0; axis < 3; ++axis)
+		{
+			scale[axis] = size[axis] > 0.0f ? maxCell / size[axis] : 0.0f;
+		}
+
+		Array<uint> codes(numTriangles);
+		Array<uint> order(numTriangles);
+		ParallelFor(numTriangles, [&](uint t)
+		{
+			codes[t] = ComputeMortonCode(centroids[t], bounds.GetMin(), scale);
+			order[t] = t;
+		});
+		// The sort is stable so the order is deterministic
+		ParallelRadixSort(order.Data(), numTriangles, [&](uint t) { return codes[t]; });
+
+		// Chunk boundaries only depend on the triangle count, never on the number of workers
+		const uint chunkCount = (numTriangles + c_ChunkTriangleCount - 1) / c_ChunkTriangleCount;
+		Array<ChunkMeshlets> chunks(chunkCount);
+		ParallelFor(chunkCount, [&](uint chunk)
+		{
+			const uint begin = chunk * c_ChunkTriangleCount;
+			const uint end = std::min(begin + c_ChunkTriangleCount, numTriangles);
+			ChunkBuilder builder(indices, centroids.Data(), maxVertices, maxTriangles);
+			builder.Build(order.Data() + begin, end - begin, chunks[chunk]);
+		}, 1);
+
+		// Concatenate the chunks in order
+		Array<uint> meshletOffsets(chunkCount + 1);
+		Array<uint> vertexOffsets(chunkCount + 1);
+		Array<uint> triangleOffsets(chunkCount + 1);
+		meshletOffsets[0] = vertexOffsets[0] = triangleOffsets[0] = 0;
+		for (uint chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			meshletOffsets[chunk + 1] = meshletOffsets[chunk] + chunks[chunk].meshlets.Size();
+			vertexOffsets[chunk + 1] = vertexOffsets[chunk] + chunks[chunk].vertexIndices.Size();
+			triangleOffsets[chunk + 1] = triangleOffsets[chunk] + chunks[chunk].triangles.Size();
+		}
+
+		data.meshlets.Resize(meshletOffsets[chunkCount]);
+		data.bounds.Resize(meshletOffsets[chunkCount]);
+		data.vertexIndices.Resize(vertexOffsets[chunkCount]);
+		data.triangles.Resize(triangleOffsets[chunkCount]);
+		ParallelFor(chunkCount, [&](uint chunk)
+		{
+			const ChunkMeshlets& source = chunks[chunk];
+			for (uint i = 0; i < source.meshlets.Size(); ++i)
+			{
+				Meshlet& meshlet = data.meshlets[meshletOffsets[chunk] + i];
+				meshlet = source.meshlets[i];
+				meshlet.vertexOffset += vertexOffsets[chunk];
+				meshlet.triangleOffset += triangleOffsets[chunk];
+			}
+			std::memcpy(data.vertexIndices.Data() + vertexOffsets[chunk], source.vertexIndices.Data(), source.vertexIndices.Size() * sizeof(uint));
+			std::memcpy(data.triangles.Data() + triangleOffsets[chunk], source.triangles.Data(), source.triangles.Size() * sizeof(uint));
+		}, 1);
+
+		ParallelFor(data.meshlets.Size(), [&](uint i)
+		{
+			data.bounds[i] = ComputeBounds(vertices, data, data.meshlets[i]);
+		});
+	}
+
+	MeshletBounds MeshletBuilder::ComputeBounds(const Vertex* vertices, const MeshletData& data, const Meshlet& meshlet)
+	{
+		const uint* vertexIndices = data.vertexIndices.Data() + meshlet.vertexOffset;
+		const uint* triangles = data.triangles.Data() + meshlet.triangleOffset;
+		MeshletBounds bounds;
+		bounds.padding = 0.0f;
+
+		// Sphere centred on the box around the vertices
+		AABB box(vertices[vertexIndices[0]].position, vertices[vertexIndices[0]].position);
+		for (uint i = 1; i < meshlet.vertexCount; ++i)
+		{
+			box.Merge(vertices[vertexIndices[i]].position);
+		}
+		bounds.centre = box.GetCentre();
+		float sqrRadius = 0.0f;
+		for (uint i = 0; i < meshlet.vertexCount; ++i)
+		{
+			sqrRadius = std::max(sqrRadius, (vertices[vertexIndices[i]].position - bounds.centre).SqrLength());
+		}
+		bounds.radius = Math::Sqrt(sqrRadius);
+
+		// The cone axis is the average of the triangles' unit normals. Degenerate triangles can't be seen so they
+		// are skipped.
+		LocalArray<Vector3, c_MaxTriangles> normals;
+		LocalArray<Vector3, c_MaxTriangles> corners;
+		Vector3 normalSum = Vector3::c_Zero;
+		for (uint t = 0; t < meshlet.triangleCount; ++t)
+		{
+			const uint packed = triangles[t];
+			const Vector3& p0 = vertices[vertexIndices[packed & 0xFF]].position;
+			const Vector3& p1 = vertices[vertexIndices[(packed >> 8) & 0xFF]].position;
+			const Vector3& p2 = vertices[vertexIndices[(packed >> 16) & 0xFF]].position;
+			// Same orientation as MeshUtil
+			const Vector3 normal = (p2 - p0).Cross(p1 - p0);
+			const float sqrLength = normal.SqrLength();
+			if (sqrLength > 0.0f)
+			{
+				normals.Add(normal * Math::InvSqrt(sqrLength));
+				corners.Add(p0);
+				normalSum += normals[normals.Size() - 1];
+			}
+		}
+
+		bounds.coneAxis = Vector3::c_Zero;
+		bounds.coneCutoff = c_NoConeCutoff;
+		bounds.coneApex = bounds.centre;
+		const float sqrSumLength = normalSum.SqrLength();
+		if (sqrSumLength == 0.0f)
+		{
+			return bounds;
+		}
+
+		const Vector3 axis = normalSum * Math::InvSqrt(sqrSumLength);
+		float minCosine = 1.0f;
+		for (uint t = 0; t < normals.Size(); ++t)
+		{
+			minCosine = std::min(minCosine, axis.Dot(normals[t]));
+		}
+		bounds.coneAxis = axis;
+		if (minCosine <= c_MinConeCosine)
+		{
+			return bounds;
+		}
+
+		// Move the apex back along the axis until it is behind every triangle's plane. A camera inside the cone
+		// opened around -axis at the apex is then behind every plane.
+		float maxOffset = 0.0f;
+		for (uint t = 0; t < normals.Size(); ++t)
+		{
+			const float offset = (bounds.centre - corners[t]).Dot(normals[t]) / axis.Dot(normals[t]);
+			maxOffset = std::max(maxOffset, offset);
+		}
+		bounds.coneApex = bounds.centre - axis * maxOffset;
+		bounds.coneCutoff = Math::Sqrt(1.0f - minCosine * minCosine);
+		return bounds;
+	}
+
+	bool MeshletBuilder::IsBackFacing(const MeshletBounds& bounds, const Vector3& cameraPosition)
+	{
+		const Vector3 direction = bounds.coneApex - cameraPosition;
+		const float length = direction.Length();
+		return direction.Dot(bounds.coneAxis) >= bounds.coneCutoff * length;
+	}
+
+	uint MeshletBuilder::CullMeshlets(const MeshletBounds* bounds, uint numMeshlets, const Frustum& frustum, const Vector3& cameraPosition,
+		uint* visibleIndices)
+	{
+		const auto cull = [&](uint begin, uint end, uint* visible)
+		{
+			uint visibleCount = 0;
+			for (uint i = begin; i < end; ++i)
+			{
+				if (!IsBackFacing(bounds[i], cameraPosition) && frustum.Intersects(BoundingSphere(bounds[i].centre, bounds[i].radius)))
+				{
+					visible[visibleCount++] = i;
+				}
+			}
+			return visibleCount;
+		};
+
+		const uint chunkCount = Parallel::ComputeChunkCount(numMeshlets, c_CullGrainSize);
+		if (chunkCount <= 1)
+		{
+			return cull(0, numMeshlets, visibleIndices);
+		}
+
+		// Each chunk writes its indices to the start of its own range, which can't overlap the other chunks
+		Array<uint> visibleCounts(chunkCount);
+		ParallelFor(chunkCount, [&](uint chunk)
+		{
+			const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, numMeshlets);
+			const uint end = Parallel::GetChunkBegin(chunk + 1, chunkCount, numMeshlets);
+			visibleCounts[chunk] = cull(begin, end, visibleIndices + begin);
+		}, 1);
+
+		uint visibleCount = visibleCounts[0];
+		for (uint chunk = 1; chunk < chunkCount; ++chunk)
+		{
+			const uint begin = Parallel::GetChunkBegin(chunk, chunkCount, numMeshlets);
+			std::memmove(visibleIndices + visibleCount, visibleIndices + begin, visibleCounts[chunk] * sizeof(uint));
+			visibleCount += visibleCounts[chunk];
+		}
+		return visibleCount;
+	}
+}
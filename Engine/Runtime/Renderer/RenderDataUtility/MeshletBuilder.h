@@ -0,0 +1,46 @@
+#pragma once
+
+#include "RendererMacros.h"
+#include "Core.h"
+#include "RenderDataTypes/Meshlet.h"
+
+namespace tyr
+{
+	struct Vertex;
+	class Frustum;
+
+	/// Splits triangle lists into meshlets for mesh shaders and culls meshlets on the CPU.
+	class TYR_RENDERER_EXPORT MeshletBuilder
+	{
+	public:
+		// Limits suited to most hardware. 124 triangles leave room for 4 more in a 128 entry output.
+		static constexpr uint c_DefaultMaxVertices = 64;
+		static constexpr uint c_DefaultMaxTriangles = 124;
+		// Largest limits that the 8 bit local indices and mesh shader outputs allow
+		static constexpr uint c_MaxVertices = 256;
+		static constexpr uint c_MaxTriangles = 256;
+		// Triangles are sorted along a space filling curve and split into chunks of this many that are built in parallel
+		static constexpr uint c_ChunkTriangleCount = 8192;
+		// Meshlets are culled in chunks of at least this many on the job system
+		static constexpr uint c_CullGrainSize = 1024;
+
+		/// Builds meshlets of at most maxVertices vertices and maxTriangles triangles and their bounds. A meshlet grows
+		/// by the neighbouring triangle that adds the fewest vertices, then the one closest to its centre. The result
+		/// doesn't depend on the number of worker threads.
+		static void Build(const Vertex* vertices, const uint* indices, uint numIndices, MeshletData& data,
+			uint maxVertices = c_DefaultMaxVertices, uint maxTriangles = c_DefaultMaxTriangles);
+
+		/// Computes the bounding sphere and normal cone of a meshlet. A triangle (p0, p1, p2) faces along
+		/// (p2 - p0) x (p1 - p0), the same as the normals MeshUtil computes.
+		static MeshletBounds ComputeBounds(const Vertex* vertices, const MeshletData& data, const Meshlet& meshlet);
+
+		/// Returns true if every triangle of the meshlet faces away from the camera.
+		static bool IsBackFacing(const MeshletBounds& bounds, const Vector3& cameraPosition);
+
+		/// Writes the indices of the meshlets that intersect the frustum and don't face away from the camera to
+		/// visibleIndices in increasing order and returns the number written. The frustum and camera must be in mesh
+		/// space. visibleIndices must hold numMeshlets indices. Runs on the job system.
+		static uint CullMeshlets(const MeshletBounds* bounds, uint numMeshlets, const Frustum& frustum, const Vector3& cameraPosition,
+			uint* visibleIndices);
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Rendering/Scene.h"
+#include "Memory/FrameAllocation.h"
 
 namespace tyr
 {
@@ -9,18 +10,22 @@ namespace tyr
 		static constexpr uint8 c_MaxRenderFrames = 3;
 		// True if the primary window resized since the last frame
 		bool windowResize = false;
-		Array<TextureDesc> m_NewTextures;
-		Array<uint> m_DeletedTextures;
-		Array<MaterialDesc> m_NewMaterials;
-		Array<uint> m_DeletedMaterials;
+		FrameArray<TextureDesc> m_NewTextures;
+		FrameArray<uint> m_DeletedTextures;
 		SceneFrame sceneFrames[Scene::c_MaxScenes];
 
 		void Clear()
 		{
-			m_NewTextures.Clear();
-			m_DeletedTextures.Clear();
-			m_NewMaterials.Clear();
-			m_DeletedMaterials.Clear();
+			// Frame arrays are reassigned as their storage belongs to an older frame generation
+			m_NewTextures = FrameArray<TextureDesc>();
+			m_DeletedTextures = FrameArray<uint>();
+			for (SceneFrame& sceneFrame : sceneFrames)
+			{
+				sceneFrame.delta.Clear();
+			}
 		}
 	};
+
+	TYR_STATIC_ASSERT(RenderFrame::c_MaxRenderFrames <= FrameAllocator::c_FrameGenerationCount,
+		"Frame allocations must outlive every render frame in flight");
 }
\ No newline at end of file
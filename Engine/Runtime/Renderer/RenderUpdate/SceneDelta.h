@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Core.h"
+#include "Memory/FrameAllocation.h"
+#include "RenderDataTypes/RenderDataTypes.h"
+
+namespace tyr
+{
+	/// Id of a scene object mirrored by the renderer. Ids are dense and reused once the renderer has seen the object
+	/// destroyed.
+	using SceneObjectId = uint;
+	constexpr SceneObjectId c_InvalidSceneObjectId = ~0u;
+
+	template<typename T>
+	struct SceneObjectUpdate
+	{
+		SceneObjectId id;
+		T data;
+	};
+
+	/// Changes to one kind of scene object since the last frame the renderer accepted. An id appears in at most one of
+	/// the streams. The streams are allocated with the frame allocator.
+	template<typename T>
+	struct SceneObjectDelta
+	{
+		FrameArray<SceneObjectUpdate<T>> created;
+		FrameArray<SceneObjectUpdate<T>> modified;
+		FrameArray<SceneObjectId> destroyed;
+
+		bool IsEmpty() const
+		{
+			return created.IsEmpty() && modified.IsEmpty() && destroyed.IsEmpty();
+		}
+
+		void Clear()
+		{
+			// The storage belongs to an older frame generation so it is dropped rather than reused
+			created = FrameArray<SceneObjectUpdate<T>>();
+			modified = FrameArray<SceneObjectUpdate<T>>();
+			destroyed = FrameArray<SceneObjectId>();
+		}
+	};
+
+	/// Changes to a scene's content sent to the renderer, which applies them to its own copy of the scene. Static
+	/// scenes produce empty deltas.
+	struct SceneDelta
+	{
+		SceneObjectDelta<RigidMeshInstance> rigidMeshInstances;
+		SceneObjectDelta<DirectionalLight> dirLights;
+		SceneObjectDelta<PointLight> pointLights;
+		SceneObjectDelta<SpotLight> spotLights;
+		SceneObjectDelta<Material> materials;
+		// Discards the renderer's copy of the scene before the changes are applied. Set on the first delta of a world
+		// since the scene may have belonged to another world before.
+		bool reset = false;
+
+		bool IsEmpty() const
+		{
+			return !reset && rigidMeshInstances.IsEmpty() && dirLights.IsEmpty() && pointLights.IsEmpty()
+				&& spotLights.IsEmpty() && materials.IsEmpty();
+		}
+
+		void Clear()
+		{
+			reset = false;
+			rigidMeshInstances.Clear();
+			dirLights.Clear();
+			pointLights.Clear();
+			spotLights.Clear();
+			materials.Clear();
+		}
+	};
+}
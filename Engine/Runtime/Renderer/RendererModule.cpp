@@ -37,6 +37,8 @@ namespace tyr
 		snprintf(byteCodeRootDirPath, sizeof(byteCodeRootDirPath), "%s/%s", binaryDirectoryPath, "Shaders");
 		rendererConfig.shaderConfig.byteCodeRootDirPath = byteCodeRootDirPath;
 		rendererConfig.shaderConfig.shaderModel = { 6, 2 };
+		rendererConfig.renderThread = true;
+		rendererConfig.frameLatency = 1;
 
 		m_RenderAPI = GraphicsManager::CreateRenderAPI(rendererConfig.renderAPICreateConfig);
 		m_RenderAPI->Initialize(rendererConfig.renderAPIConfig);
@@ -46,10 +48,11 @@ namespace tyr
 
 	void RendererModule::UpdateModule(float deltaTime)
 	{
-		// This runs on main thread
-
-		// TODO: This won't need to be called as the renderer will be running on its own thread
-		m_Renderer->Render(deltaTime);
+		// This runs on main thread. With the render thread, frames are rendered as the world manager adds them.
+		if (!m_Renderer->HasRenderThread())
+		{
+			m_Renderer->Render(deltaTime);
+		}
 	}
 
 	void RendererModule::ShutdownModule()
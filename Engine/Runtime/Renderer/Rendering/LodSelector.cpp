@@ -0,0 +1,51 @@
+#include "LodSelector.h"
+#include "Scene.h"
+#include "Threading/Parallel.h"
+
+namespace tyr
+{
+	float LodSelector::ComputeProjectionScale(const SceneCamera& camera, float viewportWidth)
+	{
+		const float halfFov = camera.fov * Math::c_DegToRad * 0.5f;
+		return viewportWidth * 0.5f / Math::Tan(halfFov);
+	}
+
+	void LodSelector::SelectLods(const SceneCamera& camera, float viewportWidth, float targetPixelError, const MeshLodChain* meshes,
+		RigidMeshInstance* instances, uint numInstances)
+	{
+		// A level is acceptable when error * scale / distance <= targetErrorPerDistance
+		const float targetErrorPerDistance = targetPixelError / ComputeProjectionScale(camera, viewportWidth);
+
+		ParallelFor(numInstances, [&](uint i)
+		{
+			RigidMeshInstance& instance = instances[i];
+			const MeshLodChain& mesh = meshes[instance.meshIndex];
+			const Matrix4& transform = instance.transform;
+
+			// Points are row vectors with the translation in the last row
+			const Vector3& localCentre = mesh.bounds.GetCentre();
+			Vector3 centre;
+			for (uint axis = 0; axis < 3; ++axis)
+			{
+				centre[axis] = localCentre.x * transform[0][axis] + localCentre.y * transform[1][axis] + localCentre.z * transform[2][axis] + transform[3][axis];
+			}
+			float sqrScale = 0.0f;
+			for (uint row = 0; row < 3; ++row)
+			{
+				sqrScale = std::max(sqrScale, Vector3(transform[row][0], transform[row][1], transform[row][2]).SqrLength());
+			}
+			const float scale = Math::Sqrt(sqrScale);
+
+			// Measure from the closest point of the bounds so that large meshes near the camera keep their detail
+			const float distance = std::max((centre - camera.position).Length() - mesh.bounds.GetRadius() * scale, camera.nearZ);
+			const float targetError = scale > 0.0f ? targetErrorPerDistance * distance / scale : 0.0f;
+
+			uint lod = 0;
+			while (lod + 1 < mesh.lods.Size() && mesh.lods[lod + 1].error <= targetError)
+			{
+				++lod;
+			}
+			instance.lod = lod;
+		}, c_GrainSize);
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "RendererMacros.h"
+#include "Core.h"
+#include "RenderDataTypes/RigidMesh.h"
+
+namespace tyr
+{
+	struct SceneCamera;
+
+	/// Chooses the level of detail of mesh instances from how large each level's error would appear on screen
+	class TYR_RENDERER_EXPORT LodSelector
+	{
+	public:
+		// Instances are split into chunks of at least this many for the job system
+		static constexpr uint c_GrainSize = 1024;
+
+		/// Returns the factor that converts an error at a distance from the camera into pixels, so that
+		/// pixels = error * factor / distance. The camera's field of view is horizontal, as in
+		/// Matrix4::CreatePerspective().
+		static float ComputeProjectionScale(const SceneCamera& camera, float viewportWidth);
+
+		/// Sets each instance's lod to the coarsest level of its mesh whose error covers at most targetPixelError pixels
+		/// at the instance's distance and scale. MeshLod::error is a root mean square estimate rather than a bound, so
+		/// some features may move further than that on screen. meshes is indexed by the instances' meshIndex. Runs on
+		/// the job system.
+		static void SelectLods(const SceneCamera& camera, float viewportWidth, float targetPixelError, const MeshLodChain* meshes,
+			RigidMeshInstance* instances, uint numInstances);
+	};
+}
@@ -10,6 +10,14 @@ namespace tyr
 	{
 		TYR_ASSERT(!s_Initialized);
 		s_ScratchAllocatorPool = new ScratchAllocatorPool<c_AllocatorCount>(blockSize);
+		s_Initialized = true;
+	}
+
+	void RenderGraphAllocator::Create(const VirtualArenaConfig& arenaConfig)
+	{
+		TYR_ASSERT(!s_Initialized);
+		s_ScratchAllocatorPool = new ScratchAllocatorPool<c_AllocatorCount>(arenaConfig);
+		s_Initialized = true;
 	}
 
 	uint8* RenderGraphAllocator::Alloc(uint amount)
@@ -6,6 +6,7 @@ namespace tyr
 {
 	template <uint N>
 	class ScratchAllocatorPool;
+	struct VirtualArenaConfig;
 
 	/// A render graph allocator which uses a scratch allocator pool  
 	/// Should only be used by the render graph
@@ -16,6 +17,9 @@ namespace tyr
 
 		static void Create(uint blockSize = 1024 * 1024);
 
+		/// Creates the allocators backed by virtual arenas
+		static void Create(const VirtualArenaConfig& arenaConfig);
+
 		static uint8* Alloc(uint amount);
 
 		static uint8* AllocAligned(uint amount, uint alignment);
@@ -8,6 +8,7 @@
 #include "RenderAPI/ShaderModule.h"
 #include "RenderAPI/CommandAllocator.h"
 #include "RenderAPI/CommandList.h"
+#include "Profiling/Profiler.h"
 #include "RenderAPI/DescriptorSetGroup.h"
 #include "RenderAPI/Sync.h"
 #include "Math/Matrix4.h"
@@ -28,8 +29,11 @@ namespace tyr
 		, m_Device(m_RenderAPI->GetDevice())
 		, m_SwapChain(m_RenderAPI->GetSwapChain())
 		, m_ShaderCreator(*m_Device, rendererConfig.shaderConfig)
+		, m_PendingFrameCount(0)
+		, m_StopRequested(false)
 	{
 		TYR_ASSERT(!s_Instantiated);
+		TYR_ASSERT(m_Config.frameLatency >= 1 && m_Config.frameLatency <= c_MaxFrameLatency);
 
 		CreateShaders();
 		CreatePipeline();
@@ -38,6 +42,7 @@ namespace tyr
 		CreateCommandLists();
 
 		m_SceneInfo.viewProj = Matrix4::c_Identity;
+		m_Frustum = Frustum(m_SceneInfo.viewProj);
 		m_SceneInfo.camPos = Vector3::c_Zero;
 		m_SceneInfo.ambient = 0.0f;
 
@@ -56,10 +61,17 @@ namespace tyr
 		m_RenderingInfo.colourAttachments.Add(std::move(colourAttachment));
 
 		s_Instantiated = true;
+
+		// Started last as the thread uses everything created above
+		if (m_Config.renderThread)
+		{
+			m_RenderThread = Thread(&Renderer::RenderThreadMain, this);
+		}
 	}
 
 	Renderer::~Renderer()
 	{
+		StopRenderThread();
 		WaitForCompletion();
 
 		TYR_SAFE_DELETE(m_CommandList);
@@ -93,6 +105,20 @@ namespace tyr
 
 	void Renderer::Render(double deltaTime)
 	{
+		TYR_ASSERT(!m_Config.renderThread);
+
+		LocalArray<const RenderFrame*, RenderFrame::c_MaxRenderFrames> frames;
+		while (Optional<const RenderFrame*> rf = m_FrameUpdateQueue.Read())
+		{
+			frames.Add(rf.value());
+		}
+		m_PendingFrameCount = 0;
+		RenderFrames(frames.Data(), frames.Size());
+	}
+
+	void Renderer::RenderFrames(const RenderFrame* const* frames, uint frameCount)
+	{
+		TYR_PROFILE_SCOPE("Renderer::RenderFrames");
 		m_SwapChainImageIndex = m_SwapChain->AcquireNextImage(m_AquireSwapChainImageSemaphores[m_SemaphoreIndex]);
 
 		const float windowWidth = m_SwapChain->GetWidth();
@@ -100,16 +126,25 @@ namespace tyr
 		m_Viewport.width = windowWidth;
 		m_Viewport.height = windowHeight;
 
-		Optional<const RenderFrame*> rf = m_FrameUpdateQueue.ReadOnly();
-		if (rf)
+		// The scene mirrors are only correct if every frame's deltas are applied in order. Only the latest frame's view
+		// is used.
+		for (uint i = 0; i < frameCount; ++i)
+		{
+			for (uint8 j = 0; j < Scene::c_MaxScenes; ++j)
+			{
+				m_SceneMirrors[j].Apply(frames[i]->sceneFrames[j].delta);
+			}
+		}
+
+		if (frameCount > 0)
 		{
-			const RenderFrame& renderFrame = *rf.value();
-			const SceneFrame& sceneFrame = renderFrame.sceneFrames[0];
+			const SceneFrame& sceneFrame = frames[frameCount - 1]->sceneFrames[0];
 			const SceneView& sceneView = sceneFrame.view;
 			const Matrix4 view = Matrix4::CreateView(sceneView.camera.position, sceneView.camera.forward, sceneView.camera.up);
 			// Do reverse-z for greater floating-point precision
 			const Matrix4 projection = Matrix4::CreatePerspective(sceneView.camera.fov, windowWidth / windowHeight, sceneView.camera.farZ, sceneView.camera.nearZ);
 			m_SceneInfo.viewProj = view * projection;
+			m_Frustum = Frustum(m_SceneInfo.viewProj);
 			m_SceneInfo.camPos = sceneView.camera.position;
 			m_RenderingInfo.renderArea.offset = 
 			{ 
@@ -662,7 +697,101 @@ namespace tyr
 
 	bool Renderer::TryAddFrame(const RenderFrame* frame)
 	{
-		return m_FrameUpdateQueue.Enqueue(frame);
+		if (!m_Config.renderThread)
+		{
+			// The game thread writes the render frame that isn't queued
+			if (m_PendingFrameCount == RenderFrame::c_MaxRenderFrames - 1)
+			{
+				return false;
+			}
+			m_FrameUpdateQueue.Enqueue(frame);
+			++m_PendingFrameCount;
+			return true;
+		}
+
+		{
+			// The queue is only accessed under the lock so that the frame's contents are visible to the render thread
+			LockGuard guard(m_FrameMutex);
+			// WaitForFreeFrame() keeps at most frameLatency + 1 frames pending, which the queue has room for even if the
+			// render thread hasn't taken any of them yet
+			const bool added = m_FrameUpdateQueue.Enqueue(frame);
+			TYR_ASSERT(added);
+			++m_PendingFrameCount;
+		}
+		m_FrameAddedCV.notify_one();
+		return true;
+	}
+
+	void Renderer::WaitForFreeFrame()
+	{
+		if (!m_Config.renderThread)
+		{
+			return;
+		}
+
+		TYR_PROFILE_SCOPE("Renderer::WaitForFreeFrame");
+		Lock lock(m_FrameMutex);
+		m_FrameDoneCV.wait(lock, [this]() { return m_PendingFrameCount <= m_Config.frameLatency || m_StopRequested; });
+	}
+
+	void Renderer::WaitForFrames()
+	{
+		if (!m_Config.renderThread)
+		{
+			return;
+		}
+
+		Lock lock(m_FrameMutex);
+		m_FrameDoneCV.wait(lock, [this]() { return m_PendingFrameCount == 0 || m_StopRequested; });
+	}
+
+	void Renderer::RenderThreadMain()
+	{
+		TYR_PROFILE_THREAD_NAME("Render");
+
+		while (true)
+		{
+			// Frames that arrived while the last one was rendered are rendered together so the thread catches up
+			LocalArray<const RenderFrame*, RenderFrame::c_MaxRenderFrames> frames;
+			{
+				Lock lock(m_FrameMutex);
+				m_FrameAddedCV.wait(lock, [this]() { return m_StopRequested || !m_FrameUpdateQueue.IsEmpty(); });
+				if (m_StopRequested)
+				{
+					break;
+				}
+				while (Optional<const RenderFrame*> rf = m_FrameUpdateQueue.Read())
+				{
+					frames.Add(rf.value());
+				}
+			}
+
+			RenderFrames(frames.Data(), frames.Size());
+
+			{
+				// The frames go back to the game thread only now as rendering read them until here
+				LockGuard guard(m_FrameMutex);
+				m_PendingFrameCount -= frames.Size();
+			}
+			m_FrameDoneCV.notify_all();
+		}
+	}
+
+	void Renderer::StopRenderThread()
+	{
+		if (!m_RenderThread.joinable())
+		{
+			return;
+		}
+
+		{
+			LockGuard guard(m_FrameMutex);
+			m_StopRequested = true;
+		}
+		m_FrameAddedCV.notify_one();
+		m_RenderThread.join();
+		// Frames still queued are dropped. Anyone waiting for them is released.
+		m_FrameDoneCV.notify_all();
 	}
 
 	void Renderer::WaitForCompletion()
@@ -3,6 +3,7 @@
 #include "Core.h"
 #include "RendererMacros.h"
 #include "Containers/SPSCRingBuffer.h"
+#include "Threading/Threading.h"
 #include "RenderDataTypes/RenderDataTypes.h"
 #include "Shaders/ShaderTypes.h"
 #include "RendererConfig.h"
@@ -10,6 +11,8 @@
 #include "Shader/ShaderCreator.h"
 #include "Resources/RenderBuffer.h"
 #include "RenderUpdate/RenderFrame.h"
+#include "Rendering/SceneMirror.h"
+#include "Geometry/Frustum.h"
 
 namespace tyr
 {
@@ -24,20 +27,45 @@ namespace tyr
 		float metallic;
 	};
 
+	/// Renders the frames produced by the game thread.
+	///
+	/// Without the render thread, frames are added to a queue and Render() consumes all of them on the calling thread.
+	/// With it, a dedicated thread waits for frames and renders them as they are added. The game thread calls
+	/// WaitForFreeFrame() before starting each frame, which blocks while more than RendererConfig::frameLatency frames
+	/// are waiting to be rendered or being rendered. A frame, and the frame allocations it points to, belong to the
+	/// renderer from TryAddFrame() until the render thread has finished it.
 	class TYR_RENDERER_EXPORT Renderer final : INonCopyable
 	{
 	public:
+		// At this latency the frames the render thread has yet to finish and the one the game thread builds use every
+		// render frame and frame allocator generation
+		static constexpr uint8 c_MaxFrameLatency = RenderFrame::c_MaxRenderFrames - 1;
+
 		Renderer(const RendererConfig& rendererConfig, Ref<RenderAPI>& renderAPI);
 		~Renderer();
 
+		/// Renders the frames added since the last call. Only used without the render thread.
 		void Render(double deltaTime);
 
 		bool TryAddFrame(const RenderFrame* frame);
 
+		/// Blocks until the game thread may build another frame. Must be called before the frame allocator starts
+		/// a new frame, as frames still being rendered use allocations of the previous frames.
+		void WaitForFreeFrame();
+
+		/// Blocks until the render thread has finished every frame added, after which the game thread may free them.
+		void WaitForFrames();
+
+		bool HasRenderThread() const { return m_Config.renderThread; }
+
 		// Wait for all rendering operations to be complete
 		void WaitForCompletion();
 	
 	private:
+		/// Applies the frames' scene deltas, in order, and records and submits GPU work with the latest frame's view.
+		void RenderFrames(const RenderFrame* const* frames, uint frameCount);
+		void RenderThreadMain();
+		void StopRenderThread();
 		RenderPassHandle CreateRenderPass();
 		void CreateShaders();
 		void CreatePipeline();
@@ -55,7 +83,8 @@ namespace tyr
 		SwapChain* m_SwapChain;
 		Device* m_Device;
 		ShaderCreator m_ShaderCreator;
-		SPSCRingBuffer<const RenderFrame*, RenderFrame::c_MaxRenderFrames> m_FrameUpdateQueue;
+		// One slot of the ring buffer is always empty, so this has room for every render frame
+		SPSCRingBuffer<const RenderFrame*, RenderFrame::c_MaxRenderFrames + 1> m_FrameUpdateQueue;
 		GraphicsPipelineHandle m_Pipeline;
 		RenderBuffer m_VertexBuffer;
 		RenderBuffer m_IndexBuffer;
@@ -75,6 +104,10 @@ namespace tyr
 		MaterialTextureData m_MaterialTextureData;
 		RendererConfig m_Config;
 		ShaderSceneInfo m_SceneInfo;
+		// View frustum of the main scene, updated with the view projection matrix
+		Frustum m_Frustum;
+		// Content of each scene, updated from the deltas of every render frame
+		SceneMirror m_SceneMirrors[Scene::c_MaxScenes];
 		RenderingInfo m_RenderingInfo;
 		CommndListExecuteDesc m_ExecuteDesc;
 		FenceHandle m_Fence;
@@ -87,6 +120,16 @@ namespace tyr
 		uint m_SwapChainImageIndex;
 		bool m_FirstRender;
 		bool m_SceneUpdated;
+
+		Thread m_RenderThread;
+		Mutex m_FrameMutex;
+		// Signalled when a frame is added or the render thread should stop
+		ConditionVariable m_FrameAddedCV;
+		// Signalled when the render thread finishes frames
+		ConditionVariable m_FrameDoneCV;
+		// Frames added that haven't been rendered. With the render thread this includes those being rendered.
+		uint m_PendingFrameCount;
+		bool m_StopRequested;
 	};
 	
 }
\ No newline at end of file
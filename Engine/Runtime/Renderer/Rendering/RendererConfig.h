@@ -16,5 +16,11 @@ namespace tyr
 		RenderAPIConfig renderAPIConfig;
 		ShaderCreatorConfig shaderConfig;
 		bool voxelRendering = false;
+		// Records and submits GPU work on a dedicated thread so that it overlaps the game thread's next frames
+		bool renderThread = false;
+		// Number of frames that may be waiting to be rendered or being rendered while the game thread builds the next
+		// one, from 1 to Renderer::c_MaxFrameLatency. With 1 the game thread builds a frame while the render thread
+		// renders the previous one. Only used with the render thread.
+		uint8 frameLatency = 1;
 	};
 }
\ No newline at end of file
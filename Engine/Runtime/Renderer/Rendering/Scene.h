@@ -7,6 +7,7 @@
 #include "Math/Matrix4.h"
 #include "RenderAPI/RenderAPITypes.h"
 #include "RenderDataTypes/RenderDataTypes.h"
+#include "RenderUpdate/SceneDelta.h"
 
 namespace tyr
 {
@@ -59,5 +60,7 @@ namespace tyr
 	{
 		bool visible = true;
 		SceneView view;
+		// Changes to the scene's content since the last frame the renderer accepted
+		SceneDelta delta;
 	};
 }
\ No newline at end of file
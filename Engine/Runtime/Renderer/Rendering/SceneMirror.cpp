@@ -0,0 +1,29 @@
+#include "SceneMirror.h"
+
+namespace tyr
+{
+	bool SceneMirror::Apply(const SceneDelta& delta)
+	{
+		if (delta.reset)
+		{
+			Clear();
+		}
+
+		bool changed = delta.reset;
+		changed |= rigidMeshInstances.Apply(delta.rigidMeshInstances);
+		changed |= dirLights.Apply(delta.dirLights);
+		changed |= pointLights.Apply(delta.pointLights);
+		changed |= spotLights.Apply(delta.spotLights);
+		changed |= materials.Apply(delta.materials);
+		return changed;
+	}
+
+	void SceneMirror::Clear()
+	{
+		rigidMeshInstances.Clear();
+		dirLights.Clear();
+		pointLights.Clear();
+		spotLights.Clear();
+		materials.Clear();
+	}
+}
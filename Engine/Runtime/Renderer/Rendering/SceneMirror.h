@@ -0,0 +1,108 @@
+#pragma once
+
+#include "RendererMacros.h"
+#include "Core.h"
+#include "RenderUpdate/SceneDelta.h"
+
+namespace tyr
+{
+	/// The renderer's copy of one kind of scene object, kept up to date by applying deltas. Objects are packed so that
+	/// they can be iterated or uploaded directly. Destroying an object moves the last object into its place.
+	template<typename T>
+	class SceneObjectMirror final
+	{
+	public:
+		/// Applies the changes in a delta and returns true if there were any.
+		bool Apply(const SceneObjectDelta<T>& delta)
+		{
+			// Ids of destroyed objects may be reused by created ones in a later delta but never in the same one
+			for (SceneObjectId id : delta.destroyed)
+			{
+				Remove(id);
+			}
+			for (const SceneObjectUpdate<T>& update : delta.created)
+			{
+				Add(update.id, update.data);
+			}
+			for (const SceneObjectUpdate<T>& update : delta.modified)
+			{
+				TYR_ASSERT(Contains(update.id));
+				m_Objects[m_Slots[update.id]] = update.data;
+			}
+			return !delta.IsEmpty();
+		}
+
+		void Clear()
+		{
+			m_Objects.Clear();
+			m_Ids.Clear();
+			m_Slots.Clear();
+		}
+
+		bool Contains(SceneObjectId id) const { return id < m_Slots.Size() && m_Slots[id] != c_NoSlot; }
+
+		/// Returns the object with the id or null if there is none.
+		const T* Find(SceneObjectId id) const { return Contains(id) ? &m_Objects[m_Slots[id]] : nullptr; }
+
+		T* GetObjects() { return m_Objects.Data(); }
+
+		const T* GetObjects() const { return m_Objects.Data(); }
+
+		/// Id of each object in GetObjects().
+		const SceneObjectId* GetIds() const { return m_Ids.Data(); }
+
+		uint GetCount() const { return m_Objects.Size(); }
+
+	private:
+		static constexpr uint c_NoSlot = ~0u;
+
+		void Add(SceneObjectId id, const T& data)
+		{
+			if (id >= m_Slots.Size())
+			{
+				m_Slots.Resize(id + 1, c_NoSlot);
+			}
+			TYR_ASSERT(m_Slots[id] == c_NoSlot);
+			m_Slots[id] = m_Objects.Size();
+			m_Objects.Add(data);
+			m_Ids.Add(id);
+		}
+
+		void Remove(SceneObjectId id)
+		{
+			TYR_ASSERT(Contains(id));
+			const uint slot = m_Slots[id];
+			const uint last = m_Objects.Size() - 1;
+			if (slot != last)
+			{
+				m_Objects[slot] = std::move(m_Objects[last]);
+				m_Ids[slot] = m_Ids[last];
+				m_Slots[m_Ids[slot]] = slot;
+			}
+			m_Objects.PopBack();
+			m_Ids.PopBack();
+			m_Slots[id] = c_NoSlot;
+		}
+
+		Array<T> m_Objects;
+		Array<SceneObjectId> m_Ids;
+		// Index in m_Objects of each id or c_NoSlot
+		Array<uint> m_Slots;
+	};
+
+	/// The renderer's copy of a scene's content. Only changes are sent each frame, so a static scene costs nothing to
+	/// keep up to date.
+	struct TYR_RENDERER_EXPORT SceneMirror
+	{
+		SceneObjectMirror<RigidMeshInstance> rigidMeshInstances;
+		SceneObjectMirror<DirectionalLight> dirLights;
+		SceneObjectMirror<PointLight> pointLights;
+		SceneObjectMirror<SpotLight> spotLights;
+		SceneObjectMirror<Material> materials;
+
+		/// Applies the changes in a delta and returns true if there were any.
+		bool Apply(const SceneDelta& delta);
+
+		void Clear();
+	};
+}
@@ -0,0 +1,294 @@
+#include "Test.h"
+#include "Containers/HashMap.h"
+#include "Containers/MPMCRingBuffer.h"
+#include "Memory/MemoryTypes.h"
+#include <unordered_map>
+
+namespace tyr
+{
+	namespace
+	{
+		// Puts every key into one of a few probe sequences so that erased slots sit inside long runs of full groups
+		struct CollidingHash
+		{
+			size_t operator()(uint key) const { return key % 7; }
+		};
+
+		template<typename Hash>
+		void TestHashMapChurn(TestState& state, uint liveCount)
+		{
+			HashMap<uint, uint, Hash> map;
+			std::unordered_map<uint, uint> reference;
+			Array<uint> liveKeys;
+			uint nextKey = 0;
+			for (uint i = 0; i < liveCount; ++i)
+			{
+				map.Insert(nextKey, nextKey * 3);
+				reference[nextKey] = nextKey * 3;
+				liveKeys.Add(nextKey++);
+			}
+			const uint initialCapacity = map.Capacity();
+
+			// Erasing and inserting at a constant size must reuse erased slots. A table more than half full may
+			// double once when it runs out of empty slots but never grows after that.
+			TestRandom random;
+			uint churnedCapacity = 0;
+			for (uint round = 0; round < 2; ++round)
+			{
+				for (uint i = 0; i < liveCount * 32; ++i)
+				{
+					const uint victim = static_cast<uint>(random.Next() % liveKeys.Size());
+					map.Erase(liveKeys[victim]);
+					reference.erase(liveKeys[victim]);
+					liveKeys[victim] = nextKey;
+					map.Insert(nextKey, nextKey * 3);
+					reference[nextKey] = nextKey * 3;
+					++nextKey;
+				}
+
+				TYR_CHECK(map.Capacity() <= initialCapacity * 2);
+				TYR_CHECK(round == 0 || map.Capacity() == churnedCapacity);
+				churnedCapacity = map.Capacity();
+			}
+
+			TYR_CHECK(map.Size() == liveCount);
+			for (const auto& [key, value] : reference)
+			{
+				const uint* found = map.Find(key);
+				TYR_CHECK(found && *found == value);
+			}
+			for (uint key = 0; key < nextKey; key += 97)
+			{
+				TYR_CHECK(map.Contains(key) == (reference.count(key) != 0));
+			}
+		}
+	}
+
+	TYR_TEST(HashMapEraseInsertChurn)
+	{
+		for (uint liveCount : { 1u, 7u, 13u, 100u, 1000u, 10000u })
+		{
+			TestHashMapChurn<std::hash<uint>>(state, liveCount);
+		}
+	}
+
+	TYR_TEST(HashMapEraseInsertChurnColliding)
+	{
+		for (uint liveCount : { 1u, 13u, 100u, 500u })
+		{
+			TestHashMapChurn<CollidingHash>(state, liveCount);
+		}
+	}
+
+	TYR_TEST(HashMapEraseReusesEmptySlots)
+	{
+		// Inserting and erasing one key at a time keeps a sparse table at its size however many keys pass through it
+		HashMap<uint, uint> map(64);
+		const uint capacity = map.Capacity();
+		for (uint key = 0; key < 100000; ++key)
+		{
+			map.Insert(key, key);
+			map.Erase(key);
+		}
+		TYR_CHECK(map.Capacity() == capacity);
+		TYR_CHECK(map.Size() == 0);
+	}
+
+	TYR_TEST(HashMapReuseAfterMove)
+	{
+		HashMap<uint, String> source;
+		for (uint key = 0; key < 100; ++key)
+		{
+			source.Insert(key, std::to_string(key));
+		}
+
+		HashMap<uint, String> moved(std::move(source));
+		TYR_CHECK(moved.Size() == 100);
+		TYR_CHECK(moved.Find(42) && *moved.Find(42) == "42");
+
+		// The moved from map must still work as an empty map
+		TYR_CHECK(source.Size() == 0);
+		TYR_CHECK(!source.Contains(7));
+		TYR_CHECK(source.Find(7) == nullptr);
+		source.Erase(7);
+		for (uint key = 0; key < 1000; ++key)
+		{
+			source.Insert(key, std::to_string(key * 2));
+		}
+		TYR_CHECK(source.Size() == 1000);
+		TYR_CHECK(source.Find(999) && *source.Find(999) == "1998");
+
+		// Same for move assignment, including assigning back into the moved from map
+		HashMap<uint, String> assigned;
+		assigned.Insert(1, "1");
+		assigned = std::move(source);
+		TYR_CHECK(assigned.Size() == 1000);
+		TYR_CHECK(source.Size() == 0);
+		source.Insert(5, "5");
+		source = std::move(assigned);
+		TYR_CHECK(source.Size() == 1000);
+		TYR_CHECK(!assigned.Contains(5));
+		assigned[3] = "3";
+		TYR_CHECK(assigned.Size() == 1);
+
+		uint count = 0;
+		for (const auto& entry : assigned)
+		{
+			TYR_CHECK(entry.first == 3);
+			++count;
+		}
+		TYR_CHECK(count == 1);
+	}
+
+	// Producers and consumers mix single and batch calls on a small buffer that wraps around many times.
+	// Every item must be dequeued exactly once and each consumer must see every producer's items in order.
+	TYR_TEST(MPMCRingBufferStress)
+	{
+		static constexpr uint c_ProducerCount = 4;
+		static constexpr uint c_ConsumerCount = 4;
+		static constexpr uint c_ItemsPerProducer = 50000;
+		static constexpr uint c_ItemCount = c_ProducerCount * c_ItemsPerProducer;
+		static constexpr uint c_MaxBatchSize = 16;
+		using RingBuffer = MPMCRingBuffer<uint64, 64>;
+
+		URef<RingBuffer> buffer = std::make_unique<RingBuffer>();
+		Atomic<bool> go = false;
+		Atomic<uint> dequeuedCount = 0;
+		Array<Thread> threads;
+		threads.Reserve(c_ProducerCount + c_ConsumerCount);
+
+		// An item holds its producer in the upper 32 bits and its sequence number within that producer in the lower
+		for (uint p = 0; p < c_ProducerCount; ++p)
+		{
+			threads.Add(Thread([&buffer, &go, p]()
+			{
+				while (!go.load(std::memory_order_acquire))
+				{
+					TYR_THREAD_YIELD
+				}
+
+				// Odd producers enqueue in batches
+				const bool useBatches = (p & 1) != 0;
+				TestRandom random(p + 1);
+				uint64 batch[c_MaxBatchSize];
+				uint sequence = 0;
+				while (sequence < c_ItemsPerProducer)
+				{
+					const uint64 item = (static_cast<uint64>(p) << 32) | sequence;
+					if (!useBatches)
+					{
+						if (buffer->TryEnqueue(item))
+						{
+							++sequence;
+						}
+						else
+						{
+							TYR_THREAD_YIELD
+						}
+						continue;
+					}
+
+					const uint batchSize = std::min(static_cast<uint>(random.Next() % c_MaxBatchSize) + 1, c_ItemsPerProducer - sequence);
+					for (uint i = 0; i < batchSize; ++i)
+					{
+						batch[i] = item + i;
+					}
+					const uint enqueued = buffer->TryEnqueueBatch(batch, batchSize);
+					sequence += enqueued;
+					if (enqueued == 0)
+					{
+						TYR_THREAD_YIELD
+					}
+				}
+			}));
+		}
+
+		Array<Array<uint64>> consumed(c_ConsumerCount);
+		for (uint c = 0; c < c_ConsumerCount; ++c)
+		{
+			threads.Add(Thread([&buffer, &go, &dequeuedCount, &items = consumed[c], c]()
+			{
+				while (!go.load(std::memory_order_acquire))
+				{
+					TYR_THREAD_YIELD
+				}
+
+				// Odd consumers dequeue in batches
+				const bool useBatches = (c & 1) != 0;
+				TestRandom random(c + 101);
+				uint64 batch[c_MaxBatchSize];
+				while (dequeuedCount.load(std::memory_order_relaxed) < c_ItemCount)
+				{
+					uint dequeued = 0;
+					if (useBatches)
+					{
+						dequeued = buffer->TryDequeueBatch(batch, static_cast<uint>(random.Next() % c_MaxBatchSize) + 1);
+						for (uint i = 0; i < dequeued; ++i)
+						{
+							items.Add(batch[i]);
+						}
+					}
+					else if (Optional<uint64> item = buffer->TryDequeue())
+					{
+						items.Add(*item);
+						dequeued = 1;
+					}
+
+					if (dequeued > 0)
+					{
+						dequeuedCount.fetch_add(dequeued, std::memory_order_relaxed);
+					}
+					else
+					{
+						TYR_THREAD_YIELD
+					}
+				}
+			}));
+		}
+
+		go.store(true, std::memory_order_release);
+		for (Thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		// The dequeued items must be exactly the enqueued ones and each consumer must see a producer's items in the
+		// order they were enqueued
+		Array<uint> tallies;
+		tallies.Resize(c_ItemCount, 0u);
+		uint invalidCount = 0;
+		uint outOfOrderCount = 0;
+		for (const Array<uint64>& items : consumed)
+		{
+			int64 lastSequences[c_ProducerCount] = { -1, -1, -1, -1 };
+			for (uint64 item : items)
+			{
+				const uint producer = static_cast<uint>(item >> 32);
+				const uint sequence = static_cast<uint>(item);
+				if (producer >= c_ProducerCount || sequence >= c_ItemsPerProducer)
+				{
+					++invalidCount;
+					continue;
+				}
+
+				++tallies[producer * c_ItemsPerProducer + sequence];
+				if (static_cast<int64>(sequence) <= lastSequences[producer])
+				{
+					++outOfOrderCount;
+				}
+				lastSequences[producer] = sequence;
+			}
+		}
+
+		uint mismatchCount = 0;
+		for (uint tally : tallies)
+		{
+			mismatchCount += tally != 1 ? 1 : 0;
+		}
+		TYR_CHECK(invalidCount == 0);
+		TYR_CHECK(mismatchCount == 0);
+		TYR_CHECK(outOfOrderCount == 0);
+		TYR_CHECK(dequeuedCount.load() == c_ItemCount);
+		TYR_CHECK(!buffer->TryDequeue());
+	}
+}
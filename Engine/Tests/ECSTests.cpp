@@ -0,0 +1,382 @@
+#include "Test.h"
+#include "ECS/EntityManager.h"
+#include <unordered_map>
+
+namespace tyr
+{
+	namespace
+	{
+		struct ValueComponent
+		{
+			uint value = 0;
+		};
+
+		// Large enough that its archetypes hold far fewer rows per chunk than the others
+		struct PaddedComponent
+		{
+			uint value = 0;
+			uint8 padding[124] = {};
+		};
+
+		// Not trivially copyable so it is moved with its relocate function. Counts its live instances to catch
+		// components that are leaked or destroyed twice.
+		struct NameComponent
+		{
+			static inline int s_LiveCount = 0;
+
+			String value;
+
+			NameComponent() { ++s_LiveCount; }
+			NameComponent(String name) : value(std::move(name)) { ++s_LiveCount; }
+			NameComponent(const NameComponent& other) : value(other.value) { ++s_LiveCount; }
+			NameComponent(NameComponent&& other) noexcept : value(std::move(other.value)) { ++s_LiveCount; }
+			NameComponent& operator=(const NameComponent& other) = default;
+			NameComponent& operator=(NameComponent&& other) noexcept = default;
+			~NameComponent() { --s_LiveCount; }
+		};
+
+		struct MarkerTag { };
+
+		struct OtherTag { };
+
+		static constexpr uint c_ComponentTypeCount = 5;
+
+		// Expected state of an entity. Values of components it doesn't have are ignored.
+		struct ReferenceEntity
+		{
+			ComponentMask mask = 0;
+			uint value = 0;
+			uint padded = 0;
+			String name;
+		};
+
+		using ReferenceMap = std::unordered_map<Entity, ReferenceEntity>;
+
+		ComponentMask GetTypeMask(uint type)
+		{
+			switch (type)
+			{
+			case 0: return GetComponentMask<ValueComponent>();
+			case 1: return GetComponentMask<PaddedComponent>();
+			case 2: return GetComponentMask<NameComponent>();
+			case 3: return GetComponentMask<MarkerTag>();
+			default: return GetComponentMask<OtherTag>();
+			}
+		}
+
+		ComponentMask CreateRandomMask(TestRandom& random)
+		{
+			ComponentMask mask = 0;
+			for (uint type = 0; type < c_ComponentTypeCount; ++type)
+			{
+				if (random.Next() & 1)
+				{
+					mask |= GetTypeMask(type);
+				}
+			}
+			return mask;
+		}
+
+		// Gives the entity's components new values, through the manager and in the reference
+		void AssignValues(EntityManager& manager, Entity entity, ReferenceEntity& reference, TestRandom& random)
+		{
+			const uint stamp = static_cast<uint>(random.Next());
+			reference.value = stamp;
+			reference.padded = stamp ^ 0x5A5A5A5Au;
+			reference.name = std::to_string(stamp);
+			if (reference.mask & GetComponentMask<ValueComponent>())
+			{
+				manager.GetComponent<ValueComponent>(entity).value = reference.value;
+			}
+			if (reference.mask & GetComponentMask<PaddedComponent>())
+			{
+				manager.GetComponent<PaddedComponent>(entity).value = reference.padded;
+			}
+			if (reference.mask & GetComponentMask<NameComponent>())
+			{
+				manager.GetComponent<NameComponent>(entity).value = reference.name;
+			}
+		}
+
+		// Components added without a value are default constructed
+		void ResetAddedValues(ReferenceEntity& reference, ComponentMask added)
+		{
+			if (added & GetComponentMask<ValueComponent>())
+			{
+				reference.value = 0;
+			}
+			if (added & GetComponentMask<PaddedComponent>())
+			{
+				reference.padded = 0;
+			}
+			if (added & GetComponentMask<NameComponent>())
+			{
+				reference.name.clear();
+			}
+		}
+
+		void CheckEntities(TestState& state, EntityManager& manager, const ReferenceMap& reference)
+		{
+			TYR_CHECK(manager.GetEntityCount() == reference.size());
+
+			uint mismatchCount = 0;
+			uint nameCount = 0;
+			for (const auto& [entity, expected] : reference)
+			{
+				if (!manager.IsValid(entity) || manager.GetMask(entity) != expected.mask)
+				{
+					++mismatchCount;
+					continue;
+				}
+
+				const ValueComponent* value = static_cast<const ValueComponent*>(manager.GetComponent(entity, GetComponentId<ValueComponent>()));
+				const PaddedComponent* padded = static_cast<const PaddedComponent*>(manager.GetComponent(entity, GetComponentId<PaddedComponent>()));
+				const NameComponent* name = static_cast<const NameComponent*>(manager.GetComponent(entity, GetComponentId<NameComponent>()));
+				const bool hasValue = (expected.mask & GetComponentMask<ValueComponent>()) != 0;
+				const bool hasPadded = (expected.mask & GetComponentMask<PaddedComponent>()) != 0;
+				const bool hasName = (expected.mask & GetComponentMask<NameComponent>()) != 0;
+				mismatchCount += (value != nullptr) != hasValue || (value && value->value != expected.value) ? 1 : 0;
+				mismatchCount += (padded != nullptr) != hasPadded || (padded && padded->value != expected.padded) ? 1 : 0;
+				mismatchCount += (name != nullptr) != hasName || (name && name->value != expected.name) ? 1 : 0;
+				mismatchCount += manager.HasComponent<MarkerTag>(entity) != ((expected.mask & GetComponentMask<MarkerTag>()) != 0) ? 1 : 0;
+				mismatchCount += manager.GetComponent(entity, GetComponentId<MarkerTag>()) != nullptr ? 1 : 0;
+				nameCount += hasName ? 1 : 0;
+			}
+			TYR_CHECK(mismatchCount == 0);
+			TYR_CHECK(NameComponent::s_LiveCount == static_cast<int>(nameCount));
+
+			// Every row of every archetype must belong to a live entity with the archetype's mask
+			uint rowCount = 0;
+			uint strayRowCount = 0;
+			for (uint i = 0; i < manager.GetArchetypeCount(); ++i)
+			{
+				const Archetype& archetype = manager.GetArchetype(i);
+				for (uint row = 0; row < archetype.GetEntityCount(); ++row)
+				{
+					const auto found = reference.find(archetype.GetEntity(row));
+					strayRowCount += found == reference.end() || found->second.mask != archetype.GetMask() ? 1 : 0;
+				}
+				rowCount += archetype.GetEntityCount();
+			}
+			TYR_CHECK(strayRowCount == 0);
+			TYR_CHECK(rowCount == reference.size());
+		}
+
+		// An add edge must lead to the archetype with the component added and back again through its remove edge
+		void CheckEdges(TestState& state, const EntityManager& manager)
+		{
+			uint edgeCount = 0;
+			uint badEdgeCount = 0;
+			for (uint i = 0; i < manager.GetArchetypeCount(); ++i)
+			{
+				const Archetype& archetype = manager.GetArchetype(i);
+				for (uint id = 0; id < c_MaxComponentTypes; ++id)
+				{
+					const ComponentId componentId = static_cast<ComponentId>(id);
+					const ComponentMask bit = ComponentMask(1) << id;
+					const uint addEdge = archetype.GetAddEdge(componentId);
+					if (addEdge != Archetype::c_NoArchetype)
+					{
+						const Archetype& target = manager.GetArchetype(addEdge);
+						badEdgeCount += (archetype.GetMask() & bit) || target.GetMask() != (archetype.GetMask() | bit)
+							|| target.GetRemoveEdge(componentId) != i ? 1 : 0;
+						++edgeCount;
+					}
+					const uint removeEdge = archetype.GetRemoveEdge(componentId);
+					if (removeEdge != Archetype::c_NoArchetype)
+					{
+						const Archetype& target = manager.GetArchetype(removeEdge);
+						badEdgeCount += !(archetype.GetMask() & bit) || target.GetMask() != (archetype.GetMask() & ~bit)
+							|| target.GetAddEdge(componentId) != i ? 1 : 0;
+						++edgeCount;
+					}
+				}
+			}
+			TYR_CHECK(edgeCount > 0);
+			TYR_CHECK(badEdgeCount == 0);
+		}
+
+		void CheckQueries(TestState& state, EntityManager& manager, const ReferenceMap& reference)
+		{
+			const ComponentMask valueMask = GetComponentMask<ValueComponent>();
+			const ComponentMask nameMask = GetComponentMask<NameComponent>();
+			const ComponentMask markerMask = GetComponentMask<MarkerTag>();
+
+			uint expectedCount = 0;
+			uint64 expectedSum = 0;
+			for (const auto& [entity, expected] : reference)
+			{
+				if ((expected.mask & (valueMask | nameMask)) == (valueMask | nameMask) && !(expected.mask & markerMask))
+				{
+					++expectedCount;
+					expectedSum += expected.value;
+				}
+			}
+
+			EntityQuery query(manager, valueMask | nameMask, markerMask);
+			TYR_CHECK(query.GetEntityCount() == expectedCount);
+
+			uint count = 0;
+			uint64 sum = 0;
+			uint mismatchCount = 0;
+			query.ForEach<ValueComponent, NameComponent>([&](Entity entity, ValueComponent& value, NameComponent& name)
+			{
+				const auto found = reference.find(entity);
+				mismatchCount += found == reference.end() || found->second.name != name.value ? 1 : 0;
+				sum += value.value;
+				++count;
+			});
+			TYR_CHECK(count == expectedCount);
+			TYR_CHECK(sum == expectedSum);
+			TYR_CHECK(mismatchCount == 0);
+
+			Atomic<uint> parallelCount = 0;
+			Atomic<uint64> parallelSum = 0;
+			query.ParallelForEach<ValueComponent>([&](Entity, ValueComponent& value)
+			{
+				parallelCount.fetch_add(1, std::memory_order_relaxed);
+				parallelSum.fetch_add(value.value, std::memory_order_relaxed);
+			});
+			TYR_CHECK(parallelCount.load() == expectedCount);
+			TYR_CHECK(parallelSum.load() == expectedSum);
+		}
+	}
+
+	// Random structural changes checked against a map of each entity's expected components. The first entities share an
+	// archetype so that it spans several chunks and removed rows are filled from other chunks.
+	TYR_TEST(EntityManagerRandomOperations)
+	{
+		static constexpr uint c_InitialCount = 3000;
+		static constexpr uint c_OperationCount = 40000;
+		static constexpr uint c_CheckInterval = 4000;
+
+		TestRandom random;
+		ReferenceMap reference;
+		Array<Entity> liveEntities;
+		Array<Entity> destroyedEntities;
+		{
+			EntityManager manager;
+
+			const ComponentMask allMask = GetComponentMask<ValueComponent, PaddedComponent, NameComponent, MarkerTag, OtherTag>();
+			for (uint i = 0; i < c_InitialCount; ++i)
+			{
+				const Entity entity = manager.CreateEntity(allMask);
+				ReferenceEntity& expected = reference[entity];
+				expected.mask = allMask;
+				AssignValues(manager, entity, expected, random);
+				liveEntities.Add(entity);
+			}
+			TYR_CHECK(manager.GetArchetype(1).GetChunkCount() > 2);
+
+			for (uint op = 0; op < c_OperationCount; ++op)
+			{
+				const uint action = static_cast<uint>(random.Next() % 100);
+				if (liveEntities.Size() == 0 || action < 15)
+				{
+					const ComponentMask mask = CreateRandomMask(random);
+					const Entity entity = manager.CreateEntity(mask);
+					ReferenceEntity& expected = reference[entity];
+					expected = ReferenceEntity();
+					expected.mask = mask;
+					AssignValues(manager, entity, expected, random);
+					liveEntities.Add(entity);
+					continue;
+				}
+
+				const uint index = static_cast<uint>(random.Next() % liveEntities.Size());
+				const Entity entity = liveEntities[index];
+				ReferenceEntity& expected = reference[entity];
+				if (action < 30)
+				{
+					manager.DestroyEntity(entity);
+					reference.erase(entity);
+					liveEntities[index] = liveEntities.Back();
+					liveEntities.PopBack();
+					destroyedEntities.Add(entity);
+				}
+				else if (action < 50)
+				{
+					// Single components go through the cached archetype edges
+					const uint type = static_cast<uint>(random.Next() % c_ComponentTypeCount);
+					const ComponentMask added = GetTypeMask(type) & ~expected.mask;
+					switch (type)
+					{
+					case 0: manager.AddComponent<ValueComponent>(entity); break;
+					case 1: manager.AddComponent<PaddedComponent>(entity); break;
+					case 2: manager.AddComponent<NameComponent>(entity); break;
+					case 3: manager.AddComponent<MarkerTag>(entity); break;
+					default: manager.AddComponent<OtherTag>(entity); break;
+					}
+					expected.mask |= added;
+					ResetAddedValues(expected, added);
+				}
+				else if (action < 70)
+				{
+					const uint type = static_cast<uint>(random.Next() % c_ComponentTypeCount);
+					switch (type)
+					{
+					case 0: manager.RemoveComponent<ValueComponent>(entity); break;
+					case 1: manager.RemoveComponent<PaddedComponent>(entity); break;
+					case 2: manager.RemoveComponent<NameComponent>(entity); break;
+					case 3: manager.RemoveComponent<MarkerTag>(entity); break;
+					default: manager.RemoveComponent<OtherTag>(entity); break;
+					}
+					expected.mask &= ~GetTypeMask(type);
+				}
+				else if (action < 80)
+				{
+					const ComponentMask mask = CreateRandomMask(random);
+					const ComponentMask added = mask & ~expected.mask;
+					manager.AddComponents(entity, mask);
+					expected.mask |= added;
+					ResetAddedValues(expected, added);
+				}
+				else if (action < 90)
+				{
+					const ComponentMask mask = CreateRandomMask(random);
+					manager.RemoveComponents(entity, mask);
+					expected.mask &= ~mask;
+				}
+				else if (action < 95)
+				{
+					// Assigning through AddComponent on a component the entity may already have
+					const String name = std::to_string(op);
+					manager.AddComponent<NameComponent>(entity, name);
+					expected.mask |= GetComponentMask<NameComponent>();
+					expected.name = name;
+				}
+				else
+				{
+					AssignValues(manager, entity, expected, random);
+				}
+
+				if ((op + 1) % c_CheckInterval == 0)
+				{
+					CheckEntities(state, manager, reference);
+				}
+			}
+
+			CheckEntities(state, manager, reference);
+			CheckEdges(state, manager);
+			CheckQueries(state, manager, reference);
+
+			// Handles of destroyed entities stay invalid even after their slots are reused
+			uint validCount = 0;
+			for (Entity entity : destroyedEntities)
+			{
+				validCount += manager.IsValid(entity) ? 1 : 0;
+			}
+			TYR_CHECK(validCount == 0);
+
+			manager.Clear();
+			TYR_CHECK(manager.GetEntityCount() == 0);
+			TYR_CHECK(NameComponent::s_LiveCount == 0);
+
+			// The manager must still work after being cleared
+			const Entity entity = manager.CreateEntity<ValueComponent, NameComponent>();
+			manager.AddComponent<NameComponent>(entity, String("cleared"));
+			TYR_CHECK(manager.GetComponent<NameComponent>(entity).value == "cleared");
+		}
+		TYR_CHECK(NameComponent::s_LiveCount == 0);
+	}
+}
@@ -0,0 +1,188 @@
+#include "Test.h"
+#include "Geometry/AABB.h"
+#include "Geometry/BoundingSphere.h"
+#include "Geometry/Frustum.h"
+#include "Math/MathKernels.h"
+#include "Math/Matrix4.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3SoA.h"
+#include "Memory/Allocation.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// Counts around the register widths and the culling grain size so that the kernel tails and the compaction of
+		// the chunk results both run
+		static constexpr uint c_CullCounts[] = { 0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 33, 100, 4095, 4096, 4097, 8191, 8193, 12345, 70001 };
+
+		Vector3 RandomVector3(TestRandom& random, float range)
+		{
+			return Vector3(random.NextFloat(-range, range), random.NextFloat(-range, range), random.NextFloat(-range, range));
+		}
+
+		// A perspective frustum at a random position and orientation, with reverse-z on every other call
+		Frustum CreateRandomFrustum(TestRandom& random, bool reverseZ)
+		{
+			Quaternion rotation(random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f),
+				random.NextFloat(-1.0f, 1.0f));
+			rotation.SafeNormalize();
+			const Matrix4 view = Matrix4::CreateView(RandomVector3(random, 10.0f), rotation);
+			const float near = 0.1f;
+			const float far = 200.0f;
+			const Matrix4 projection = reverseZ ? Matrix4::CreatePerspective(90.0f, 16.0f / 9.0f, far, near)
+				: Matrix4::CreatePerspective(60.0f, 4.0f / 3.0f, near, far);
+			return Frustum(view * projection);
+		}
+
+		// Random spheres and boxes around the frustum so that some are inside, some outside and some cross planes
+		struct CullVolumes
+		{
+			Vector3SoA sphereCentres;
+			float* radii;
+			Array<BoundingSphere> spheres;
+			Vector3SoA boxCentres;
+			Vector3SoA boxExtents;
+			Array<AABB> boxes;
+
+			CullVolumes(TestRandom& random, uint count)
+				: sphereCentres(count)
+				, boxCentres(count)
+				, boxExtents(count)
+			{
+				radii = static_cast<float*>(AllocAligned(sphereCentres.PaddedSize() * sizeof(float), Vector3SoA::c_Alignment));
+				for (uint i = 0; i < sphereCentres.PaddedSize(); ++i)
+				{
+					radii[i] = 0.0f;
+				}
+
+				for (uint i = 0; i < count; ++i)
+				{
+					const BoundingSphere sphere(RandomVector3(random, 150.0f), random.NextFloat(0.0f, 20.0f));
+					spheres.Add(sphere);
+					sphereCentres.Set(i, sphere.GetCentre());
+					radii[i] = sphere.GetRadius();
+
+					// The streams take the centre and extents the box itself reports so that both sides see the same values
+					const Vector3 min = RandomVector3(random, 150.0f);
+					const AABB box(min, min + Vector3(random.NextFloat(0.0f, 40.0f), random.NextFloat(0.0f, 40.0f), random.NextFloat(0.0f, 40.0f)));
+					boxes.Add(box);
+					boxCentres.Set(i, box.GetCentre());
+					boxExtents.Set(i, box.GetExtents());
+				}
+			}
+
+			~CullVolumes()
+			{
+				FreeAligned(radii);
+			}
+		};
+
+		void CheckVisible(TestState& state, const uint* visible, uint visibleCount, const Array<uint>& expected)
+		{
+			TYR_CHECK(visibleCount == expected.Size());
+			if (visibleCount != expected.Size())
+			{
+				return;
+			}
+			for (uint i = 0; i < visibleCount; ++i)
+			{
+				TYR_CHECK(visible[i] == expected[i]);
+			}
+		}
+	}
+
+	TYR_TEST(FrustumCullBatch)
+	{
+		TestRandom random;
+		for (uint count : c_CullCounts)
+		{
+			const Frustum frustum = CreateRandomFrustum(random, count % 2 == 0);
+			CullVolumes volumes(random, count);
+
+			Array<uint> expectedSpheres;
+			Array<uint> expectedBoxes;
+			for (uint i = 0; i < count; ++i)
+			{
+				if (frustum.Intersects(volumes.spheres[i]))
+				{
+					expectedSpheres.Add(i);
+				}
+				if (frustum.Intersects(volumes.boxes[i]))
+				{
+					expectedBoxes.Add(i);
+				}
+			}
+
+			Array<uint> visible(count + 1);
+			CheckVisible(state, visible.Data(), frustum.CullSpheres(volumes.sphereCentres, volumes.radii, visible.Data()), expectedSpheres);
+			CheckVisible(state, visible.Data(), frustum.CullBoxes(volumes.boxCentres, volumes.boxExtents, visible.Data()), expectedBoxes);
+		}
+	}
+}
+
+#if TYR_USE_SIMD
+namespace tyr
+{
+	// Frustum only runs the widest variant the CPU supports, so every narrower variant is checked through the kernels
+	TYR_TEST(FrustumCullKernelVariants)
+	{
+		TestRandom random;
+		for (SIMDLevel level : { SIMDLevel::SSE42, SIMDLevel::AVX2, SIMDLevel::AVX512 })
+		{
+			const MathKernels kernels = CreateMathKernels(level);
+			if (kernels.level != level)
+			{
+				continue;
+			}
+
+			for (uint count : c_CullCounts)
+			{
+				const Frustum frustum = CreateRandomFrustum(random, count % 2 == 1);
+				float planes[Frustum::c_PlaneCount * 4];
+				for (uint p = 0; p < Frustum::c_PlaneCount; ++p)
+				{
+					const Plane& plane = frustum.GetPlane(p);
+					planes[p * 4] = plane.GetNormal().x;
+					planes[p * 4 + 1] = plane.GetNormal().y;
+					planes[p * 4 + 2] = plane.GetNormal().z;
+					planes[p * 4 + 3] = plane.GetDistance();
+				}
+				CullVolumes volumes(random, count);
+
+				// Ranges that start past zero write the indices of their own volumes
+				for (uint begin : { 0u, 8u, 16u })
+				{
+					if (begin > count)
+					{
+						continue;
+					}
+
+					Array<uint> expectedSpheres;
+					Array<uint> expectedBoxes;
+					for (uint i = begin; i < count; ++i)
+					{
+						if (frustum.Intersects(volumes.spheres[i]))
+						{
+							expectedSpheres.Add(i);
+						}
+						if (frustum.Intersects(volumes.boxes[i]))
+						{
+							expectedBoxes.Add(i);
+						}
+					}
+
+					Array<uint> visible(count + 1);
+					uint visibleCount = kernels.cullSpheres(planes, volumes.sphereCentres.X(), volumes.radii,
+						volumes.sphereCentres.PaddedSize(), begin, count, visible.Data());
+					CheckVisible(state, visible.Data(), visibleCount, expectedSpheres);
+
+					visibleCount = kernels.cullBoxes(planes, volumes.boxCentres.X(), volumes.boxExtents.X(),
+						volumes.boxCentres.PaddedSize(), begin, count, visible.Data());
+					CheckVisible(state, visible.Data(), visibleCount, expectedBoxes);
+				}
+			}
+		}
+	}
+}
+#endif
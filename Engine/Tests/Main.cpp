@@ -0,0 +1,53 @@
+#include "Test.h"
+#include "Threading/JobSystem.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace tyr;
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::printf(
+			"Usage: TyrantTests [options]\n"
+			"  --filter <text>  Only run tests whose name contains text\n"
+			"  --list           List the tests and exit\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	String filter;
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+		if (std::strcmp(arg, "--filter") == 0 && i + 1 < argc)
+		{
+			filter = argv[++i];
+		}
+		else if (std::strcmp(arg, "--list") == 0)
+		{
+			for (const TestDesc& desc : TestRegistry::Instance().GetTests())
+			{
+				std::printf("%s\n", desc.name.c_str());
+			}
+			return EXIT_SUCCESS;
+		}
+		else
+		{
+			PrintUsage();
+			return std::strcmp(arg, "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	// Batch kernels and parallel code paths use the job system like the engine does
+	JobSystem::Instance().Initialize(JobSystemConfig());
+
+	const uint failedCount = TestRegistry::Instance().Run(filter);
+
+	JobSystem::Instance().Shutdown();
+
+	return failedCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
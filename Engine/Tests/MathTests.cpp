@@ -0,0 +1,748 @@
+#include "Test.h"
+#include "Math/MathKernels.h"
+#include "Math/Matrix4.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3SoA.h"
+#include "Math/Vector4.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// Counts around the 4, 8 and 16 wide register sizes so that every kernel's tail handling runs
+		static constexpr uint c_Counts[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 100 };
+		static constexpr uint c_MaxCount = 100;
+
+		// Relative to the magnitude of the inputs since the kernels may round differently to the references
+		static constexpr float c_Tolerance = 1e-5f;
+
+		// The references are written out in scalar code rather than calling the per element functions, which use SIMD
+		// themselves when TYR_USE_SIMD is on.
+
+		Matrix4 ReferenceMultiply(const Matrix4& lhs, const Matrix4& rhs)
+		{
+			Matrix4 output;
+			for (uint row = 0; row < 4; ++row)
+			{
+				for (uint col = 0; col < 4; ++col)
+				{
+					output[row][col] = lhs[row][0] * rhs[0][col] + lhs[row][1] * rhs[1][col]
+						+ lhs[row][2] * rhs[2][col] + lhs[row][3] * rhs[3][col];
+				}
+			}
+			return output;
+		}
+
+		Vector4 ReferenceTransform(const Matrix4& mat, const Vector4& v)
+		{
+			float output[4];
+			for (uint col = 0; col < 4; ++col)
+			{
+				output[col] = mat[0][col] * v.x + mat[1][col] * v.y + mat[2][col] * v.z + mat[3][col] * v.w;
+			}
+			return Vector4(output[0], output[1], output[2], output[3]);
+		}
+
+		Matrix4 ReferenceTRS(const Vector3& t, const Quaternion& q, const Vector3& s)
+		{
+			const float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+			const float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+			const float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+			const float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+			Matrix4 output;
+			output[0][0] = s.x * (1.0f - (yy + zz));
+			output[0][1] = s.x * (xy + wz);
+			output[0][2] = s.x * (xz - wy);
+			output[0][3] = 0.0f;
+			output[1][0] = s.y * (xy - wz);
+			output[1][1] = s.y * (1.0f - (xx + zz));
+			output[1][2] = s.y * (yz + wx);
+			output[1][3] = 0.0f;
+			output[2][0] = s.z * (xz + wy);
+			output[2][1] = s.z * (yz - wx);
+			output[2][2] = s.z * (1.0f - (xx + yy));
+			output[2][3] = 0.0f;
+			output[3][0] = t.x;
+			output[3][1] = t.y;
+			output[3][2] = t.z;
+			output[3][3] = 1.0f;
+			return output;
+		}
+
+		Quaternion ReferenceMultiply(const Quaternion& lhs, const Quaternion& rhs)
+		{
+			return Quaternion(
+				lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z,
+				lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+				lhs.w * rhs.y + lhs.y * rhs.w + lhs.z * rhs.x - lhs.x * rhs.z,
+				lhs.w * rhs.z + lhs.z * rhs.w + lhs.x * rhs.y - lhs.y * rhs.x);
+		}
+
+		Vector3 ReferenceRotate(const Quaternion& q, const Vector3& v)
+		{
+			// v + 2w (u x v) + 2 u x (u x v) with u the vector part
+			const Vector3 u(q.x, q.y, q.z);
+			const Vector3 uv(u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x);
+			const Vector3 uuv(u.y * uv.z - u.z * uv.y, u.z * uv.x - u.x * uv.z, u.x * uv.y - u.y * uv.x);
+			return Vector3(v.x + 2.0f * (q.w * uv.x + uuv.x), v.y + 2.0f * (q.w * uv.y + uuv.y),
+				v.z + 2.0f * (q.w * uv.z + uuv.z));
+		}
+
+		// Scales, then rotates, then translates a row vector by composing the three matrices. The rows of the rotation
+		// are the rotated basis vectors.
+		Matrix4 ReferenceComposeTRS(const Vector3& t, const Quaternion& q, const Vector3& s)
+		{
+			Matrix4 scale = Matrix4::c_Zero;
+			scale[0][0] = s.x;
+			scale[1][1] = s.y;
+			scale[2][2] = s.z;
+			scale[3][3] = 1.0f;
+
+			Matrix4 rotation = Matrix4::c_Zero;
+			const Vector3 basis[3] = { Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f) };
+			for (uint row = 0; row < 3; ++row)
+			{
+				const Vector3 rotated = ReferenceRotate(q, basis[row]);
+				rotation[row][0] = rotated.x;
+				rotation[row][1] = rotated.y;
+				rotation[row][2] = rotated.z;
+			}
+			rotation[3][3] = 1.0f;
+
+			Matrix4 translation = Matrix4::c_Identity;
+			translation[3][0] = t.x;
+			translation[3][1] = t.y;
+			translation[3][2] = t.z;
+
+			return ReferenceMultiply(ReferenceMultiply(scale, rotation), translation);
+		}
+
+		// Determinant of the 3x3 matrix left after removing a row and a column
+		double ReferenceMinor(const Matrix4& mat, uint skipRow, uint skipCol)
+		{
+			double sub[3][3];
+			for (uint row = 0, r = 0; row < 4; ++row)
+			{
+				if (row == skipRow)
+				{
+					continue;
+				}
+				for (uint col = 0, c = 0; col < 4; ++col)
+				{
+					if (col != skipCol)
+					{
+						sub[r][c++] = mat[row][col];
+					}
+				}
+				++r;
+			}
+			return sub[0][0] * (sub[1][1] * sub[2][2] - sub[1][2] * sub[2][1])
+				- sub[0][1] * (sub[1][0] * sub[2][2] - sub[1][2] * sub[2][0])
+				+ sub[0][2] * (sub[1][0] * sub[2][1] - sub[1][1] * sub[2][0]);
+		}
+
+		// Inverse as the transposed cofactor matrix divided by the determinant, in double precision
+		Matrix4 ReferenceInverse(const Matrix4& mat)
+		{
+			double cofactors[4][4];
+			for (uint row = 0; row < 4; ++row)
+			{
+				for (uint col = 0; col < 4; ++col)
+				{
+					cofactors[row][col] = ((row + col) % 2 ? -1.0 : 1.0) * ReferenceMinor(mat, row, col);
+				}
+			}
+			double det = 0.0;
+			for (uint col = 0; col < 4; ++col)
+			{
+				det += mat[0][col] * cofactors[0][col];
+			}
+
+			Matrix4 output;
+			for (uint row = 0; row < 4; ++row)
+			{
+				for (uint col = 0; col < 4; ++col)
+				{
+					output[row][col] = static_cast<float>(cofactors[col][row] / det);
+				}
+			}
+			return output;
+		}
+
+		// Inverse of a matrix whose last row is (0, 0, 0, 1). The 3x3 part is inverted with cofactors and the
+		// translation column becomes minus the inverse times the translation.
+		Matrix4 ReferenceInverseAffine(const Matrix4& mat)
+		{
+			const double a = mat[0][0], b = mat[0][1], c = mat[0][2];
+			const double d = mat[1][0], e = mat[1][1], f = mat[1][2];
+			const double g = mat[2][0], h = mat[2][1], k = mat[2][2];
+			const double inverse[3][3] =
+			{
+				{ e * k - f * h, c * h - b * k, b * f - c * e },
+				{ f * g - d * k, a * k - c * g, c * d - a * f },
+				{ d * h - e * g, b * g - a * h, a * e - b * d }
+			};
+			const double det = a * inverse[0][0] + b * inverse[1][0] + c * inverse[2][0];
+
+			Matrix4 output = Matrix4::c_Identity;
+			for (uint row = 0; row < 3; ++row)
+			{
+				double translation = 0.0;
+				for (uint col = 0; col < 3; ++col)
+				{
+					const double value = inverse[row][col] / det;
+					output[row][col] = static_cast<float>(value);
+					translation -= value * mat[col][3];
+				}
+				output[row][3] = static_cast<float>(translation);
+			}
+			return output;
+		}
+
+		Vector3 RandomVector3(TestRandom& random, float range)
+		{
+			return Vector3(random.NextFloat(-range, range), random.NextFloat(-range, range), random.NextFloat(-range, range));
+		}
+
+		Quaternion RandomRotation(TestRandom& random)
+		{
+			Quaternion q(random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f),
+				random.NextFloat(-1.0f, 1.0f));
+			q.SafeNormalize();
+			return q;
+		}
+
+		Matrix4 RandomMatrix(TestRandom& random)
+		{
+			Matrix4 mat;
+			for (uint i = 0; i < 16; ++i)
+			{
+				mat[i / 4][i % 4] = random.NextFloat(-4.0f, 4.0f);
+			}
+			return mat;
+		}
+
+		Matrix4 RandomAffineMatrix(TestRandom& random)
+		{
+			return Matrix4::CreateTRS(RandomVector3(random, 100.0f), RandomRotation(random), RandomVector3(random, 3.0f));
+		}
+
+		// An affine matrix in the layout IsAffine() and InverseAffine() expect, with the translation in the last column
+		Matrix4 RandomColumnAffineMatrix(TestRandom& random, const Vector3& scale)
+		{
+			return ReferenceComposeTRS(RandomVector3(random, 100.0f), RandomRotation(random), scale).Transpose();
+		}
+
+		// Largest absolute element of the top left size x size block
+		float MaxAbs(const Matrix4& mat, uint size = 4)
+		{
+			float max = 0.0f;
+			for (uint i = 0; i < size * size; ++i)
+			{
+				max = std::max(max, std::abs(mat[i / size][i % size]));
+			}
+			return max;
+		}
+
+		bool IsNear(float a, float b, float magnitude)
+		{
+			return std::abs(a - b) <= c_Tolerance * std::max(1.0f, magnitude);
+		}
+
+		bool IsNear(const Matrix4& a, const Matrix4& b, float magnitude)
+		{
+			for (uint i = 0; i < 16; ++i)
+			{
+				if (!IsNear(a[i / 4][i % 4], b[i / 4][i % 4], magnitude))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool IsNear(const Vector3& a, const Vector3& b, float magnitude)
+		{
+			return IsNear(a.x, b.x, magnitude) && IsNear(a.y, b.y, magnitude) && IsNear(a.z, b.z, magnitude);
+		}
+
+		bool IsNear(const Vector4& a, const Vector4& b, float magnitude)
+		{
+			return IsNear(a.x, b.x, magnitude) && IsNear(a.y, b.y, magnitude) && IsNear(a.z, b.z, magnitude)
+				&& IsNear(a.w, b.w, magnitude);
+		}
+
+		bool IsNear(const Quaternion& a, const Quaternion& b)
+		{
+			return IsNear(a.x, b.x, 1.0f) && IsNear(a.y, b.y, 1.0f) && IsNear(a.z, b.z, 1.0f) && IsNear(a.w, b.w, 1.0f);
+		}
+	}
+
+	TYR_TEST(Matrix4MultiplyBatch)
+	{
+		TestRandom random;
+		Array<Matrix4> lhs(c_MaxCount);
+		Array<Matrix4> rhs(c_MaxCount);
+		Array<Matrix4> output(c_MaxCount + 1);
+		for (uint count : c_Counts)
+		{
+			for (uint i = 0; i < count; ++i)
+			{
+				lhs[i] = RandomMatrix(random);
+				rhs[i] = RandomMatrix(random);
+			}
+			// Checks that nothing is written past the last matrix
+			output[count] = Matrix4::c_Identity;
+
+			Matrix4::MultiplyBatch(lhs.Data(), rhs.Data(), output.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(output[i], ReferenceMultiply(lhs[i], rhs[i]), 64.0f));
+			}
+			TYR_CHECK(output[count] == Matrix4::c_Identity);
+
+			// In place
+			Array<Matrix4> inPlace = rhs;
+			Matrix4::MultiplyBatch(lhs.Data(), inPlace.Data(), inPlace.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(output[i] == inPlace[i]);
+			}
+		}
+	}
+
+	TYR_TEST(Matrix4MultiplyBatchSingleLhs)
+	{
+		TestRandom random;
+		const Matrix4 lhs = RandomMatrix(random);
+		Array<Matrix4> rhs(c_MaxCount);
+		Array<Matrix4> output(c_MaxCount + 1);
+		for (uint count : c_Counts)
+		{
+			for (uint i = 0; i < count; ++i)
+			{
+				rhs[i] = RandomMatrix(random);
+			}
+			output[count] = Matrix4::c_Identity;
+
+			Matrix4::MultiplyBatch(lhs, rhs.Data(), output.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(output[i], ReferenceMultiply(lhs, rhs[i]), 64.0f));
+			}
+			TYR_CHECK(output[count] == Matrix4::c_Identity);
+
+			Matrix4::MultiplyBatch(lhs, rhs.Data(), rhs.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(output[i] == rhs[i]);
+			}
+		}
+	}
+
+	TYR_TEST(Matrix4CreateTRSBatch)
+	{
+		TestRandom random;
+		Array<Vector3> translations(c_MaxCount);
+		Array<Quaternion> rotations(c_MaxCount);
+		Array<Vector3> scales(c_MaxCount);
+		Array<Matrix4> output(c_MaxCount + 1);
+		for (uint count : c_Counts)
+		{
+			for (uint i = 0; i < count; ++i)
+			{
+				translations[i] = RandomVector3(random, 100.0f);
+				rotations[i] = RandomRotation(random);
+				scales[i] = RandomVector3(random, 3.0f);
+			}
+			output[count] = Matrix4::c_Identity;
+
+			Matrix4::CreateTRSBatch(translations.Data(), rotations.Data(), scales.Data(), output.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(output[i], ReferenceTRS(translations[i], rotations[i], scales[i]), 100.0f));
+				const Matrix4 composed = ReferenceComposeTRS(translations[i], rotations[i], scales[i]);
+				TYR_CHECK(IsNear(output[i], composed, 100.0f));
+				TYR_CHECK(IsNear(Matrix4::CreateTRS(translations[i], rotations[i], scales[i]), composed, 100.0f));
+			}
+			TYR_CHECK(output[count] == Matrix4::c_Identity);
+		}
+	}
+
+	TYR_TEST(Matrix4Inverse)
+	{
+		TestRandom random;
+		for (uint i = 0; i < 1000; ++i)
+		{
+			Matrix4 mat;
+			switch (i % 3)
+			{
+			case 0:
+				mat = RandomMatrix(random);
+				break;
+			case 1:
+				mat = RandomColumnAffineMatrix(random, RandomVector3(random, 3.0f));
+				break;
+			default:
+				// The last row is nearly the sum of the first two so the determinant is close to zero
+				mat = RandomMatrix(random);
+				for (uint col = 0; col < 4; ++col)
+				{
+					mat[3][col] = mat[0][col] + mat[1][col] + random.NextFloat(-1e-3f, 1e-3f);
+				}
+				break;
+			}
+
+			const Matrix4 reference = ReferenceInverse(mat);
+			const Matrix4 inverse = mat.Inverse();
+			// Rounding errors grow with the condition number, estimated from the largest elements of both matrices
+			const float condition = 16.0f * MaxAbs(mat) * MaxAbs(reference);
+			TYR_CHECK(IsNear(inverse, reference, condition * MaxAbs(reference)));
+			TYR_CHECK(IsNear(ReferenceMultiply(mat, inverse), Matrix4::c_Identity, condition));
+			TYR_CHECK(IsNear(ReferenceMultiply(inverse, mat), Matrix4::c_Identity, condition));
+		}
+	}
+
+	TYR_TEST(Matrix4InverseAffine)
+	{
+		TestRandom random;
+		for (uint i = 0; i < 1000; ++i)
+		{
+			// Every other matrix nearly flattens one axis
+			Vector3 scale = RandomVector3(random, 3.0f);
+			if (i % 2)
+			{
+				scale[i % 3] = random.NextFloat(1e-4f, 1e-3f);
+			}
+			const Matrix4 mat = RandomColumnAffineMatrix(random, scale);
+			TYR_CHECK(mat.IsAffine());
+
+			const Matrix4 reference = ReferenceInverseAffine(mat);
+			const Matrix4 inverse = mat.InverseAffine();
+			// Only the 3x3 part is inverted, the translation is then multiplied by the result
+			const float condition = 9.0f * MaxAbs(mat, 3) * MaxAbs(reference, 3);
+			TYR_CHECK(inverse.IsAffine());
+			TYR_CHECK(IsNear(inverse, reference, condition * MaxAbs(reference)));
+			TYR_CHECK(IsNear(ReferenceMultiply(mat, inverse), Matrix4::c_Identity, condition * MaxAbs(mat)));
+			TYR_CHECK(IsNear(ReferenceInverse(mat), reference, condition * MaxAbs(reference)));
+		}
+	}
+
+	TYR_TEST(Matrix4TransformBatch)
+	{
+		TestRandom random;
+		Array<Vector4> vectors(c_MaxCount);
+		Array<Vector4> vectorOutput(c_MaxCount + 1);
+		Array<Vector3> points(c_MaxCount);
+		Array<Vector3> pointOutput(c_MaxCount + 1);
+		const Vector4 sentinel4(-1.0f, -2.0f, -3.0f, -4.0f);
+		const Vector3 sentinel3(-1.0f, -2.0f, -3.0f);
+		for (uint count : c_Counts)
+		{
+			const Matrix4 mat = RandomMatrix(random);
+			const Matrix4 affine = RandomAffineMatrix(random);
+			for (uint i = 0; i < count; ++i)
+			{
+				vectors[i] = Vector4(random.NextFloat(-10.0f, 10.0f), random.NextFloat(-10.0f, 10.0f),
+					random.NextFloat(-10.0f, 10.0f), random.NextFloat(-10.0f, 10.0f));
+				points[i] = RandomVector3(random, 10.0f);
+			}
+			vectorOutput[count] = sentinel4;
+			pointOutput[count] = sentinel3;
+
+			mat.MultiplyBatch(vectors.Data(), vectorOutput.Data(), count);
+			affine.TransformPoints(points.Data(), pointOutput.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(vectorOutput[i], ReferenceTransform(mat, vectors[i]), 160.0f));
+
+				const Vector4 point = ReferenceTransform(affine, Vector4(points[i].x, points[i].y, points[i].z, 1.0f));
+				TYR_CHECK(IsNear(pointOutput[i], Vector3(point.x, point.y, point.z), 200.0f));
+			}
+			// Points are 12 bytes so a kernel storing whole registers would overwrite the next one
+			TYR_CHECK(vectorOutput[count] == sentinel4);
+			TYR_CHECK(pointOutput[count] == sentinel3);
+
+			affine.TransformPoints(points.Data(), points.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(points[i] == pointOutput[i]);
+			}
+		}
+	}
+
+	TYR_TEST(QuaternionBatch)
+	{
+		TestRandom random;
+		Array<Quaternion> lhs(c_MaxCount);
+		Array<Quaternion> rhs(c_MaxCount);
+		Array<Quaternion> products(c_MaxCount);
+		Array<Vector3> vectors(c_MaxCount);
+		Array<Vector3> rotated(c_MaxCount + 1);
+		const Vector3 sentinel(-1.0f, -2.0f, -3.0f);
+		for (uint count : c_Counts)
+		{
+			const Quaternion rotation = RandomRotation(random);
+			for (uint i = 0; i < count; ++i)
+			{
+				lhs[i] = RandomRotation(random);
+				rhs[i] = RandomRotation(random);
+				vectors[i] = RandomVector3(random, 10.0f);
+			}
+
+			Quaternion::MultiplyBatch(lhs.Data(), rhs.Data(), products.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(products[i], ReferenceMultiply(lhs[i], rhs[i])));
+			}
+
+			rotated[count] = sentinel;
+			rotation.RotateBatch(vectors.Data(), rotated.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(rotated[i], ReferenceRotate(rotation, vectors[i]), 10.0f));
+			}
+			TYR_CHECK(rotated[count] == sentinel);
+
+			Quaternion::RotateBatch(lhs.Data(), vectors.Data(), rotated.Data(), count);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(rotated[i], ReferenceRotate(lhs[i], vectors[i]), 10.0f));
+			}
+			TYR_CHECK(rotated[count] == sentinel);
+		}
+	}
+
+	TYR_TEST(Vector3SoAStreams)
+	{
+		TestRandom random;
+		Array<Vector3> a(c_MaxCount);
+		Array<Vector3> b(c_MaxCount);
+		Array<Vector3> output(c_MaxCount);
+		for (uint count : c_Counts)
+		{
+			if (count == 0)
+			{
+				continue;
+			}
+
+			for (uint i = 0; i < count; ++i)
+			{
+				a[i] = RandomVector3(random, 10.0f);
+				b[i] = RandomVector3(random, 10.0f);
+			}
+			// A zero vector must come through Normalize unchanged
+			a[count / 2] = Vector3::c_Zero;
+
+			Vector3SoA soaA;
+			Vector3SoA soaB;
+			Vector3SoA soaOutput;
+			soaA.FromAoS(a.Data(), count);
+			soaB.FromAoS(b.Data(), count);
+			soaA.ToAoS(output.Data());
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(output[i] == a[i]);
+			}
+
+			Vector3SoA::Add(soaA, soaB, soaOutput);
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(soaOutput.Get(i), Vector3(a[i].x + b[i].x, a[i].y + b[i].y, a[i].z + b[i].z), 10.0f));
+			}
+
+			Vector3SoA::Cross(soaA, soaB, soaOutput);
+			for (uint i = 0; i < count; ++i)
+			{
+				const Vector3 cross(a[i].y * b[i].z - a[i].z * b[i].y, a[i].z * b[i].x - a[i].x * b[i].z,
+					a[i].x * b[i].y - a[i].y * b[i].x);
+				TYR_CHECK(IsNear(soaOutput.Get(i), cross, 100.0f));
+			}
+
+			Array<float> scalars(soaA.PaddedSize());
+			Vector3SoA::Dot(soaA, soaB, scalars.Data());
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(scalars[i], a[i].x * b[i].x + a[i].y * b[i].y + a[i].z * b[i].z, 300.0f));
+			}
+
+			Vector3SoA::Length(soaA, scalars.Data());
+			for (uint i = 0; i < count; ++i)
+			{
+				TYR_CHECK(IsNear(scalars[i], std::sqrt(a[i].x * a[i].x + a[i].y * a[i].y + a[i].z * a[i].z), 20.0f));
+			}
+
+			Vector3SoA::Normalize(soaA, soaOutput);
+			for (uint i = 0; i < count; ++i)
+			{
+				const float length = std::sqrt(a[i].x * a[i].x + a[i].y * a[i].y + a[i].z * a[i].z);
+				const Vector3 expected = length > 0.0f ? Vector3(a[i].x / length, a[i].y / length, a[i].z / length) : a[i];
+				TYR_CHECK(IsNear(soaOutput.Get(i), expected, 1.0f));
+			}
+
+			Vector3 min;
+			Vector3 max;
+			soaB.GetBounds(min, max);
+			Vector3 expectedMin = b[0];
+			Vector3 expectedMax = b[0];
+			for (uint i = 1; i < count; ++i)
+			{
+				expectedMin = Vector3(std::min(expectedMin.x, b[i].x), std::min(expectedMin.y, b[i].y), std::min(expectedMin.z, b[i].z));
+				expectedMax = Vector3(std::max(expectedMax.x, b[i].x), std::max(expectedMax.y, b[i].y), std::max(expectedMax.z, b[i].z));
+			}
+			// Padding is zero so bounds that don't contain the origin show whether it leaked in
+			TYR_CHECK(min == expectedMin);
+			TYR_CHECK(max == expectedMax);
+		}
+	}
+}
+
+#if TYR_USE_SIMD
+namespace tyr
+{
+	// The batch functions above only run the widest variant the CPU supports, so every narrower variant is also
+	// checked through the kernels directly
+	TYR_TEST(MathKernelVariants)
+	{
+		TestRandom random;
+		for (SIMDLevel level : { SIMDLevel::SSE42, SIMDLevel::AVX2, SIMDLevel::AVX512 })
+		{
+			const MathKernels kernels = CreateMathKernels(level);
+			if (kernels.level != level)
+			{
+				continue;
+			}
+
+			for (uint count : c_Counts)
+			{
+				Array<Matrix4> lhs(count + 1);
+				Array<Matrix4> rhs(count + 1);
+				Array<Matrix4> output(count + 1);
+				Array<Vector4> vectors(count + 1);
+				Array<Vector4> vectorOutput(count + 1);
+				Array<Vector3> points(count + 1);
+				Array<Vector3> pointOutput(count + 1);
+				for (uint i = 0; i < count; ++i)
+				{
+					lhs[i] = RandomMatrix(random);
+					rhs[i] = RandomMatrix(random);
+					vectors[i] = Vector4(random.NextFloat(-10.0f, 10.0f), random.NextFloat(-10.0f, 10.0f),
+						random.NextFloat(-10.0f, 10.0f), random.NextFloat(-10.0f, 10.0f));
+					points[i] = RandomVector3(random, 10.0f);
+				}
+				Matrix4 affine = RandomAffineMatrix(random);
+				output[count] = Matrix4::c_Identity;
+				vectorOutput[count] = Vector4(-1.0f, -2.0f, -3.0f, -4.0f);
+				pointOutput[count] = Vector3(-1.0f, -2.0f, -3.0f);
+
+				kernels.multiplyMatrices(&lhs[0][0][0], &rhs[0][0][0], &output[0][0][0], count);
+				for (uint i = 0; i < count; ++i)
+				{
+					TYR_CHECK(IsNear(output[i], ReferenceMultiply(lhs[i], rhs[i]), 64.0f));
+				}
+
+				kernels.multiplyMatrixByMatrices(&lhs[0][0][0], &rhs[0][0][0], &output[0][0][0], count);
+				for (uint i = 0; i < count; ++i)
+				{
+					TYR_CHECK(IsNear(output[i], ReferenceMultiply(lhs[0], rhs[i]), 64.0f));
+				}
+				TYR_CHECK(output[count] == Matrix4::c_Identity);
+
+				kernels.transformVectors(&affine[0][0], &vectors[0].x, &vectorOutput[0].x, count);
+				kernels.transformPoints(&affine[0][0], &points[0].x, &pointOutput[0].x, count);
+				for (uint i = 0; i < count; ++i)
+				{
+					TYR_CHECK(IsNear(vectorOutput[i], ReferenceTransform(affine, vectors[i]), 1000.0f));
+
+					const Vector4 point = ReferenceTransform(affine, Vector4(points[i].x, points[i].y, points[i].z, 1.0f));
+					TYR_CHECK(IsNear(pointOutput[i], Vector3(point.x, point.y, point.z), 200.0f));
+				}
+				TYR_CHECK(vectorOutput[count] == Vector4(-1.0f, -2.0f, -3.0f, -4.0f));
+				TYR_CHECK(pointOutput[count] == Vector3(-1.0f, -2.0f, -3.0f));
+
+				Array<Quaternion> rotations(count + 1);
+				Array<Vector3> scales(count + 1);
+				for (uint i = 0; i < count; ++i)
+				{
+					rotations[i] = RandomRotation(random);
+					scales[i] = RandomVector3(random, 3.0f);
+				}
+				output[count] = Matrix4::c_Identity;
+				kernels.createTRS(&points[0].x, &rotations[0].x, &scales[0].x, &output[0][0][0], count);
+				for (uint i = 0; i < count; ++i)
+				{
+					TYR_CHECK(IsNear(output[i], ReferenceTRS(points[i], rotations[i], scales[i]), 100.0f));
+				}
+				TYR_CHECK(output[count] == Matrix4::c_Identity);
+
+				if (count == 0)
+				{
+					continue;
+				}
+
+				// Stream kernels run on whole registers of a padded stream, conversions and min/max take any count
+				Vector3SoA a;
+				Vector3SoA b;
+				Vector3SoA soaOutput(count);
+				a.FromAoS(points.Data(), count);
+				b.Resize(count);
+				for (uint i = 0; i < count; ++i)
+				{
+					b.Set(i, RandomVector3(random, 10.0f));
+				}
+				const uint padded = a.PaddedSize();
+
+				kernels.mulAddStreams(a.X(), b.X(), a.X(), soaOutput.X(), 3 * padded);
+				for (uint i = 0; i < count; ++i)
+				{
+					const Vector3 u = a.Get(i);
+					const Vector3 v = b.Get(i);
+					TYR_CHECK(IsNear(soaOutput.Get(i), Vector3(u.x * v.x + u.x, u.y * v.y + u.y, u.z * v.z + u.z), 100.0f));
+				}
+
+				kernels.crossStreams(a.X(), b.X(), soaOutput.X(), padded);
+				Array<float> dots(padded);
+				kernels.dotStreams(a.X(), b.X(), dots.Data(), padded);
+				for (uint i = 0; i < count; ++i)
+				{
+					const Vector3 u = a.Get(i);
+					const Vector3 v = b.Get(i);
+					TYR_CHECK(IsNear(soaOutput.Get(i), Vector3(u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x), 100.0f));
+					TYR_CHECK(IsNear(dots[i], u.x * v.x + u.y * v.y + u.z * v.z, 300.0f));
+				}
+
+				kernels.normalizeStreams(b.X(), soaOutput.X(), padded);
+				for (uint i = 0; i < count; ++i)
+				{
+					const Vector3 v = b.Get(i);
+					const float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+					TYR_CHECK(IsNear(soaOutput.Get(i), Vector3(v.x / length, v.y / length, v.z / length), 1.0f));
+				}
+
+				float min;
+				float max;
+				kernels.minMaxStream(a.Y(), count, &min, &max);
+				float expectedMin = a.Y()[0];
+				float expectedMax = a.Y()[0];
+				for (uint i = 1; i < count; ++i)
+				{
+					expectedMin = std::min(expectedMin, a.Y()[i]);
+					expectedMax = std::max(expectedMax, a.Y()[i]);
+				}
+				TYR_CHECK(min == expectedMin);
+				TYR_CHECK(max == expectedMax);
+
+				kernels.aosToSoA(&points[0].x, soaOutput.X(), padded, count);
+				kernels.soaToAoS(soaOutput.X(), padded, &pointOutput[0].x, count);
+				for (uint i = 0; i < count; ++i)
+				{
+					TYR_CHECK(soaOutput.Get(i) == points[i]);
+					TYR_CHECK(pointOutput[i] == points[i]);
+				}
+				TYR_CHECK(pointOutput[count] == Vector3(-1.0f, -2.0f, -3.0f));
+			}
+		}
+	}
+}
+#endif
@@ -0,0 +1,19 @@
+#include "Test.h"
+#include "Reflection/ReflectionUtil.h"
+#include "Math/Vector3.h"
+#include "Math/Quaternion.h"
+
+namespace tyr
+{
+	// Type IDs are hashes of the type names, so types that resolve to the same name collide in the type registry
+	TYR_TEST(ReflectionTypeNames)
+	{
+		TYR_CHECK(GetTypeName<float>() == "float");
+		TYR_CHECK(GetTypeName<Vector3>() == "Vector3");
+		TYR_CHECK(GetTypeName<Quaternion>() == "Quaternion");
+
+		TYR_CHECK(GetTypeID<float>() != GetTypeID<int>());
+		TYR_CHECK(GetTypeID<Vector3>() != GetTypeID<Quaternion>());
+		TYR_CHECK(GetTypeID<Vector3>() == GetTypeID<Vector3>());
+	}
+}
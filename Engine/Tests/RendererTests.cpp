@@ -0,0 +1,120 @@
+#include "Test.h"
+#include "RenderDataUtility/MeshUtil.h"
+#include "RenderDataUtility/MeshletBuilder.h"
+#include "RenderDataUtility/MeshOptimizer.h"
+#include "RenderDataTypes/Vertex.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// A unit right triangle in the xy plane with texture coordinates that match its positions
+		void CreateTriangle(Vertex* vertices)
+		{
+			vertices[0] = Vertex(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			vertices[1] = Vertex(0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+			vertices[2] = Vertex(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+		}
+
+		void CheckVector(TestState& state, const Vector3& actual, const Vector3& expected)
+		{
+			TYR_CHECK_NEAR(actual.x, expected.x, 1e-5f);
+			TYR_CHECK_NEAR(actual.y, expected.y, 1e-5f);
+			TYR_CHECK_NEAR(actual.z, expected.z, 1e-5f);
+		}
+	}
+
+	TYR_TEST(MeshUtilNormalOrientation)
+	{
+		for (MeshUtil::NormalWeighting weighting : { MeshUtil::NormalWeighting::Area, MeshUtil::NormalWeighting::Angle })
+		{
+			Vertex vertices[3];
+			CreateTriangle(vertices);
+			const uint indices[] = { 0, 1, 2 };
+			MeshUtil::CreateNormalsAndTangents(vertices, 3, indices, 3, weighting);
+			for (const Vertex& vertex : vertices)
+			{
+				CheckVector(state, vertex.normal, Vector3(0.0f, 0.0f, 1.0f));
+				CheckVector(state, vertex.tangent, Vector3(1.0f, 0.0f, 0.0f));
+			}
+
+			// Reversing the winding flips the normal but the tangent follows the texture coordinates
+			CreateTriangle(vertices);
+			const uint reversedIndices[] = { 0, 2, 1 };
+			MeshUtil::CreateNormalsAndTangents(vertices, 3, reversedIndices, 3, weighting);
+			for (const Vertex& vertex : vertices)
+			{
+				CheckVector(state, vertex.normal, Vector3(0.0f, 0.0f, -1.0f));
+				CheckVector(state, vertex.tangent, Vector3(1.0f, 0.0f, 0.0f));
+			}
+		}
+	}
+
+	TYR_TEST(MeshletConeOrientation)
+	{
+		// Both triangles face +z like the one in MeshUtilNormalOrientation
+		Vertex vertices[4];
+		CreateTriangle(vertices);
+		vertices[3] = Vertex(1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+		const uint indices[] = { 0, 1, 2, 2, 1, 3 };
+		MeshUtil::CreateNormalsAndTangents(vertices, 4, indices, 6);
+
+		MeshletData data;
+		MeshletBuilder::Build(vertices, indices, 6, data);
+		TYR_CHECK(data.meshlets.Size() == 1);
+		const MeshletBounds& bounds = data.bounds[0];
+		CheckVector(state, bounds.coneAxis, vertices[0].normal);
+		TYR_CHECK(!MeshletBuilder::IsBackFacing(bounds, Vector3(0.5f, 0.5f, 10.0f)));
+		TYR_CHECK(MeshletBuilder::IsBackFacing(bounds, Vector3(0.5f, 0.5f, -10.0f)));
+	}
+
+	TYR_TEST(MeshOptimizerOverdrawOrder)
+	{
+		// A closed 1 x 2 x 4 box centred on the origin. Each face has its own vertices so that the overdraw
+		// optimisation splits the faces into separate clusters.
+		const float halfExtents[] = { 0.5f, 1.0f, 2.0f };
+		Vertex vertices[24];
+		uint indices[36];
+		for (uint face = 0; face < 6; ++face)
+		{
+			const uint axis = face / 2;
+			const uint u = (axis + 1) % 3;
+			const uint v = (axis + 2) % 3;
+			const float sign = face % 2 == 0 ? 1.0f : -1.0f;
+			for (uint corner = 0; corner < 4; ++corner)
+			{
+				float position[3];
+				position[axis] = sign * halfExtents[axis];
+				position[u] = corner & 1 ? halfExtents[u] : -halfExtents[u];
+				position[v] = corner & 2 ? halfExtents[v] : -halfExtents[v];
+				vertices[face * 4 + corner] = Vertex(position[0], position[1], position[2], 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+			}
+
+			// Wind the face so that the normal MeshUtil computes for it points out of the box
+			uint* faceIndices = indices + face * 6;
+			const uint first = face * 4;
+			const uint faceTemplate[] = { 0, 1, 2, 2, 1, 3 };
+			for (uint i = 0; i < 6; ++i)
+			{
+				faceIndices[i] = first + faceTemplate[i];
+			}
+			MeshUtil::CreateNormalsAndTangents(vertices, 24, faceIndices, 6);
+			if (vertices[first].normal.Dot(vertices[first].position) < 0.0f)
+			{
+				for (uint i = 0; i < 6; i += 3)
+				{
+					std::swap(faceIndices[i + 1], faceIndices[i + 2]);
+				}
+			}
+		}
+
+		MeshOptimizer::OptimizeOverdraw(indices, 36, vertices, 24);
+
+		// Faces further from the centre occlude more, so the z faces come first and the x faces last
+		for (uint t = 0; t < 4; ++t)
+		{
+			TYR_CHECK(indices[t * 3] / 8 == 2);
+			TYR_CHECK(indices[(11 - t) * 3] / 8 == 0);
+		}
+	}
+}
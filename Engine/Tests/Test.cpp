@@ -0,0 +1,56 @@
+#include "Test.h"
+#include <cstdio>
+
+namespace tyr
+{
+	void TestState::Fail(const char* file, int line, const char* expression)
+	{
+		// Only the first few failures of a test are printed since a broken loop can fail thousands of times
+		if (m_FailureCount < 10)
+		{
+			std::printf("  %s(%d): check failed: %s\n", file, line, expression);
+		}
+		++m_FailureCount;
+	}
+
+	TestRegistry& TestRegistry::Instance()
+	{
+		static TestRegistry instance;
+		return instance;
+	}
+
+	void TestRegistry::Register(const char* name, TestFunc func)
+	{
+		TestDesc desc;
+		desc.name = name;
+		desc.func = func;
+		m_Tests.Add(desc);
+	}
+
+	uint TestRegistry::Run(const String& filter) const
+	{
+		uint runCount = 0;
+		uint failedCount = 0;
+		for (const TestDesc& desc : m_Tests)
+		{
+			if (!filter.empty() && desc.name.find(filter) == String::npos)
+			{
+				continue;
+			}
+
+			std::printf("Running %s...\n", desc.name.c_str());
+			std::fflush(stdout);
+			TestState state;
+			desc.func(state);
+			++runCount;
+			if (state.GetFailureCount() > 0)
+			{
+				std::printf("FAILED %s with %u failed check(s)\n", desc.name.c_str(), state.GetFailureCount());
+				++failedCount;
+			}
+		}
+
+		std::printf("\n%u of %u test(s) passed\n", runCount - failedCount, runCount);
+		return failedCount;
+	}
+}
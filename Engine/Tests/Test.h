@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Base/Base.h"
+#include "Containers/Array.h"
+#include "String/StringTypes.h"
+#include <cmath>
+
+namespace tyr
+{
+	/// Passed to a test function. Failed checks are recorded and the test carries on so that every failure is reported.
+	class TestState final
+	{
+	public:
+		void Fail(const char* file, int line, const char* expression);
+
+		uint GetFailureCount() const { return m_FailureCount; }
+
+	private:
+		uint m_FailureCount = 0;
+	};
+
+	using TestFunc = void(*)(TestState&);
+
+	struct TestDesc
+	{
+		String name;
+		TestFunc func;
+	};
+
+	/// Registry and runner for the tests.
+	class TestRegistry final
+	{
+	public:
+		static TestRegistry& Instance();
+
+		void Register(const char* name, TestFunc func);
+
+		/// Runs the tests whose name contains filter, or all of them if it is empty. Returns the number that failed.
+		uint Run(const String& filter) const;
+
+		const Array<TestDesc>& GetTests() const { return m_Tests; }
+
+	private:
+		Array<TestDesc> m_Tests;
+	};
+
+	struct TestRegistrar final
+	{
+		TestRegistrar(const char* name, TestFunc func)
+		{
+			TestRegistry::Instance().Register(name, func);
+		}
+	};
+
+	/// Deterministic xorshift generator so that every run uses the same data.
+	class TestRandom final
+	{
+	public:
+		TestRandom(uint64 seed = 0x9E3779B97F4A7C15ull)
+			: m_State(seed ? seed : 1)
+		{
+
+		}
+
+		uint64 Next()
+		{
+			m_State ^= m_State << 13;
+			m_State ^= m_State >> 7;
+			m_State ^= m_State << 17;
+			return m_State;
+		}
+
+		/// Returns a float in [min, max).
+		float NextFloat(float min, float max)
+		{
+			return min + (max - min) * static_cast<float>(Next() >> 40) / static_cast<float>(1ull << 24);
+		}
+
+	private:
+		uint64 m_State;
+	};
+}
+
+#define TYR_TEST_CONCAT_INNER(a, b) a##b
+#define TYR_TEST_CONCAT(a, b) TYR_TEST_CONCAT_INNER(a, b)
+
+/// Defines and registers a test function taking a TestState& named state.
+#define TYR_TEST(name) \
+	static void name(::tyr::TestState& state); \
+	static ::tyr::TestRegistrar TYR_TEST_CONCAT(s_Registrar, name)(#name, name); \
+	static void name(::tyr::TestState& state)
+
+/// Records a failure if the condition is false.
+#define TYR_CHECK(condition) \
+	do { if (!(condition)) { state.Fail(__FILE__, __LINE__, #condition); } } while (false)
+
+/// Records a failure if a and b differ by more than tolerance.
+#define TYR_CHECK_NEAR(a, b, tolerance) \
+	do { if (!(std::abs((a) - (b)) <= (tolerance))) { state.Fail(__FILE__, __LINE__, #a " == " #b); } } while (false)
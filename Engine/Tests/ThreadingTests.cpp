@@ -0,0 +1,252 @@
+#include "Test.h"
+#include "Containers/WorkStealingQueue.h"
+#include "Memory/MemoryTypes.h"
+#include "Threading/JobSystem.h"
+
+namespace tyr
+{
+	namespace
+	{
+		// Counts how often each item was seen. Returns the number of items seen more than once and the number never seen.
+		void CountTallies(const Array<uint>& tallies, uint& duplicatedCount, uint& lostCount)
+		{
+			duplicatedCount = 0;
+			lostCount = 0;
+			for (uint tally : tallies)
+			{
+				duplicatedCount += tally > 1 ? 1 : 0;
+				lostCount += tally == 0 ? 1 : 0;
+			}
+		}
+
+		static constexpr uint c_SubmitterCount = 3;
+		static constexpr uint c_OuterJobCount = 128;
+		static constexpr uint c_InnerJobCount = 32;
+		static constexpr uint c_JobsPerSubmitter = c_OuterJobCount * (c_InnerJobCount + 1);
+
+		struct JobStressState
+		{
+			JobSystem* jobSystem;
+			URef<Atomic<uint>[]> tallies;
+			// Outer jobs that found one of their inner jobs unfinished after waiting on them
+			Atomic<uint> incompleteWaitCount;
+		};
+
+		struct JobStressContext
+		{
+			JobStressState* stress;
+			uint index;
+		};
+
+		void RunInnerJob(void* data)
+		{
+			const JobStressContext& context = *static_cast<JobStressContext*>(data);
+			context.stress->tallies[context.index].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Submits its inner jobs and waits on them from inside the job
+		void RunOuterJob(void* data)
+		{
+			JobStressContext* context = static_cast<JobStressContext*>(data);
+			JobStressState& stress = *context->stress;
+
+			JobCounter counter;
+			for (uint i = 1; i <= c_InnerJobCount; ++i)
+			{
+				Callable callable;
+				callable.Execute = &RunInnerJob;
+				callable.Context = context + i;
+				stress.jobSystem->Submit(std::move(callable), &counter);
+			}
+			stress.jobSystem->Wait(counter);
+
+			for (uint i = 1; i <= c_InnerJobCount; ++i)
+			{
+				if (stress.tallies[context[i].index].load(std::memory_order_relaxed) == 0)
+				{
+					stress.incompleteWaitCount.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+			stress.tallies[context->index].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Submits the outer jobs of one submitter. Each outer job is followed by the contexts of its inner jobs.
+		void SubmitOuterJobs(JobStressState& stress, Array<JobStressContext>& contexts, uint submitter)
+		{
+			JobCounter counter;
+			const uint first = submitter * c_JobsPerSubmitter;
+			for (uint i = 0; i < c_JobsPerSubmitter; i += c_InnerJobCount + 1)
+			{
+				Callable callable;
+				callable.Execute = &RunOuterJob;
+				callable.Context = &contexts[first + i];
+				stress.jobSystem->Submit(std::move(callable), &counter);
+			}
+			stress.jobSystem->Wait(counter);
+		}
+	}
+
+	// The owner pushes and pops while thieves steal. Every item must come out exactly once.
+	TYR_TEST(WorkStealingQueueExactlyOnce)
+	{
+		static constexpr uint c_ItemCount = 200000;
+		static constexpr uint c_ThiefCount = 3;
+		// Small so that the deque fills up and wraps around many times
+		using Queue = WorkStealingQueue<uint64, 256>;
+
+		URef<Queue> queue = std::make_unique<Queue>();
+		Atomic<bool> done = false;
+		Array<Array<uint64>> stolenItems(c_ThiefCount);
+		Array<Thread> thieves;
+		thieves.Reserve(c_ThiefCount);
+		for (uint t = 0; t < c_ThiefCount; ++t)
+		{
+			thieves.Add(Thread([&queue, &done, &stolen = stolenItems[t]]()
+			{
+				while (!done.load(std::memory_order_acquire))
+				{
+					if (Optional<uint64> item = queue->Steal())
+					{
+						stolen.Add(*item);
+					}
+					else
+					{
+						TYR_THREAD_YIELD
+					}
+				}
+			}));
+		}
+
+		TestRandom random;
+		Array<uint64> poppedItems;
+		for (uint64 i = 0; i < c_ItemCount; ++i)
+		{
+			while (!queue->Push(i))
+			{
+				// Full so make room the way a worker would, by running one of its own jobs
+				if (Optional<uint64> item = queue->Pop())
+				{
+					poppedItems.Add(*item);
+				}
+			}
+
+			// Pop every so often so that the owner races the thieves for the last items as well as the top, and yield
+			// every so often so that the thieves get to run even on a single core
+			const uint64 action = random.Next() % 16;
+			if (action < 2)
+			{
+				if (Optional<uint64> item = queue->Pop())
+				{
+					poppedItems.Add(*item);
+				}
+			}
+			else if (action == 2)
+			{
+				TYR_THREAD_YIELD
+			}
+		}
+		while (!queue->IsEmpty())
+		{
+			if (Optional<uint64> item = queue->Pop())
+			{
+				poppedItems.Add(*item);
+			}
+		}
+
+		done.store(true, std::memory_order_release);
+		for (Thread& thief : thieves)
+		{
+			thief.join();
+		}
+
+		Array<uint> tallies;
+		tallies.Resize(c_ItemCount, 0u);
+		uint invalidCount = 0;
+		auto tally = [&tallies, &invalidCount](const Array<uint64>& items)
+		{
+			for (uint64 item : items)
+			{
+				if (item < c_ItemCount)
+				{
+					++tallies[static_cast<uint>(item)];
+				}
+				else
+				{
+					++invalidCount;
+				}
+			}
+		};
+		tally(poppedItems);
+		for (const Array<uint64>& stolen : stolenItems)
+		{
+			tally(stolen);
+		}
+
+		uint duplicatedCount;
+		uint lostCount;
+		CountTallies(tallies, duplicatedCount, lostCount);
+		TYR_CHECK(invalidCount == 0);
+		TYR_CHECK(duplicatedCount == 0);
+		TYR_CHECK(lostCount == 0);
+	}
+
+	// Workers and external threads submit jobs that submit and wait on nested jobs. Every job must run exactly once
+	// and every wait must return only once its jobs have finished.
+	TYR_TEST(JobSystemNestedWaitExactlyOnce)
+	{
+		static constexpr uint c_JobCount = c_SubmitterCount * c_JobsPerSubmitter;
+
+		JobStressState stress;
+		stress.tallies = std::make_unique<Atomic<uint>[]>(c_JobCount);
+		stress.incompleteWaitCount.store(0, std::memory_order_relaxed);
+		Array<JobStressContext> contexts(c_JobCount);
+		for (uint i = 0; i < c_JobCount; ++i)
+		{
+			contexts[i] = { &stress, i };
+		}
+
+		// Runs on its own job system with a fixed worker count so that jobs are stolen whatever the core count.
+		// The thread that initializes it becomes worker 0 so the test's thread isn't affected.
+		Thread owner([&stress, &contexts]()
+		{
+			JobSystem jobSystem;
+			JobSystemConfig config;
+			config.workerCount = 4;
+			jobSystem.Initialize(config);
+			stress.jobSystem = &jobSystem;
+
+			// Threads that aren't workers go through the shared queue and task pool
+			Array<Thread> externals;
+			externals.Reserve(c_SubmitterCount - 1);
+			for (uint s = 1; s < c_SubmitterCount; ++s)
+			{
+				externals.Add(Thread([&stress, &contexts, s]()
+				{
+					SubmitOuterJobs(stress, contexts, s);
+				}));
+			}
+			SubmitOuterJobs(stress, contexts, 0);
+			for (Thread& external : externals)
+			{
+				external.join();
+			}
+
+			jobSystem.Shutdown();
+		});
+		owner.join();
+
+		Array<uint> tallies;
+		tallies.Reserve(c_JobCount);
+		for (uint i = 0; i < c_JobCount; ++i)
+		{
+			tallies.Add(stress.tallies[i].load(std::memory_order_relaxed));
+		}
+
+		uint duplicatedCount;
+		uint lostCount;
+		CountTallies(tallies, duplicatedCount, lostCount);
+		TYR_CHECK(duplicatedCount == 0);
+		TYR_CHECK(lostCount == 0);
+		TYR_CHECK(stress.incompleteWaitCount.load(std::memory_order_relaxed) == 0);
+	}
+}